@@ -1,4 +1,5 @@
 
+using System.IO;
 using UnrealBuildTool;
 
 public class MultiplayGameServerSDK : ModuleRules
@@ -28,5 +29,20 @@ public class MultiplayGameServerSDK : ModuleRules
 				"Engine",
 			}
 			);
+
+		// The settings derive from UDeveloperSettings, which moved out of the Engine module in 4.26.
+		if (Target.Version.MajorVersion > 4 || Target.Version.MinorVersion >= 26)
+		{
+			PublicDependencyModuleNames.Add("DeveloperSettings");
+		}
+		else
+		{
+			PublicDependencyModuleNames.Add("Engine");
+		}
+
+		// The query receiver polls the descriptors of its sockets together, which the BSD socket header exposes.
+		PrivateIncludePaths.Add(Path.Combine(EngineDirectory, "Source", "Runtime", "Sockets", "Private"));
+
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
 	}
 }
@@ -1,38 +1,40 @@
 #include "MultiplayCentrifugeClient.h"
 #include "MultiplayCentrifugeLog.h"
 #include "MultiplayCentrifugeMessages.h"
-#include "WebSocketsModule.h"
-#include "IWebSocket.h"
-#include "Runtime/Launch/Resources/Version.h"
+#include "MultiplayGameServerSDK/MultiplayLogSink.h"
 
 namespace Multiplay
 {
-	FCentrifugeClient::FCentrifugeClient(FString Url) : Url(Url), Id(kInitialMsgId), Status(EConnectionStatus::Disconnected)
+	FCentrifugeClient::FCentrifugeClient(FString Url, ECentrifugeConnectionType ConnectionType, FString UnixSocketPath) : Url(Url), ConnectionType(ConnectionType), UnixSocketPath(UnixSocketPath), Id(kInitialMsgId), Status(EConnectionStatus::Disconnected), MessageReceivedSeconds(0.0)
 	{
-		WebSocket = FWebSocketsModule::Get().CreateWebSocket(Url, TEXT("ws"));
+		CreateWebSocket();
+	}
+
+	FCentrifugeClient::~FCentrifugeClient()
+	{
+		DestroyWebSocket();
+	}
+
+	void FCentrifugeClient::CreateWebSocket()
+	{
+		WebSocket = CreateCentrifugeConnection(Url, ConnectionType, UnixSocketPath);
 
 		WebSocket->OnConnected().AddRaw(this, &FCentrifugeClient::OnConnected);
 		WebSocket->OnConnectionError().AddRaw(this, &FCentrifugeClient::OnConnectionError);
 		WebSocket->OnClosed().AddRaw(this, &FCentrifugeClient::OnClosed);
 		WebSocket->OnMessage().AddRaw(this, &FCentrifugeClient::OnMessage);
-#if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 25) || (ENGINE_MAJOR_VERSION > 4)
-		// This callback was added in UE 4.25.
-		// This callback is used for logging purposes so its absence is acceptable.
 		WebSocket->OnMessageSent().AddRaw(this, &FCentrifugeClient::OnMessageSent);
-#endif
 	}
 
-	FCentrifugeClient::~FCentrifugeClient()
+	void FCentrifugeClient::DestroyWebSocket()
 	{
 		WebSocket->OnConnected().RemoveAll(this);
 		WebSocket->OnConnectionError().RemoveAll(this);
 		WebSocket->OnClosed().RemoveAll(this);
 		WebSocket->OnMessage().RemoveAll(this);
-#if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 25) || (ENGINE_MAJOR_VERSION > 4)
-		// This callback was added in UE 4.25.
-		// This callback is used for logging purposes so its absence is acceptable.
 		WebSocket->OnMessageSent().RemoveAll(this);
-#endif
+
+		WebSocket.Reset();
 	}
 
 	void FCentrifugeClient::Connect(const FConnectRequest& Request)
@@ -51,6 +53,9 @@ namespace Multiplay
 		}
 		else
 		{
+			// The request is kept so that it can be sent again whenever the connection is re-established.
+			ConnectRequest = MakeUnique<FConnectRequest>(Request);
+
 			ChangeConnectionStatus(EConnectionStatus::Connecting);
 
 			WebSocket->Connect();
@@ -59,12 +64,16 @@ namespace Multiplay
 
 	void FCentrifugeClient::Subscribe(const FSubscribeRequest& Request)
 	{
-		SendRequest<FSubscribeRequest>(Request);
+		uint32 MessageId = SendRequest<FSubscribeRequest>(Request);
+
+		Requests[MessageId].Channel = Request.Channel.Get(FString());
 	}
 
 	void FCentrifugeClient::Unsubscribe(const FUnsubscribeRequest& Request)
 	{
-		SendRequest<FUnsubscribeRequest>(Request);
+		uint32 MessageId = SendRequest<FUnsubscribeRequest>(Request);
+
+		Requests[MessageId].Channel = Request.Channel;
 	}
 
 	void FCentrifugeClient::Publish(const FPublishRequest& Request)
@@ -84,7 +93,9 @@ namespace Multiplay
 
 	void FCentrifugeClient::History(const FHistoryRequest& Request)
 	{
-		SendRequest<FHistoryRequest>(Request);
+		uint32 MessageId = SendRequest<FHistoryRequest>(Request);
+
+		Requests[MessageId].Channel = Request.Channel;
 	}
 
 	void FCentrifugeClient::Ping(const FPingRequest& Request)
@@ -102,6 +113,13 @@ namespace Multiplay
 		SendRequest<FRpcRequest>(Request);
 	}
 
+	void FCentrifugeClient::Rpc(const FRpcRequest& Request, const FRpcCompleteDelegate& OnComplete)
+	{
+		uint32 MessageId = SendRequest<FRpcRequest>(Request);
+
+		Requests[MessageId].OnRpcComplete = OnComplete;
+	}
+
 	void FCentrifugeClient::Refresh(const FRefreshRequest& Request)
 	{
 		SendRequest<FRefreshRequest>(Request);
@@ -134,22 +152,51 @@ namespace Multiplay
 		}
 	}
 
+	void FCentrifugeClient::Reconnect()
+	{
+		UE_LOG(LogCentrifuge, Log, TEXT("Reconnecting to the Centrifuge server."));
+
+		// The handlers are unbound before closing so that the stale connection cannot report back once it has been replaced.
+		TSharedPtr<ICentrifugeConnection, ESPMode::ThreadSafe> StaleWebSocket = WebSocket;
+		DestroyWebSocket();
+		StaleWebSocket->Close();
+
+		// Replies to commands sent over the stale connection will never arrive.
+		FailPendingRequests(TEXT("The connection was re-established."));
+
+		ChangeConnectionStatus(EConnectionStatus::Disconnected);
+
+		CreateWebSocket();
+
+		ChangeConnectionStatus(EConnectionStatus::Connecting);
+
+		WebSocket->Connect();
+	}
+
 	void FCentrifugeClient::OnConnected()
 	{
 		ChangeConnectionStatus(EConnectionStatus::Connected);
 
 		UE_LOG(LogCentrifuge, Log, TEXT("OnConnected()"));
 
-		// TODO: Use argument from FCentrifugeClient::Connect() for FConnectRequest.
-		FConnectRequest Request;
-		SendRequest<FConnectRequest>(Request);
+		if (ConnectRequest.IsValid())
+		{
+			SendRequest<FConnectRequest>(*ConnectRequest);
+		}
+		else
+		{
+			SendRequest<FConnectRequest>(FConnectRequest());
+		}
 	}
 
 	void FCentrifugeClient::OnConnectionError(const FString& Error)
 	{
 		UE_LOG(LogCentrifuge, Error, TEXT("OnConnectionError(%s)"), *Error);
 
-		// TODO: Implement this method.
+		// The attempt is over, a client left connecting could never be connected again.
+		ChangeConnectionStatus(EConnectionStatus::Disconnected);
+
+		FailPendingRequests(TEXT("The connection failed."));
 	}
 
 	void FCentrifugeClient::OnClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
@@ -158,24 +205,26 @@ namespace Multiplay
 
 		UE_LOG(LogCentrifuge, Log, TEXT("OnClosed(%d, %s, %d)"), StatusCode, *Reason, bWasClean);
 
-		// TODO: Implement this method.
+		FailPendingRequests(TEXT("The connection was closed."));
 	}
 
-	void FCentrifugeClient::OnMessage(const FString& MessageString)
+	void FCentrifugeClient::OnMessage(const FString& MessageString, double ReceivedSeconds)
 	{
-		UE_LOG(LogCentrifuge, Log, TEXT("OnMessage(%s)"), *MessageString);
+		MessageReceivedSeconds = ReceivedSeconds;
+
+		MULTIPLAY_LOG(LogCentrifuge, Log, TEXT("OnMessage(%s)"), *MessageString);
 
 		ParseCentrifugeMessages(MessageString);
 	}
 
 	void FCentrifugeClient::OnMessageSent(const FString& MessageString)
 	{
-		UE_LOG(LogCentrifuge, Log, TEXT("OnMessageSent(%s)"), *MessageString);
+		MULTIPLAY_LOG(LogCentrifuge, Log, TEXT("OnMessageSent(%s)"), *MessageString);
 	}
 
 	void FCentrifugeClient::ChangeConnectionStatus(EConnectionStatus NewStatus)
 	{
-		UE_LOG(LogCentrifuge, Verbose, TEXT("Changing connection status from %d to %d."), Status, NewStatus);
+		MULTIPLAY_LOG(LogCentrifuge, Verbose, TEXT("Changing connection status from %d to %d."), Status, NewStatus);
 
 		Status = NewStatus;
 		ConnectionStatusChanged.Broadcast(Status);
@@ -197,7 +246,7 @@ namespace Multiplay
 	}
 
 	template <typename T>
-	void FCentrifugeClient::SendRequest(const T& Request)
+	uint32 FCentrifugeClient::SendRequest(const T& Request)
 	{
 		uint32 MessageId = GetNextMessageId();
 
@@ -214,6 +263,28 @@ namespace Multiplay
 		Writer->Close();
 
 		WebSocket->Send(JsonBody);
+
+		return MessageId;
+	}
+
+	void FCentrifugeClient::FailPendingRequests(const FString& Reason)
+	{
+		// The requests are moved out first so that a completion callback may safely issue new commands.
+		TMap<uint32, FRequest> PendingRequests = MoveTemp(Requests);
+		Requests.Reset();
+
+		FError Error;
+		Error.Code = 0;
+		Error.Message = Reason;
+
+		for (const auto& It : PendingRequests)
+		{
+			It.Value.OnRpcComplete.ExecuteIfBound(false, FRpcResult(), Error);
+
+			// Reported like an error reply, so that the issuer of a command such as HISTORY stops waiting for its reply.
+			MessageChannel = It.Value.Channel;
+			ErrorReply.Broadcast(It.Value.Method, Error);
+		}
 	}
 
 	bool FCentrifugeClient::TryGetError(const TSharedPtr<FJsonObject>& JsonObject)
@@ -229,7 +300,17 @@ namespace Multiplay
 		{
 			UE_LOG(LogCentrifuge, Error, TEXT("Encountered a Centrifuge error: %d - %s"), Error.Code, *Error.Message);
 
-			// TODO: Respond to the error.
+			// Errors sent in reply to a command carry the ID of that command, release it so that the caller can respond to the failure.
+			uint32 ReplyId;
+			FRequest Request;
+			if (TryGetJsonValue(JsonObject, TEXT("id"), ReplyId) && Requests.RemoveAndCopyValue(ReplyId, Request))
+			{
+				MessageChannel = Request.Channel;
+
+				Request.OnRpcComplete.ExecuteIfBound(false, FRpcResult(), Error);
+
+				ErrorReply.Broadcast(Request.Method, Error);
+			}
 
 			return true;
 		}
@@ -252,10 +333,18 @@ namespace Multiplay
 			return false;
 		}
 
+		MessageChannel = Request.Channel;
+
 		TSharedPtr<FJsonValue> ResultJsonValue;
 		if (!TryGetJsonValue(JsonObject, TEXT("result"), ResultJsonValue))
 		{
-			return false;
+			// Centrifuge omits empty results from replies to a PING or an RPC.
+			if (Request.Method != EMethodType::Ping && Request.Method != EMethodType::RPC)
+			{
+				return false;
+			}
+
+			ResultJsonValue = MakeShared<FJsonValueObject>(MakeShared<FJsonObject>());
 		}
 
 		switch (Request.Method)
@@ -400,6 +489,8 @@ namespace Multiplay
 			FRpcResult Reply;
 			if (Reply.FromJson(ResultJsonValue))
 			{
+				Request.OnRpcComplete.ExecuteIfBound(true, Reply, FError());
+
 				RpcReply.Broadcast(Reply);
 
 				return true;
@@ -407,6 +498,11 @@ namespace Multiplay
 			else
 			{
 				UE_LOG(LogCentrifuge, Error, TEXT("Failed to parse RpcResult"));
+
+				FError Error;
+				Error.Code = 0;
+				Error.Message = TEXT("Failed to parse RpcResult");
+				Request.OnRpcComplete.ExecuteIfBound(false, FRpcResult(), Error);
 			}
 
 			break;
@@ -472,6 +568,10 @@ namespace Multiplay
 			return false;
 		}
 
+		// Pushes for a subscription name its channel, connection-wide pushes do not.
+		MessageChannel.Empty();
+		TryGetJsonValue(*ResultObject, TEXT("channel"), MessageChannel);
+
 		EPushType PushType;
 		if (!TryGetJsonValue(*ResultObject, TEXT("type"), (int32&)PushType))
 		{
@@ -653,14 +753,14 @@ namespace Multiplay
 			{
 				const FString& Message = MessageArray[i];
 
-				UE_LOG(LogCentrifuge, Log, TEXT("Attempting to parse message %d of %d: %s"), (i + 1), Count, *Message);
+				MULTIPLAY_LOG(LogCentrifuge, Log, TEXT("Attempting to parse message %d of %d: %s"), (i + 1), Count, *Message);
 
 				ParseCentrifugeMessage(Message);
 			}
 		}
 		else
 		{
-			UE_LOG(LogCentrifuge, Log, TEXT("Attempting to parse message: %s"), *MessageString);
+			MULTIPLAY_LOG(LogCentrifuge, Log, TEXT("Attempting to parse message: %s"), *MessageString);
 
 			ParseCentrifugeMessage(MessageString);
 		}
@@ -678,7 +778,7 @@ namespace Multiplay
 			{
 				if (TryGetError(*JsonObject) || TryGetReply(*JsonObject) || TryGetPush(*JsonObject))
 				{
-					UE_LOG(LogCentrifuge, Log, TEXT("Successfully converted %s into an ERROR, REPLY, or PUSH message."), *MessageString);
+					MULTIPLAY_LOG(LogCentrifuge, Log, TEXT("Successfully converted %s into an ERROR, REPLY, or PUSH message."), *MessageString);
 				}
 				else
 				{
@@ -3,8 +3,7 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 #include "MultiplayCentrifugeForwardDeclarations.h"
-
-class IWebSocket;
+#include "MultiplayCentrifugeConnection.h"
 
 namespace Multiplay
 {
@@ -16,10 +15,16 @@ namespace Multiplay
 		Disconnecting,
 	};
 
+	// Invoked once per RPC with either the result, or the error that rejected it. An error with code 0 means the connection was lost before a reply arrived.
+	DECLARE_DELEGATE_ThreeParams(FRpcCompleteDelegate, bool /* bSucceeded */, const FRpcResult& /* Result */, const FError& /* Error */);
+
 	struct FRequest
 	{
 		uint32 Id;
 		EMethodType Method;
+		// The channel the command was sent for, empty for commands that do not name one.
+		FString Channel;
+		FRpcCompleteDelegate OnRpcComplete;
 	};
 
 	class FCentrifugeClient
@@ -32,11 +37,23 @@ namespace Multiplay
 		static constexpr uint32 kInitialMsgId = 1;
 
 	public:
-		FCentrifugeClient(FString Url);
+		FCentrifugeClient(FString Url, ECentrifugeConnectionType ConnectionType = ECentrifugeConnectionType::Engine, FString UnixSocketPath = FString());
 		~FCentrifugeClient();
 
 		void Disconnect();
 
+		// Discards the current connection without waiting for a close handshake and connects again.
+		void Reconnect();
+
+		EConnectionStatus GetConnectionStatus() const { return Status; }
+		bool IsConnected() const { return Status == EConnectionStatus::Connected; }
+
+		// The FPlatformTime::Seconds at which the socket read the message currently or most recently dispatched.
+		double GetMessageReceivedSeconds() const { return MessageReceivedSeconds; }
+
+		// The channel of the reply or push currently or most recently dispatched, empty when it did not concern one.
+		const FString& GetMessageChannel() const { return MessageChannel; }
+
 	public:
 		// Command Messages
 		void Connect(const FConnectRequest& Request);
@@ -49,6 +66,7 @@ namespace Multiplay
 		void Ping(const FPingRequest& Request);
 		void Send(const FSendRequest& Request);
 		void Rpc(const FRpcRequest& Request);
+		void Rpc(const FRpcRequest& Request, const FRpcCompleteDelegate& OnComplete);
 		void Refresh(const FRefreshRequest& Request);
 		void SubRefresh(const FSubRefreshRequest& Request);
 
@@ -87,6 +105,10 @@ namespace Multiplay
 		DECLARE_EVENT_OneParam(FCentrifugeClient, FSubRefreshReplyEvent, const FSubRefreshResult&)
 		FSubRefreshReplyEvent& OnSubRefreshReply() { return SubRefreshReply; }
 
+		// Error Messages
+		DECLARE_EVENT_TwoParams(FCentrifugeClient, FErrorReplyEvent, EMethodType, const FError&)
+		FErrorReplyEvent& OnErrorReply() { return ErrorReply; }
+
 	public:
 		// Push Messages
 		DECLARE_EVENT_OneParam(FCentrifugeClient, FPublicationPushEvent, const FPublication&)
@@ -122,20 +144,26 @@ namespace Multiplay
 		FConnectionStatusChangedEvent& OnConnectionStatusChanged() { return ConnectionStatusChanged; }
 
 	private:
-		// IWebSocket
+		// ICentrifugeConnection
 		void OnConnected();
 		void OnConnectionError(const FString& Error);
 		void OnClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
-		void OnMessage(const FString& MessageString);
+		void OnMessage(const FString& MessageString, double ReceivedSeconds);
 		void OnMessageSent(const FString& MessageString);
 
 	private:
+		void CreateWebSocket();
+		void DestroyWebSocket();
+
 		void ChangeConnectionStatus(EConnectionStatus NewStatus);
 
 		uint32 GetNextMessageId();
 
 		template <typename T>
-		void SendRequest(const T& Request);
+		uint32 SendRequest(const T& Request);
+
+		// Completes every outstanding RPC with an error and raises an error reply for every outstanding command, replies to them can no longer arrive.
+		void FailPendingRequests(const FString& Reason);
 
 		bool TryGetError(const TSharedPtr<FJsonObject>& JsonObject);
 		bool TryGetReply(const TSharedPtr<FJsonObject>& JsonObject);
@@ -157,6 +185,7 @@ namespace Multiplay
 		FRpcReplyEvent RpcReply;
 		FRefreshReplyEvent RefreshReply;
 		FSubRefreshReplyEvent SubRefreshReply;
+		FErrorReplyEvent ErrorReply;
 		
 	private:
 		// Push Messages
@@ -176,9 +205,14 @@ namespace Multiplay
 
 	private:
 		FString Url;
+		ECentrifugeConnectionType ConnectionType;
+		FString UnixSocketPath;
 		uint32 Id;
 		EConnectionStatus Status;
-		TSharedPtr<IWebSocket> WebSocket;
+		TSharedPtr<ICentrifugeConnection, ESPMode::ThreadSafe> WebSocket;
 		TMap<uint32, FRequest> Requests;
+		TUniquePtr<FConnectRequest> ConnectRequest;
+		double MessageReceivedSeconds;
+		FString MessageChannel;
 	};
 } // namespace Multiplay
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "MultiplayCentrifugeConnection.h"
+#include "MultiplayCentrifugeWebSocket.h"
+#include "HAL/PlatformTime.h"
+#include "WebSocketsModule.h"
+#include "IWebSocket.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+namespace Multiplay
+{
+	FEngineCentrifugeConnection::FEngineCentrifugeConnection(const FString& Url)
+	{
+		WebSocket = FWebSocketsModule::Get().CreateWebSocket(Url, TEXT("ws"));
+
+		WebSocket->OnConnected().AddLambda([this]() { ConnectedEvent.Broadcast(); });
+		WebSocket->OnConnectionError().AddLambda([this](const FString& Error) { ConnectionErrorEvent.Broadcast(Error); });
+		WebSocket->OnClosed().AddLambda([this](int32 StatusCode, const FString& Reason, bool bWasClean) { ClosedEvent.Broadcast(StatusCode, Reason, bWasClean); });
+		// The engine reads the socket from its tick, just before broadcasting.
+		WebSocket->OnMessage().AddLambda([this](const FString& MessageString) { MessageEvent.Broadcast(MessageString, FPlatformTime::Seconds()); });
+#if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 25) || (ENGINE_MAJOR_VERSION > 4)
+		// This callback was added in UE 4.25.
+		// This callback is used for logging purposes so its absence is acceptable.
+		WebSocket->OnMessageSent().AddLambda([this](const FString& MessageString) { MessageSentEvent.Broadcast(MessageString); });
+#endif
+	}
+
+	FEngineCentrifugeConnection::~FEngineCentrifugeConnection()
+	{
+		// The engine websocket may outlive this object while it is closing, it must not call back into it.
+		WebSocket->OnConnected().Clear();
+		WebSocket->OnConnectionError().Clear();
+		WebSocket->OnClosed().Clear();
+		WebSocket->OnMessage().Clear();
+#if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 25) || (ENGINE_MAJOR_VERSION > 4)
+		WebSocket->OnMessageSent().Clear();
+#endif
+	}
+
+	void FEngineCentrifugeConnection::Connect()
+	{
+		WebSocket->Connect();
+	}
+
+	void FEngineCentrifugeConnection::Close()
+	{
+		WebSocket->Close();
+	}
+
+	bool FEngineCentrifugeConnection::IsConnected() const
+	{
+		return WebSocket->IsConnected();
+	}
+
+	void FEngineCentrifugeConnection::Send(const FString& Data)
+	{
+		WebSocket->Send(Data);
+	}
+
+	TSharedRef<ICentrifugeConnection, ESPMode::ThreadSafe> CreateCentrifugeConnection(const FString& Url, ECentrifugeConnectionType Type, const FString& UnixSocketPath)
+	{
+		if (Type == ECentrifugeConnectionType::BuiltIn || !UnixSocketPath.IsEmpty())
+		{
+			return MakeShared<FCentrifugeWebSocket, ESPMode::ThreadSafe>(Url, UnixSocketPath);
+		}
+
+		return MakeShared<FEngineCentrifugeConnection, ESPMode::ThreadSafe>(Url);
+	}
+} // namespace Multiplay
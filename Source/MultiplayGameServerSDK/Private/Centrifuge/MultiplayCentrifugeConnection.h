@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IWebSocket;
+
+namespace Multiplay
+{
+	enum class ECentrifugeConnectionType
+	{
+		// The engine WebSockets module.
+		Engine,
+		// The built-in client serviced from its own I/O thread, see FCentrifugeWebSocket.
+		BuiltIn,
+	};
+
+	// The websocket carrying Centrifuge messages. Events are broadcast on the game thread, except that messages received on
+	// an I/O thread are queued until they are drained, see DrainMessages.
+	class ICentrifugeConnection
+	{
+	public:
+		DECLARE_MULTICAST_DELEGATE(FConnectedEvent);
+		DECLARE_MULTICAST_DELEGATE_OneParam(FConnectionErrorEvent, const FString& /* Error */);
+		DECLARE_MULTICAST_DELEGATE_ThreeParams(FClosedEvent, int32 /* StatusCode */, const FString& /* Reason */, bool /* bWasClean */);
+		// ReceivedSeconds is the FPlatformTime::Seconds at which the socket read the message, which may precede the broadcast.
+		DECLARE_MULTICAST_DELEGATE_TwoParams(FMessageEvent, const FString& /* MessageString */, double /* ReceivedSeconds */);
+		DECLARE_MULTICAST_DELEGATE_OneParam(FMessageSentEvent, const FString& /* MessageString */);
+
+	public:
+		virtual ~ICentrifugeConnection() {}
+
+		virtual void Connect() = 0;
+		virtual void Close() = 0;
+		virtual bool IsConnected() const = 0;
+		virtual void Send(const FString& Data) = 0;
+
+		// Broadcasts the queued messages on the calling thread and returns how many there were. Connections that receive on
+		// the game thread broadcast as they receive and never queue.
+		virtual int32 DrainMessages() { return 0; }
+
+		FConnectedEvent& OnConnected() { return ConnectedEvent; }
+		FConnectionErrorEvent& OnConnectionError() { return ConnectionErrorEvent; }
+		FClosedEvent& OnClosed() { return ClosedEvent; }
+		FMessageEvent& OnMessage() { return MessageEvent; }
+		FMessageSentEvent& OnMessageSent() { return MessageSentEvent; }
+
+	protected:
+		FConnectedEvent ConnectedEvent;
+		FConnectionErrorEvent ConnectionErrorEvent;
+		FClosedEvent ClosedEvent;
+		FMessageEvent MessageEvent;
+		FMessageSentEvent MessageSentEvent;
+	};
+
+	// Forwards the engine IWebSocket, which is serviced from the engine tick.
+	class FEngineCentrifugeConnection : public ICentrifugeConnection
+	{
+	public:
+		FEngineCentrifugeConnection(const FString& Url);
+		virtual ~FEngineCentrifugeConnection();
+
+		virtual void Connect() override;
+		virtual void Close() override;
+		virtual bool IsConnected() const override;
+		virtual void Send(const FString& Data) override;
+
+	private:
+		TSharedPtr<IWebSocket> WebSocket;
+	};
+
+	// A Unix domain socket path is only supported by the built-in client, which is used regardless of Type when one is given.
+	TSharedRef<ICentrifugeConnection, ESPMode::ThreadSafe> CreateCentrifugeConnection(const FString& Url, ECentrifugeConnectionType Type, const FString& UnixSocketPath = FString());
+} // namespace Multiplay
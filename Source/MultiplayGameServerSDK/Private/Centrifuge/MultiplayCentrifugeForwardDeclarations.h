@@ -2,6 +2,7 @@
 
 namespace Multiplay
 {
+	enum class EConnectionStatus;
 	enum class EDisconnectCode;
 	enum class EMethodType;
 	enum class EPushType;
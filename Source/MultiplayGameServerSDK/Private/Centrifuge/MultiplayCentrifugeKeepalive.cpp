@@ -0,0 +1,213 @@
+#include "MultiplayCentrifugeKeepalive.h"
+#include "MultiplayCentrifugeClient.h"
+#include "MultiplayCentrifugeLog.h"
+#include "MultiplayCentrifugeMessages.h"
+#include "MultiplayGameServerSDK/MultiplayLogSink.h"
+#include "HAL/PlatformTime.h"
+
+namespace Multiplay
+{
+	constexpr double FCentrifugeRttHistogram::kBucketUpperBoundsMs[];
+
+	FCentrifugeRttHistogram::FCentrifugeRttHistogram()
+	{
+		Reset();
+	}
+
+	void FCentrifugeRttHistogram::Record(double RttMs)
+	{
+		BucketCounts[GetBucketIndex(RttMs)] += 1;
+
+		MinMs = (Count == 0) ? RttMs : FMath::Min(MinMs, RttMs);
+		MaxMs = (Count == 0) ? RttMs : FMath::Max(MaxMs, RttMs);
+		SumMs += RttMs;
+		Count += 1;
+	}
+
+	void FCentrifugeRttHistogram::Reset()
+	{
+		FMemory::Memzero(BucketCounts);
+		Count = 0;
+		SumMs = 0.0;
+		MinMs = 0.0;
+		MaxMs = 0.0;
+	}
+
+	double FCentrifugeRttHistogram::GetPercentileMs(double Percentile) const
+	{
+		if (Count == 0)
+		{
+			return 0.0;
+		}
+
+		const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 100.0) / 100.0 * Count)));
+
+		uint64 Cumulative = 0;
+		for (int32 Index = 0; Index < kNumBounds; ++Index)
+		{
+			Cumulative += BucketCounts[Index];
+			if (Cumulative >= Rank)
+			{
+				return FMath::Min(kBucketUpperBoundsMs[Index], MaxMs);
+			}
+		}
+
+		return MaxMs;
+	}
+
+	int32 FCentrifugeRttHistogram::GetBucketIndex(double RttMs)
+	{
+		for (int32 Index = 0; Index < kNumBounds; ++Index)
+		{
+			if (RttMs <= kBucketUpperBoundsMs[Index])
+			{
+				return Index;
+			}
+		}
+
+		return kNumBounds;
+	}
+
+	FCentrifugeKeepalive::FCentrifugeKeepalive(FCentrifugeClient& InClient, float IntervalSeconds, int32 InMaxMissedPongs, float MaxReconnectDelaySeconds)
+		: FMultiplayTickerObjectBase(IntervalSeconds)
+		, Client(InClient)
+		, MaxMissedPongs(FMath::Max(1, InMaxMissedPongs))
+		, BaseReconnectDelay(IntervalSeconds)
+		, MaxReconnectDelay(FMath::Max(IntervalSeconds, MaxReconnectDelaySeconds))
+		, LastRttMs(0.0)
+		, PingsSent(0)
+		, PongsReceived(0)
+		, Reconnects(0)
+		, PingSentTime(0.0)
+		, MissedPongs(0)
+		, LastStatus(InClient.GetConnectionStatus())
+		, ReconnectDelay(IntervalSeconds)
+		, ReconnectAt(0.0)
+	{
+		Client.OnPingReply().AddRaw(this, &FCentrifugeKeepalive::OnPingReply);
+		Client.OnConnectionStatusChanged().AddRaw(this, &FCentrifugeKeepalive::OnConnectionStatusChanged);
+	}
+
+	FCentrifugeKeepalive::~FCentrifugeKeepalive()
+	{
+		Client.OnPingReply().RemoveAll(this);
+		Client.OnConnectionStatusChanged().RemoveAll(this);
+	}
+
+	bool FCentrifugeKeepalive::Tick(float DeltaTime)
+	{
+		Update(FPlatformTime::Seconds());
+
+		return true;
+	}
+
+	void FCentrifugeKeepalive::Update(double Now)
+	{
+		if (ReconnectAt > 0.0)
+		{
+			if (Now >= ReconnectAt && Client.GetConnectionStatus() == EConnectionStatus::Disconnected)
+			{
+				UE_LOG(LogCentrifuge, Log, TEXT("Retrying the connection to the Centrifuge server."));
+
+				// The next attempt waits longer if this one fails as well.
+				ReconnectDelay = FMath::Min(ReconnectDelay * 2.0, MaxReconnectDelay);
+
+				Reconnect();
+			}
+
+			return;
+		}
+
+		if (Client.GetConnectionStatus() != EConnectionStatus::Connected)
+		{
+			return;
+		}
+
+		if (PingSentTime > 0.0)
+		{
+			MissedPongs += 1;
+
+			UE_LOG(LogCentrifuge, Warning, TEXT("Missed pong %d of %d from the Centrifuge server."), MissedPongs, MaxMissedPongs);
+
+			if (MissedPongs >= MaxMissedPongs)
+			{
+				UE_LOG(LogCentrifuge, Error, TEXT("The Centrifuge server has not answered a ping for %d intervals, reconnecting."), MissedPongs);
+
+				Reconnect();
+			}
+
+			return;
+		}
+
+		PingSentTime = Now;
+		PingsSent += 1;
+
+		Client.Ping(FPingRequest());
+	}
+
+	void FCentrifugeKeepalive::Reconnect()
+	{
+		PingSentTime = 0.0;
+		MissedPongs = 0;
+		ReconnectAt = 0.0;
+		Reconnects += 1;
+
+		Client.Reconnect();
+	}
+
+	void FCentrifugeKeepalive::OnPingReply(const FPingResult& Result)
+	{
+		if (PingSentTime <= 0.0)
+		{
+			return;
+		}
+
+		LastRttMs = (FPlatformTime::Seconds() - PingSentTime) * 1000.0;
+		PingSentTime = 0.0;
+		MissedPongs = 0;
+		PongsReceived += 1;
+
+		Histogram.Record(LastRttMs);
+
+		MULTIPLAY_LOG(LogCentrifuge, Verbose, TEXT("Centrifuge round-trip time was %.3f ms."), LastRttMs);
+	}
+
+	void FCentrifugeKeepalive::OnConnectionStatusChanged(const EConnectionStatus& Status)
+	{
+		// A ping sent on a previous connection will never be answered on the next one.
+		if (Status != EConnectionStatus::Connected)
+		{
+			PingSentTime = 0.0;
+			MissedPongs = 0;
+		}
+
+		switch (Status)
+		{
+		case EConnectionStatus::Connected:
+			ReconnectDelay = BaseReconnectDelay;
+			ReconnectAt = 0.0;
+			break;
+		case EConnectionStatus::Connecting:
+			ReconnectAt = 0.0;
+			break;
+		case EConnectionStatus::Disconnecting:
+			// Disconnected on purpose.
+			ReconnectDelay = BaseReconnectDelay;
+			ReconnectAt = 0.0;
+			break;
+		case EConnectionStatus::Disconnected:
+			// A connection that was lost or could not be established, rather than closed on purpose.
+			if (LastStatus == EConnectionStatus::Connected || LastStatus == EConnectionStatus::Connecting)
+			{
+				UE_LOG(LogCentrifuge, Warning, TEXT("Lost the connection to the Centrifuge server, reconnecting in %.1f seconds."), ReconnectDelay);
+
+				ReconnectAt = FPlatformTime::Seconds() + ReconnectDelay;
+			}
+			break;
+		default:
+			break;
+		}
+
+		LastStatus = Status;
+	}
+} // namespace Multiplay
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Utils/MultiplayTicker.h"
+#include "MultiplayCentrifugeForwardDeclarations.h"
+
+namespace Multiplay
+{
+	// Records round-trip times into fixed buckets so that the distribution can be reported without storing every sample.
+	class FCentrifugeRttHistogram
+	{
+	public:
+		// Inclusive upper bound of each bucket in milliseconds, the final bucket holds every sample above the last bound.
+		static constexpr int32 kNumBounds = 10;
+		static constexpr double kBucketUpperBoundsMs[kNumBounds] = { 1.0, 2.0, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0 };
+		static constexpr int32 kNumBuckets = kNumBounds + 1;
+
+	public:
+		FCentrifugeRttHistogram();
+
+		void Record(double RttMs);
+		void Reset();
+
+		// Returns the upper bound of the bucket containing the given percentile (0-100), or the largest sample for the overflow bucket.
+		double GetPercentileMs(double Percentile) const;
+
+		static int32 GetBucketIndex(double RttMs);
+
+		const uint64* GetBucketCounts() const { return BucketCounts; }
+		uint64 GetCount() const { return Count; }
+		double GetMinMs() const { return MinMs; }
+		double GetMaxMs() const { return MaxMs; }
+		double GetMeanMs() const { return Count > 0 ? (SumMs / Count) : 0.0; }
+
+	private:
+		uint64 BucketCounts[kNumBuckets];
+		uint64 Count;
+		double SumMs;
+		double MinMs;
+		double MaxMs;
+	};
+
+	// Periodically pings the Centrifuge server, measures the round-trip time and reconnects when the link stops responding.
+	//
+	// Only one ping is in flight at a time. Every interval that elapses without a reply counts as a missed pong, which
+	// keeps a late reply attributed to the ping that produced it.
+	//
+	// A connection that is lost or fails to be established is retried after a delay that starts at the interval and
+	// doubles with every attempt up to MaxReconnectDelaySeconds, until the client is connected again. A client that
+	// is disconnected on purpose is left disconnected.
+	class FCentrifugeKeepalive : public FMultiplayTickerObjectBase
+	{
+	public:
+		FCentrifugeKeepalive(FCentrifugeClient& Client, float IntervalSeconds, int32 MaxMissedPongs, float MaxReconnectDelaySeconds = 30.0f);
+		virtual ~FCentrifugeKeepalive();
+
+		virtual bool Tick(float DeltaTime) override;
+
+		// Pings or reconnects as due at the given FPlatformTime::Seconds.
+		void Update(double Now);
+
+	public:
+		const FCentrifugeRttHistogram& GetHistogram() const { return Histogram; }
+		double GetLastRttMs() const { return LastRttMs; }
+		uint64 GetPingsSent() const { return PingsSent; }
+		uint64 GetPongsReceived() const { return PongsReceived; }
+		int32 GetMissedPongs() const { return MissedPongs; }
+		uint64 GetReconnects() const { return Reconnects; }
+
+		// The delay before the next reconnect attempt, zero when none is scheduled.
+		double GetReconnectDelay() const { return ReconnectAt > 0.0 ? ReconnectDelay : 0.0; }
+
+	private:
+		void OnPingReply(const FPingResult& Result);
+		void OnConnectionStatusChanged(const EConnectionStatus& Status);
+
+		void Reconnect();
+
+	private:
+		FCentrifugeClient& Client;
+		int32 MaxMissedPongs;
+		double BaseReconnectDelay;
+		double MaxReconnectDelay;
+
+		FCentrifugeRttHistogram Histogram;
+		double LastRttMs;
+		uint64 PingsSent;
+		uint64 PongsReceived;
+		uint64 Reconnects;
+
+		// Time at which the outstanding ping was sent, zero when no ping is outstanding.
+		double PingSentTime;
+		int32 MissedPongs;
+
+		EConnectionStatus LastStatus;
+		double ReconnectDelay;
+		// Time at which the client is reconnected, zero when no reconnect is scheduled.
+		double ReconnectAt;
+	};
+} // namespace Multiplay
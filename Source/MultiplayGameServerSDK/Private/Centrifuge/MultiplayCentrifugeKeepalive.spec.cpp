@@ -0,0 +1,108 @@
+#include "MultiplayCentrifugeKeepalive.h"
+#include "MultiplayCentrifugeClient.h"
+#include "MultiplayCentrifugeMessages.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformTime.h"
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayCentrifugeKeepaliveSpec, "MultiplayGameServerSDK.CentrifugeKeepalive", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FMultiplayCentrifugeKeepaliveSpec)
+
+void FMultiplayCentrifugeKeepaliveSpec::Define()
+{
+	Describe("FCentrifugeRttHistogram", [this]()
+		{
+			It("should place round-trip times in the bucket with the smallest inclusive upper bound.", [this]()
+				{
+					TestEqual("GetBucketIndex(0.5)", Multiplay::FCentrifugeRttHistogram::GetBucketIndex(0.5), 0);
+					TestEqual("GetBucketIndex(1.0)", Multiplay::FCentrifugeRttHistogram::GetBucketIndex(1.0), 0);
+					TestEqual("GetBucketIndex(1.5)", Multiplay::FCentrifugeRttHistogram::GetBucketIndex(1.5), 1);
+					TestEqual("GetBucketIndex(30.0)", Multiplay::FCentrifugeRttHistogram::GetBucketIndex(30.0), 5);
+					TestEqual("GetBucketIndex(1000.0)", Multiplay::FCentrifugeRttHistogram::GetBucketIndex(1000.0), 9);
+					TestEqual("GetBucketIndex(5000.0)", Multiplay::FCentrifugeRttHistogram::GetBucketIndex(5000.0), Multiplay::FCentrifugeRttHistogram::kNumBuckets - 1);
+				});
+
+			It("should summarize the recorded round-trip times.", [this]()
+				{
+					Multiplay::FCentrifugeRttHistogram Histogram;
+					Histogram.Record(0.5);
+					Histogram.Record(3.0);
+					Histogram.Record(4.0);
+					Histogram.Record(40.0);
+
+					TestEqual("GetCount()", Histogram.GetCount(), static_cast<uint64>(4));
+					TestEqual("GetMinMs()", Histogram.GetMinMs(), 0.5);
+					TestEqual("GetMaxMs()", Histogram.GetMaxMs(), 40.0);
+					TestEqual("GetMeanMs()", Histogram.GetMeanMs(), 11.875);
+					TestEqual("GetBucketCounts()[2]", Histogram.GetBucketCounts()[2], static_cast<uint64>(2));
+					TestEqual("GetPercentileMs(50.0)", Histogram.GetPercentileMs(50.0), 5.0);
+					TestEqual("GetPercentileMs(99.0)", Histogram.GetPercentileMs(99.0), 40.0);
+				});
+
+			It("should report the largest sample as the percentile of the overflow bucket.", [this]()
+				{
+					Multiplay::FCentrifugeRttHistogram Histogram;
+					Histogram.Record(1500.0);
+
+					TestEqual("GetPercentileMs(99.0)", Histogram.GetPercentileMs(99.0), 1500.0);
+
+					Histogram.Reset();
+
+					TestEqual("GetCount()", Histogram.GetCount(), static_cast<uint64>(0));
+					TestEqual("GetPercentileMs(99.0)", Histogram.GetPercentileMs(99.0), 0.0);
+				});
+		});
+
+	Describe("FCentrifugeKeepalive", [this]()
+		{
+			It("should keep retrying a reconnect that fails, waiting twice as long each time up to the maximum.", [this]()
+				{
+					using Multiplay::EConnectionStatus;
+
+					// The built-in client only supports ws:// URLs, so every attempt fails and reports the error on the game thread.
+					Multiplay::FCentrifugeClient Client(TEXT("http://127.0.0.1:8086/v1/connection/websocket"), Multiplay::ECentrifugeConnectionType::BuiltIn);
+					Multiplay::FCentrifugeKeepalive Keepalive(Client, 1.0f, 3, 4.0f);
+
+					Client.Connect(Multiplay::FConnectRequest());
+					TestTrueExpr(Client.GetConnectionStatus() == EConnectionStatus::Connecting);
+
+					FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+					TestTrueExpr(Client.GetConnectionStatus() == EConnectionStatus::Disconnected);
+					TestEqual("GetReconnectDelay()", Keepalive.GetReconnectDelay(), 1.0);
+
+					// The first attempt is not due yet.
+					Keepalive.Update(FPlatformTime::Seconds());
+					TestEqual("GetReconnects()", Keepalive.GetReconnects(), static_cast<uint64>(0));
+
+					const double ExpectedDelays[] = { 2.0, 4.0, 4.0 };
+					for (const double ExpectedDelay : ExpectedDelays)
+					{
+						Keepalive.Update(FPlatformTime::Seconds() + 60.0);
+						TestTrueExpr(Client.GetConnectionStatus() == EConnectionStatus::Connecting);
+						TestEqual("GetReconnectDelay()", Keepalive.GetReconnectDelay(), 0.0);
+
+						FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+						TestTrueExpr(Client.GetConnectionStatus() == EConnectionStatus::Disconnected);
+						TestEqual("GetReconnectDelay()", Keepalive.GetReconnectDelay(), ExpectedDelay);
+					}
+
+					TestEqual("GetReconnects()", Keepalive.GetReconnects(), static_cast<uint64>(3));
+				});
+
+			It("should not reconnect a client that was never connected.", [this]()
+				{
+					Multiplay::FCentrifugeClient Client(TEXT("http://127.0.0.1:8086/v1/connection/websocket"), Multiplay::ECentrifugeConnectionType::BuiltIn);
+					Multiplay::FCentrifugeKeepalive Keepalive(Client, 1.0f, 3);
+
+					Keepalive.Update(FPlatformTime::Seconds() + 60.0);
+
+					TestTrueExpr(Client.GetConnectionStatus() == Multiplay::EConnectionStatus::Disconnected);
+					TestEqual("GetReconnects()", Keepalive.GetReconnects(), static_cast<uint64>(0));
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -130,7 +130,7 @@ namespace Multiplay
 		}
 
 	public:
-		uint32 Code;
+		uint32 Code = 0;
 		FString Message;
 	};
 
@@ -222,6 +222,60 @@ namespace Multiplay
 		TOptional<uint64> Offset; // NOTE: This value may be truncated, it is cast to an int64 because TJsonWriter::WriteValueOnly() does not have overloads for uint32/uint64.
 	};
 
+	// message SubscribeResult {
+	//   bool expires = 1;
+	//   uint32 ttl = 2;
+	//   bool recoverable = 3;
+	//   // 4-5 skipped here for backwards compatibility.
+	//   string epoch = 6;
+	//   repeated Publication publications = 7;
+	//   bool recovered = 8;
+	//   uint64 offset = 9;
+	//   bool positioned = 10;
+	//   bytes data = 11;
+	// }
+	class FSubscribeResult : public IJsonReadable
+	{
+	public:
+		virtual ~FSubscribeResult() {}
+
+		virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) override
+		{
+			const TSharedPtr<FJsonObject>* Object;
+			if (!JsonValue->TryGetObject(Object))
+				return false;
+
+			bool bParseSuccess = true;
+
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("expires"), bExpires);
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("ttl"), TTL);
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("recoverable"), bRecoverable);
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("epoch"), Epoch);
+			// TODO:
+			//   repeated Publication publications = 7;
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("recovered"), bRecovered);
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("offset"), Offset);
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("positioned"), bPositioned);
+			// TODO:
+			//   bytes data = 11;
+
+			return bParseSuccess;
+		}
+
+	public:
+		TOptional<bool> bExpires;
+		TOptional<uint32> TTL;
+		TOptional<bool> bRecoverable;
+		TOptional<FString> Epoch;
+		// TODO:
+		//   repeated Publication publications = 7;
+		TOptional<bool> bRecovered;
+		TOptional<uint64> Offset;
+		TOptional<bool> bPositioned;
+		// TODO:
+		//   bytes data = 11;
+	};
+
 	// message ConnectRequest{
 	//   string token = 1;
 	//   bytes data = 2;
@@ -247,7 +301,10 @@ namespace Multiplay
 			}
 			// TODO
 			//   bytes data = 2;
-			//   map<string, SubscribeRequest> subs = 3;
+			if (Subs.Num() > 0)
+			{
+				Writer->WriteIdentifierPrefix(TEXT("subs")); WriteJsonValue(Writer, Subs);
+			}
 			if (Version.IsSet())
 			{
 				Writer->WriteIdentifierPrefix(TEXT("version")); WriteJsonValue(Writer, Version.GetValue());
@@ -265,7 +322,7 @@ namespace Multiplay
 		TOptional<FString> Name;
 		// TODO
 		//   bytes data = 2;
-		//   map<string, SubscribeRequest> subs = 3;
+		TMap<FString, FSubscribeRequest> Subs; // Channels to subscribe to as part of the connection, keyed by channel name.
 		TOptional<FString> Version;
 	};
 
@@ -296,7 +353,7 @@ namespace Multiplay
 			bParseSuccess &= TryGetJsonValue(*Object, TEXT("ttl"), TTL);
 			// TODO
 			//   bytes data = 5;
-			//   map<string, SubscribeResult> subs = 6;
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("subs"), Subs);
 
 			return bParseSuccess;
 		}
@@ -308,7 +365,7 @@ namespace Multiplay
 		TOptional<uint32> TTL;
 		// TODO
 		//   bytes data = 5;
-		//   map<string, SubscribeResult> subs = 6;
+		TOptional<TMap<FString, FSubscribeResult>> Subs;
 	};
 
 	// message ClientInfo {
@@ -387,7 +444,7 @@ namespace Multiplay
 	public:
 		TSharedPtr<FJsonValue> Data;
 		TOptional<FClientInfo> Info;
-		uint64 Offset;
+		uint64 Offset = 0;
 	};
 
 	// message Join {
@@ -585,60 +642,6 @@ namespace Multiplay
 		uint32 TTL;
 	};
 
-	// message SubscribeResult {
-	//   bool expires = 1;
-	//   uint32 ttl = 2;
-	//   bool recoverable = 3;
-	//   // 4-5 skipped here for backwards compatibility.
-	//   string epoch = 6;
-	//   repeated Publication publications = 7;
-	//   bool recovered = 8;
-	//   uint64 offset = 9;
-	//   bool positioned = 10;
-	//   bytes data = 11;
-	// }
-	class FSubscribeResult : public IJsonReadable
-	{
-	public:
-		virtual ~FSubscribeResult() {}
-
-		virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) override
-		{
-			const TSharedPtr<FJsonObject>* Object;
-			if (!JsonValue->TryGetObject(Object))
-				return false;
-
-			bool bParseSuccess = true;
-
-			bParseSuccess &= TryGetJsonValue(*Object, TEXT("expires"), bExpires);
-			bParseSuccess &= TryGetJsonValue(*Object, TEXT("ttl"), TTL);
-			bParseSuccess &= TryGetJsonValue(*Object, TEXT("recoverable"), bRecoverable);
-			bParseSuccess &= TryGetJsonValue(*Object, TEXT("epoch"), Epoch);
-			// TODO:
-			//   repeated Publication publications = 7;
-			bParseSuccess &= TryGetJsonValue(*Object, TEXT("recovered"), bRecovered);
-			bParseSuccess &= TryGetJsonValue(*Object, TEXT("offset"), Offset);
-			bParseSuccess &= TryGetJsonValue(*Object, TEXT("positioned"), bPositioned);
-			// TODO:
-			//   bytes data = 11;
-
-			return bParseSuccess;
-		}
-
-	public:
-		TOptional<bool> bExpires;
-		TOptional<uint32> TTL;
-		TOptional<bool> bRecoverable;
-		TOptional<FString> Epoch;
-		// TODO:
-		//   repeated Publication publications = 7;
-		TOptional<bool> bRecovered;
-		TOptional<uint64> Offset;
-		TOptional<bool> bPositioned;
-		// TODO:
-		//   bytes data = 11;
-	};
-
 	// message Disconnect {
 	//   uint32 code = 1;
 	//   string reason = 2;
@@ -932,7 +935,7 @@ namespace Multiplay
 		}
 
 	public:
-		uint64 Offset;
+		uint64 Offset = 0;
 		FString Epoch;
 	};
 
@@ -965,9 +968,9 @@ namespace Multiplay
 
 	public:
 		FString Channel;
-		int32 Limit;
+		int32 Limit = 0;
 		FStreamPosition Since;
-		bool bReverse;
+		bool bReverse = false;
 	};
 
 	// message HistoryResult {
@@ -988,8 +991,11 @@ namespace Multiplay
 
 			bool bParseSuccess = true;
 
-			// TODO:
-			//   repeated Publication publications = 1;
+			// Empty repeated fields are omitted from the JSON encoding of the result.
+			if ((*Object)->HasField(TEXT("publications")))
+			{
+				bParseSuccess &= TryGetJsonValue(*Object, TEXT("publications"), Publications);
+			}
 			bParseSuccess &= TryGetJsonValue(*Object, TEXT("epoch"), Epoch);
 			bParseSuccess &= TryGetJsonValue(*Object, TEXT("offset"), Offset);
 
@@ -997,8 +1003,7 @@ namespace Multiplay
 		}
 
 	public:
-		// TODO:
-		//   repeated Publication publications = 1;
+		TArray<FPublication> Publications;
 		FString Epoch;
 		uint64 Offset;
 	};
@@ -1041,8 +1046,10 @@ namespace Multiplay
 		virtual void WriteJson(JsonWriter& Writer) const override
 		{
 			Writer->WriteObjectStart();
-			// TODO:
-			//   bytes data = 1;
+			if (Data.IsValid())
+			{
+				Writer->WriteIdentifierPrefix(TEXT("data")); WriteJsonValue(Writer, Data);
+			}
 			Writer->WriteIdentifierPrefix(TEXT("method")); WriteJsonValue(Writer, Method);
 			Writer->WriteObjectEnd();
 		}
@@ -1053,8 +1060,7 @@ namespace Multiplay
 		}
 
 	public:
-		// TODO:
-		//   bytes data = 1;
+		TSharedPtr<FJsonValue> Data;
 		FString Method;
 	};
 
@@ -1068,14 +1074,19 @@ namespace Multiplay
 
 		virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) override
 		{
-			// TODO:
-			//   bytes data = 1;
-			return false;
+			const TSharedPtr<FJsonObject>* Object;
+			if (!JsonValue->TryGetObject(Object))
+				return false;
+
+			bool bParseSuccess = true;
+
+			bParseSuccess &= TryGetJsonValue(*Object, TEXT("data"), Data);
+
+			return bParseSuccess;
 		}
 
 	public:
-		// TODO:
-		//   bytes data = 1;
+		TOptional<TSharedPtr<FJsonValue>> Data;
 	};
 
 	// message RefreshRequest {
@@ -72,6 +72,31 @@ void FMultiplayCentrifugeMessagesSpec::Define()
 							TestEqual("FConnectResult::bExpires", Result.bExpires.Get(false), bExpires);
 							TestEqual("FConnectResult::TTL", Result.TTL.Get(0), TTL);
 						});
+
+					It("returns true if connect-time subscriptions are parsed correctly.", [this]()
+						{
+							FString JsonString = TEXT(R"({"client": "foo", "subs": {"server#12345": {"epoch": "bar", "offset": 42, "recoverable": true}}})");
+
+							TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+
+							Multiplay::FConnectResult Result;
+							TSharedPtr<FJsonValue> JsonValue;
+							if (MP_TEST_TRUE_EXPR(FJsonSerializer::Deserialize(JsonReader, JsonValue) && JsonValue.IsValid()))
+							{
+								TestTrueExpr(Result.FromJson(JsonValue));
+
+								if (MP_TEST_TRUE_EXPR(Result.Subs.IsSet()))
+								{
+									const Multiplay::FSubscribeResult* SubscribeResult = Result.Subs.GetValue().Find(TEXT("server#12345"));
+									if (MP_TEST_TRUE_EXPR(SubscribeResult != nullptr))
+									{
+										TestEqual("FSubscribeResult::Epoch", SubscribeResult->Epoch.Get(TEXT("")), FString(TEXT("bar")));
+										TestEqual("FSubscribeResult::Offset", SubscribeResult->Offset.Get(0), static_cast<uint64>(42));
+										TestEqual("FSubscribeResult::bRecoverable", SubscribeResult->bRecoverable.Get(false), true);
+									}
+								}
+							}
+						});
 				});
 		});
 
@@ -204,6 +229,63 @@ void FMultiplayCentrifugeMessagesSpec::Define()
 				});
 		});
 
+	Describe("FHistoryResult", [this]()
+		{
+			Describe("FromJson", [this]()
+				{
+					It("returns true if JSON data is parsed correctly.", [this]()
+						{
+							FString JsonString = TEXT(R"({"publications": [{"data": {}, "offset": 7}, {"data": {}, "offset": 8}], "epoch": "foo", "offset": 8})");
+
+							TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+
+							bool bDidParseJson;
+							Multiplay::FHistoryResult Result;
+							TSharedPtr<FJsonValue> JsonValue;
+							if (FJsonSerializer::Deserialize(JsonReader, JsonValue) && JsonValue.IsValid())
+							{
+								bDidParseJson = Result.FromJson(JsonValue);
+							}
+							else
+							{
+								bDidParseJson = false;
+							}
+
+							TestTrueExpr(bDidParseJson);
+							TestEqual("FHistoryResult::Epoch", Result.Epoch, FString(TEXT("foo")));
+							TestEqual("FHistoryResult::Offset", Result.Offset, static_cast<uint64>(8));
+
+							if (MP_TEST_TRUE_EXPR(Result.Publications.Num() == 2))
+							{
+								TestEqual("FPublication::Offset", Result.Publications[0].Offset, static_cast<uint64>(7));
+								TestEqual("FPublication::Offset", Result.Publications[1].Offset, static_cast<uint64>(8));
+							}
+						});
+
+					It("returns true if the publications are omitted.", [this]()
+						{
+							FString JsonString = TEXT(R"({"epoch": "foo", "offset": 8})");
+
+							TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+
+							bool bDidParseJson;
+							Multiplay::FHistoryResult Result;
+							TSharedPtr<FJsonValue> JsonValue;
+							if (FJsonSerializer::Deserialize(JsonReader, JsonValue) && JsonValue.IsValid())
+							{
+								bDidParseJson = Result.FromJson(JsonValue);
+							}
+							else
+							{
+								bDidParseJson = false;
+							}
+
+							TestTrueExpr(bDidParseJson);
+							TestEqual("FHistoryResult::Publications", Result.Publications.Num(), 0);
+						});
+				});
+		});
+
 	Describe("FCommand", [this]()
 		{
 			Describe("WriteJson", [this]()
@@ -307,6 +389,33 @@ void FMultiplayCentrifugeMessagesSpec::Define()
 								{
 									TestEqual("FConnectRequest::Version", Version, ConnectRequest.Version.GetValue());
 								}
+
+								TestFalseExpr(Object->HasField(TEXT("subs")));
+							}
+						});
+
+					It("writes connect-time subscriptions keyed by channel.", [this]()
+						{
+							Multiplay::FConnectRequest ConnectRequest;
+							ConnectRequest.Subs.Add(TEXT("server#12345"), Multiplay::FSubscribeRequest());
+
+							FString JsonBody;
+
+							Multiplay::JsonWriter Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonBody);
+
+							ConnectRequest.WriteJson(Writer);
+
+							Writer->Close();
+
+							TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<>::Create(JsonBody);
+							TSharedPtr<FJsonObject> Object;
+							if (MP_TEST_TRUE_EXPR(FJsonSerializer::Deserialize(JsonReader, Object)))
+							{
+								const TSharedPtr<FJsonObject>* Subs;
+								if (MP_TEST_TRUE_EXPR(Object->TryGetObjectField(TEXT("subs"), Subs)))
+								{
+									TestTrueExpr((*Subs)->HasField(TEXT("server#12345")));
+								}
 							}
 						});
 				});
@@ -0,0 +1,764 @@
+#include "MultiplayCentrifugeWebSocket.h"
+#include "MultiplayCentrifugeLog.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Base64.h"
+#include "Misc/SecureHash.h"
+#include "Utils/MultiplayStreamSocket.h"
+
+namespace Multiplay
+{
+	namespace
+	{
+		// Appended to the Sec-WebSocket-Key by the server, see RFC 6455 section 4.2.2.
+		const TCHAR* const kAcceptKeyGuid = TEXT("258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+
+		// Bounds how long the I/O thread sleeps in the socket, which is also how long it takes to notice a stop request.
+		const FTimespan kWaitTime = FTimespan::FromMilliseconds(50);
+
+		constexpr double kHandshakeTimeoutSeconds = 5.0;
+		constexpr double kCloseTimeoutSeconds = 2.0;
+		constexpr int32 kMaxHandshakeSize = 8 * 1024;
+		constexpr int32 kInitialReceiveBufferSize = 64 * 1024;
+
+		// Close status codes, see RFC 6455 section 7.4.1.
+		constexpr uint16 kCloseNormal = 1000;
+		constexpr uint16 kCloseProtocolError = 1002;
+		constexpr uint16 kCloseNoStatus = 1005;
+		constexpr uint16 kCloseAbnormal = 1006;
+		constexpr uint16 kCloseTooBig = 1009;
+
+		int32 FindHeaderEnd(const uint8* Data, int32 Length)
+		{
+			for (int32 Index = 0; Index + 3 < Length; ++Index)
+			{
+				if (Data[Index] == '\r' && Data[Index + 1] == '\n' && Data[Index + 2] == '\r' && Data[Index + 3] == '\n')
+				{
+					return Index;
+				}
+			}
+
+			return INDEX_NONE;
+		}
+
+		FString Utf8ToString(const uint8* Data, int32 Length)
+		{
+			FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Length);
+			return FString(Converted.Length(), Converted.Get());
+		}
+	} // namespace
+
+	void FCentrifugeWebSocketFrame::Encode(uint8 Opcode, const uint8* Payload, int32 PayloadLength, const uint8 MaskKey[4], TArray<uint8>& OutBuffer)
+	{
+		OutBuffer.Add(0x80 | (Opcode & 0x0F));
+
+		if (PayloadLength < 126)
+		{
+			OutBuffer.Add(0x80 | static_cast<uint8>(PayloadLength));
+		}
+		else if (PayloadLength <= 0xFFFF)
+		{
+			OutBuffer.Add(0x80 | 126);
+			OutBuffer.Add(static_cast<uint8>(PayloadLength >> 8));
+			OutBuffer.Add(static_cast<uint8>(PayloadLength));
+		}
+		else
+		{
+			OutBuffer.Add(0x80 | 127);
+			for (int32 Shift = 56; Shift >= 0; Shift -= 8)
+			{
+				OutBuffer.Add(static_cast<uint8>(static_cast<uint64>(PayloadLength) >> Shift));
+			}
+		}
+
+		OutBuffer.Append(MaskKey, 4);
+
+		const int32 PayloadOffset = OutBuffer.Num();
+		OutBuffer.Append(Payload, PayloadLength);
+		ApplyMask(OutBuffer.GetData() + PayloadOffset, PayloadLength, MaskKey);
+	}
+
+	bool FCentrifugeWebSocketFrame::DecodeHeader(const uint8* Data, int32 Length, FHeader& OutHeader)
+	{
+		if (Length < 2)
+		{
+			return false;
+		}
+
+		OutHeader.bFin = (Data[0] & 0x80) != 0;
+		OutHeader.Opcode = Data[0] & 0x0F;
+		OutHeader.bMasked = (Data[1] & 0x80) != 0;
+
+		const uint8 ShortLength = Data[1] & 0x7F;
+		int32 Offset = 2;
+
+		if (ShortLength == 126)
+		{
+			if (Length < Offset + 2)
+			{
+				return false;
+			}
+
+			OutHeader.PayloadLength = (static_cast<uint64>(Data[2]) << 8) | Data[3];
+			Offset += 2;
+		}
+		else if (ShortLength == 127)
+		{
+			if (Length < Offset + 8)
+			{
+				return false;
+			}
+
+			OutHeader.PayloadLength = 0;
+			for (int32 Index = 0; Index < 8; ++Index)
+			{
+				OutHeader.PayloadLength = (OutHeader.PayloadLength << 8) | Data[Offset + Index];
+			}
+			Offset += 8;
+		}
+		else
+		{
+			OutHeader.PayloadLength = ShortLength;
+		}
+
+		if (OutHeader.bMasked)
+		{
+			if (Length < Offset + 4)
+			{
+				return false;
+			}
+
+			FMemory::Memcpy(OutHeader.MaskKey, Data + Offset, 4);
+			Offset += 4;
+		}
+
+		OutHeader.HeaderLength = Offset;
+		return true;
+	}
+
+	void FCentrifugeWebSocketFrame::ApplyMask(uint8* Data, int32 Length, const uint8 MaskKey[4])
+	{
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			Data[Index] ^= MaskKey[Index & 3];
+		}
+	}
+
+	FString FCentrifugeWebSocketFrame::ComputeAcceptKey(const FString& Key)
+	{
+		FTCHARToUTF8 Converted(*(Key + kAcceptKeyGuid));
+
+		uint8 Hash[20];
+		FSHA1::HashBuffer(Converted.Get(), Converted.Length(), Hash);
+
+		return FBase64::Encode(TArray<uint8>(Hash, sizeof(Hash)));
+	}
+
+	bool FCentrifugeWebSocketFrame::ParseUrl(const FString& Url, FString& OutHost, int32& OutPort, FString& OutPath)
+	{
+		static const FString Scheme = TEXT("ws://");
+		if (!Url.StartsWith(Scheme, ESearchCase::IgnoreCase))
+		{
+			return false;
+		}
+
+		FString Authority = Url.Mid(Scheme.Len());
+		OutPath = TEXT("/");
+
+		int32 PathIndex;
+		if (Authority.FindChar(TEXT('/'), PathIndex))
+		{
+			OutPath = Authority.Mid(PathIndex);
+			Authority.LeftInline(PathIndex);
+		}
+
+		OutPort = 80;
+
+		FString PortString;
+		if (Authority.Split(TEXT(":"), &OutHost, &PortString))
+		{
+			if (!PortString.IsNumeric())
+			{
+				return false;
+			}
+
+			OutPort = FCString::Atoi(*PortString);
+		}
+		else
+		{
+			OutHost = Authority;
+		}
+
+		return !OutHost.IsEmpty() && OutPort > 0 && OutPort <= 0xFFFF;
+	}
+
+	FCentrifugeWebSocket::FCentrifugeWebSocket(const FString& InUrl, const FString& InUnixSocketPath)
+		: Url(InUrl)
+		, Port(0)
+		, UnixSocketPath(InUnixSocketPath)
+		, Thread(nullptr)
+		, bStopping(false)
+		, bConnected(false)
+		, MaskStream(static_cast<int32>(FPlatformTime::Cycles()))
+		, bCloseSent(false)
+		, CloseSentTime(0.0)
+		, bDrainQueued(false)
+		, ReceiveLength(0)
+		, MessageOpcode(0)
+		, CloseStatusCode(kCloseAbnormal)
+		, bCloseReceived(false)
+	{
+		if (!FCentrifugeWebSocketFrame::ParseUrl(Url, Host, Port, Path))
+		{
+			Host.Empty();
+		}
+	}
+
+	FCentrifugeWebSocket::~FCentrifugeWebSocket()
+	{
+		if (Thread != nullptr)
+		{
+			// Stops the I/O thread and waits for it to exit.
+			Thread->Kill(true);
+			delete Thread;
+			Thread = nullptr;
+		}
+
+		CloseSocket();
+	}
+
+	void FCentrifugeWebSocket::Connect()
+	{
+		if (Thread != nullptr)
+		{
+			UE_LOG(LogCentrifuge, Warning, TEXT("Attempted to connect a websocket that has already been connected."));
+			return;
+		}
+
+		WeakThis = AsShared();
+
+		if (Host.IsEmpty())
+		{
+			DispatchConnectionError(FString::Printf(TEXT("Unsupported websocket URL '%s', only ws:// is supported."), *Url));
+			return;
+		}
+
+		ReceiveBuffer.SetNumUninitialized(kInitialReceiveBufferSize);
+
+		Thread = FRunnableThread::Create(this, TEXT("MultiplayCentrifugeWebSocket"), 0, TPri_AboveNormal);
+	}
+
+	void FCentrifugeWebSocket::Close()
+	{
+		if (!bConnected)
+		{
+			// Abandons a connection attempt that is still in progress.
+			bStopping = true;
+			return;
+		}
+
+		// The I/O thread closes the socket once the server has answered, or the close times out.
+		SendClose(kCloseNormal);
+	}
+
+	int32 FCentrifugeWebSocket::DrainMessages()
+	{
+		int32 Count = 0;
+
+		FReceivedMessage Message;
+		while (ReceivedMessages.Dequeue(Message))
+		{
+			MessageEvent.Broadcast(Message.MessageString, Message.ReceivedSeconds);
+			++Count;
+		}
+
+		return Count;
+	}
+
+	void FCentrifugeWebSocket::Send(const FString& Data)
+	{
+		if (!bConnected)
+		{
+			UE_LOG(LogCentrifuge, Warning, TEXT("Attempted to send a message when the websocket is not connected."));
+			return;
+		}
+
+		FTCHARToUTF8 Converted(*Data);
+		if (SendFrame(FCentrifugeWebSocketFrame::kOpcodeText, reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length()))
+		{
+			MessageSentEvent.Broadcast(Data);
+		}
+	}
+
+	uint32 FCentrifugeWebSocket::Run()
+	{
+		FString Error;
+		if (!OpenSocket(Error) || !Handshake(Error))
+		{
+			CloseSocket();
+			DispatchConnectionError(Error);
+			return 0;
+		}
+
+		bConnected = true;
+		DispatchConnected();
+
+		CloseStatusCode = kCloseAbnormal;
+		CloseReason = TEXT("The connection was lost.");
+
+		// Frames sent straight after the handshake may already have been read.
+		bool bOpen = ProcessFrames();
+
+		while (bOpen && !bStopping)
+		{
+			{
+				FScopeLock Lock(&SendLock);
+				if (bCloseSent && FPlatformTime::Seconds() - CloseSentTime > kCloseTimeoutSeconds)
+				{
+					UE_LOG(LogCentrifuge, Warning, TEXT("The server did not answer the websocket close handshake within %.1f seconds."), kCloseTimeoutSeconds);
+					break;
+				}
+			}
+
+			if (Socket->WaitForRead(kWaitTime) && !ReceiveFrames())
+			{
+				break;
+			}
+		}
+
+		bConnected = false;
+		CloseSocket();
+
+		DispatchClosed(CloseStatusCode, CloseReason, bCloseReceived);
+		return 0;
+	}
+
+	void FCentrifugeWebSocket::Stop()
+	{
+		bStopping = true;
+	}
+
+	bool FCentrifugeWebSocket::OpenSocket(FString& OutError)
+	{
+		TUniquePtr<IMultiplayStreamSocket> NewSocket = UnixSocketPath.IsEmpty() ? ConnectTcpSocket(Host, Port, OutError) : ConnectUnixSocket(UnixSocketPath, OutError);
+		if (!NewSocket.IsValid())
+		{
+			return false;
+		}
+
+		FScopeLock Lock(&SendLock);
+		Socket = MoveTemp(NewSocket);
+		return true;
+	}
+
+	bool FCentrifugeWebSocket::Handshake(FString& OutError)
+	{
+		const FGuid Nonce = FGuid::NewGuid();
+		TArray<uint8> NonceBytes;
+		NonceBytes.SetNumUninitialized(sizeof(FGuid));
+		FMemory::Memcpy(NonceBytes.GetData(), &Nonce, sizeof(FGuid));
+
+		const FString Key = FBase64::Encode(NonceBytes);
+
+		const FString Request = FString::Printf(
+			TEXT("GET %s HTTP/1.1\r\nHost: %s:%d\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: %s\r\nSec-WebSocket-Version: 13\r\n\r\n"),
+			*Path, *Host, Port, *Key);
+
+		FTCHARToUTF8 Converted(*Request);
+		{
+			FScopeLock Lock(&SendLock);
+			if (!SendAll(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length()))
+			{
+				OutError = TEXT("Failed to send the websocket handshake.");
+				return false;
+			}
+		}
+
+		const double Deadline = FPlatformTime::Seconds() + kHandshakeTimeoutSeconds;
+		int32 HeaderEnd = INDEX_NONE;
+
+		while (HeaderEnd == INDEX_NONE)
+		{
+			if (bStopping)
+			{
+				OutError = TEXT("The connection was closed before the websocket handshake completed.");
+				return false;
+			}
+
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				OutError = TEXT("Timed out waiting for the websocket handshake.");
+				return false;
+			}
+
+			if (ReceiveLength >= kMaxHandshakeSize)
+			{
+				OutError = TEXT("The websocket handshake response is too large.");
+				return false;
+			}
+
+			if (!Socket->WaitForRead(kWaitTime))
+			{
+				continue;
+			}
+
+			int32 BytesRead = 0;
+			if (!Socket->Recv(ReceiveBuffer.GetData() + ReceiveLength, kMaxHandshakeSize - ReceiveLength, BytesRead))
+			{
+				OutError = TEXT("The connection was closed during the websocket handshake.");
+				return false;
+			}
+
+			ReceiveLength += BytesRead;
+			HeaderEnd = FindHeaderEnd(ReceiveBuffer.GetData(), ReceiveLength);
+		}
+
+		TArray<FString> Lines;
+		Utf8ToString(ReceiveBuffer.GetData(), HeaderEnd).ParseIntoArray(Lines, TEXT("\r\n"));
+
+		if (Lines.Num() == 0 || !Lines[0].StartsWith(TEXT("HTTP/1.1 101")))
+		{
+			OutError = FString::Printf(TEXT("The server rejected the websocket upgrade: %s"), Lines.Num() > 0 ? *Lines[0] : TEXT(""));
+			return false;
+		}
+
+		FString Accept;
+		for (int32 Index = 1; Index < Lines.Num(); ++Index)
+		{
+			FString Name;
+			FString Value;
+			if (Lines[Index].Split(TEXT(":"), &Name, &Value) && Name.TrimStartAndEnd().Equals(TEXT("Sec-WebSocket-Accept"), ESearchCase::IgnoreCase))
+			{
+				Accept = Value.TrimStartAndEnd();
+			}
+		}
+
+		if (Accept != FCentrifugeWebSocketFrame::ComputeAcceptKey(Key))
+		{
+			OutError = TEXT("The server answered the websocket handshake with an invalid Sec-WebSocket-Accept.");
+			return false;
+		}
+
+		const int32 ConsumedLength = HeaderEnd + 4;
+		ReceiveLength -= ConsumedLength;
+		FMemory::Memmove(ReceiveBuffer.GetData(), ReceiveBuffer.GetData() + ConsumedLength, ReceiveLength);
+
+		return true;
+	}
+
+	void FCentrifugeWebSocket::CloseSocket()
+	{
+		FScopeLock Lock(&SendLock);
+		Socket.Reset();
+	}
+
+	bool FCentrifugeWebSocket::ReceiveFrames()
+	{
+		if (ReceiveLength < ReceiveBuffer.Num())
+		{
+			int32 BytesRead = 0;
+			if (!Socket->Recv(ReceiveBuffer.GetData() + ReceiveLength, ReceiveBuffer.Num() - ReceiveLength, BytesRead))
+			{
+				return false;
+			}
+
+			ReceiveLength += BytesRead;
+		}
+
+		return ProcessFrames();
+	}
+
+	bool FCentrifugeWebSocket::ProcessFrames()
+	{
+		uint8* Data = ReceiveBuffer.GetData();
+		int32 Offset = 0;
+		int32 RequiredLength = 0;
+
+		FCentrifugeWebSocketFrame::FHeader Header;
+		while (FCentrifugeWebSocketFrame::DecodeHeader(Data + Offset, ReceiveLength - Offset, Header))
+		{
+			if (Header.PayloadLength > static_cast<uint64>(kMaxMessageSize))
+			{
+				return FailConnection(kCloseTooBig, TEXT("The message is too large."));
+			}
+
+			const int32 FrameLength = Header.HeaderLength + static_cast<int32>(Header.PayloadLength);
+			if (ReceiveLength - Offset < FrameLength)
+			{
+				RequiredLength = FrameLength;
+				break;
+			}
+
+			uint8* Payload = Data + Offset + Header.HeaderLength;
+			if (Header.bMasked)
+			{
+				FCentrifugeWebSocketFrame::ApplyMask(Payload, static_cast<int32>(Header.PayloadLength), Header.MaskKey);
+			}
+
+			Offset += FrameLength;
+
+			if (!HandleFrame(Header, Payload))
+			{
+				return false;
+			}
+		}
+
+		if (Offset > 0)
+		{
+			ReceiveLength -= Offset;
+			FMemory::Memmove(Data, Data + Offset, ReceiveLength);
+		}
+
+		// The buffer only ever grows, so a large message costs one allocation for the lifetime of the connection.
+		if (RequiredLength > ReceiveBuffer.Num())
+		{
+			ReceiveBuffer.SetNumUninitialized(RequiredLength);
+		}
+
+		return true;
+	}
+
+	bool FCentrifugeWebSocket::HandleFrame(const FCentrifugeWebSocketFrame::FHeader& Header, uint8* Payload)
+	{
+		const int32 Length = static_cast<int32>(Header.PayloadLength);
+
+		switch (Header.Opcode)
+		{
+		case FCentrifugeWebSocketFrame::kOpcodePing:
+		case FCentrifugeWebSocketFrame::kOpcodePong:
+		case FCentrifugeWebSocketFrame::kOpcodeClose:
+		{
+			if (!Header.bFin || Length > 125)
+			{
+				return FailConnection(kCloseProtocolError, TEXT("Received a fragmented or oversized control frame."));
+			}
+
+			if (Header.Opcode == FCentrifugeWebSocketFrame::kOpcodePing)
+			{
+				SendFrame(FCentrifugeWebSocketFrame::kOpcodePong, Payload, Length);
+			}
+			else if (Header.Opcode == FCentrifugeWebSocketFrame::kOpcodeClose)
+			{
+				HandleClose(Payload, Length);
+				return false;
+			}
+
+			return true;
+		}
+		case FCentrifugeWebSocketFrame::kOpcodeText:
+		case FCentrifugeWebSocketFrame::kOpcodeBinary:
+		{
+			if (MessageOpcode != 0)
+			{
+				return FailConnection(kCloseProtocolError, TEXT("Received a new message before the previous one was complete."));
+			}
+
+			if (Header.bFin)
+			{
+				// Unfragmented messages, which is all Centrifuge sends, are converted straight from the receive buffer.
+				if (Header.Opcode == FCentrifugeWebSocketFrame::kOpcodeText)
+				{
+					DispatchMessageReceived(Utf8ToString(Payload, Length));
+				}
+				else
+				{
+					UE_LOG(LogCentrifuge, Warning, TEXT("Ignoring a binary websocket message of %d bytes."), Length);
+				}
+
+				return true;
+			}
+
+			MessageOpcode = Header.Opcode;
+			MessageBuffer.Reset();
+			break;
+		}
+		case FCentrifugeWebSocketFrame::kOpcodeContinuation:
+		{
+			if (MessageOpcode == 0)
+			{
+				return FailConnection(kCloseProtocolError, TEXT("Received a continuation frame outside of a message."));
+			}
+
+			break;
+		}
+		default:
+		{
+			return FailConnection(kCloseProtocolError, FString::Printf(TEXT("Received a frame with the unknown opcode %d."), Header.Opcode));
+		}
+		}
+
+		if (MessageBuffer.Num() + Length > kMaxMessageSize)
+		{
+			return FailConnection(kCloseTooBig, TEXT("The message is too large."));
+		}
+
+		MessageBuffer.Append(Payload, Length);
+
+		if (Header.bFin)
+		{
+			if (MessageOpcode == FCentrifugeWebSocketFrame::kOpcodeText)
+			{
+				DispatchMessageReceived(Utf8ToString(MessageBuffer.GetData(), MessageBuffer.Num()));
+			}
+			else
+			{
+				UE_LOG(LogCentrifuge, Warning, TEXT("Ignoring a binary websocket message of %d bytes."), MessageBuffer.Num());
+			}
+
+			// Reset keeps the allocation for the next fragmented message.
+			MessageOpcode = 0;
+			MessageBuffer.Reset();
+		}
+
+		return true;
+	}
+
+	void FCentrifugeWebSocket::HandleClose(const uint8* Payload, int32 Length)
+	{
+		bCloseReceived = true;
+
+		if (Length >= 2)
+		{
+			CloseStatusCode = (static_cast<int32>(Payload[0]) << 8) | Payload[1];
+			CloseReason = Utf8ToString(Payload + 2, Length - 2);
+		}
+		else
+		{
+			CloseStatusCode = kCloseNoStatus;
+			CloseReason.Empty();
+		}
+
+		// Echoes the close unless this side initiated it.
+		SendClose(CloseStatusCode == kCloseNoStatus ? kCloseNormal : static_cast<uint16>(CloseStatusCode));
+	}
+
+	bool FCentrifugeWebSocket::FailConnection(uint16 StatusCode, const FString& Reason)
+	{
+		UE_LOG(LogCentrifuge, Error, TEXT("Closing the websocket: %s"), *Reason);
+
+		CloseStatusCode = StatusCode;
+		CloseReason = Reason;
+
+		SendClose(StatusCode);
+		return false;
+	}
+
+	bool FCentrifugeWebSocket::SendFrame(uint8 Opcode, const uint8* Payload, int32 Length)
+	{
+		FScopeLock Lock(&SendLock);
+
+		if (Socket == nullptr)
+		{
+			return false;
+		}
+
+		uint8 MaskKey[4];
+		const uint32 RandomMask = MaskStream.GetUnsignedInt();
+		FMemory::Memcpy(MaskKey, &RandomMask, sizeof(MaskKey));
+
+		// Reset keeps the allocation, so sending does not allocate once the buffer has grown to the largest message.
+		SendBuffer.Reset();
+		FCentrifugeWebSocketFrame::Encode(Opcode, Payload, Length, MaskKey, SendBuffer);
+
+		return SendAll(SendBuffer.GetData(), SendBuffer.Num());
+	}
+
+	void FCentrifugeWebSocket::SendClose(uint16 StatusCode)
+	{
+		FScopeLock Lock(&SendLock);
+
+		if (bCloseSent)
+		{
+			return;
+		}
+
+		const uint8 Payload[2] = { static_cast<uint8>(StatusCode >> 8), static_cast<uint8>(StatusCode) };
+		SendFrame(FCentrifugeWebSocketFrame::kOpcodeClose, Payload, sizeof(Payload));
+
+		bCloseSent = true;
+		CloseSentTime = FPlatformTime::Seconds();
+	}
+
+	bool FCentrifugeWebSocket::SendAll(const uint8* Data, int32 Length)
+	{
+		int32 TotalSent = 0;
+		while (TotalSent < Length)
+		{
+			int32 BytesSent = 0;
+			if (!Socket->Send(Data + TotalSent, Length - TotalSent, BytesSent))
+			{
+				UE_LOG(LogCentrifuge, Error, TEXT("Failed to write to the websocket."));
+				return false;
+			}
+
+			TotalSent += BytesSent;
+		}
+
+		return true;
+	}
+
+	void FCentrifugeWebSocket::DispatchConnected()
+	{
+		TWeakPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> Weak = WeakThis;
+		AsyncTask(ENamedThreads::GameThread, [Weak]()
+			{
+				if (TSharedPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> This = Weak.Pin())
+				{
+					This->ConnectedEvent.Broadcast();
+				}
+			});
+	}
+
+	void FCentrifugeWebSocket::DispatchConnectionError(const FString& Error)
+	{
+		TWeakPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> Weak = WeakThis;
+		AsyncTask(ENamedThreads::GameThread, [Weak, Error]()
+			{
+				if (TSharedPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> This = Weak.Pin())
+				{
+					This->ConnectionErrorEvent.Broadcast(Error);
+				}
+			});
+	}
+
+	void FCentrifugeWebSocket::DispatchClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
+	{
+		TWeakPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> Weak = WeakThis;
+		AsyncTask(ENamedThreads::GameThread, [Weak, StatusCode, Reason, bWasClean]()
+			{
+				if (TSharedPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> This = Weak.Pin())
+				{
+					// The messages received before the close are delivered first.
+					This->DrainMessages();
+					This->ClosedEvent.Broadcast(StatusCode, Reason, bWasClean);
+				}
+			});
+	}
+
+	void FCentrifugeWebSocket::DispatchMessageReceived(FString MessageString)
+	{
+		// Stamped here rather than when drained, so that the time spent waiting for the consumer is accounted for.
+		FReceivedMessage Message;
+		Message.MessageString = MoveTemp(MessageString);
+		Message.ReceivedSeconds = FPlatformTime::Seconds();
+		ReceivedMessages.Enqueue(MoveTemp(Message));
+
+		// A drain that is already queued picks the message up.
+		if (bDrainQueued.AtomicSet(true))
+		{
+			return;
+		}
+
+		TWeakPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> Weak = WeakThis;
+		AsyncTask(ENamedThreads::GameThread, [Weak]()
+			{
+				if (TSharedPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> This = Weak.Pin())
+				{
+					// Cleared first, so that a message queued during the drain queues another one.
+					This->bDrainQueued = false;
+					This->DrainMessages();
+				}
+			});
+	}
+} // namespace Multiplay
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Math/RandomStream.h"
+#include "MultiplayCentrifugeConnection.h"
+
+class FRunnableThread;
+
+namespace Multiplay
+{
+	class IMultiplayStreamSocket;
+
+	// RFC 6455 frame encoding and decoding.
+	struct FCentrifugeWebSocketFrame
+	{
+		static constexpr uint8 kOpcodeContinuation = 0x0;
+		static constexpr uint8 kOpcodeText = 0x1;
+		static constexpr uint8 kOpcodeBinary = 0x2;
+		static constexpr uint8 kOpcodeClose = 0x8;
+		static constexpr uint8 kOpcodePing = 0x9;
+		static constexpr uint8 kOpcodePong = 0xA;
+
+		// Largest header: 2 bytes, 8 bytes of extended length and 4 bytes of mask key.
+		static constexpr int32 kMaxHeaderLength = 14;
+
+		struct FHeader
+		{
+			bool bFin = false;
+			uint8 Opcode = 0;
+			bool bMasked = false;
+			uint8 MaskKey[4] = { 0, 0, 0, 0 };
+			uint64 PayloadLength = 0;
+			int32 HeaderLength = 0;
+		};
+
+		// Appends a single final frame to OutBuffer, the payload is masked with MaskKey as required of clients.
+		static void Encode(uint8 Opcode, const uint8* Payload, int32 PayloadLength, const uint8 MaskKey[4], TArray<uint8>& OutBuffer);
+
+		// Returns false if Data does not yet hold a complete header.
+		static bool DecodeHeader(const uint8* Data, int32 Length, FHeader& OutHeader);
+
+		// Masking is its own inverse.
+		static void ApplyMask(uint8* Data, int32 Length, const uint8 MaskKey[4]);
+
+		// Returns the Sec-WebSocket-Accept value the server must answer the given Sec-WebSocket-Key with.
+		static FString ComputeAcceptKey(const FString& Key);
+
+		// Splits a ws:// URL, returns false for any other scheme.
+		static bool ParseUrl(const FString& Url, FString& OutHost, int32& OutPort, FString& OutPath);
+	};
+
+	// A minimal websocket client for the plaintext ws:// endpoint of the local SDK daemon.
+	//
+	// The connection is made over TCP, or over a Unix domain socket when a socket path is given, in which case the URL
+	// only supplies the host and path of the handshake.
+	//
+	// The socket is serviced on a dedicated I/O thread, which answers pings and the close handshake and reassembles
+	// fragmented messages independently of the engine tick. Frames are sent directly from the calling thread.
+	// Complete messages are pushed onto a lock-free queue by the I/O thread and broadcast by whichever thread drains it,
+	// the game thread is woken to drain it once per burst rather than once per message. State changes are queued to the
+	// game thread, which drains the pending messages before broadcasting a close. The messages are handled when the game
+	// thread next runs its queued tasks, so their delivery still depends on the frame rate.
+	class FCentrifugeWebSocket : public ICentrifugeConnection, public TSharedFromThis<FCentrifugeWebSocket, ESPMode::ThreadSafe>, private FRunnable
+	{
+	public:
+		// Messages above this size are rejected with a 1009 close.
+		static constexpr int32 kMaxMessageSize = 16 * 1024 * 1024;
+
+	public:
+		FCentrifugeWebSocket(const FString& Url, const FString& UnixSocketPath = FString());
+		virtual ~FCentrifugeWebSocket();
+
+		virtual void Connect() override;
+		virtual void Close() override;
+		virtual bool IsConnected() const override { return bConnected; }
+		virtual void Send(const FString& Data) override;
+
+		// Must only be called from one thread at a time, the game thread drains as well.
+		virtual int32 DrainMessages() override;
+
+	private:
+		// FRunnable
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+
+	private:
+		bool OpenSocket(FString& OutError);
+		bool Handshake(FString& OutError);
+		void CloseSocket();
+
+		// Reads whatever is available, returns false once the connection is over.
+		bool ReceiveFrames();
+		bool ProcessFrames();
+		bool HandleFrame(const FCentrifugeWebSocketFrame::FHeader& Header, uint8* Payload);
+		void HandleClose(const uint8* Payload, int32 Length);
+
+		// Starts the close handshake after a protocol violation, always returns false.
+		bool FailConnection(uint16 StatusCode, const FString& Reason);
+
+		bool SendFrame(uint8 Opcode, const uint8* Payload, int32 Length);
+		void SendClose(uint16 StatusCode);
+		bool SendAll(const uint8* Data, int32 Length);
+
+		void DispatchConnected();
+		void DispatchConnectionError(const FString& Error);
+		void DispatchClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
+		void DispatchMessageReceived(FString MessageString);
+
+	private:
+		FString Url;
+		FString Host;
+		int32 Port;
+		FString Path;
+		FString UnixSocketPath;
+
+		// Events are queued with a weak reference so that they are dropped once the connection has been destroyed.
+		TWeakPtr<FCentrifugeWebSocket, ESPMode::ThreadSafe> WeakThis;
+
+		TUniquePtr<IMultiplayStreamSocket> Socket;
+		FRunnableThread* Thread;
+		FThreadSafeBool bStopping;
+		FThreadSafeBool bConnected;
+
+		// Guards Socket, SendBuffer, MaskStream and the close state against the game thread.
+		FCriticalSection SendLock;
+		TArray<uint8> SendBuffer;
+		FRandomStream MaskStream;
+		bool bCloseSent;
+		double CloseSentTime;
+
+		struct FReceivedMessage
+		{
+			FString MessageString;
+			double ReceivedSeconds;
+		};
+
+		// Produced by the I/O thread and consumed by DrainMessages.
+		TQueue<FReceivedMessage, EQueueMode::Spsc> ReceivedMessages;
+		// Set while a drain is queued to the game thread, so that a burst of messages queues a single one.
+		FThreadSafeBool bDrainQueued;
+
+		// Owned by the I/O thread. The buffers keep their allocation across frames.
+		TArray<uint8> ReceiveBuffer;
+		int32 ReceiveLength;
+		TArray<uint8> MessageBuffer;
+		uint8 MessageOpcode;
+		int32 CloseStatusCode;
+		FString CloseReason;
+		bool bCloseReceived;
+	};
+} // namespace Multiplay
@@ -0,0 +1,299 @@
+#include "MultiplayCentrifugeWebSocket.h"
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "Async/Async.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Multiplay
+{
+	// Stands in for the SDK daemon, accepting a single websocket on a Unix domain socket and sending it one text message.
+	class FCentrifugeWebSocketSpecDaemon
+	{
+	public:
+		FCentrifugeWebSocketSpecDaemon(const FString& InPath, const FString& InMessage) : Path(InPath), Message(InMessage), Descriptor(-1)
+		{
+			unlink(TCHAR_TO_UTF8(*Path));
+
+			sockaddr_un Address;
+			FMemory::Memzero(Address);
+			Address.sun_family = AF_UNIX;
+			FCStringAnsi::Strncpy(Address.sun_path, TCHAR_TO_UTF8(*Path), sizeof(Address.sun_path));
+
+			Descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (Descriptor >= 0 && (bind(Descriptor, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0 || listen(Descriptor, 1) != 0))
+			{
+				close(Descriptor);
+				Descriptor = -1;
+			}
+		}
+
+		~FCentrifugeWebSocketSpecDaemon()
+		{
+			if (Served.IsValid())
+			{
+				Served.Wait();
+			}
+
+			if (Descriptor >= 0)
+			{
+				close(Descriptor);
+			}
+
+			unlink(TCHAR_TO_UTF8(*Path));
+		}
+
+		bool IsListening() const { return Descriptor >= 0; }
+
+		// Accepts one connection on a background thread and holds it open until the client goes away.
+		void Serve()
+		{
+			Served = ServedPromise.GetFuture();
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this]()
+				{
+					Answer();
+					ServedPromise.SetValue();
+				});
+		}
+
+	private:
+		void Answer()
+		{
+			pollfd Poll = { Descriptor, POLLIN, 0 };
+			if (poll(&Poll, 1, 5000) <= 0)
+			{
+				return;
+			}
+
+			const int Connection = accept(Descriptor, nullptr, nullptr);
+			if (Connection < 0)
+			{
+				return;
+			}
+
+			TArray<ANSICHAR> Buffer;
+			Buffer.SetNumZeroed(4096);
+			int32 Length = 0;
+			while (Length < Buffer.Num() - 1 && FCStringAnsi::Strstr(Buffer.GetData(), "\r\n\r\n") == nullptr)
+			{
+				const ssize_t Read = recv(Connection, Buffer.GetData() + Length, Buffer.Num() - 1 - Length, 0);
+				if (Read <= 0)
+				{
+					break;
+				}
+
+				Length += static_cast<int32>(Read);
+			}
+
+			TArray<FString> Lines;
+			FString(UTF8_TO_TCHAR(Buffer.GetData())).ParseIntoArray(Lines, TEXT("\r\n"));
+
+			FString Key;
+			for (const FString& Line : Lines)
+			{
+				FString Name;
+				FString Value;
+				if (Line.Split(TEXT(":"), &Name, &Value) && Name.TrimStartAndEnd().Equals(TEXT("Sec-WebSocket-Key"), ESearchCase::IgnoreCase))
+				{
+					Key = Value.TrimStartAndEnd();
+				}
+			}
+
+			const FString Response = FString::Printf(
+				TEXT("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n"),
+				*FCentrifugeWebSocketFrame::ComputeAcceptKey(Key));
+
+			FTCHARToUTF8 ConvertedResponse(*Response);
+			send(Connection, ConvertedResponse.Get(), ConvertedResponse.Length(), 0);
+
+			// An unmasked single-frame text message, as servers send them.
+			FTCHARToUTF8 ConvertedMessage(*Message);
+			TArray<uint8> Frame;
+			Frame.Add(0x80 | FCentrifugeWebSocketFrame::kOpcodeText);
+			Frame.Add(static_cast<uint8>(ConvertedMessage.Length()));
+			Frame.Append(reinterpret_cast<const uint8*>(ConvertedMessage.Get()), ConvertedMessage.Length());
+			send(Connection, Frame.GetData(), Frame.Num(), 0);
+
+			// Waits for the client to close the connection.
+			Poll = { Connection, POLLIN, 0 };
+			while (poll(&Poll, 1, 5000) > 0 && recv(Connection, Buffer.GetData(), Buffer.Num(), 0) > 0)
+			{
+			}
+
+			close(Connection);
+		}
+
+	private:
+		FString Path;
+		FString Message;
+		int Descriptor;
+		TPromise<void> ServedPromise;
+		TFuture<void> Served;
+	};
+} // namespace Multiplay
+#endif
+
+BEGIN_DEFINE_SPEC(FMultiplayCentrifugeWebSocketSpec, "MultiplayGameServerSDK.CentrifugeWebSocket", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+void TestRoundTrip(int32 PayloadLength, int32 ExpectedHeaderLength);
+END_DEFINE_SPEC(FMultiplayCentrifugeWebSocketSpec)
+
+void FMultiplayCentrifugeWebSocketSpec::TestRoundTrip(int32 PayloadLength, int32 ExpectedHeaderLength)
+{
+	using Multiplay::FCentrifugeWebSocketFrame;
+
+	TArray<uint8> Payload;
+	for (int32 Index = 0; Index < PayloadLength; ++Index)
+	{
+		Payload.Add(static_cast<uint8>(Index));
+	}
+
+	const uint8 MaskKey[4] = { 0x12, 0x34, 0x56, 0x78 };
+
+	TArray<uint8> Buffer;
+	FCentrifugeWebSocketFrame::Encode(FCentrifugeWebSocketFrame::kOpcodeText, Payload.GetData(), Payload.Num(), MaskKey, Buffer);
+
+	FCentrifugeWebSocketFrame::FHeader Header;
+	if (MP_TEST_TRUE_EXPR(FCentrifugeWebSocketFrame::DecodeHeader(Buffer.GetData(), Buffer.Num(), Header)))
+	{
+		TestTrueExpr(Header.bFin);
+		TestTrueExpr(Header.bMasked);
+		TestEqual("Opcode", static_cast<int32>(Header.Opcode), static_cast<int32>(FCentrifugeWebSocketFrame::kOpcodeText));
+		TestEqual("PayloadLength", Header.PayloadLength, static_cast<uint64>(PayloadLength));
+		TestEqual("HeaderLength", Header.HeaderLength, ExpectedHeaderLength);
+
+		if (MP_TEST_TRUE_EXPR(Buffer.Num() == Header.HeaderLength + PayloadLength))
+		{
+			FCentrifugeWebSocketFrame::ApplyMask(Buffer.GetData() + Header.HeaderLength, PayloadLength, Header.MaskKey);
+			TestTrueExpr(FMemory::Memcmp(Buffer.GetData() + Header.HeaderLength, Payload.GetData(), PayloadLength) == 0);
+		}
+	}
+}
+
+void FMultiplayCentrifugeWebSocketSpec::Define()
+{
+	Describe("FCentrifugeWebSocketFrame", [this]()
+		{
+			It("should round-trip a frame with a 7-bit length.", [this]()
+				{
+					TestRoundTrip(5, 6);
+				});
+
+			It("should round-trip a frame with a 16-bit length.", [this]()
+				{
+					TestRoundTrip(300, 8);
+				});
+
+			It("should round-trip a frame with a 64-bit length.", [this]()
+				{
+					TestRoundTrip(70000, 14);
+				});
+
+			It("should decode an unmasked server frame.", [this]()
+				{
+					// A single-frame unmasked text message containing "Hello", see RFC 6455 section 5.7.
+					const uint8 Frame[] = { 0x81, 0x05, 0x48, 0x65, 0x6c, 0x6c, 0x6f };
+
+					Multiplay::FCentrifugeWebSocketFrame::FHeader Header;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FCentrifugeWebSocketFrame::DecodeHeader(Frame, sizeof(Frame), Header)))
+					{
+						TestTrueExpr(Header.bFin);
+						TestFalseExpr(Header.bMasked);
+						TestEqual("PayloadLength", Header.PayloadLength, static_cast<uint64>(5));
+						TestEqual("HeaderLength", Header.HeaderLength, 2);
+					}
+				});
+
+			It("should wait for the rest of a partially received header.", [this]()
+				{
+					const uint8 Frame[] = { 0x81, 0xFE, 0x01 };
+
+					Multiplay::FCentrifugeWebSocketFrame::FHeader Header;
+					TestFalseExpr(Multiplay::FCentrifugeWebSocketFrame::DecodeHeader(Frame, 1, Header));
+					TestFalseExpr(Multiplay::FCentrifugeWebSocketFrame::DecodeHeader(Frame, sizeof(Frame), Header));
+				});
+
+			It("should compute the accept key of the handshake.", [this]()
+				{
+					// The example from RFC 6455 section 1.3.
+					TestEqual("ComputeAcceptKey()", Multiplay::FCentrifugeWebSocketFrame::ComputeAcceptKey(TEXT("dGhlIHNhbXBsZSBub25jZQ==")), FString(TEXT("s3pPLMBiTxaQ9kYGzzhZKxfMo5o=")));
+				});
+
+			It("should split a ws:// URL.", [this]()
+				{
+					FString Host;
+					int32 Port;
+					FString Path;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FCentrifugeWebSocketFrame::ParseUrl(TEXT("ws://127.0.0.1:8086/v1/connection/websocket"), Host, Port, Path)))
+					{
+						TestEqual("Host", Host, FString(TEXT("127.0.0.1")));
+						TestEqual("Port", Port, 8086);
+						TestEqual("Path", Path, FString(TEXT("/v1/connection/websocket")));
+					}
+
+					TestFalseExpr(Multiplay::FCentrifugeWebSocketFrame::ParseUrl(TEXT("wss://127.0.0.1:8086/"), Host, Port, Path));
+				});
+		});
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+	Describe("FCentrifugeWebSocket", [this]()
+		{
+			It("should complete the handshake and queue a message from its I/O thread for the draining thread.", [this]()
+				{
+					const FString Path = FString::Printf(TEXT("/tmp/multiplay-sdk-websocket-spec-%u.sock"), FPlatformProcess::GetCurrentProcessId());
+					const FString Message = TEXT("{\"id\":1,\"result\":{}}");
+
+					Multiplay::FCentrifugeWebSocketSpecDaemon Daemon(Path, Message);
+					MP_TEST_TRUE_EXPR(Daemon.IsListening());
+					Daemon.Serve();
+
+					TSharedPtr<Multiplay::FCentrifugeWebSocket, ESPMode::ThreadSafe> WebSocket = MakeShared<Multiplay::FCentrifugeWebSocket, ESPMode::ThreadSafe>(TEXT("ws://localhost:8086/connection/websocket"), Path);
+
+					TArray<FString> Messages;
+					double ReceivedSeconds = 0.0;
+					double BroadcastSeconds = 0.0;
+					uint32 BroadcastThreadId = 0;
+					WebSocket->OnMessage().AddLambda([&](const FString& MessageString, double InReceivedSeconds)
+						{
+							Messages.Add(MessageString);
+							ReceivedSeconds = InReceivedSeconds;
+							BroadcastSeconds = FPlatformTime::Seconds();
+							BroadcastThreadId = FPlatformTLS::GetCurrentThreadId();
+						});
+
+					WebSocket->Connect();
+
+					// The game thread is not ticked while waiting, so the handshake and the message are handled by the I/O thread alone.
+					const double ConnectSeconds = FPlatformTime::Seconds();
+					const double Deadline = ConnectSeconds + 5.0;
+					while (Messages.Num() == 0 && FPlatformTime::Seconds() < Deadline)
+					{
+						// Leaves the message queued for a while, its timestamp must be the time it was read rather than drained.
+						FPlatformProcess::Sleep(0.1f);
+						WebSocket->DrainMessages();
+					}
+
+					TestTrueExpr(WebSocket->IsConnected());
+					if (MP_TEST_TRUE_EXPR(Messages.Num() == 1))
+					{
+						TestEqual(TEXT("Message"), Messages[0], Message);
+						TestEqual(TEXT("BroadcastThreadId"), BroadcastThreadId, FPlatformTLS::GetCurrentThreadId());
+						TestTrueExpr(ReceivedSeconds >= ConnectSeconds);
+						TestTrueExpr(ReceivedSeconds < BroadcastSeconds);
+					}
+
+					// Stops the I/O thread, which closes the socket the daemon is waiting on.
+					WebSocket.Reset();
+				});
+		});
+#endif
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
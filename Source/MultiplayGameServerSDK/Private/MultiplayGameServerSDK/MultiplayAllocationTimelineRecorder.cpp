@@ -0,0 +1,134 @@
+#include "MultiplayAllocationTimelineRecorder.h"
+
+namespace Multiplay
+{
+	FMultiplayAllocationTimelineRecorder::FMultiplayAllocationTimelineRecorder(int32 InWindowSize)
+		: CurrentReceivedSeconds(0.0)
+		, WindowSize(FMath::Max(InWindowSize, 1))
+		, NextIndex(0)
+		, CompletedCount(0)
+		, AbandonedCount(0)
+	{
+		Window.Reserve(WindowSize);
+	}
+
+	void FMultiplayAllocationTimelineRecorder::Begin(const FGuid& AllocationId, double MessageReceivedSeconds)
+	{
+		if (CurrentId.IsValid())
+		{
+			++AbandonedCount;
+		}
+
+		CurrentId = AllocationId;
+		CurrentReceivedSeconds = MessageReceivedSeconds;
+		for (float& StageMs : Current.StageMs)
+		{
+			StageMs = -1.0f;
+		}
+	}
+
+	bool FMultiplayAllocationTimelineRecorder::Mark(const FGuid& AllocationId, EStage Stage, double Seconds)
+	{
+		if (!CurrentId.IsValid() || AllocationId != CurrentId)
+		{
+			return false;
+		}
+
+		float& StageMs = Current.StageMs[static_cast<int32>(Stage)];
+		if (StageMs >= 0.0f)
+		{
+			return false;
+		}
+
+		// Clamped so that no stage is reported as reached before the message was received.
+		StageMs = static_cast<float>(FMath::Max(Seconds - CurrentReceivedSeconds, 0.0) * 1000.0);
+
+		if (Stage != EStage::ReadyAcknowledged)
+		{
+			return false;
+		}
+
+		Last = ToTimeline(CurrentId.ToString(), Current);
+
+		if (Window.Num() < WindowSize)
+		{
+			Window.Add(Current);
+		}
+		else
+		{
+			Window[NextIndex] = Current;
+		}
+		NextIndex = (NextIndex + 1) % WindowSize;
+
+		++CompletedCount;
+		CurrentId.Invalidate();
+		return true;
+	}
+
+	void FMultiplayAllocationTimelineRecorder::Abandon(const FGuid& AllocationId)
+	{
+		if (CurrentId.IsValid() && AllocationId == CurrentId)
+		{
+			++AbandonedCount;
+			CurrentId.Invalidate();
+		}
+	}
+
+	FMultiplayAllocationTimelineStats FMultiplayAllocationTimelineRecorder::GetStats() const
+	{
+		FMultiplayAllocationTimelineStats Stats;
+		Stats.CompletedAllocations = CompletedCount;
+		Stats.AbandonedAllocations = AbandonedCount;
+		Stats.SampleCount = Window.Num();
+		Stats.P50 = GetPercentile(Window, 50.0);
+		Stats.P90 = GetPercentile(Window, 90.0);
+		Stats.P99 = GetPercentile(Window, 99.0);
+		return Stats;
+	}
+
+	FMultiplayAllocationTimeline FMultiplayAllocationTimelineRecorder::ToTimeline(const FString& AllocationId, const FSample& Sample)
+	{
+		FMultiplayAllocationTimeline Timeline;
+		Timeline.AllocationId = AllocationId;
+		Timeline.EventParsedMs = Sample.StageMs[static_cast<int32>(EStage::EventParsed)];
+		Timeline.AllocateBroadcastMs = Sample.StageMs[static_cast<int32>(EStage::AllocateBroadcast)];
+		Timeline.PayloadRequestedMs = Sample.StageMs[static_cast<int32>(EStage::PayloadRequested)];
+		Timeline.PayloadReceivedMs = Sample.StageMs[static_cast<int32>(EStage::PayloadReceived)];
+		Timeline.ReadyRequestedMs = Sample.StageMs[static_cast<int32>(EStage::ReadyRequested)];
+		Timeline.ReadyAcknowledgedMs = Sample.StageMs[static_cast<int32>(EStage::ReadyAcknowledged)];
+		return Timeline;
+	}
+
+	FMultiplayAllocationTimeline FMultiplayAllocationTimelineRecorder::GetPercentile(const TArray<FSample>& Samples, double Percentile)
+	{
+		FSample Result;
+
+		// Each stage is ranked over the timelines that reached it, a game that never requests the payload leaves those stages out.
+		TArray<float> Values;
+		Values.Reserve(Samples.Num());
+		for (int32 Stage = 0; Stage < static_cast<int32>(EStage::Num); ++Stage)
+		{
+			Values.Reset();
+			for (const FSample& Sample : Samples)
+			{
+				if (Sample.StageMs[Stage] >= 0.0f)
+				{
+					Values.Add(Sample.StageMs[Stage]);
+				}
+			}
+
+			if (Values.Num() == 0)
+			{
+				Result.StageMs[Stage] = -1.0f;
+				continue;
+			}
+
+			// Nearest rank, so the reported time is one that was actually recorded.
+			Values.Sort();
+			const int32 Rank = FMath::CeilToInt(static_cast<float>(Percentile / 100.0 * Values.Num()));
+			Result.StageMs[Stage] = Values[FMath::Clamp(Rank - 1, 0, Values.Num() - 1)];
+		}
+
+		return ToTimeline(FString(), Result);
+	}
+} // namespace Multiplay
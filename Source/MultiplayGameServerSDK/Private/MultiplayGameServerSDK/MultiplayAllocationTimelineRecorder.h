@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayAllocationTimeline.h"
+
+namespace Multiplay
+{
+	// Records when each stage between an allocation message being received and the server being acknowledged as ready
+	// was reached, and keeps the most recently completed timelines to report percentiles from.
+	//
+	// Only the allocation most recently begun is tracked, marks for any other allocation are ignored. Each stage keeps the
+	// first time it was reached, so a retried payload request or ready call does not hide the original one. Times are
+	// taken from FPlatformTime::Seconds by the caller.
+	class FMultiplayAllocationTimelineRecorder
+	{
+	public:
+		enum class EStage : uint8
+		{
+			EventParsed,
+			AllocateBroadcast,
+			PayloadRequested,
+			PayloadReceived,
+			ReadyRequested,
+			// Completes the timeline.
+			ReadyAcknowledged,
+			Num,
+		};
+
+		// The number of completed timelines percentiles are computed from.
+		static constexpr int32 kDefaultWindowSize = 128;
+
+	public:
+		explicit FMultiplayAllocationTimelineRecorder(int32 WindowSize = kDefaultWindowSize);
+
+		// Starts the timeline of an allocation whose message was received at the given time. An incomplete timeline is abandoned.
+		void Begin(const FGuid& AllocationId, double MessageReceivedSeconds);
+
+		// Records the time the allocation reached the stage, returns true if it completed the timeline.
+		bool Mark(const FGuid& AllocationId, EStage Stage, double Seconds);
+
+		// Abandons the timeline of the allocation if it is in progress.
+		void Abandon(const FGuid& AllocationId);
+
+		bool IsInProgress() const { return CurrentId.IsValid(); }
+
+		// The timeline most recently completed, default if none has been.
+		const FMultiplayAllocationTimeline& GetLast() const { return Last; }
+
+		FMultiplayAllocationTimelineStats GetStats() const;
+
+	private:
+		struct FSample
+		{
+			float StageMs[static_cast<int32>(EStage::Num)];
+		};
+
+		static FMultiplayAllocationTimeline ToTimeline(const FString& AllocationId, const FSample& Sample);
+		static FMultiplayAllocationTimeline GetPercentile(const TArray<FSample>& Samples, double Percentile);
+
+	private:
+		FGuid CurrentId;
+		double CurrentReceivedSeconds;
+		FSample Current;
+
+		FMultiplayAllocationTimeline Last;
+
+		// Completed timelines, overwritten oldest first once the window is full.
+		TArray<FSample> Window;
+		int32 WindowSize;
+		int32 NextIndex;
+
+		int64 CompletedCount;
+		int64 AbandonedCount;
+	};
+} // namespace Multiplay
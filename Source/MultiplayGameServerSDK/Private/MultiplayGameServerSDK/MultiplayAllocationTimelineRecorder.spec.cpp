@@ -0,0 +1,107 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayAllocationTimelineRecorder.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayAllocationTimelineRecorderSpec, "MultiplayGameServerSDK.AllocationTimelineRecorder", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+using EStage = Multiplay::FMultiplayAllocationTimelineRecorder::EStage;
+bool Complete(Multiplay::FMultiplayAllocationTimelineRecorder& Recorder, const FGuid& AllocationId, double ReadySeconds) const;
+END_DEFINE_SPEC(FMultiplayAllocationTimelineRecorderSpec)
+
+// Takes an allocation received at 100s to ready at the given time, without requesting the payload.
+bool FMultiplayAllocationTimelineRecorderSpec::Complete(Multiplay::FMultiplayAllocationTimelineRecorder& Recorder, const FGuid& AllocationId, double ReadySeconds) const
+{
+	Recorder.Begin(AllocationId, 100.0);
+	Recorder.Mark(AllocationId, EStage::EventParsed, 100.001);
+	Recorder.Mark(AllocationId, EStage::ReadyRequested, ReadySeconds - 0.001);
+	return Recorder.Mark(AllocationId, EStage::ReadyAcknowledged, ReadySeconds);
+}
+
+void FMultiplayAllocationTimelineRecorderSpec::Define()
+{
+	It("should report each stage relative to the message being received once ready is acknowledged.", [this]()
+		{
+			Multiplay::FMultiplayAllocationTimelineRecorder Recorder;
+			const FGuid AllocationId = FGuid::NewGuid();
+
+			Recorder.Begin(AllocationId, 10.0);
+			TestFalseExpr(Recorder.Mark(AllocationId, EStage::EventParsed, 10.002));
+			TestFalseExpr(Recorder.Mark(AllocationId, EStage::AllocateBroadcast, 10.003));
+			TestFalseExpr(Recorder.Mark(AllocationId, EStage::PayloadRequested, 10.010));
+			TestFalseExpr(Recorder.Mark(AllocationId, EStage::PayloadReceived, 10.030));
+			TestFalseExpr(Recorder.Mark(AllocationId, EStage::ReadyRequested, 10.100));
+
+			// Only the first time a stage is reached is kept.
+			TestFalseExpr(Recorder.Mark(AllocationId, EStage::PayloadRequested, 10.050));
+			TestTrueExpr(Recorder.GetLast().AllocationId.IsEmpty());
+
+			MP_TEST_TRUE_EXPR(Recorder.Mark(AllocationId, EStage::ReadyAcknowledged, 10.250));
+			TestFalseExpr(Recorder.IsInProgress());
+
+			const FMultiplayAllocationTimeline& Timeline = Recorder.GetLast();
+			TestEqual(TEXT("AllocationId"), Timeline.AllocationId, AllocationId.ToString());
+			TestEqual(TEXT("EventParsedMs"), Timeline.EventParsedMs, 2.0f, 0.01f);
+			TestEqual(TEXT("AllocateBroadcastMs"), Timeline.AllocateBroadcastMs, 3.0f, 0.01f);
+			TestEqual(TEXT("PayloadRequestedMs"), Timeline.PayloadRequestedMs, 10.0f, 0.01f);
+			TestEqual(TEXT("PayloadReceivedMs"), Timeline.PayloadReceivedMs, 30.0f, 0.01f);
+			TestEqual(TEXT("ReadyRequestedMs"), Timeline.ReadyRequestedMs, 100.0f, 0.01f);
+			TestEqual(TEXT("ReadyAcknowledgedMs"), Timeline.ReadyAcknowledgedMs, 250.0f, 0.01f);
+		});
+
+	It("should ignore stages reached by an allocation other than the one in progress.", [this]()
+		{
+			Multiplay::FMultiplayAllocationTimelineRecorder Recorder;
+			const FGuid Previous = FGuid::NewGuid();
+			const FGuid Current = FGuid::NewGuid();
+
+			Recorder.Begin(Previous, 10.0);
+			Recorder.Begin(Current, 20.0);
+
+			TestFalseExpr(Recorder.Mark(Previous, EStage::ReadyAcknowledged, 20.5));
+			TestTrueExpr(Recorder.IsInProgress());
+			TestEqual(TEXT("AbandonedAllocations"), Recorder.GetStats().AbandonedAllocations, static_cast<int64>(1));
+
+			MP_TEST_TRUE_EXPR(Recorder.Mark(Current, EStage::ReadyAcknowledged, 20.5));
+			TestEqual(TEXT("ReadyAcknowledgedMs"), Recorder.GetLast().ReadyAcknowledgedMs, 500.0f, 0.01f);
+		});
+
+	It("should count a deallocated allocation as abandoned.", [this]()
+		{
+			Multiplay::FMultiplayAllocationTimelineRecorder Recorder;
+			const FGuid AllocationId = FGuid::NewGuid();
+
+			Recorder.Begin(AllocationId, 10.0);
+			Recorder.Abandon(AllocationId);
+
+			TestFalseExpr(Recorder.Mark(AllocationId, EStage::ReadyAcknowledged, 10.5));
+
+			const FMultiplayAllocationTimelineStats Stats = Recorder.GetStats();
+			TestEqual(TEXT("CompletedAllocations"), Stats.CompletedAllocations, static_cast<int64>(0));
+			TestEqual(TEXT("AbandonedAllocations"), Stats.AbandonedAllocations, static_cast<int64>(1));
+		});
+
+	It("should report nearest rank percentiles over the most recent allocations.", [this]()
+		{
+			Multiplay::FMultiplayAllocationTimelineRecorder Recorder(100);
+
+			// A slow allocation that has left the window no longer affects the percentiles.
+			Complete(Recorder, FGuid::NewGuid(), 200.0);
+			for (int32 Index = 1; Index <= 100; ++Index)
+			{
+				MP_TEST_TRUE_EXPR(Complete(Recorder, FGuid::NewGuid(), 100.0 + Index * 0.001));
+			}
+
+			const FMultiplayAllocationTimelineStats Stats = Recorder.GetStats();
+			TestEqual(TEXT("CompletedAllocations"), Stats.CompletedAllocations, static_cast<int64>(101));
+			TestEqual(TEXT("SampleCount"), Stats.SampleCount, 100);
+			TestEqual(TEXT("P50"), Stats.P50.ReadyAcknowledgedMs, 50.0f, 0.01f);
+			TestEqual(TEXT("P90"), Stats.P90.ReadyAcknowledgedMs, 90.0f, 0.01f);
+			TestEqual(TEXT("P99"), Stats.P99.ReadyAcknowledgedMs, 99.0f, 0.01f);
+
+			// Stages no allocation reached are reported as not reached.
+			TestTrueExpr(Stats.P99.PayloadReceivedMs < 0.0f);
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,124 @@
+#include "MultiplayConnectionWarmer.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "HAL/PlatformTime.h"
+#include "MultiplayGameServerSDKLog.h"
+
+namespace Multiplay
+{
+	FMultiplayConnectionWarmer::FMultiplayConnectionWarmer(const FString& InUrl, float InIntervalSeconds)
+		: Url(InUrl)
+		, IntervalSeconds(FMath::Max(0.1f, InIntervalSeconds))
+		, LastAnsweredAt(0.0)
+		, LastActivityAt(0.0)
+		, bWarmupInFlight(false)
+		, WarmupRequests(0)
+		, WarmupFailures(0)
+		, WarmCalls(0)
+		, ColdCalls(0)
+		, WarmCallSeconds(0.0)
+		, ColdCallSeconds(0.0)
+	{
+	}
+
+	bool FMultiplayConnectionWarmer::Tick(float DeltaTime)
+	{
+		if (FPlatformTime::Seconds() - LastActivityAt >= IntervalSeconds)
+		{
+			Warm();
+		}
+
+		return true;
+	}
+
+	void FMultiplayConnectionWarmer::Warm()
+	{
+		if (bWarmupInFlight)
+		{
+			return;
+		}
+
+		LastActivityAt = FPlatformTime::Seconds();
+
+		if (SendWarmupRequest().IsValid())
+		{
+			bWarmupInFlight = true;
+			++WarmupRequests;
+		}
+	}
+
+	bool FMultiplayConnectionWarmer::IsWarm(double Now) const
+	{
+		return LastAnsweredAt > 0.0 && Now - LastAnsweredAt < 2.0 * IntervalSeconds;
+	}
+
+	void FMultiplayConnectionWarmer::RecordCall(bool bWasWarm, double DurationSeconds, bool bAnswered, double Now)
+	{
+		if (bWasWarm)
+		{
+			++WarmCalls;
+			WarmCallSeconds += DurationSeconds;
+		}
+		else
+		{
+			++ColdCalls;
+			ColdCallSeconds += DurationSeconds;
+		}
+
+		// A call keeps the connection open just as a warmup request does.
+		LastActivityAt = Now;
+		if (bAnswered)
+		{
+			LastAnsweredAt = Now;
+		}
+	}
+
+	FMultiplayConnectionStats FMultiplayConnectionWarmer::GetStats() const
+	{
+		FMultiplayConnectionStats Stats;
+		Stats.WarmupRequests = WarmupRequests;
+		Stats.WarmupFailures = WarmupFailures;
+		Stats.WarmCalls = WarmCalls;
+		Stats.ColdCalls = ColdCalls;
+		Stats.MeanWarmCallMs = WarmCalls > 0 ? static_cast<float>(WarmCallSeconds * 1000.0 / WarmCalls) : 0.0f;
+		Stats.MeanColdCallMs = ColdCalls > 0 ? static_cast<float>(ColdCallSeconds * 1000.0 / ColdCalls) : 0.0f;
+		return Stats;
+	}
+
+	FHttpRequestPtr FMultiplayConnectionWarmer::SendWarmupRequest()
+	{
+		// Any answer keeps the connection open, so the request asks for nothing but the headers of the root path.
+		const FHttpRequestPtr HttpRequest = FHttpModule::Get().CreateRequest();
+		HttpRequest->SetURL(Url + TEXT("/"));
+		HttpRequest->SetVerb(TEXT("HEAD"));
+		HttpRequest->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+		HttpRequest->OnProcessRequestComplete().BindSP(this, &FMultiplayConnectionWarmer::OnWarmupResponse);
+
+		if (!HttpRequest->ProcessRequest())
+		{
+			return nullptr;
+		}
+
+		return HttpRequest;
+	}
+
+	void FMultiplayConnectionWarmer::OnWarmupComplete(bool bAnswered, double Now)
+	{
+		bWarmupInFlight = false;
+
+		if (bAnswered)
+		{
+			LastAnsweredAt = Now;
+		}
+		else
+		{
+			++WarmupFailures;
+			UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("The SDK daemon did not answer a warmup request."));
+		}
+	}
+
+	void FMultiplayConnectionWarmer::OnWarmupResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
+	{
+		OnWarmupComplete(bSucceeded && HttpResponse.IsValid(), FPlatformTime::Seconds());
+	}
+} // namespace Multiplay
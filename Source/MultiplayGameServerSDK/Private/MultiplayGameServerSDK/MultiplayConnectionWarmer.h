@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Utils/MultiplayTicker.h"
+#include "MultiplayConnectionStats.h"
+
+namespace Multiplay
+{
+	// Keeps a connection to the SDK daemon open so that calls made after an allocation do not pay for connection setup.
+	//
+	// The engine HTTP module keeps connections to a host open between requests and reuses them. While no call is made to the
+	// daemon, a small request is sent every interval so that the connection is not closed for being idle. A call is counted
+	// as warm if the daemon answered a request less than two intervals before it was sent.
+	class FMultiplayConnectionWarmer : public FMultiplayTickerObjectBase, public TSharedFromThis<FMultiplayConnectionWarmer>
+	{
+	public:
+		FMultiplayConnectionWarmer(const FString& Url, float IntervalSeconds);
+
+		virtual bool Tick(float DeltaTime) override;
+
+		// Sends a warmup request unless one is already in flight.
+		void Warm();
+
+		// Returns true if a call sent at the given time would find the connection open.
+		bool IsWarm(double Now) const;
+
+		// Records a call to the daemon that was sent while the connection was warm or cold, and whether the daemon answered it.
+		void RecordCall(bool bWasWarm, double DurationSeconds, bool bAnswered, double Now);
+
+		FMultiplayConnectionStats GetStats() const;
+
+	protected:
+		// Sends the warmup request, returns null if it could not be sent.
+		virtual FHttpRequestPtr SendWarmupRequest();
+
+		void OnWarmupComplete(bool bAnswered, double Now);
+
+	private:
+		void OnWarmupResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
+
+	private:
+		FString Url;
+		double IntervalSeconds;
+		double LastAnsweredAt;
+		double LastActivityAt;
+		bool bWarmupInFlight;
+		int64 WarmupRequests;
+		int64 WarmupFailures;
+		int64 WarmCalls;
+		int64 ColdCalls;
+		double WarmCallSeconds;
+		double ColdCallSeconds;
+	};
+} // namespace Multiplay
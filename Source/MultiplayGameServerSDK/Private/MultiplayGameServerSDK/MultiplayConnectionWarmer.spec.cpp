@@ -0,0 +1,95 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayConnectionWarmer.h"
+#include "HttpModule.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace Multiplay
+{
+	// Creates warmup requests without sending them, so that the tests decide when the daemon answers.
+	class FTestConnectionWarmer : public FMultiplayConnectionWarmer
+	{
+	public:
+		using FMultiplayConnectionWarmer::FMultiplayConnectionWarmer;
+		using FMultiplayConnectionWarmer::OnWarmupComplete;
+
+	protected:
+		virtual FHttpRequestPtr SendWarmupRequest() override
+		{
+			return FHttpModule::Get().CreateRequest();
+		}
+	};
+} // namespace Multiplay
+
+BEGIN_DEFINE_SPEC(FMultiplayConnectionWarmerSpec, "MultiplayGameServerSDK.ConnectionWarmer", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TSharedPtr<Multiplay::FTestConnectionWarmer> Warmer;
+END_DEFINE_SPEC(FMultiplayConnectionWarmerSpec)
+
+void FMultiplayConnectionWarmerSpec::Define()
+{
+	BeforeEach([this]()
+		{
+			Warmer = MakeShared<Multiplay::FTestConnectionWarmer>(TEXT("http://localhost:8086"), 10.0f);
+		});
+
+	AfterEach([this]()
+		{
+			Warmer.Reset();
+		});
+
+	Describe("Warm", [this]()
+		{
+			It("should only have one warmup request in flight.", [this]()
+				{
+					Warmer->Warm();
+					Warmer->Warm();
+					TestEqual("WarmupRequests", Warmer->GetStats().WarmupRequests, static_cast<int64>(1));
+
+					Warmer->OnWarmupComplete(false, 0.0);
+					Warmer->Warm();
+					TestEqual("WarmupRequests", Warmer->GetStats().WarmupRequests, static_cast<int64>(2));
+					TestEqual("WarmupFailures", Warmer->GetStats().WarmupFailures, static_cast<int64>(1));
+				});
+		});
+
+	Describe("IsWarm", [this]()
+		{
+			It("should be warm for two intervals after the daemon answered.", [this]()
+				{
+					TestFalseExpr(Warmer->IsWarm(100.0));
+
+					Warmer->Warm();
+					Warmer->OnWarmupComplete(true, 100.0);
+
+					TestTrueExpr(Warmer->IsWarm(110.0));
+					TestFalseExpr(Warmer->IsWarm(120.0));
+				});
+
+			It("should stay warm while calls are answered.", [this]()
+				{
+					Warmer->RecordCall(false, 0.05, true, 100.0);
+					Warmer->RecordCall(true, 0.01, true, 115.0);
+
+					TestTrueExpr(Warmer->IsWarm(130.0));
+				});
+		});
+
+	Describe("GetStats", [this]()
+		{
+			It("should report warm and cold calls separately.", [this]()
+				{
+					Warmer->RecordCall(false, 0.05, true, 100.0);
+					Warmer->RecordCall(true, 0.01, true, 101.0);
+					Warmer->RecordCall(true, 0.03, true, 102.0);
+
+					const FMultiplayConnectionStats Stats = Warmer->GetStats();
+					TestEqual("ColdCalls", Stats.ColdCalls, static_cast<int64>(1));
+					TestEqual("WarmCalls", Stats.WarmCalls, static_cast<int64>(2));
+					TestEqual("MeanColdCallMs", Stats.MeanColdCallMs, 50.0f, 0.01f);
+					TestEqual("MeanWarmCallMs", Stats.MeanWarmCallMs, 20.0f, 0.01f);
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,41 @@
+#include "MultiplayEventIdFilter.h"
+
+namespace Multiplay
+{
+	FMultiplayEventIdFilter::FMultiplayEventIdFilter(int32 InCapacity)
+		: Capacity(FMath::Max(InCapacity, 1))
+		, NextIndex(0)
+		, HitCount(0)
+		, MissCount(0)
+	{
+		Ids.Reserve(Capacity);
+	}
+
+	bool FMultiplayEventIdFilter::Admit(const FGuid& EventId)
+	{
+		if (!EventId.IsValid())
+		{
+			++MissCount;
+			return true;
+		}
+
+		if (Ids.Contains(EventId))
+		{
+			++HitCount;
+			return false;
+		}
+
+		if (Ids.Num() < Capacity)
+		{
+			Ids.Add(EventId);
+		}
+		else
+		{
+			Ids[NextIndex] = EventId;
+		}
+		NextIndex = (NextIndex + 1) % Capacity;
+
+		++MissCount;
+		return true;
+	}
+} // namespace Multiplay
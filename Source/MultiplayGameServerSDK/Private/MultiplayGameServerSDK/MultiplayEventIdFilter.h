@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Multiplay
+{
+	// Remembers the ids of the most recent server events, so that an event delivered again is dropped.
+	//
+	// An event is redelivered by a reconnect, a history replay or a retry of the daemon, all of which happen shortly after
+	// the original. The ids are kept in a small ring that is searched linearly, the oldest being forgotten first.
+	class FMultiplayEventIdFilter
+	{
+	public:
+		static constexpr int32 kDefaultCapacity = 64;
+
+	public:
+		explicit FMultiplayEventIdFilter(int32 Capacity = kDefaultCapacity);
+
+		// Returns true and remembers the id if it has not been seen, false if the event is a duplicate. An invalid id is always admitted.
+		bool Admit(const FGuid& EventId);
+
+		// The number of events dropped as duplicates.
+		int64 GetHitCount() const { return HitCount; }
+
+		// The number of events admitted.
+		int64 GetMissCount() const { return MissCount; }
+
+	private:
+		TArray<FGuid> Ids;
+		int32 Capacity;
+		int32 NextIndex;
+		int64 HitCount;
+		int64 MissCount;
+	};
+} // namespace Multiplay
@@ -0,0 +1,53 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayEventIdFilter.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayEventIdFilterSpec, "MultiplayGameServerSDK.EventIdFilter", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FMultiplayEventIdFilterSpec)
+
+void FMultiplayEventIdFilterSpec::Define()
+{
+	It("should drop an event whose id has already been admitted.", [this]()
+		{
+			Multiplay::FMultiplayEventIdFilter Filter;
+			const FGuid Allocate = FGuid::NewGuid();
+			const FGuid Deallocate = FGuid::NewGuid();
+
+			TestTrueExpr(Filter.Admit(Allocate));
+			TestTrueExpr(Filter.Admit(Deallocate));
+			TestFalseExpr(Filter.Admit(Allocate));
+			TestFalseExpr(Filter.Admit(Deallocate));
+
+			TestEqual(TEXT("Hits"), Filter.GetHitCount(), static_cast<int64>(2));
+			TestEqual(TEXT("Misses"), Filter.GetMissCount(), static_cast<int64>(2));
+		});
+
+	It("should forget the oldest ids once it is full.", [this]()
+		{
+			Multiplay::FMultiplayEventIdFilter Filter(2);
+			const FGuid First = FGuid::NewGuid();
+			const FGuid Second = FGuid::NewGuid();
+			const FGuid Third = FGuid::NewGuid();
+
+			Filter.Admit(First);
+			Filter.Admit(Second);
+			Filter.Admit(Third);
+
+			TestFalseExpr(Filter.Admit(Second));
+			TestFalseExpr(Filter.Admit(Third));
+			TestTrueExpr(Filter.Admit(First));
+		});
+
+	It("should always admit an event without an id.", [this]()
+		{
+			Multiplay::FMultiplayEventIdFilter Filter;
+
+			TestTrueExpr(Filter.Admit(FGuid()));
+			TestTrueExpr(Filter.Admit(FGuid()));
+			TestEqual(TEXT("Hits"), Filter.GetHitCount(), static_cast<int64>(0));
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,99 @@
+#include "MultiplayFileWatcher.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "MultiplayGameServerSDKLog.h"
+
+#if PLATFORM_LINUX
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Multiplay
+{
+	FMultiplayFileWatcher::FMultiplayFileWatcher(const FString& InPath, float IntervalSeconds, FChangedFunction InOnChanged)
+		: FMultiplayTickerObjectBase(IntervalSeconds)
+		, Path(FPaths::ConvertRelativePathToFull(InPath))
+		, FileName(FPaths::GetCleanFilename(InPath))
+		, OnChanged(MoveTemp(InOnChanged))
+		, Descriptor(-1)
+		, LastTimeStamp(IFileManager::Get().GetTimeStamp(*Path))
+		, LastSize(IFileManager::Get().FileSize(*Path))
+	{
+#if PLATFORM_LINUX
+		Descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (Descriptor >= 0 && inotify_add_watch(Descriptor, TCHAR_TO_UTF8(*FPaths::GetPath(Path)), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to watch the directory of %s (errno %d), comparing the file every interval."), *Path, errno);
+
+			close(Descriptor);
+			Descriptor = -1;
+		}
+#endif
+	}
+
+	FMultiplayFileWatcher::~FMultiplayFileWatcher()
+	{
+#if PLATFORM_LINUX
+		if (Descriptor >= 0)
+		{
+			close(Descriptor);
+		}
+#endif
+	}
+
+	bool FMultiplayFileWatcher::Tick(float DeltaTime)
+	{
+		const bool bChanged = IsNotified() ? ReadNotifications() : CompareFile();
+		if (bChanged)
+		{
+			OnChanged();
+		}
+
+		return true;
+	}
+
+	bool FMultiplayFileWatcher::ReadNotifications()
+	{
+		bool bChanged = false;
+
+#if PLATFORM_LINUX
+		alignas(inotify_event) char Buffer[4096];
+
+		ssize_t Length;
+		while ((Length = read(Descriptor, Buffer, sizeof(Buffer))) > 0)
+		{
+			for (char* Position = Buffer; Position < Buffer + Length; )
+			{
+				const inotify_event* Event = reinterpret_cast<const inotify_event*>(Position);
+
+				// An overflowed queue may have dropped the event for the file.
+				if ((Event->mask & IN_Q_OVERFLOW) != 0 || (Event->len > 0 && FileName.Equals(UTF8_TO_TCHAR(Event->name), ESearchCase::CaseSensitive)))
+				{
+					bChanged = true;
+				}
+
+				Position += sizeof(inotify_event) + Event->len;
+			}
+		}
+#endif
+
+		return bChanged;
+	}
+
+	bool FMultiplayFileWatcher::CompareFile()
+	{
+		const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*Path);
+		const int64 Size = IFileManager::Get().FileSize(*Path);
+		if (TimeStamp == LastTimeStamp && Size == LastSize)
+		{
+			return false;
+		}
+
+		LastTimeStamp = TimeStamp;
+		LastSize = Size;
+
+		// A missing file is reported once it has been written again.
+		return Size >= 0;
+	}
+} // namespace Multiplay
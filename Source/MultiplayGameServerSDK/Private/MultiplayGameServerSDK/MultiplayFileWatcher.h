@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Utils/MultiplayTicker.h"
+
+namespace Multiplay
+{
+	// Reports changes to a file, such as the server.json the Multiplay agent rewrites when it recycles a server.
+	//
+	// On Linux the directory of the file is watched with inotify, so that a file replaced by renaming another over it is
+	// reported as well, and the queued events are read without blocking every interval. A change is then only reported once
+	// the file has been closed after writing or moved into place. On other platforms, or if the directory cannot be
+	// watched, the modification time and size of the file are compared every interval instead, and a file that is still
+	// being written may be reported before it is complete. Must only be used from the game thread.
+	class FMultiplayFileWatcher : public FMultiplayTickerObjectBase
+	{
+	public:
+		using FChangedFunction = TFunction<void()>;
+
+		FMultiplayFileWatcher(const FString& Path, float IntervalSeconds, FChangedFunction OnChanged);
+		~FMultiplayFileWatcher();
+
+		virtual bool Tick(float DeltaTime) override;
+
+		// Whether changes are notified by inotify rather than found by comparing the file every interval.
+		bool IsNotified() const { return Descriptor >= 0; }
+
+	private:
+		// Returns true if a notification concerned the file.
+		bool ReadNotifications();
+
+		// Returns true if the modification time or size of the file differs from the last comparison.
+		bool CompareFile();
+
+	private:
+		FString Path;
+		FString FileName;
+		FChangedFunction OnChanged;
+
+		// The inotify descriptor, negative when the file is compared every interval.
+		int32 Descriptor;
+
+		FDateTime LastTimeStamp;
+		int64 LastSize;
+	};
+} // namespace Multiplay
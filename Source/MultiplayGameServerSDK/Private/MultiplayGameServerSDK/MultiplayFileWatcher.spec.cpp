@@ -0,0 +1,72 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayFileWatcher.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayFileWatcherSpec, "MultiplayGameServerSDK.FileWatcher", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+FString Directory;
+FString Path;
+TUniquePtr<Multiplay::FMultiplayFileWatcher> Watcher;
+int32 Changes;
+END_DEFINE_SPEC(FMultiplayFileWatcherSpec)
+
+void FMultiplayFileWatcherSpec::Define()
+{
+	BeforeEach([this]()
+		{
+			Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MultiplayFileWatcherSpec"), FGuid::NewGuid().ToString());
+			Path = FPaths::Combine(Directory, TEXT("server.json"));
+			FFileHelper::SaveStringToFile(TEXT("{}"), *Path);
+
+			// The watcher is ticked by the tests, the interval keeps the ticker from doing so.
+			Changes = 0;
+			Watcher = MakeUnique<Multiplay::FMultiplayFileWatcher>(Path, 3600.0f, [this]() { ++Changes; });
+		});
+
+	AfterEach([this]()
+		{
+			Watcher.Reset();
+			IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		});
+
+	It("should report the file once it has been rewritten.", [this]()
+		{
+			Watcher->Tick(0.0f);
+			TestEqual(TEXT("Changes"), Changes, 0);
+
+			// The size changes as well, so that the change is found even where timestamps are coarse.
+			FFileHelper::SaveStringToFile(TEXT("{\"serverID\": 1}"), *Path);
+
+			Watcher->Tick(0.0f);
+			TestEqual(TEXT("Changes"), Changes, 1);
+
+			Watcher->Tick(0.0f);
+			TestEqual(TEXT("Changes"), Changes, 1);
+		});
+
+	It("should report the file once another file has been moved over it.", [this]()
+		{
+			const FString Replacement = FPaths::Combine(Directory, TEXT("server.json.tmp"));
+			FFileHelper::SaveStringToFile(TEXT("{\"serverID\": 2}"), *Replacement);
+			Watcher->Tick(0.0f);
+
+			IFileManager::Get().Move(*Path, *Replacement);
+
+			Watcher->Tick(0.0f);
+			TestEqual(TEXT("Changes"), Changes, 1);
+		});
+
+	It("should not report changes to the other files in the directory.", [this]()
+		{
+			FFileHelper::SaveStringToFile(TEXT("unrelated"), *FPaths::Combine(Directory, TEXT("server.log")));
+
+			Watcher->Tick(0.0f);
+			TestEqual(TEXT("Changes"), Changes, 0);
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -1,10 +1,29 @@
 #include "MultiplayGameServerSubsystem.h"
 #include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/Paths.h"
+#include "Logging/LogVerbosity.h"
 #include "Subsystems/SubsystemCollection.h"
 #include "Centrifuge/MultiplayCentrifugeClient.h"
+#include "Centrifuge/MultiplayCentrifugeKeepalive.h"
 #include "Centrifuge/MultiplayCentrifugeMessages.h"
 #include "MultiplayServerEvents.h"
+#include "MultiplayServerEventRouter.h"
+#include "MultiplayStreamRecovery.h"
+#include "MultiplaySdkCore.h"
+#include "MultiplayRpcTransport.h"
+#include "MultiplayConnectionWarmer.h"
+#include "MultiplayReadinessReconciler.h"
+#include "MultiplayAllocationTimelineRecorder.h"
+#include "MultiplayWarmStandby.h"
+#include "MultiplayEventIdFilter.h"
+#include "MultiplayLogSink.h"
+#include "MultiplayPayloadCache.h"
+#include "MultiplayPayloadTokenCache.h"
+#include "MultiplayPayloadBufferFactory.h"
+#include "Utils/MultiplayStreamSocket.h"
 #include "MultiplayServerConfigSubsystem.h"
+#include "MultiplayGameServerSettings.h"
 #include "OpenAPIGameServerApi.h"
 #include "OpenAPIGameServerApiOperations.h"
 #include "OpenAPIPayloadApi.h"
@@ -14,7 +33,19 @@
 #include "OpenAPIPayloadTokenResponseBody.h"
 #include "MultiplayGameServerSDKLog.h"
 
-// Necessary to avoid triggering C4150 error for TUniquePtr<FCentrifugeClient> because FCentrifugeClient is forward declared.
+namespace
+{
+	FMultiplayErrorResponse MakeInvalidAllocationResponse()
+	{
+		FMultiplayErrorResponse InvalidAllocationResponse;
+		InvalidAllocationResponse.Title = TEXT("Invalid Allocation ID");
+		InvalidAllocationResponse.Detail = TEXT("Attempted invoke ReadyServerForPlayers() with an invalid allocation ID.");
+		InvalidAllocationResponse.Status = 400;
+		return InvalidAllocationResponse;
+	}
+} // namespace
+
+// Necessary to avoid triggering C4150 error for TUniquePtr<FMultiplayStreamRecovery> because FMultiplayStreamRecovery is forward declared.
 // See documentation in TDefaultDelete<T>::operator() for an explanation.
 UMultiplayGameServerSubsystem::UMultiplayGameServerSubsystem() = default;
 UMultiplayGameServerSubsystem::~UMultiplayGameServerSubsystem() = default;
@@ -27,27 +58,106 @@ void UMultiplayGameServerSubsystem::Initialize(FSubsystemCollectionBase& Collect
     // This subsystem is dependent on the server.json file having been parsed so that the serverID value can be retrieved.
     Collection.InitializeDependency(UMultiplayServerConfigSubsystem::StaticClass());
 
-	FString SdkDaemonIp = TEXT("localhost");
-	uint16 SdkDaemonPort = 8086;
-	FString SdkDaemonUrl = FString::Printf(TEXT("http://%s:%u"), *SdkDaemonIp, SdkDaemonPort);
-	FString SdkDaemonCentrifugeEndpoint = FString::Printf(TEXT("ws://%s:%u/v1/connection/websocket"), *SdkDaemonIp, SdkDaemonPort);
+	const UMultiplayGameServerSettings* Settings = GetDefault<UMultiplayGameServerSettings>();
+
+	// With a shared core only the state of the server channel is kept per game instance, the connection to the daemon is kept once per process.
+	SdkCore = Settings->bShareSdkCore ? Multiplay::FMultiplaySdkCore::GetShared() : MakeShared<Multiplay::FMultiplaySdkCore>();
+	RpcTransport = SdkCore->GetRpcTransport();
+
+	if (Settings->bReconcileReadiness)
+	{
+		ReadinessReconciler = MakeShared<Multiplay::FMultiplayReadinessReconciler>([this](bool bReady, Multiplay::FMultiplayReadinessReconciler::FCompleteFunction OnComplete)
+			{
+				SendReadiness(bReady, MoveTemp(OnComplete));
+			});
+
+		// Without transport retries a failed declaration would otherwise be dropped after a single request.
+		if (!Settings->bEnableRetries)
+		{
+			ReadinessReconciler->EnableResend(Settings->ReadinessResendBaseDelaySeconds, Settings->ReadinessResendMaxDelaySeconds);
+		}
+	}
+
+	AllocationTimeline = MakeUnique<Multiplay::FMultiplayAllocationTimelineRecorder>();
+	EventIdFilter = MakeUnique<Multiplay::FMultiplayEventIdFilter>();
+
+	EventRouter = MakeUnique<Multiplay::FMultiplayServerEventRouter>();
+	EventRouter->Register<Multiplay::FMultiplayServerAllocateEvent>([this](const Multiplay::FMultiplayServerAllocateEvent& Event) { OnAllocateEvent(Event); });
+	EventRouter->Register<Multiplay::FMultiplayServerDeallocateEvent>([this](const Multiplay::FMultiplayServerDeallocateEvent& Event) { OnDeallocateEvent(Event); });
+
+	WarmStandby = MakeShared<Multiplay::FMultiplayWarmStandby>([this](double WarmSeconds)
+		{
+			MULTIPLAY_LOG(LogMultiplayGameServerSDK, Log, TEXT("Standby tasks completed after %.3f seconds."), WarmSeconds);
+			OnStandbyHot.Broadcast(static_cast<float>(WarmSeconds));
+		});
+
+	// A prefetched token is kept in the token cache so that it is never served past its expiry.
+	if (Settings->bCachePayloadToken || Settings->bPrefetchPayloadOnAllocate)
+	{
+		PayloadTokenCache = MakeShared<Multiplay::FMultiplayPayloadTokenCache>(RpcTransport, Settings->PayloadTokenExpiryMarginSeconds, Settings->PayloadTokenRefreshAheadSeconds);
+	}
+
+	if (Settings->bPrefetchPayloadOnAllocate)
+	{
+		PayloadCache = MakeShared<Multiplay::FMultiplayPayloadCache>(RpcTransport, PayloadTokenCache);
+	}
+
+	StreamRecovery = MakeUnique<Multiplay::FMultiplayStreamRecovery>(GetServerChannel(), GetCheckpointPath());
+
+	OpenLogSink();
+
+	GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>()->OnServerConfigChanged().AddUObject(this, &UMultiplayGameServerSubsystem::OnServerConfigChanged);
+}
 
-	GameServerApi = MakeUnique<Multiplay::OpenAPIGameServerApi>();
-	GameServerApi->SetURL(SdkDaemonUrl);
+void UMultiplayGameServerSubsystem::OpenLogSink()
+{
+	const UMultiplayGameServerSettings* Settings = GetDefault<UMultiplayGameServerSettings>();
+	const FMultiplayServerConfig& ServerConfig = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>()->GetServerConfig();
 
-	PayloadApi = MakeUnique<Multiplay::OpenAPIPayloadApi>();
-	PayloadApi->SetURL(SdkDaemonUrl);
+	if (Settings->bEnableLogSink)
+	{
+		ELogVerbosity::Type LogSinkVerbosity = ParseLogVerbosityFromString(Settings->LogSinkVerbosity);
+		if (LogSinkVerbosity == ELogVerbosity::NoLogging)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Unrecognized SDK log sink verbosity '%s', using Log."), *Settings->LogSinkVerbosity);
+			LogSinkVerbosity = ELogVerbosity::Log;
+		}
 
-	CentrifugeClient = MakeUnique<Multiplay::FCentrifugeClient>(SdkDaemonCentrifugeEndpoint);
-	CentrifugeClient->OnConnectReply().AddUObject(this, &UMultiplayGameServerSubsystem::OnConnectReply);
-	CentrifugeClient->OnPublicationPush().AddUObject(this, &UMultiplayGameServerSubsystem::OnPublicationPush);
+		if (ServerConfig.ServerLogDirectory.IsEmpty())
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("The SDK log sink is enabled but there is no server log directory, logging through UE_LOG."));
+		}
+		else
+		{
+			// The sink is process-wide, with a shared core the game instances share it until the last of them closes it.
+			bLogSinkOpened = Multiplay::FMultiplayLogSink::Get().Open(ServerConfig.ServerLogDirectory, LogSinkVerbosity, Settings->LogSinkMaxFileBytes, Settings->LogSinkMaxFiles, Settings->LogSinkCapacity);
+		}
+	}
 }
 
 void UMultiplayGameServerSubsystem::Deinitialize()
 {
-	CentrifugeClient->Disconnect();
-	CentrifugeClient->OnConnectReply().RemoveAll(this);
-	CentrifugeClient->OnPublicationPush().RemoveAll(this);
+	if (UMultiplayServerConfigSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>())
+	{
+		Subsystem->OnServerConfigChanged().RemoveAll(this);
+	}
+
+	ReadinessReconciler.Reset();
+	WarmStandby.Reset();
+	StandbyStreamableManager.Reset();
+	PayloadCache.Reset();
+	PayloadTokenCache.Reset();
+	RpcTransport.Reset();
+
+	// A shared core stays connected for the other game instances, an owned one disconnects as it is destroyed.
+	UnsubscribeToServerEvents();
+	SdkCore.Reset();
+
+	if (bLogSinkOpened)
+	{
+		Multiplay::FMultiplayLogSink::Get().Close();
+		bLogSinkOpened = false;
+	}
 
 	Super::Deinitialize();
 }
@@ -58,87 +168,255 @@ bool UMultiplayGameServerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 	return true;
 }
 
-void UMultiplayGameServerSubsystem::OnConnectReply(const Multiplay::FConnectResult& Result)
+void UMultiplayGameServerSubsystem::OnSubscribeReply(const Multiplay::FSubscribeResult& Result)
 {
-	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::OnConnectReply()"));
+	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::OnSubscribeReply()"));
 
-	UMultiplayServerConfigSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>();
-	const FMultiplayServerConfig& ServerConfig = Subsystem->GetServerConfig();
-	int64 ServerId = ServerConfig.ServerId;
+	Multiplay::FHistoryRequest Request;
+	TArray<Multiplay::FPublication> Publications;
+	if (StreamRecovery->BeginCatchUp(Result, Request, Publications))
+	{
+		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Requesting publications missed on %s since offset %llu."), *Request.Channel, Request.Since.Offset);
+
+		SdkCore->GetClient().History(Request);
+	}
+
+	// Publications held back by a catch-up that the previous connection left unfinished.
+	for (const Multiplay::FPublication& Publication : Publications)
+	{
+		ConsumePublication(Publication);
+	}
+}
+
+void UMultiplayGameServerSubsystem::OnHistoryReply(const Multiplay::FHistoryResult& Result)
+{
+	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::OnHistoryReply()"));
+
+	if (!StreamRecovery->IsCatchingUp())
+	{
+		return;
+	}
+
+	TArray<Multiplay::FPublication> Publications;
+	Multiplay::FHistoryRequest Request;
+	if (StreamRecovery->CompleteCatchUp(Result, Publications, Request))
+	{
+		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Requesting the next page of publications missed on %s since offset %llu."), *Request.Channel, Request.Since.Offset);
+
+		SdkCore->GetClient().History(Request);
+	}
+
+	for (const Multiplay::FPublication& Publication : Publications)
+	{
+		ConsumePublication(Publication);
+	}
+}
+
+void UMultiplayGameServerSubsystem::OnErrorReply(Multiplay::EMethodType Method, const Multiplay::FError& Error)
+{
+	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::OnErrorReply()"));
 
-	Multiplay::FSubscribeRequest request = Multiplay::FSubscribeRequest();
-	request.Channel = FString::Printf(TEXT("server#%lld"), ServerId);
-	CentrifugeClient->Subscribe(request);
+	if (Method == Multiplay::EMethodType::History && StreamRecovery->IsCatchingUp())
+	{
+		UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to recover missed publications: %d - %s"), Error.Code, *Error.Message);
+
+		TArray<Multiplay::FPublication> Publications;
+		StreamRecovery->AbortCatchUp(Publications);
+
+		for (const Multiplay::FPublication& Publication : Publications)
+		{
+			ConsumePublication(Publication);
+		}
+	}
 }
 
 void UMultiplayGameServerSubsystem::OnPublicationPush(const Multiplay::FPublication& Push)
 {
-	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::OnPublicationPush()"));
+	MULTIPLAY_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::OnPublicationPush()"));
+
+	if (StreamRecovery->ShouldConsume(Push))
+	{
+		ConsumePublication(Push);
+	}
+}
+
+void UMultiplayGameServerSubsystem::ConsumePublication(const Multiplay::FPublication& Publication)
+{
+	FString EventType;
+	switch (EventRouter->Route(Publication.Data, EventType))
+	{
+	case Multiplay::FMultiplayServerEventRouter::ERouteResult::Handled:
+		break;
+	case Multiplay::FMultiplayServerEventRouter::ERouteResult::Unhandled:
+		UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Ignoring PUSH message with unhandled event type '%s'."), *EventType);
+		break;
+	case Multiplay::FMultiplayServerEventRouter::ERouteResult::Invalid:
+		UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to parse PUSH message into a '%s' event!"), *EventType);
+		break;
+	default:
+		UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to parse PUSH message into an event!"));
+		break;
+	}
+
+	// The checkpoint advances after the event has been handled, a crash inside a handler replays the event on restart.
+	StreamRecovery->Commit(Publication);
+}
+
+void UMultiplayGameServerSubsystem::OnAllocateEvent(const Multiplay::FMultiplayServerAllocateEvent& AllocateEvent)
+{
+	const double ParsedSeconds = FPlatformTime::Seconds();
 
-	Multiplay::FMultiplayServerAllocateEvent AllocateEvent;
-	Multiplay::FMultiplayServerDeallocateEvent DeallocateEvent;
+	MULTIPLAY_LOG(LogMultiplayGameServerSDK, Log, TEXT("Successfully parsed FMultiplayServerAllocateEvent"));
 
-	if (AllocateEvent.FromJson(Push.Data))
+	// A redelivered event would start the game's allocation handling again.
+	if (!EventIdFilter->Admit(AllocateEvent.EventId))
 	{
-		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Successfully parsed FMultiplayServerAllocateEvent"));
+		MULTIPLAY_LOG(LogMultiplayGameServerSDK, Log, TEXT("Dropping FMultiplayServerAllocateEvent %s, it has already been broadcast."), *AllocateEvent.EventId.ToString());
+		return;
+	}
 
-		AllocationId = AllocateEvent.AllocationId;
+	AllocationId = AllocateEvent.AllocationId;
 
-		FMultiplayAllocation MultiplayAllocation;
-		MultiplayAllocation.EventId = AllocateEvent.EventId.ToString();
-		MultiplayAllocation.ServerId = AllocateEvent.ServerId;
-		MultiplayAllocation.AllocationId = AllocateEvent.AllocationId.ToString();
+	AllocationTimeline->Begin(AllocationId, SdkCore->GetClient().GetMessageReceivedSeconds());
+	AllocationTimeline->Mark(AllocationId, Multiplay::FMultiplayAllocationTimelineRecorder::EStage::EventParsed, ParsedSeconds);
 
-		OnAllocate.Broadcast(MultiplayAllocation);
+	// The daemon resets the readiness of a new allocation, so a later declaration must be sent even if it matches.
+	if (ReadinessReconciler.IsValid())
+	{
+		ReadinessReconciler->Invalidate();
 	}
-	else if (DeallocateEvent.FromJson(Push.Data))
+
+	// The requests are started before OnAllocate so that they are in flight while the game handles the allocation.
+	if (PayloadCache.IsValid())
 	{
-		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Successfully parsed FMultiplayServerDeallocateEvent"));
+		PayloadCache->Prefetch(AllocationId);
+	}
 
-		AllocationId.Invalidate();
+	FMultiplayAllocation MultiplayAllocation;
+	MultiplayAllocation.EventId = AllocateEvent.EventId.ToString();
+	MultiplayAllocation.ServerId = AllocateEvent.ServerId;
+	MultiplayAllocation.AllocationId = AllocateEvent.AllocationId.ToString();
 
-		FMultiplayDeallocation MultiplayDeallocation;
-		MultiplayDeallocation.EventId = DeallocateEvent.EventId.ToString();
-		MultiplayDeallocation.ServerId = DeallocateEvent.ServerId;
-		MultiplayDeallocation.AllocationId = DeallocateEvent.AllocationId.ToString();
+	WarmStandby->SetAllocated(true);
 
-		OnDeallocate.Broadcast(MultiplayDeallocation);
+	AllocationTimeline->Mark(AllocationId, Multiplay::FMultiplayAllocationTimelineRecorder::EStage::AllocateBroadcast, FPlatformTime::Seconds());
+
+	OnAllocate.Broadcast(MultiplayAllocation);
+}
+
+void UMultiplayGameServerSubsystem::OnDeallocateEvent(const Multiplay::FMultiplayServerDeallocateEvent& DeallocateEvent)
+{
+	MULTIPLAY_LOG(LogMultiplayGameServerSDK, Log, TEXT("Successfully parsed FMultiplayServerDeallocateEvent"));
+
+	if (!EventIdFilter->Admit(DeallocateEvent.EventId))
+	{
+		MULTIPLAY_LOG(LogMultiplayGameServerSDK, Log, TEXT("Dropping FMultiplayServerDeallocateEvent %s, it has already been broadcast."), *DeallocateEvent.EventId.ToString());
+		return;
 	}
-	else
+
+	if (PayloadCache.IsValid())
 	{
-		UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to parse PUSH message into an event!"));
+		PayloadCache->Invalidate(DeallocateEvent.AllocationId);
+	}
+
+	AllocationTimeline->Abandon(DeallocateEvent.AllocationId);
+
+	AllocationId.Invalidate();
+
+	if (ReadinessReconciler.IsValid())
+	{
+		ReadinessReconciler->Invalidate();
 	}
+
+	FMultiplayDeallocation MultiplayDeallocation;
+	MultiplayDeallocation.EventId = DeallocateEvent.EventId.ToString();
+	MultiplayDeallocation.ServerId = DeallocateEvent.ServerId;
+	MultiplayDeallocation.AllocationId = DeallocateEvent.AllocationId.ToString();
+
+	OnDeallocate.Broadcast(MultiplayDeallocation);
+
+	// Started after OnDeallocate, so that the tasks find what the game released while handling it.
+	WarmStandby->SetAllocated(false);
+	WarmStandby->Warm();
 }
 
-void UMultiplayGameServerSubsystem::ReadyServerForPlayers(FReadyServerSuccessDelegate OnSuccess, FReadyServerFailureDelegate OnFailure)
+bool UMultiplayGameServerSubsystem::RegisterServerEventHandler(const FString& EventType, TFunction<void(const TSharedRef<FJsonObject>&)> Handler)
 {
-	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::ReadyServerForPlayers()"));
+	if (EventType.Equals(Multiplay::FMultiplayServerAllocateEvent::kEventType) || EventType.Equals(Multiplay::FMultiplayServerDeallocateEvent::kEventType))
+	{
+		UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Cannot register a handler for '%s' events, they are handled by the SDK."), *EventType);
+		return false;
+	}
 
-	OnReadyServerSuccess = OnSuccess;
-	OnReadyServerFailure = OnFailure;
+	EventRouter->Register(EventType, [Handler = MoveTemp(Handler)](const TSharedPtr<FJsonValue>& Data)
+		{
+			// The router only passes on objects.
+			Handler(Data->AsObject().ToSharedRef());
+			return true;
+		});
 
-	if (AllocationId.IsValid()) 
+	return true;
+}
+
+void UMultiplayGameServerSubsystem::UnregisterServerEventHandler(const FString& EventType)
+{
+	if (!EventType.Equals(Multiplay::FMultiplayServerAllocateEvent::kEventType) && !EventType.Equals(Multiplay::FMultiplayServerDeallocateEvent::kEventType))
 	{
-        UMultiplayServerConfigSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>();
-        const FMultiplayServerConfig& ServerConfig = Subsystem->GetServerConfig();
-        int64 ServerId = ServerConfig.ServerId;
+		EventRouter->Unregister(EventType);
+	}
+}
 
-		Multiplay::ReadyServerRequest Request;
-		Request.ServerId = ServerId;
-		Request.AllocationId = AllocationId;
+FString UMultiplayGameServerSubsystem::GetServerChannel() const
+{
+	UMultiplayServerConfigSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>();
+	const FMultiplayServerConfig& ServerConfig = Subsystem->GetServerConfig();
+	int64 ServerId = ServerConfig.ServerId;
 
-		Multiplay::FReadyServerDelegate Delegate =
-			Multiplay::FReadyServerDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnReadyServer);
+	return FString::Printf(TEXT("server#%lld"), ServerId);
+}
+
+FString UMultiplayGameServerSubsystem::GetCheckpointPath() const
+{
+	// The position of the last consumed publication is persisted alongside the server logs so that it survives a process restart.
+	const FMultiplayServerConfig& ServerConfig = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>()->GetServerConfig();
+	if (ServerConfig.ServerLogDirectory.IsEmpty())
+	{
+		return FString();
+	}
+
+	return FPaths::Combine(ServerConfig.ServerLogDirectory, Multiplay::FMultiplayStreamCheckpoint::kFileName);
+}
+
+void UMultiplayGameServerSubsystem::ReadyServerForPlayers(FReadyServerSuccessDelegate OnSuccess, FReadyServerFailureDelegate OnFailure)
+{
+	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::ReadyServerForPlayers()"));
 
-		GameServerApi->ReadyServer(Request, Delegate);
+	if (AllocationId.IsValid()) 
+	{
+		AllocationTimeline->Mark(AllocationId, Multiplay::FMultiplayAllocationTimelineRecorder::EStage::ReadyRequested, FPlatformTime::Seconds());
+
+		TWeakObjectPtr<UMultiplayGameServerSubsystem> WeakThis(this);
+		const FGuid ReadyAllocationId = AllocationId;
+		SetReadiness(true, [WeakThis, ReadyAllocationId, OnSuccess, OnFailure](bool bSucceeded, const FMultiplayErrorResponse& ErrorResponse)
+			{
+				if (bSucceeded)
+				{
+					if (WeakThis.IsValid())
+					{
+						WeakThis->OnReadyAcknowledged(ReadyAllocationId);
+					}
+
+					OnSuccess.ExecuteIfBound();
+				}
+				else
+				{
+					OnFailure.ExecuteIfBound(ErrorResponse);
+				}
+			});
 	}
 	else
 	{
-		FMultiplayErrorResponse InvalidAllocationResponse;
-		InvalidAllocationResponse.Title = TEXT("Invalid Allocation ID");
-		InvalidAllocationResponse.Detail = TEXT("Attempted invoke ReadyServerForPlayers() with an invalid allocation ID.");
-		InvalidAllocationResponse.Status = 400;
-		OnReadyServerFailure.Execute(InvalidAllocationResponse);
+		OnFailure.ExecuteIfBound(MakeInvalidAllocationResponse());
 	}
 }
 
@@ -146,100 +424,230 @@ void UMultiplayGameServerSubsystem::UnreadyServer(FUnreadyServerSuccessDelegate
 {
 	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::UnreadyServer()"));
 
-	OnUnreadyServerSuccess = OnSuccess;
-	OnUnreadyServerFailure = OnFailure;
+	SetReadiness(false, [OnSuccess, OnFailure](bool bSucceeded, const FMultiplayErrorResponse& ErrorResponse)
+		{
+			if (bSucceeded)
+			{
+				OnSuccess.ExecuteIfBound();
+			}
+			else
+			{
+				OnFailure.ExecuteIfBound(ErrorResponse);
+			}
+		});
+}
+
+void UMultiplayGameServerSubsystem::SetReadiness(bool bReady, TFunction<void(bool, const FMultiplayErrorResponse&)> OnComplete)
+{
+	if (ReadinessReconciler.IsValid())
+	{
+		ReadinessReconciler->SetDesired(bReady, MoveTemp(OnComplete));
+	}
+	else
+	{
+		SendReadiness(bReady, MoveTemp(OnComplete));
+	}
+}
 
+void UMultiplayGameServerSubsystem::SendReadiness(bool bReady, TFunction<void(bool, const FMultiplayErrorResponse&)> OnComplete)
+{
     UMultiplayServerConfigSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>();
     const FMultiplayServerConfig& ServerConfig = Subsystem->GetServerConfig();
     int64 ServerId = ServerConfig.ServerId;
 
-	Multiplay::UnreadyServerRequest Request;
-	Request.ServerId = ServerId;
+	if (bReady)
+	{
+		// The server may have been deallocated while the declaration waited for an earlier request.
+		if (!AllocationId.IsValid())
+		{
+			OnComplete(false, MakeInvalidAllocationResponse());
+			return;
+		}
+
+		Multiplay::ReadyServerRequest Request;
+		Request.ServerId = ServerId;
+		Request.AllocationId = AllocationId;
+
+		Multiplay::FReadyServerDelegate Delegate =
+			Multiplay::FReadyServerDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnReadyServer, MoveTemp(OnComplete));
+
+		RpcTransport->ReadyServer(Request, Delegate);
+	}
+	else
+	{
+		Multiplay::UnreadyServerRequest Request;
+		Request.ServerId = ServerId;
 
-	Multiplay::FUnreadyServerDelegate Delegate =
-		Multiplay::FUnreadyServerDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnUnreadyServer);
+		Multiplay::FUnreadyServerDelegate Delegate =
+			Multiplay::FUnreadyServerDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnUnreadyServer, MoveTemp(OnComplete));
 
-	GameServerApi->UnreadyServer(Request, Delegate);
+		RpcTransport->UnreadyServer(Request, Delegate);
+	}
 }
 
 void UMultiplayGameServerSubsystem::SubscribeToServerEvents()
 {
 	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::SubscribeToServerEvents()"));
 
-	Multiplay::FConnectRequest Request;
-	CentrifugeClient->Connect(Request);
+	SubscribedChannel = GetServerChannel();
+
+	// The core passes on only the replies and publications for this server's channel.
+	Multiplay::FMultiplaySdkCore::FChannelHandlers Handlers;
+	Handlers.OnSubscribed = [this](const Multiplay::FSubscribeResult& Result) { OnSubscribeReply(Result); };
+	Handlers.OnHistory = [this](const Multiplay::FHistoryResult& Result) { OnHistoryReply(Result); };
+	Handlers.OnError = [this](Multiplay::EMethodType Method, const Multiplay::FError& Error) { OnErrorReply(Method, Error); };
+	Handlers.OnPublication = [this](const Multiplay::FPublication& Push) { OnPublicationPush(Push); };
+	SdkCore->Subscribe(SubscribedChannel, MoveTemp(Handlers));
 }
 
 void UMultiplayGameServerSubsystem::UnsubscribeToServerEvents()
 {
 	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::UnsubscribeToServerEvents()"));
 
-	CentrifugeClient->Disconnect();
+	if (!SubscribedChannel.IsEmpty())
+	{
+		SdkCore->Unsubscribe(SubscribedChannel);
+		SubscribedChannel.Empty();
+	}
 }
 
 void UMultiplayGameServerSubsystem::GetPayloadAllocation(FPayloadAllocationSuccessDelegate OnSuccess, FPayloadAllocationFailureDelegate OnFailure)
 {
 	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::GetPayloadAllocation()"));
 
-	OnPayloadAllocationSuccess = OnSuccess;
-	OnPayloadAllocationFailure = OnFailure;
+	GetPayloadAllocationBuffer(FPayloadAllocationBufferDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnPayloadAllocation, OnSuccess, OnFailure));
+}
+
+void UMultiplayGameServerSubsystem::GetPayloadAllocationBuffer(FPayloadAllocationBufferDelegate OnComplete)
+{
+	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::GetPayloadAllocationBuffer()"));
 
 	Multiplay::PayloadAllocationRequest Request;
 	Request.AllocationId = AllocationId;
 
+	AllocationTimeline->Mark(AllocationId, Multiplay::FMultiplayAllocationTimelineRecorder::EStage::PayloadRequested, FPlatformTime::Seconds());
+
 	Multiplay::FPayloadAllocationDelegate Delegate =
-		Multiplay::FPayloadAllocationDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnPayloadAllocation);
+		Multiplay::FPayloadAllocationDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnPayloadAllocationBuffer, OnComplete, AllocationId);
 
-	PayloadApi->PayloadAllocation(Request, Delegate);
+	if (PayloadCache.IsValid() && AllocationId.IsValid())
+	{
+		PayloadCache->PayloadAllocation(AllocationId, Delegate);
+	}
+	else
+	{
+		RpcTransport->PayloadAllocation(Request, Delegate);
+	}
 }
 
 void UMultiplayGameServerSubsystem::GetPayloadToken(FPayloadTokenSuccessDelegate OnSuccess, FPayloadTokenFailureDelegate OnFailure)
 {
 	UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("UMultiplayGameServerSubsystem::GetPayloadToken()"));
 
-	OnPayloadTokenSuccess = OnSuccess;
-	OnPayloadTokenFailure = OnFailure;
-
 	Multiplay::PayloadTokenRequest Request;
 
 	Multiplay::FPayloadTokenDelegate Delegate =
-		Multiplay::FPayloadTokenDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnPayloadToken);
+		Multiplay::FPayloadTokenDelegate::CreateUObject(this, &UMultiplayGameServerSubsystem::OnPayloadToken, OnSuccess, OnFailure);
+
+	if (PayloadTokenCache.IsValid())
+	{
+		PayloadTokenCache->PayloadToken(Delegate);
+	}
+	else
+	{
+		RpcTransport->PayloadToken(Request, Delegate);
+	}
+}
+
+FMultiplayPingStats UMultiplayGameServerSubsystem::GetPingStats() const
+{
+	FMultiplayPingStats Stats;
+
+	for (double UpperBoundMs : Multiplay::FCentrifugeRttHistogram::kBucketUpperBoundsMs)
+	{
+		Stats.BucketUpperBoundsMs.Add(UpperBoundMs);
+	}
+
+	Stats.BucketCounts.SetNumZeroed(Multiplay::FCentrifugeRttHistogram::kNumBuckets);
+
+	const Multiplay::FCentrifugeKeepalive* CentrifugeKeepalive = SdkCore.IsValid() ? SdkCore->GetKeepalive() : nullptr;
+	if (CentrifugeKeepalive != nullptr)
+	{
+		const Multiplay::FCentrifugeRttHistogram& Histogram = CentrifugeKeepalive->GetHistogram();
+
+		Stats.PingsSent = CentrifugeKeepalive->GetPingsSent();
+		Stats.PongsReceived = CentrifugeKeepalive->GetPongsReceived();
+		Stats.MissedPongs = CentrifugeKeepalive->GetMissedPongs();
+		Stats.Reconnects = CentrifugeKeepalive->GetReconnects();
+		Stats.LastRttMs = CentrifugeKeepalive->GetLastRttMs();
+		Stats.MinRttMs = Histogram.GetMinMs();
+		Stats.MeanRttMs = Histogram.GetMeanMs();
+		Stats.MaxRttMs = Histogram.GetMaxMs();
+		Stats.P99RttMs = Histogram.GetPercentileMs(99.0);
+
+		for (int32 Index = 0; Index < Multiplay::FCentrifugeRttHistogram::kNumBuckets; ++Index)
+		{
+			Stats.BucketCounts[Index] = Histogram.GetBucketCounts()[Index];
+		}
+	}
+
+	return Stats;
+}
 
-	PayloadApi->PayloadToken(Request, Delegate);
+FMultiplayConnectionStats UMultiplayGameServerSubsystem::GetConnectionStats() const
+{
+	return SdkCore.IsValid() && SdkCore->GetConnectionWarmer().IsValid() ? SdkCore->GetConnectionWarmer()->GetStats() : FMultiplayConnectionStats();
+}
+
+FMultiplayEventStats UMultiplayGameServerSubsystem::GetEventStats() const
+{
+	FMultiplayEventStats Stats;
+
+	if (EventIdFilter.IsValid())
+	{
+		Stats.UniqueEvents = EventIdFilter->GetMissCount();
+		Stats.DuplicateEvents = EventIdFilter->GetHitCount();
+	}
+
+	return Stats;
+}
+
+FMultiplayAllocationTimeline UMultiplayGameServerSubsystem::GetLastAllocationTimeline() const
+{
+	return AllocationTimeline.IsValid() ? AllocationTimeline->GetLast() : FMultiplayAllocationTimeline();
+}
+
+FMultiplayAllocationTimelineStats UMultiplayGameServerSubsystem::GetAllocationTimelineStats() const
+{
+	return AllocationTimeline.IsValid() ? AllocationTimeline->GetStats() : FMultiplayAllocationTimelineStats();
 }
 
-void UMultiplayGameServerSubsystem::OnReadyServer(const Multiplay::ReadyServerResponse& Response)
+void UMultiplayGameServerSubsystem::OnReadyServer(const Multiplay::ReadyServerResponse& Response, TFunction<void(bool, const FMultiplayErrorResponse&)> OnComplete)
 {
 	if (Response.IsSuccessful())
 	{
 		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("ServerReady() was successful"));
-		OnReadyServerSuccess.ExecuteIfBound();
+		OnComplete(true, FMultiplayErrorResponse());
 	}
 	else
 	{
-		const FHttpResponsePtr& HttpResponse = Response.GetHttpResponse();
-		int32 ResponseCode = HttpResponse->GetResponseCode();
-		FString ResponseBody = HttpResponse->GetContentAsString();
-		TSharedPtr<FJsonValue> JsonParsed;
-		TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ResponseBody);
-		
+		int32 ResponseCode = Response.GetHttpResponseCode();
+		const FString& ResponseBody = Response.GetResponseContent();
+
 		FMultiplayErrorResponse MultiplayErrorResponseBodyStruct = {};
 
-		if (FJsonSerializer::Deserialize(JsonReader, JsonParsed) && JsonParsed.IsValid())
+		// The body was decoded into ErrorContent when the response was received.
+		if (Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::Decoded)
 		{
-			TUniquePtr<Multiplay::OpenAPIErrorResponseBody> ErrorResponseBody = MakeUnique<Multiplay::OpenAPIErrorResponseBody>();
-			if (ErrorResponseBody->FromJson(JsonParsed)) 
-			{
-				MultiplayErrorResponseBodyStruct.Status = ErrorResponseBody->Status;
-				MultiplayErrorResponseBodyStruct.Detail = ErrorResponseBody->Detail;
-				MultiplayErrorResponseBodyStruct.Title = ErrorResponseBody->Title;
-			}
-			else 
-			{
-				MultiplayErrorResponseBodyStruct.Status = 500;
-				MultiplayErrorResponseBodyStruct.Detail = TEXT("Failed to parse ReadyServer JSON response body on failure");
-				MultiplayErrorResponseBodyStruct.Title = TEXT("Parsing failed error");
-			}
+			MultiplayErrorResponseBodyStruct.Status = Response.ErrorContent.Status;
+			MultiplayErrorResponseBodyStruct.Detail = Response.ErrorContent.Detail;
+			MultiplayErrorResponseBodyStruct.Title = Response.ErrorContent.Title;
+		}
+		else if (Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::InvalidModel)
+		{
+			MultiplayErrorResponseBodyStruct.Status = 500;
+			MultiplayErrorResponseBodyStruct.Detail = TEXT("Failed to parse ReadyServer JSON response body on failure");
+			MultiplayErrorResponseBodyStruct.Title = TEXT("Parsing failed error");
 		}
 		else
 		{
@@ -250,43 +658,36 @@ void UMultiplayGameServerSubsystem::OnReadyServer(const Multiplay::ReadyServerRe
 
 		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("ServerReady() was unsuccessful, response status code is '%d' and response body is '%s'"), ResponseCode, *ResponseBody);
 
-		OnReadyServerFailure.ExecuteIfBound(MultiplayErrorResponseBodyStruct);
+		OnComplete(false, MultiplayErrorResponseBodyStruct);
 	}
 }
 
-void UMultiplayGameServerSubsystem::OnUnreadyServer(const Multiplay::UnreadyServerResponse& Response)
+void UMultiplayGameServerSubsystem::OnUnreadyServer(const Multiplay::UnreadyServerResponse& Response, TFunction<void(bool, const FMultiplayErrorResponse&)> OnComplete)
 {
 	if (Response.IsSuccessful())
 	{
 		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("ServerUnready() was successful"));
 
-		OnUnreadyServerSuccess.ExecuteIfBound();
+		OnComplete(true, FMultiplayErrorResponse());
 	}
 	else
 	{
-		const FHttpResponsePtr& HttpResponse = Response.GetHttpResponse();
-		int32 ResponseCode = HttpResponse->GetResponseCode();
-		FString ResponseBody = HttpResponse->GetContentAsString();
-		TSharedPtr<FJsonValue> JsonParsed;
-		TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ResponseBody);
+		int32 ResponseCode = Response.GetHttpResponseCode();
+		const FString& ResponseBody = Response.GetResponseContent();
 
 		FMultiplayErrorResponse MultiplayErrorResponseBodyStruct = {};
 
-		if (FJsonSerializer::Deserialize(JsonReader, JsonParsed) && JsonParsed.IsValid())
+		if (Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::Decoded)
 		{
-			TUniquePtr<Multiplay::OpenAPIErrorResponseBody> ErrorResponseBody = MakeUnique<Multiplay::OpenAPIErrorResponseBody>();
-			if (ErrorResponseBody->FromJson(JsonParsed))
-			{
-				MultiplayErrorResponseBodyStruct.Status = ErrorResponseBody->Status;
-				MultiplayErrorResponseBodyStruct.Detail = ErrorResponseBody->Detail;
-				MultiplayErrorResponseBodyStruct.Title = ErrorResponseBody->Title;
-			}
-			else
-			{
-				MultiplayErrorResponseBodyStruct.Status = 500;
-				MultiplayErrorResponseBodyStruct.Detail = TEXT("Failed to parse ReadyServer JSON response body on failure");
-				MultiplayErrorResponseBodyStruct.Title = TEXT("Parsing failed error");
-			}
+			MultiplayErrorResponseBodyStruct.Status = Response.ErrorContent.Status;
+			MultiplayErrorResponseBodyStruct.Detail = Response.ErrorContent.Detail;
+			MultiplayErrorResponseBodyStruct.Title = Response.ErrorContent.Title;
+		}
+		else if (Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::InvalidModel)
+		{
+			MultiplayErrorResponseBodyStruct.Status = 500;
+			MultiplayErrorResponseBodyStruct.Detail = TEXT("Failed to parse ReadyServer JSON response body on failure");
+			MultiplayErrorResponseBodyStruct.Title = TEXT("Parsing failed error");
 		}
 		else
 		{
@@ -297,48 +698,231 @@ void UMultiplayGameServerSubsystem::OnUnreadyServer(const Multiplay::UnreadyServ
 
 		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("OnUnreadyServer() was unsuccessful, response status code is '%d' and response body is '%s'"), ResponseCode, *ResponseBody);
 
-		OnUnreadyServerFailure.ExecuteIfBound(MultiplayErrorResponseBodyStruct);
+		OnComplete(false, MultiplayErrorResponseBodyStruct);
+	}
+}
+
+void UMultiplayGameServerSubsystem::AddStandbyTask(FName Name, TFunction<void(TFunction<void()>)> Task)
+{
+	WarmStandby->AddTask(Name, MoveTemp(Task));
+}
+
+void UMultiplayGameServerSubsystem::AddStandbyAssets(FName Name, const TArray<FSoftObjectPath>& Assets)
+{
+	if (!StandbyStreamableManager.IsValid())
+	{
+		StandbyStreamableManager = MakeUnique<FStreamableManager>();
+	}
+
+	// The handle keeps the assets loaded between allocations, so running the task again finds nothing left to load.
+	FStreamableManager* StreamableManager = StandbyStreamableManager.Get();
+	TSharedRef<TSharedPtr<FStreamableHandle>> Handle = MakeShared<TSharedPtr<FStreamableHandle>>();
+	AddStandbyTask(Name, [StreamableManager, Assets, Handle](TFunction<void()> Done)
+		{
+			if (Handle->IsValid() && (*Handle)->HasLoadCompleted())
+			{
+				Done();
+				return;
+			}
+
+			*Handle = StreamableManager->RequestAsyncLoad(Assets, [Done]() { Done(); }, FStreamableManager::AsyncLoadHighPriority);
+
+			// No handle is returned when there is nothing to load.
+			if (!Handle->IsValid())
+			{
+				Done();
+			}
+		});
+}
+
+void UMultiplayGameServerSubsystem::WhenStandbyHot(TFunction<void()> OnHot)
+{
+	WarmStandby->WhenHot(MoveTemp(OnHot));
+}
+
+EMultiplayStandbyState UMultiplayGameServerSubsystem::GetStandbyState() const
+{
+	return WarmStandby.IsValid() ? WarmStandby->GetState() : EMultiplayStandbyState::Cold;
+}
+
+FMultiplayServerInstanceState UMultiplayGameServerSubsystem::GetInstanceState() const
+{
+	FMultiplayServerInstanceState State;
+
+	UMultiplayServerConfigSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>();
+	State.ServerId = Subsystem->GetServerConfig().ServerId;
+	State.ServerChannel = SubscribedChannel;
+	State.AllocationId = AllocationId.IsValid() ? AllocationId.ToString() : FString();
+	State.StandbyState = GetStandbyState();
+
+	if (SdkCore.IsValid())
+	{
+		State.bSubscribed = !SubscribedChannel.IsEmpty() && SdkCore->IsSubscribed(SubscribedChannel);
+		State.bSharedCore = SdkCore->IsShared();
+		State.CoreServers = SdkCore->GetChannelCount();
+	}
+
+	return State;
+}
+
+void UMultiplayGameServerSubsystem::RecycleServer()
+{
+	UMultiplayServerConfigSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>();
+	const FMultiplayServerConfig PreviousConfig = Subsystem->GetServerConfig();
+
+	{
+		TGuardValue<bool> RecyclingGuard(bRecycling, true);
+		Subsystem->ReloadServerConfig();
 	}
+
+	Recycle(PreviousConfig);
 }
 
-void UMultiplayGameServerSubsystem::OnPayloadAllocation(const Multiplay::PayloadAllocationResponse& Response)
+void UMultiplayGameServerSubsystem::OnServerConfigChanged(const FMultiplayServerConfig& PreviousConfig, const FMultiplayServerConfig& ServerConfig)
+{
+	// The agent also rewrites server.json on allocation, only a server ID or log directory of its own starts another server.
+	if (!bRecycling && (PreviousConfig.ServerId != ServerConfig.ServerId || PreviousConfig.ServerLogDirectory != ServerConfig.ServerLogDirectory))
+	{
+		Recycle(PreviousConfig);
+	}
+}
+
+void UMultiplayGameServerSubsystem::Recycle(const FMultiplayServerConfig& PreviousConfig)
+{
+	const UMultiplayGameServerSettings* Settings = GetDefault<UMultiplayGameServerSettings>();
+	const FMultiplayServerConfig& ServerConfig = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>()->GetServerConfig();
+
+	MULTIPLAY_LOG(LogMultiplayGameServerSDK, Log, TEXT("Recycling server %lld as server %lld."), PreviousConfig.ServerId, ServerConfig.ServerId);
+
+	// The allocation is forgotten without OnDeallocate, the game is told by OnServerRecycled instead.
+	const bool bWasAllocated = AllocationId.IsValid();
+	if (bWasAllocated)
+	{
+		if (PayloadCache.IsValid())
+		{
+			PayloadCache->Invalidate(AllocationId);
+		}
+
+		AllocationTimeline->Abandon(AllocationId);
+		AllocationId.Invalidate();
+	}
+
+	if (ReadinessReconciler.IsValid())
+	{
+		ReadinessReconciler->Invalidate();
+	}
+
+	// A payload token is issued to one server, so the caches are replaced along with the server ID.
+	if (PreviousConfig.ServerId != ServerConfig.ServerId && PayloadTokenCache.IsValid())
+	{
+		PayloadTokenCache = MakeShared<Multiplay::FMultiplayPayloadTokenCache>(RpcTransport, Settings->PayloadTokenExpiryMarginSeconds, Settings->PayloadTokenRefreshAheadSeconds);
+
+		if (PayloadCache.IsValid())
+		{
+			PayloadCache = MakeShared<Multiplay::FMultiplayPayloadCache>(RpcTransport, PayloadTokenCache);
+		}
+	}
+
+	if (PreviousConfig.ServerLogDirectory != ServerConfig.ServerLogDirectory)
+	{
+		if (bLogSinkOpened)
+		{
+			Multiplay::FMultiplayLogSink::Get().Close();
+			bLogSinkOpened = false;
+		}
+
+		OpenLogSink();
+	}
+
+	if (PreviousConfig.ServerId != ServerConfig.ServerId || PreviousConfig.ServerLogDirectory != ServerConfig.ServerLogDirectory)
+	{
+		StreamRecovery = MakeUnique<Multiplay::FMultiplayStreamRecovery>(GetServerChannel(), GetCheckpointPath());
+	}
+
+	// The new channel is subscribed before the previous one is unsubscribed, so that the connection to the daemon stays open.
+	if (!SubscribedChannel.IsEmpty() && SubscribedChannel != GetServerChannel())
+	{
+		const FString PreviousChannel = SubscribedChannel;
+		SubscribeToServerEvents();
+		SdkCore->Unsubscribe(PreviousChannel);
+	}
+
+	OnServerRecycled.Broadcast(ServerConfig);
+
+	// Started after OnServerRecycled, so that the tasks find what the game released while handling it.
+	if (bWasAllocated)
+	{
+		WarmStandby->SetAllocated(false);
+		WarmStandby->Warm();
+	}
+}
+
+void UMultiplayGameServerSubsystem::OnReadyAcknowledged(const FGuid& ReadyAllocationId)
+{
+	if (!AllocationTimeline->Mark(ReadyAllocationId, Multiplay::FMultiplayAllocationTimelineRecorder::EStage::ReadyAcknowledged, FPlatformTime::Seconds()))
+	{
+		return;
+	}
+
+	const FMultiplayAllocationTimeline& Timeline = AllocationTimeline->GetLast();
+
+	MULTIPLAY_LOG(LogMultiplayGameServerSDK, Log, TEXT("Allocation %s ready after %.1fms: parsed %.1fms, broadcast %.1fms, payload requested %.1fms, payload received %.1fms, ready requested %.1fms."),
+		*Timeline.AllocationId, Timeline.ReadyAcknowledgedMs, Timeline.EventParsedMs, Timeline.AllocateBroadcastMs, Timeline.PayloadRequestedMs, Timeline.PayloadReceivedMs, Timeline.ReadyRequestedMs);
+
+	OnAllocationReady.Broadcast(Timeline);
+}
+
+void UMultiplayGameServerSubsystem::OnPayloadAllocation(FMultiplayPayloadBufferPtr Payload, const FMultiplayPayloadAllocationErrorResponse& ErrorResponse, FPayloadAllocationSuccessDelegate OnSuccess, FPayloadAllocationFailureDelegate OnFailure)
+{
+	if (Payload.IsValid())
+	{
+		OnSuccess.ExecuteIfBound(Payload->ToString());
+	}
+	else
+	{
+		OnFailure.ExecuteIfBound(ErrorResponse);
+	}
+}
+
+void UMultiplayGameServerSubsystem::OnPayloadAllocationBuffer(const Multiplay::PayloadAllocationResponse& Response, FPayloadAllocationBufferDelegate OnComplete, FGuid RequestedAllocationId)
 {
 	if (Response.IsSuccessful())
 	{
 		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("PayloadAllocation() was successful"));
-		const FHttpResponsePtr& HttpResponse = Response.GetHttpResponse();
-		FString ResponseBody = HttpResponse->GetContentAsString();
-		OnPayloadAllocationSuccess.ExecuteIfBound(ResponseBody);
+
+		// Responses always carry a payload buffer, one is made from the content in case a transport did not provide it.
+		FMultiplayPayloadBufferPtr Payload = Response.Payload;
+		if (!Payload.IsValid())
+		{
+			Payload = Multiplay::MakeStringPayloadBuffer(Response.GetResponseContent());
+		}
+
+		AllocationTimeline->Mark(RequestedAllocationId, Multiplay::FMultiplayAllocationTimelineRecorder::EStage::PayloadReceived, FPlatformTime::Seconds());
+
+		OnComplete.ExecuteIfBound(Payload, FMultiplayPayloadAllocationErrorResponse());
 	}
 	else
 	{
-		const FHttpResponsePtr& HttpResponse = Response.GetHttpResponse();
-		int32 ResponseCode = HttpResponse->GetResponseCode();
-		FString ResponseBody = HttpResponse->GetContentAsString();
-		TSharedPtr<FJsonValue> JsonParsed;
-		TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ResponseBody);
-		
+		int32 ResponseCode = Response.GetHttpResponseCode();
+		const FString& ResponseBody = Response.GetResponseContent();
+
 		FMultiplayPayloadAllocationErrorResponse MultiplayErrorResponseBodyStruct = {};
-		
-		if (FJsonSerializer::Deserialize(JsonReader, JsonParsed) && JsonParsed.IsValid())
+
+		if (Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::Decoded)
 		{
-			TUniquePtr<Multiplay::OpenAPIPayloadAllocationErrorResponseBody> ErrorResponseBody = MakeUnique<Multiplay::OpenAPIPayloadAllocationErrorResponseBody>();
-			if (ErrorResponseBody->FromJson(JsonParsed))
-			{
-				MultiplayErrorResponseBodyStruct.Error = ErrorResponseBody->Error;
-				MultiplayErrorResponseBodyStruct.ErrorCode = ErrorResponseBody->ErrorCode;
-				MultiplayErrorResponseBodyStruct.ErrorMessage = ErrorResponseBody->ErrorMessage;
-				MultiplayErrorResponseBodyStruct.Success = ErrorResponseBody->Success;
-			}
-			else
-			{
-				MultiplayErrorResponseBodyStruct.Error = true;
-				MultiplayErrorResponseBodyStruct.ErrorCode = 500;
-				MultiplayErrorResponseBodyStruct.ErrorMessage = TEXT("Failed to parse JSON response body on failure");
-				MultiplayErrorResponseBodyStruct.Success = false;
-			}
+			MultiplayErrorResponseBodyStruct.Error = Response.ErrorContent.Error;
+			MultiplayErrorResponseBodyStruct.ErrorCode = Response.ErrorContent.ErrorCode;
+			MultiplayErrorResponseBodyStruct.ErrorMessage = Response.ErrorContent.ErrorMessage;
+			MultiplayErrorResponseBodyStruct.Success = Response.ErrorContent.Success;
 		}
-		else 
+		else if (Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::InvalidModel)
+		{
+			MultiplayErrorResponseBodyStruct.Error = true;
+			MultiplayErrorResponseBodyStruct.ErrorCode = 500;
+			MultiplayErrorResponseBodyStruct.ErrorMessage = TEXT("Failed to parse JSON response body on failure");
+			MultiplayErrorResponseBodyStruct.Success = false;
+		}
+		else
 		{
 			MultiplayErrorResponseBodyStruct.Error = true;
 			MultiplayErrorResponseBodyStruct.ErrorCode = 500;
@@ -348,69 +932,55 @@ void UMultiplayGameServerSubsystem::OnPayloadAllocation(const Multiplay::Payload
 
 		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("OnPayloadAllocation() was unsuccessful, response status code is '%d' and response body is '%s'"), ResponseCode, *ResponseBody);
 
-		OnPayloadAllocationFailure.ExecuteIfBound(MultiplayErrorResponseBodyStruct);
+		OnComplete.ExecuteIfBound(nullptr, MultiplayErrorResponseBodyStruct);
 	}
 }
 
-void UMultiplayGameServerSubsystem::OnPayloadToken(const Multiplay::PayloadTokenResponse& Response)
+void UMultiplayGameServerSubsystem::OnPayloadToken(const Multiplay::PayloadTokenResponse& Response, FPayloadTokenSuccessDelegate OnSuccess, FPayloadTokenFailureDelegate OnFailure)
 {
 	FMultiplayPayloadTokenResponse MultiplayTokenResponseBodyStruct = {};
 
+	const Multiplay::EContentDecodeStatus DecodeStatus = Response.GetContentDecodeStatus();
+
 	if (Response.IsSuccessful())
 	{
 		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("PayloadToken() was successful"));
-		const FHttpResponsePtr& HttpResponse = Response.GetHttpResponse();
-		int32 ResponseCode = HttpResponse->GetResponseCode();
-		FString ResponseBody = HttpResponse->GetContentAsString();
-		TSharedPtr<FJsonValue> JsonParsed;
-		TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ResponseBody);
-		
-		if (FJsonSerializer::Deserialize(JsonReader, JsonParsed) && JsonParsed.IsValid())
+
+		if (DecodeStatus == Multiplay::EContentDecodeStatus::Decoded)
 		{
-			TUniquePtr<Multiplay::OpenAPIPayloadTokenResponseBody> PayloadTokenResponseBody = MakeUnique<Multiplay::OpenAPIPayloadTokenResponseBody>();
-			if (PayloadTokenResponseBody->FromJson(JsonParsed))
-			{
-				MultiplayTokenResponseBodyStruct.Error = PayloadTokenResponseBody->Error;
-				MultiplayTokenResponseBodyStruct.Token = PayloadTokenResponseBody->Token;
-				OnPayloadTokenSuccess.ExecuteIfBound(MultiplayTokenResponseBodyStruct);
-			}
-			else
-			{
-				MultiplayTokenResponseBodyStruct.Error = TEXT("Succeeded retrieving token but failed to parse the response");
-				MultiplayTokenResponseBodyStruct.Token = TEXT("");
-				OnPayloadTokenFailure.ExecuteIfBound(MultiplayTokenResponseBodyStruct);
-			}
+			MultiplayTokenResponseBodyStruct.Error = Response.Content.Error;
+			MultiplayTokenResponseBodyStruct.Token = Response.Content.Token;
+			OnSuccess.ExecuteIfBound(MultiplayTokenResponseBodyStruct);
 		}
-		else 
+		else if (DecodeStatus == Multiplay::EContentDecodeStatus::InvalidModel)
+		{
+			MultiplayTokenResponseBodyStruct.Error = TEXT("Succeeded retrieving token but failed to parse the response");
+			MultiplayTokenResponseBodyStruct.Token = TEXT("");
+			OnFailure.ExecuteIfBound(MultiplayTokenResponseBodyStruct);
+		}
+		else
 		{
 			MultiplayTokenResponseBodyStruct.Error = TEXT("Succeeded retrieving token but failed to deserialize the response");
 			MultiplayTokenResponseBodyStruct.Token = TEXT("");
-			OnPayloadTokenFailure.ExecuteIfBound(MultiplayTokenResponseBodyStruct);
+			OnFailure.ExecuteIfBound(MultiplayTokenResponseBodyStruct);
 		}
 	}
 	else
 	{
-		const FHttpResponsePtr& HttpResponse = Response.GetHttpResponse();
-		int32 ResponseCode = HttpResponse->GetResponseCode();
-		FString ResponseBody = HttpResponse->GetContentAsString();
-		TSharedPtr<FJsonValue> JsonParsed;
-		TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ResponseBody);
-		
-		if (FJsonSerializer::Deserialize(JsonReader, JsonParsed) && JsonParsed.IsValid())
+		int32 ResponseCode = Response.GetHttpResponseCode();
+		const FString& ResponseBody = Response.GetResponseContent();
+
+		if (DecodeStatus == Multiplay::EContentDecodeStatus::Decoded)
 		{
-			TUniquePtr<Multiplay::OpenAPIPayloadTokenResponseBody> ErrorResponseBody = MakeUnique<Multiplay::OpenAPIPayloadTokenResponseBody>();
-			if (ErrorResponseBody->FromJson(JsonParsed))
-			{
-				MultiplayTokenResponseBodyStruct.Error = ErrorResponseBody->Error;
-				MultiplayTokenResponseBodyStruct.Token = ErrorResponseBody->Token;
-			}
-			else
-			{
-				MultiplayTokenResponseBodyStruct.Error = TEXT("Failed to parse Json response body on failure");
-				MultiplayTokenResponseBodyStruct.Token = TEXT("");
-			}
+			MultiplayTokenResponseBodyStruct.Error = Response.Content.Error;
+			MultiplayTokenResponseBodyStruct.Token = Response.Content.Token;
 		}
-		else 
+		else if (DecodeStatus == Multiplay::EContentDecodeStatus::InvalidModel)
+		{
+			MultiplayTokenResponseBodyStruct.Error = TEXT("Failed to parse Json response body on failure");
+			MultiplayTokenResponseBodyStruct.Token = TEXT("");
+		}
+		else
 		{
 			MultiplayTokenResponseBodyStruct.Error = TEXT("Failed to deserialize Json response body on failure");
 			MultiplayTokenResponseBodyStruct.Token = TEXT("");
@@ -418,6 +988,6 @@ void UMultiplayGameServerSubsystem::OnPayloadToken(const Multiplay::PayloadToken
 
 		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("OnPayloadToken() was unsuccessful, response status code is '%d' and response body is '%s'"), ResponseCode, *ResponseBody);
 
-		OnPayloadTokenFailure.ExecuteIfBound(MultiplayTokenResponseBodyStruct);
+		OnFailure.ExecuteIfBound(MultiplayTokenResponseBodyStruct);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "MultiplayLogSink.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Logging/LogVerbosity.h"
+#include "Misc/Paths.h"
+#include "MultiplayGameServerSDKLog.h"
+
+namespace Multiplay
+{
+	FMultiplayLogSink& FMultiplayLogSink::Get()
+	{
+		static FMultiplayLogSink Instance;
+		return Instance;
+	}
+
+	FMultiplayLogSink::FMultiplayLogSink()
+		: Thread(nullptr)
+		, OpenCount(0)
+		, ActiveVerbosity(ELogVerbosity::NoLogging)
+		, bStopping(false)
+		, MaxFileBytes(0)
+		, MaxFiles(1)
+		, FileSize(0)
+		, StartCycles(0)
+		, ReportedDrops(0)
+	{
+	}
+
+	FMultiplayLogSink::~FMultiplayLogSink()
+	{
+		Shutdown();
+	}
+
+	bool FMultiplayLogSink::Open(const FString& InDirectory, ELogVerbosity::Type Verbosity, int64 InMaxFileBytes, int32 InMaxFiles, int32 Capacity)
+	{
+		if (Thread != nullptr)
+		{
+			if (!InDirectory.Equals(Directory))
+			{
+				UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("The SDK log sink is already open, logs for %s are written to %s."), *InDirectory, *Directory);
+			}
+
+			OpenCount += 1;
+			return true;
+		}
+
+		if (!IFileManager::Get().MakeDirectory(*InDirectory, true))
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to create the SDK log directory %s."), *InDirectory);
+			return false;
+		}
+
+		// The ring outlives the sink being closed, a thread may still be copying a message into it.
+		if (!Ring.IsValid())
+		{
+			Ring = MakeUnique<FMultiplayLogRing>(Capacity);
+		}
+
+		Directory = InDirectory;
+		MaxFileBytes = FMath::Max<int64>(InMaxFileBytes, kBatchSize);
+		MaxFiles = FMath::Max(InMaxFiles, 1);
+		StartCycles = FPlatformTime::Cycles64();
+		StartTime = FDateTime::UtcNow();
+		ReportedDrops = Ring->GetDroppedCount();
+		Batch.Reset(kBatchSize * 2);
+
+		if (!OpenFile())
+		{
+			return false;
+		}
+
+		bStopping = false;
+		Thread = FRunnableThread::Create(this, TEXT("MultiplayLogSink"), 0, TPri_BelowNormal);
+		if (Thread == nullptr)
+		{
+			File.Reset();
+			return false;
+		}
+
+		OpenCount = 1;
+		ActiveVerbosity.store(Verbosity, std::memory_order_release);
+		return true;
+	}
+
+	void FMultiplayLogSink::Close()
+	{
+		if (Thread == nullptr)
+		{
+			return;
+		}
+
+		OpenCount -= 1;
+		if (OpenCount <= 0)
+		{
+			Shutdown();
+		}
+	}
+
+	void FMultiplayLogSink::Shutdown()
+	{
+		if (Thread == nullptr)
+		{
+			return;
+		}
+
+		OpenCount = 0;
+
+		ActiveVerbosity.store(ELogVerbosity::NoLogging, std::memory_order_release);
+
+		bStopping = true;
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	void FMultiplayLogSink::Write(const TCHAR* Category, ELogVerbosity::Type Verbosity, const TCHAR* Message, int32 Length)
+	{
+		const bool bTruncated = Length < 0 || Length > FMultiplayLogRecord::kMaxLength;
+		Ring->TryPush(Category, static_cast<uint8>(Verbosity), Message, bTruncated ? FCString::Strlen(Message) : Length, bTruncated);
+	}
+
+	int64 FMultiplayLogSink::GetDroppedCount() const
+	{
+		return Ring.IsValid() ? Ring->GetDroppedCount() : 0;
+	}
+
+	FString FMultiplayLogSink::GetFileName(int32 Index)
+	{
+		return Index == 0 ? FString(TEXT("multiplay-sdk.log")) : FString::Printf(TEXT("multiplay-sdk.%d.log"), Index);
+	}
+
+	uint32 FMultiplayLogSink::Run()
+	{
+		while (!bStopping)
+		{
+			if (Drain() == 0)
+			{
+				Flush();
+				FPlatformProcess::Sleep(kIdleSleepSeconds);
+			}
+		}
+
+		Drain();
+		Flush();
+		File.Reset();
+		return 0;
+	}
+
+	void FMultiplayLogSink::Stop()
+	{
+		bStopping = true;
+	}
+
+	int32 FMultiplayLogSink::Drain()
+	{
+		int32 Count = 0;
+		while (Ring->TryPop([this](const FMultiplayLogRecord& Record) { AppendRecord(Record); }))
+		{
+			++Count;
+			if (Batch.Num() >= kBatchSize)
+			{
+				Flush();
+			}
+		}
+
+		const int64 Dropped = Ring->GetDroppedCount();
+		if (Dropped != ReportedDrops)
+		{
+			FMultiplayLogRecord Record;
+			Record.Cycles = FPlatformTime::Cycles64();
+			Record.Category = TEXT("LogMultiplayGameServerSDK");
+			Record.Verbosity = ELogVerbosity::Warning;
+			Record.bTruncated = false;
+
+			const FString Text = FString::Printf(TEXT("Dropped %lld messages, the SDK log sink fell behind."), Dropped - ReportedDrops);
+			Record.Length = static_cast<uint16>(FMath::Min(Text.Len(), FMultiplayLogRecord::kMaxLength));
+			FMemory::Memcpy(Record.Text, *Text, Record.Length * sizeof(TCHAR));
+
+			AppendRecord(Record);
+			ReportedDrops = Dropped;
+		}
+
+		return Count;
+	}
+
+	void FMultiplayLogSink::AppendRecord(const FMultiplayLogRecord& Record)
+	{
+		// Messages left over from a previous session were queued before the sink was opened and are stamped with the time it was.
+		const FDateTime Time = Record.Cycles > StartCycles ? StartTime + FTimespan::FromSeconds(FPlatformTime::ToSeconds64(Record.Cycles - StartCycles)) : StartTime;
+
+		const FString Prefix = FString::Printf(TEXT("%s %s %s: "), *Time.ToIso8601(), Record.Category, ToString(static_cast<ELogVerbosity::Type>(Record.Verbosity)));
+
+		FTCHARToUTF8 ConvertedPrefix(*Prefix);
+		Batch.Append(reinterpret_cast<const uint8*>(ConvertedPrefix.Get()), ConvertedPrefix.Length());
+
+		FTCHARToUTF8 ConvertedText(Record.Text, Record.Length);
+		Batch.Append(reinterpret_cast<const uint8*>(ConvertedText.Get()), ConvertedText.Length());
+
+		if (Record.bTruncated)
+		{
+			static const ANSICHAR kTruncated[] = " [truncated]";
+			Batch.Append(reinterpret_cast<const uint8*>(kTruncated), sizeof(kTruncated) - 1);
+		}
+
+		Batch.Add('\n');
+	}
+
+	void FMultiplayLogSink::Flush()
+	{
+		if (Batch.Num() == 0)
+		{
+			return;
+		}
+
+		if (FileSize > 0 && FileSize + Batch.Num() > MaxFileBytes)
+		{
+			Rotate();
+		}
+
+		if (File.IsValid() || OpenFile())
+		{
+			File->Serialize(Batch.GetData(), Batch.Num());
+			File->Flush();
+			FileSize += Batch.Num();
+		}
+
+		Batch.Reset();
+	}
+
+	bool FMultiplayLogSink::OpenFile()
+	{
+		const FString Path = FPaths::Combine(Directory, GetFileName(0));
+
+		File.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append | FILEWRITE_AllowRead));
+		if (!File.IsValid())
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to open the SDK log file %s."), *Path);
+			return false;
+		}
+
+		FileSize = File->TotalSize();
+		return true;
+	}
+
+	void FMultiplayLogSink::Rotate()
+	{
+		File.Reset();
+
+		IFileManager& FileManager = IFileManager::Get();
+		FileManager.Delete(*FPaths::Combine(Directory, GetFileName(MaxFiles - 1)), false, false, true);
+		for (int32 Index = MaxFiles - 2; Index >= 0; --Index)
+		{
+			const FString Source = FPaths::Combine(Directory, GetFileName(Index));
+			if (FileManager.FileExists(*Source))
+			{
+				FileManager.Move(*FPaths::Combine(Directory, GetFileName(Index + 1)), *Source, true, false, false, true);
+			}
+		}
+
+		OpenFile();
+	}
+} // namespace Multiplay
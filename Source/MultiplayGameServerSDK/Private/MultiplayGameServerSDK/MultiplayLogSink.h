@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Utils/MultiplayLogRing.h"
+
+class FRunnableThread;
+
+namespace Multiplay
+{
+	// Writes SDK logs to size-rotated files from a background thread.
+	//
+	// Logging copies the formatted message into a lock-free ring and returns, the writer thread converts the records to
+	// lines and writes them in batches, so the threads that log never wait on the disk. Messages logged while the ring is
+	// full are dropped and counted. The newest file is multiplay-sdk.log, older ones are numbered from multiplay-sdk.1.log.
+	class FMultiplayLogSink : private FRunnable
+	{
+	public:
+		// The writer sleeps for this long when the ring is empty rather than being woken by the threads that log.
+		static constexpr float kIdleSleepSeconds = 0.01f;
+
+		// Lines are written to the file in batches of up to this size.
+		static constexpr int32 kBatchSize = 64 * 1024;
+
+	public:
+		static FMultiplayLogSink& Get();
+
+		FMultiplayLogSink();
+		virtual ~FMultiplayLogSink();
+
+		// Starts writing messages at or above the verbosity to files in the directory. A sink that is already open is shared
+		// instead, for example by the game instances of a shared SDK core, and keeps writing to the directory it was opened in.
+		bool Open(const FString& Directory, ELogVerbosity::Type Verbosity, int64 MaxFileBytes, int32 MaxFiles, int32 Capacity);
+
+		// Releases a successful Open. Once every Open has been released, writes the queued messages and stops the writer thread.
+		void Close();
+
+		bool IsOpen() const { return Thread != nullptr; }
+
+		// Whether messages at the verbosity are written to the sink, cheap enough to check before formatting a message.
+		bool IsEnabled(ELogVerbosity::Type Verbosity) const
+		{
+			return static_cast<int32>(Verbosity) <= ActiveVerbosity.load(std::memory_order_acquire);
+		}
+
+		// Queues a message, Length is negative or above the record size when it was truncated while being formatted.
+		void Write(const TCHAR* Category, ELogVerbosity::Type Verbosity, const TCHAR* Message, int32 Length);
+
+		// The number of messages dropped because the writer had fallen behind.
+		int64 GetDroppedCount() const;
+
+		static FString GetFileName(int32 Index);
+
+	private:
+		// FRunnable
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+
+	private:
+		// Returns the number of records written.
+		int32 Drain();
+		void Shutdown();
+		void AppendRecord(const FMultiplayLogRecord& Record);
+		void Flush();
+		bool OpenFile();
+		void Rotate();
+
+	private:
+		TUniquePtr<FMultiplayLogRing> Ring;
+		FRunnableThread* Thread;
+		int32 OpenCount;
+		std::atomic<int32> ActiveVerbosity;
+		std::atomic<bool> bStopping;
+
+		FString Directory;
+		int64 MaxFileBytes;
+		int32 MaxFiles;
+
+		// Owned by the writer thread while it runs.
+		TUniquePtr<FArchive> File;
+		int64 FileSize;
+		TArray<uint8> Batch;
+		uint64 StartCycles;
+		FDateTime StartTime;
+		int64 ReportedDrops;
+	};
+} // namespace Multiplay
+
+// Logs to the SDK log sink when it is enabled for the verbosity, and with UE_LOG otherwise. Warnings and errors are also always logged with UE_LOG.
+#define MULTIPLAY_LOG(CategoryName, Verbosity, Format, ...) \
+	do \
+	{ \
+		const bool bMultiplayLogSinkEnabled = Multiplay::FMultiplayLogSink::Get().IsEnabled(ELogVerbosity::Verbosity); \
+		if (bMultiplayLogSinkEnabled) \
+		{ \
+			TCHAR MultiplayLogMessage[Multiplay::FMultiplayLogRecord::kMaxLength + 1]; \
+			const int32 MultiplayLogLength = FCString::Snprintf(MultiplayLogMessage, Multiplay::FMultiplayLogRecord::kMaxLength + 1, Format, ##__VA_ARGS__); \
+			MultiplayLogMessage[Multiplay::FMultiplayLogRecord::kMaxLength] = TEXT('\0'); \
+			Multiplay::FMultiplayLogSink::Get().Write(TEXT(#CategoryName), ELogVerbosity::Verbosity, MultiplayLogMessage, MultiplayLogLength); \
+		} \
+		if (!bMultiplayLogSinkEnabled || ELogVerbosity::Verbosity <= ELogVerbosity::Warning) \
+		{ \
+			UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__); \
+		} \
+	} while (0)
@@ -0,0 +1,220 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayLogSink.h"
+#include "MultiplayGameServerSDKLog.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayLogSinkSpec, "MultiplayGameServerSDK.LogSink", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+FString Directory;
+void Push(Multiplay::FMultiplayLogRing& Ring, const FString& Text) const;
+END_DEFINE_SPEC(FMultiplayLogSinkSpec)
+
+void FMultiplayLogSinkSpec::Push(Multiplay::FMultiplayLogRing& Ring, const FString& Text) const
+{
+	Ring.TryPush(TEXT("LogSpec"), ELogVerbosity::Log, *Text, Text.Len(), false);
+}
+
+void FMultiplayLogSinkSpec::Define()
+{
+	Describe("FMultiplayLogRing", [this]()
+		{
+			It("should hand records to the consumer in the order they were pushed.", [this]()
+				{
+					Multiplay::FMultiplayLogRing Ring(4);
+					Push(Ring, TEXT("first"));
+					Push(Ring, TEXT("second"));
+
+					FString Text;
+					MP_TEST_TRUE_EXPR(Ring.TryPop([&Text](const Multiplay::FMultiplayLogRecord& Record) { Text = FString(Record.Length, Record.Text); }));
+					TestEqual(TEXT("First"), Text, FString(TEXT("first")));
+
+					MP_TEST_TRUE_EXPR(Ring.TryPop([&Text](const Multiplay::FMultiplayLogRecord& Record) { Text = FString(Record.Length, Record.Text); }));
+					TestEqual(TEXT("Second"), Text, FString(TEXT("second")));
+
+					TestFalseExpr(Ring.TryPop([](const Multiplay::FMultiplayLogRecord&) {}));
+				});
+
+			It("should drop records rather than wait when it is full.", [this]()
+				{
+					Multiplay::FMultiplayLogRing Ring(3);
+					TestEqual(TEXT("Capacity"), Ring.GetCapacity(), 4);
+
+					for (int32 Index = 0; Index < 6; ++Index)
+					{
+						Push(Ring, TEXT("message"));
+					}
+					TestEqual(TEXT("Dropped"), Ring.GetDroppedCount(), static_cast<int64>(2));
+
+					// A freed cell is reused by the next record.
+					Ring.TryPop([](const Multiplay::FMultiplayLogRecord&) {});
+					Push(Ring, TEXT("message"));
+					TestEqual(TEXT("Dropped"), Ring.GetDroppedCount(), static_cast<int64>(2));
+				});
+
+			It("should truncate messages longer than a record.", [this]()
+				{
+					Multiplay::FMultiplayLogRing Ring(2);
+					Push(Ring, FString::ChrN(Multiplay::FMultiplayLogRecord::kMaxLength + 10, TEXT('x')));
+
+					Ring.TryPop([this](const Multiplay::FMultiplayLogRecord& Record)
+						{
+							TestEqual(TEXT("Length"), static_cast<int32>(Record.Length), Multiplay::FMultiplayLogRecord::kMaxLength);
+							TestTrueExpr(Record.bTruncated);
+						});
+				});
+
+			It("should keep every record pushed concurrently by several threads.", [this]()
+				{
+					static constexpr int32 kThreads = 4;
+					static constexpr int32 kRecordsPerThread = 2000;
+
+					Multiplay::FMultiplayLogRing Ring(kThreads * kRecordsPerThread);
+
+					TArray<TFuture<void>> Producers;
+					for (int32 Thread = 0; Thread < kThreads; ++Thread)
+					{
+						TSharedRef<TPromise<void>> Promise = MakeShared<TPromise<void>>();
+						Producers.Add(Promise->GetFuture());
+						AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [&Ring, Thread, Promise]()
+							{
+								for (int32 Index = 0; Index < kRecordsPerThread; ++Index)
+								{
+									const FString Text = FString::Printf(TEXT("%d %d"), Thread, Index);
+									Ring.TryPush(TEXT("LogSpec"), ELogVerbosity::Log, *Text, Text.Len(), false);
+								}
+								Promise->SetValue();
+							});
+					}
+
+					for (TFuture<void>& Producer : Producers)
+					{
+						Producer.Wait();
+					}
+
+					// Each thread's records arrive in the order it pushed them.
+					TArray<int32> NextIndex;
+					NextIndex.SetNumZeroed(kThreads);
+					int32 Count = 0;
+					bool bOrdered = true;
+					while (Ring.TryPop([&](const Multiplay::FMultiplayLogRecord& Record)
+						{
+							FString ThreadText;
+							FString IndexText;
+							FString(Record.Length, Record.Text).Split(TEXT(" "), &ThreadText, &IndexText);
+							const int32 Thread = FCString::Atoi(*ThreadText);
+							bOrdered &= FCString::Atoi(*IndexText) == NextIndex[Thread]++;
+						}))
+					{
+						++Count;
+					}
+
+					TestEqual(TEXT("Count"), Count, kThreads * kRecordsPerThread);
+					TestTrueExpr(bOrdered);
+					TestEqual(TEXT("Dropped"), Ring.GetDroppedCount(), static_cast<int64>(0));
+				});
+		});
+
+	Describe("FMultiplayLogSink", [this]()
+		{
+			BeforeEach([this]()
+				{
+					Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("MultiplayLogSinkSpec"), FGuid::NewGuid().ToString());
+				});
+
+			AfterEach([this]()
+				{
+					IFileManager::Get().DeleteDirectory(*Directory, false, true);
+				});
+
+			It("should write the messages at or above its verbosity once closed.", [this]()
+				{
+					Multiplay::FMultiplayLogSink Sink;
+					MP_TEST_TRUE_EXPR(Sink.Open(Directory, ELogVerbosity::Log, 1024 * 1024, 2, 64));
+
+					TestTrueExpr(Sink.IsEnabled(ELogVerbosity::Warning));
+					TestTrueExpr(Sink.IsEnabled(ELogVerbosity::Log));
+					TestFalseExpr(Sink.IsEnabled(ELogVerbosity::Verbose));
+
+					Sink.Write(TEXT("LogSpec"), ELogVerbosity::Log, TEXT("Received a message."), 19);
+					Sink.Write(TEXT("LogSpec"), ELogVerbosity::Warning, TEXT("Missed a pong."), -1);
+					Sink.Close();
+
+					TestFalseExpr(Sink.IsEnabled(ELogVerbosity::Error));
+
+					FString Contents;
+					MP_TEST_TRUE_EXPR(FFileHelper::LoadFileToString(Contents, *FPaths::Combine(Directory, Multiplay::FMultiplayLogSink::GetFileName(0))));
+
+					TArray<FString> Lines;
+					Contents.ParseIntoArrayLines(Lines);
+					MP_TEST_TRUE_EXPR(Lines.Num() == 2);
+					TestTrueExpr(Lines[0].EndsWith(TEXT(" LogSpec Log: Received a message.")));
+					TestTrueExpr(Lines[1].EndsWith(TEXT(" LogSpec Warning: Missed a pong. [truncated]")));
+				});
+
+			It("should stay open in its first directory until every owner has closed it.", [this]()
+				{
+					Multiplay::FMultiplayLogSink Sink;
+					MP_TEST_TRUE_EXPR(Sink.Open(Directory, ELogVerbosity::Log, 1024 * 1024, 2, 64));
+					TestTrueExpr(Sink.Open(FPaths::Combine(Directory, TEXT("Other")), ELogVerbosity::Log, 1024 * 1024, 2, 64));
+
+					Sink.Close();
+					TestTrueExpr(Sink.IsOpen());
+
+					Sink.Write(TEXT("LogSpec"), ELogVerbosity::Log, TEXT("Still logging."), 14);
+					Sink.Close();
+					TestFalseExpr(Sink.IsOpen());
+
+					FString Contents;
+					TestTrueExpr(FFileHelper::LoadFileToString(Contents, *FPaths::Combine(Directory, Multiplay::FMultiplayLogSink::GetFileName(0))));
+					TestTrueExpr(Contents.Contains(TEXT("Still logging.")));
+				});
+
+			It("should rotate the files once they reach the size limit.", [this]()
+				{
+					const int64 MaxFileBytes = Multiplay::FMultiplayLogSink::kBatchSize;
+					const FString Message = FString::ChrN(400, TEXT('m'));
+
+					Multiplay::FMultiplayLogSink Sink;
+					MP_TEST_TRUE_EXPR(Sink.Open(Directory, ELogVerbosity::Log, MaxFileBytes, 3, 2048));
+
+					for (int32 Index = 0; Index < 1000; ++Index)
+					{
+						Sink.Write(TEXT("LogSpec"), ELogVerbosity::Log, *Message, Message.Len());
+					}
+					Sink.Close();
+
+					IFileManager& FileManager = IFileManager::Get();
+					for (int32 Index = 0; Index < 3; ++Index)
+					{
+						const int64 Size = FileManager.FileSize(*FPaths::Combine(Directory, Multiplay::FMultiplayLogSink::GetFileName(Index)));
+						TestTrueExpr(Size > 0 && Size <= 2 * MaxFileBytes);
+					}
+
+					TestFalseExpr(FileManager.FileExists(*FPaths::Combine(Directory, Multiplay::FMultiplayLogSink::GetFileName(3))));
+				});
+		});
+
+	Describe("MULTIPLAY_LOG", [this]()
+		{
+			It("should expand to a single statement that can be followed by an else.", [this]()
+				{
+					int32 Branch = 0;
+					for (const bool bLog : { true, false })
+					{
+						if (bLog)
+							MULTIPLAY_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("Logged from the if branch."));
+						else
+							Branch = 2;
+					}
+
+					TestEqual("Branch", Branch, 2);
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
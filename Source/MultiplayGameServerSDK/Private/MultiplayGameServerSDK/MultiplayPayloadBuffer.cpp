@@ -0,0 +1,150 @@
+#include "MultiplayPayloadBuffer.h"
+#include "MultiplayPayloadBufferFactory.h"
+#include "MultiplayGameServerSDKLog.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FString FMultiplayPayloadBuffer::ToString() const
+{
+	const TArrayView<const uint8> Bytes = GetBytes();
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+bool FMultiplayPayloadBuffer::ForEachChunk(int32 ChunkSize, TFunctionRef<bool(TArrayView<const uint8> Chunk)> Parser) const
+{
+	check(ChunkSize > 0);
+
+	const TArrayView<const uint8> Bytes = GetBytes();
+	for (int32 Offset = 0; Offset < Bytes.Num(); Offset += ChunkSize)
+	{
+		if (!Parser(Bytes.Slice(Offset, FMath::Min(ChunkSize, Bytes.Num() - Offset))))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+namespace Multiplay
+{
+	class FHttpPayloadBuffer : public FMultiplayPayloadBuffer
+	{
+	public:
+		FHttpPayloadBuffer(const FHttpResponsePtr& InHttpResponse) : HttpResponse(InHttpResponse)
+		{
+		}
+
+		virtual TArrayView<const uint8> GetBytes() const override
+		{
+			return HttpResponse->GetContent();
+		}
+
+	private:
+		FHttpResponsePtr HttpResponse;
+	};
+
+	class FOwnedPayloadBuffer : public FMultiplayPayloadBuffer
+	{
+	public:
+		FOwnedPayloadBuffer(TArray<uint8>&& InBytes) : Bytes(MoveTemp(InBytes))
+		{
+		}
+
+		virtual TArrayView<const uint8> GetBytes() const override
+		{
+			return Bytes;
+		}
+
+	private:
+		TArray<uint8> Bytes;
+	};
+
+	class FMappedPayloadBuffer : public FMultiplayPayloadBuffer
+	{
+	public:
+		FMappedPayloadBuffer(FString InFilename, TUniquePtr<IMappedFileHandle> InHandle, TUniquePtr<IMappedFileRegion> InRegion)
+			: Filename(MoveTemp(InFilename))
+			, Handle(MoveTemp(InHandle))
+			, Region(MoveTemp(InRegion))
+		{
+		}
+
+		virtual ~FMappedPayloadBuffer()
+		{
+			// The region must be unmapped before its handle is closed, and both before the file can be deleted.
+			Region.Reset();
+			Handle.Reset();
+			IFileManager::Get().Delete(*Filename, false, false, true);
+		}
+
+		virtual TArrayView<const uint8> GetBytes() const override
+		{
+			return TArrayView<const uint8>(Region->GetMappedPtr(), static_cast<int32>(Region->GetMappedSize()));
+		}
+
+		virtual bool IsMapped() const override
+		{
+			return true;
+		}
+
+	private:
+		FString Filename;
+		TUniquePtr<IMappedFileHandle> Handle;
+		TUniquePtr<IMappedFileRegion> Region;
+	};
+
+	FMultiplayPayloadBufferPtr MakeHttpPayloadBuffer(const FHttpResponsePtr& HttpResponse)
+	{
+		check(HttpResponse.IsValid());
+		return MakeShared<FHttpPayloadBuffer, ESPMode::ThreadSafe>(HttpResponse);
+	}
+
+	FMultiplayPayloadBufferPtr MakeOwnedPayloadBuffer(TArray<uint8>&& Bytes)
+	{
+		return MakeShared<FOwnedPayloadBuffer, ESPMode::ThreadSafe>(MoveTemp(Bytes));
+	}
+
+	FMultiplayPayloadBufferPtr MakeStringPayloadBuffer(const FString& Payload)
+	{
+		const FTCHARToUTF8 Converted(*Payload, Payload.Len());
+
+		TArray<uint8> Bytes;
+		Bytes.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+
+		return MakeOwnedPayloadBuffer(MoveTemp(Bytes));
+	}
+
+	FMultiplayPayloadBufferPtr MakeMappedPayloadBuffer(TArrayView<const uint8> Bytes)
+	{
+		// An empty file cannot be mapped.
+		if (Bytes.Num() == 0)
+		{
+			return nullptr;
+		}
+
+		const FString Filename = FPaths::CreateTempFilename(FPlatformProcess::UserTempDir(), TEXT("MultiplayPayload"), TEXT(".bin"));
+		if (!FFileHelper::SaveArrayToFile(Bytes, *Filename))
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to write the payload to %s, keeping it in memory."), *Filename);
+			return nullptr;
+		}
+
+		TUniquePtr<IMappedFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+		TUniquePtr<IMappedFileRegion> Region(Handle.IsValid() ? Handle->MapRegion() : nullptr);
+		if (!Region.IsValid())
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to map the payload file %s, keeping the payload in memory."), *Filename);
+			Handle.Reset();
+			IFileManager::Get().Delete(*Filename, false, false, true);
+			return nullptr;
+		}
+
+		return MakeShared<FMappedPayloadBuffer, ESPMode::ThreadSafe>(Filename, MoveTemp(Handle), MoveTemp(Region));
+	}
+} // namespace Multiplay
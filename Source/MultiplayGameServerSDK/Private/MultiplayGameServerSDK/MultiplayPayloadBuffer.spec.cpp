@@ -0,0 +1,131 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayPayloadBufferFactory.h"
+#include "OpenAPIPayloadApiOperations.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayPayloadBufferSpec, "MultiplayGameServerSDK.PayloadBuffer", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FMultiplayPayloadBufferSpec)
+
+void FMultiplayPayloadBufferSpec::Define()
+{
+	Describe("MakeStringPayloadBuffer", [this]()
+		{
+			It("should hold the payload in UTF-8.", [this]()
+				{
+					FMultiplayPayloadBufferPtr Buffer = Multiplay::MakeStringPayloadBuffer(TEXT("{\"name\": \"caf\u00e9\"}"));
+
+					TestEqual("Num()", Buffer->Num(), 17);
+					TestFalseExpr(Buffer->IsMapped());
+					TestEqual("ToString()", Buffer->ToString(), FString(TEXT("{\"name\": \"caf\u00e9\"}")));
+				});
+		});
+
+	Describe("ForEachChunk", [this]()
+		{
+			It("should hand every byte to the parser in order.", [this]()
+				{
+					FMultiplayPayloadBufferPtr Buffer = Multiplay::MakeStringPayloadBuffer(TEXT("0123456789"));
+
+					TArray<int32> ChunkSizes;
+					FString Consumed;
+					const bool bCompleted = Buffer->ForEachChunk(4, [&ChunkSizes, &Consumed](TArrayView<const uint8> Chunk)
+						{
+							ChunkSizes.Add(Chunk.Num());
+							for (uint8 Byte : Chunk)
+							{
+								Consumed.AppendChar(static_cast<TCHAR>(Byte));
+							}
+							return true;
+						});
+
+					TestTrueExpr(bCompleted);
+					TestEqual("Consumed", Consumed, FString(TEXT("0123456789")));
+					if (MP_TEST_TRUE_EXPR(ChunkSizes.Num() == 3))
+					{
+						TestEqual("ChunkSizes[2]", ChunkSizes[2], 2);
+					}
+				});
+
+			It("should stop when the parser returns false.", [this]()
+				{
+					FMultiplayPayloadBufferPtr Buffer = Multiplay::MakeStringPayloadBuffer(TEXT("0123456789"));
+
+					int32 Chunks = 0;
+					const bool bCompleted = Buffer->ForEachChunk(4, [&Chunks](TArrayView<const uint8> Chunk)
+						{
+							++Chunks;
+							return false;
+						});
+
+					TestFalseExpr(bCompleted);
+					TestEqual("Chunks", Chunks, 1);
+				});
+		});
+
+	Describe("MakeMappedPayloadBuffer", [this]()
+		{
+			It("should map the payload and delete the file once released.", [this]()
+				{
+					TArray<uint8> Bytes;
+					for (int32 Index = 0; Index < 100000; ++Index)
+					{
+						Bytes.Add(static_cast<uint8>(Index));
+					}
+
+					FMultiplayPayloadBufferPtr Buffer = Multiplay::MakeMappedPayloadBuffer(Bytes);
+
+					// Some platforms cannot map files, in which case the payload stays on the heap.
+					if (Buffer.IsValid())
+					{
+						TestTrueExpr(Buffer->IsMapped());
+						if (MP_TEST_TRUE_EXPR(Buffer->Num() == Bytes.Num()))
+						{
+							TestTrueExpr(FMemory::Memcmp(Buffer->GetBytes().GetData(), Bytes.GetData(), Bytes.Num()) == 0);
+						}
+
+						TArray<FString> Files;
+						IFileManager::Get().FindFiles(Files, *FPaths::Combine(FPlatformProcess::UserTempDir(), TEXT("MultiplayPayload*.bin")), true, false);
+						TestTrueExpr(Files.Num() > 0);
+
+						const int32 FilesBeforeRelease = Files.Num();
+						Buffer.Reset();
+
+						Files.Reset();
+						IFileManager::Get().FindFiles(Files, *FPaths::Combine(FPlatformProcess::UserTempDir(), TEXT("MultiplayPayload*.bin")), true, false);
+						TestEqual("Files.Num()", Files.Num(), FilesBeforeRelease - 1);
+					}
+				});
+		});
+
+	Describe("PayloadAllocationResponse", [this]()
+		{
+			It("should carry a successful payload received as a string in a buffer.", [this]()
+				{
+					Multiplay::PayloadAllocationResponse Response;
+					Response.SetHttpResponseCode(EHttpResponseCodes::Ok);
+					Response.ReceiveContent(TEXT("{\"players\": []}"), TEXT("application/json"));
+
+					if (MP_TEST_TRUE_EXPR(Response.Payload.IsValid()))
+					{
+						TestEqual("ToString()", Response.Payload->ToString(), FString(TEXT("{\"players\": []}")));
+					}
+				});
+
+			It("should not carry a buffer for an unsuccessful response.", [this]()
+				{
+					Multiplay::PayloadAllocationResponse Response;
+					Response.SetHttpResponseCode(EHttpResponseCodes::NotFound);
+					Response.ReceiveContent(TEXT(R"({"error": true, "error_code": 404, "error_message": "foo", "success": false})"), TEXT("application/json"));
+
+					TestFalseExpr(Response.Payload.IsValid());
+					TestTrueExpr(Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::Decoded);
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
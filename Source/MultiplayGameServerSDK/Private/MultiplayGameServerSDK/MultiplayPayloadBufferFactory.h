@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpResponse.h"
+#include "MultiplayPayloadBuffer.h"
+
+namespace Multiplay
+{
+	// Wraps the content of an HTTP response without copying it, the response is kept alive by the buffer.
+	FMultiplayPayloadBufferPtr MakeHttpPayloadBuffer(const FHttpResponsePtr& HttpResponse);
+
+	// Takes ownership of payload bytes produced by the SDK, when decompressing for instance.
+	FMultiplayPayloadBufferPtr MakeOwnedPayloadBuffer(TArray<uint8>&& Bytes);
+
+	// Converts a payload received as a string, over RPC for instance, to UTF-8.
+	FMultiplayPayloadBufferPtr MakeStringPayloadBuffer(const FString& Payload);
+
+	// Writes a payload to a temporary file and maps it, returns null if the file cannot be written or mapped.
+	// The file is deleted when the buffer is destroyed.
+	FMultiplayPayloadBufferPtr MakeMappedPayloadBuffer(TArrayView<const uint8> Bytes);
+} // namespace Multiplay
@@ -0,0 +1,112 @@
+#include "MultiplayPayloadCache.h"
+#include "MultiplayPayloadTokenCache.h"
+#include "MultiplayRpcTransport.h"
+#include "MultiplayGameServerSDKLog.h"
+
+namespace Multiplay
+{
+	FMultiplayPayloadCache::FMultiplayPayloadCache(TSharedPtr<FMultiplayRpcTransport> InTransport, TSharedPtr<FMultiplayPayloadTokenCache> InTokenCache)
+		: Transport(MoveTemp(InTransport))
+		, TokenCache(MoveTemp(InTokenCache))
+	{
+	}
+
+	void FMultiplayPayloadCache::Prefetch(const FGuid& AllocationId)
+	{
+		UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("Prefetching the payload and token of allocation %s."), *AllocationId.ToString());
+
+		Entries.FindOrAdd(AllocationId);
+
+		FetchPayloadAllocation(AllocationId);
+
+		if (TokenCache.IsValid())
+		{
+			TokenCache->Prefetch();
+		}
+	}
+
+	void FMultiplayPayloadCache::PayloadAllocation(const FGuid& AllocationId, const FPayloadAllocationDelegate& Delegate)
+	{
+		FEntry& Entry = Entries.FindOrAdd(AllocationId);
+		if (Entry.Response.IsSet())
+		{
+			Delegate.ExecuteIfBound(Entry.Response.GetValue());
+			return;
+		}
+
+		Entry.Waiters.Add(Delegate);
+		FetchPayloadAllocation(AllocationId);
+	}
+
+	void FMultiplayPayloadCache::Invalidate(const FGuid& AllocationId)
+	{
+		FEntry* Entry = Entries.Find(AllocationId);
+		if (Entry == nullptr)
+		{
+			return;
+		}
+
+		if (Entry->bInFlight)
+		{
+			// The entry is kept until its request completes so that its waiters are still answered.
+			Entry->Response.Reset();
+			Entry->bInvalidated = true;
+		}
+		else
+		{
+			Entries.Remove(AllocationId);
+		}
+	}
+
+	bool FMultiplayPayloadCache::IsPayloadAllocationCached(const FGuid& AllocationId) const
+	{
+		const FEntry* Entry = Entries.Find(AllocationId);
+		return Entry != nullptr && Entry->Response.IsSet();
+	}
+
+	void FMultiplayPayloadCache::FetchPayloadAllocation(const FGuid& AllocationId)
+	{
+		FEntry& Entry = Entries.FindChecked(AllocationId);
+		if (Entry.Response.IsSet() || Entry.bInFlight)
+		{
+			return;
+		}
+
+		Entry.bInFlight = true;
+
+		PayloadAllocationRequest Request;
+		Request.AllocationId = AllocationId;
+
+		Transport->PayloadAllocation(Request, FPayloadAllocationDelegate::CreateSP(this, &FMultiplayPayloadCache::OnPayloadAllocation, AllocationId));
+	}
+
+	void FMultiplayPayloadCache::OnPayloadAllocation(const PayloadAllocationResponse& Response, FGuid AllocationId)
+	{
+		FEntry* Entry = Entries.Find(AllocationId);
+		if (Entry == nullptr)
+		{
+			return;
+		}
+
+		Entry->bInFlight = false;
+
+		if (Response.IsSuccessful() && !Entry->bInvalidated)
+		{
+			Entry->Response = Response;
+		}
+
+		// The waiters are moved out first because a waiter may issue new requests or invalidate the entry.
+		TArray<FPayloadAllocationDelegate> Waiters = MoveTemp(Entry->Waiters);
+		Entry->Waiters.Reset();
+
+		if (Entry->bInvalidated)
+		{
+			Entries.Remove(AllocationId);
+		}
+
+		for (const FPayloadAllocationDelegate& Waiter : Waiters)
+		{
+			Waiter.ExecuteIfBound(Response);
+		}
+	}
+} // namespace Multiplay
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OpenAPIPayloadApi.h"
+#include "OpenAPIPayloadApiOperations.h"
+
+namespace Multiplay
+{
+	class FMultiplayRpcTransport;
+	class FMultiplayPayloadTokenCache;
+
+	// Fetches the payload of an allocation once and serves every later request for it from memory.
+	//
+	// Requests made while a fetch is in flight wait for that fetch instead of issuing another. Unsuccessful
+	// responses are delivered to the waiting requests but are not cached, so the next request fetches again.
+	// The payload token is not tied to an allocation, it is prefetched into the token cache which tracks its expiry.
+	class FMultiplayPayloadCache : public TSharedFromThis<FMultiplayPayloadCache>
+	{
+	public:
+		FMultiplayPayloadCache(TSharedPtr<FMultiplayRpcTransport> Transport, TSharedPtr<FMultiplayPayloadTokenCache> TokenCache);
+
+		// Starts fetching the payload of an allocation and the payload token in parallel.
+		void Prefetch(const FGuid& AllocationId);
+
+		void PayloadAllocation(const FGuid& AllocationId, const FPayloadAllocationDelegate& Delegate);
+
+		// Drops the payload cached for an allocation. A request still in flight completes, but its response is not cached.
+		void Invalidate(const FGuid& AllocationId);
+
+		bool IsPayloadAllocationCached(const FGuid& AllocationId) const;
+
+	private:
+		struct FEntry
+		{
+			TOptional<PayloadAllocationResponse> Response;
+			TArray<FPayloadAllocationDelegate> Waiters;
+			bool bInFlight = false;
+			bool bInvalidated = false;
+		};
+
+		void FetchPayloadAllocation(const FGuid& AllocationId);
+
+		void OnPayloadAllocation(const PayloadAllocationResponse& Response, FGuid AllocationId);
+
+	private:
+		TSharedPtr<FMultiplayRpcTransport> Transport;
+		TSharedPtr<FMultiplayPayloadTokenCache> TokenCache;
+		TMap<FGuid, FEntry> Entries;
+	};
+} // namespace Multiplay
@@ -0,0 +1,85 @@
+#include "MultiplayPayloadCompression.h"
+#include "MultiplayGameServerSDKLog.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace Multiplay
+{
+	bool FMultiplayPayloadCompression::IsGzip(const FString& ContentEncoding, TArrayView<const uint8> Bytes)
+	{
+		// See RFC 1952 section 2.3.1 for the magic number.
+		return ContentEncoding.TrimStartAndEnd().Equals(TEXT("gzip"), ESearchCase::IgnoreCase)
+			&& Bytes.Num() >= 2 && Bytes[0] == 0x1f && Bytes[1] == 0x8b;
+	}
+
+	bool FMultiplayPayloadCompression::InflateGzip(TArrayView<const uint8> Compressed, int64 MaxBytes, TArray<uint8>& OutBytes)
+	{
+		OutBytes.Reset();
+
+		// The output is held in a single array, which cannot grow past MAX_int32 bytes whatever the setting allows.
+		const int64 Limit = FMath::Clamp<int64>(MaxBytes, 0, MAX_int32);
+
+		z_stream Stream;
+		FMemory::Memzero(Stream);
+
+		// Adding 16 to the window bits selects the gzip wrapper instead of the zlib one.
+		if (inflateInit2(&Stream, 16 + MAX_WBITS) != Z_OK)
+		{
+			return false;
+		}
+
+		Stream.next_in = const_cast<Bytef*>(Compressed.GetData());
+		Stream.avail_in = static_cast<uInt>(Compressed.Num());
+
+		int Result = Z_OK;
+		while (Result == Z_OK)
+		{
+			// The output grows one chunk at a time so that a stream claiming a large size cannot allocate ahead of its data.
+			const int64 Remaining = Limit - OutBytes.Num();
+			if (Remaining <= 0)
+			{
+				// The stream may have ended exactly at the limit, which inflate only reports once it is given more room.
+				uint8 Probe;
+				Stream.next_out = &Probe;
+				Stream.avail_out = 1;
+				Result = inflate(&Stream, Z_NO_FLUSH);
+				if (Result == Z_STREAM_END && Stream.avail_out == 1)
+				{
+					break;
+				}
+
+				UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("The compressed payload inflates to more than %lld bytes."), Limit);
+				Result = Z_DATA_ERROR;
+				break;
+			}
+
+			const int32 ChunkSize = static_cast<int32>(FMath::Min<int64>(kInflateChunkSize, Remaining));
+			const int32 Offset = OutBytes.Num();
+			OutBytes.AddUninitialized(ChunkSize);
+
+			Stream.next_out = OutBytes.GetData() + Offset;
+			Stream.avail_out = static_cast<uInt>(ChunkSize);
+
+			Result = inflate(&Stream, Z_NO_FLUSH);
+			OutBytes.SetNum(Offset + ChunkSize - static_cast<int32>(Stream.avail_out), false);
+
+			// Running out of input before the end of the stream means that it was truncated.
+			if (Result == Z_BUF_ERROR || (Result == Z_OK && Stream.avail_in == 0 && Stream.avail_out != 0))
+			{
+				Result = Z_DATA_ERROR;
+			}
+		}
+
+		inflateEnd(&Stream);
+
+		if (Result != Z_STREAM_END)
+		{
+			OutBytes.Reset();
+			return false;
+		}
+
+		return true;
+	}
+} // namespace Multiplay
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+
+namespace Multiplay
+{
+	// Decompresses allocation payloads transferred with a content encoding.
+	class FMultiplayPayloadCompression
+	{
+	public:
+		// The content encodings that can be decompressed, in the form of an Accept-Encoding header.
+		static constexpr const TCHAR* const kAcceptEncoding = TEXT("gzip");
+
+		// The number of bytes inflated at a time.
+		static constexpr int32 kInflateChunkSize = 64 * 1024;
+
+	public:
+		// Returns true if a response with this Content-Encoding header and body carries a gzip stream.
+		// The body is checked as well because the HTTP module may already have decoded it without removing the header.
+		static bool IsGzip(const FString& ContentEncoding, TArrayView<const uint8> Bytes);
+
+		// Inflates a gzip stream. Returns false if the stream is malformed, truncated, or inflates to more than MaxBytes.
+		// MaxBytes is clamped to MAX_int32, the most an array can hold.
+		static bool InflateGzip(TArrayView<const uint8> Compressed, int64 MaxBytes, TArray<uint8>& OutBytes);
+	};
+} // namespace Multiplay
@@ -0,0 +1,82 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayPayloadCompression.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayPayloadCompressionSpec, "MultiplayGameServerSDK.PayloadCompression", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+// {"players": ["a", "b"]} compressed with gzip, as served by a daemon that honours Accept-Encoding.
+const TArray<uint8> Compressed = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xab, 0x56, 0x2a, 0xc8, 0x49, 0xac,
+	0x4c, 0x2d, 0x2a, 0x56, 0xb2, 0x52, 0x88, 0x56, 0x4a, 0x54, 0xd2, 0x51, 0x50, 0x4a, 0x52, 0x8a,
+	0xad, 0x05, 0x00, 0xc6, 0x16, 0xae, 0xe3, 0x17, 0x00, 0x00, 0x00 };
+const FString Payload = TEXT("{\"players\": [\"a\", \"b\"]}");
+FString ToString(const TArray<uint8>& Bytes) const;
+END_DEFINE_SPEC(FMultiplayPayloadCompressionSpec)
+
+FString FMultiplayPayloadCompressionSpec::ToString(const TArray<uint8>& Bytes) const
+{
+	const FUTF8ToTCHAR String(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+	return FString(String.Length(), String.Get());
+}
+
+void FMultiplayPayloadCompressionSpec::Define()
+{
+	Describe("IsGzip", [this]()
+		{
+			It("should require both the content encoding and the gzip header.", [this]()
+				{
+					const TArray<uint8> Plain = { '{', '}' };
+
+					TestTrueExpr(Multiplay::FMultiplayPayloadCompression::IsGzip(TEXT("gzip"), Compressed));
+					TestTrueExpr(Multiplay::FMultiplayPayloadCompression::IsGzip(TEXT("GZIP"), Compressed));
+					TestFalseExpr(Multiplay::FMultiplayPayloadCompression::IsGzip(TEXT(""), Compressed));
+					TestFalseExpr(Multiplay::FMultiplayPayloadCompression::IsGzip(TEXT("gzip"), Plain));
+				});
+		});
+
+	Describe("InflateGzip", [this]()
+		{
+			It("should inflate a gzip stream.", [this]()
+				{
+					TArray<uint8> Inflated;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayPayloadCompression::InflateGzip(Compressed, 1024, Inflated)))
+					{
+						TestEqual("Inflated", ToString(Inflated), Payload);
+					}
+				});
+
+			It("should accept a stream that inflates to exactly the limit.", [this]()
+				{
+					TArray<uint8> Inflated;
+					TestTrueExpr(Multiplay::FMultiplayPayloadCompression::InflateGzip(Compressed, Payload.Len(), Inflated));
+				});
+
+			It("should inflate a gzip stream when the limit exceeds the size of an array.", [this]()
+				{
+					TArray<uint8> Inflated;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayPayloadCompression::InflateGzip(Compressed, int64(MAX_int32) * 4, Inflated)))
+					{
+						TestEqual("Inflated", ToString(Inflated), Payload);
+					}
+				});
+
+			It("should reject a stream that inflates to more than the limit.", [this]()
+				{
+					AddExpectedError(TEXT("inflates to more than"), EAutomationExpectedErrorFlags::Contains, 1);
+
+					TArray<uint8> Inflated;
+					TestFalseExpr(Multiplay::FMultiplayPayloadCompression::InflateGzip(Compressed, Payload.Len() - 1, Inflated));
+					TestEqual("Inflated.Num()", Inflated.Num(), 0);
+				});
+
+			It("should reject a truncated stream.", [this]()
+				{
+					TArray<uint8> Inflated;
+					TestFalseExpr(Multiplay::FMultiplayPayloadCompression::InflateGzip(TArrayView<const uint8>(Compressed.GetData(), Compressed.Num() - 8), 1024, Inflated));
+					TestEqual("Inflated.Num()", Inflated.Num(), 0);
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,141 @@
+#include "MultiplayPayloadTokenCache.h"
+#include "MultiplayRpcTransport.h"
+#include "MultiplayGameServerSDKLog.h"
+#include "Utils/MultiplayJsonHelpers.h"
+
+namespace Multiplay
+{
+	FMultiplayPayloadTokenCache::FMultiplayPayloadTokenCache(TSharedPtr<FMultiplayRpcTransport> InTransport, float InExpiryMarginSeconds, float InRefreshAheadSeconds)
+		: Transport(MoveTemp(InTransport))
+		, ExpiryMarginSeconds(InExpiryMarginSeconds)
+		, RefreshAheadSeconds(InRefreshAheadSeconds)
+		, CachedExpiry(0)
+		, NextRefreshAttempt(0)
+		, bInFlight(false)
+	{
+	}
+
+	bool FMultiplayPayloadTokenCache::Tick(float DeltaTime)
+	{
+		if (!CachedResponse.IsSet() || bInFlight)
+		{
+			return true;
+		}
+
+		const int64 Now = GetUnixTime();
+		if (Now >= CachedExpiry - ExpiryMarginSeconds - RefreshAheadSeconds && Now >= NextRefreshAttempt)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("Refreshing the payload token, it expires in %lld seconds."), CachedExpiry - Now);
+
+			NextRefreshAttempt = Now + kRefreshRetrySeconds;
+			Fetch();
+		}
+
+		return true;
+	}
+
+	void FMultiplayPayloadTokenCache::PayloadToken(const FPayloadTokenDelegate& Delegate)
+	{
+		if (IsTokenCached())
+		{
+			Delegate.ExecuteIfBound(CachedResponse.GetValue());
+			return;
+		}
+
+		Waiters.Add(Delegate);
+		Fetch();
+	}
+
+	void FMultiplayPayloadTokenCache::Prefetch()
+	{
+		if (!IsTokenCached())
+		{
+			Fetch();
+		}
+	}
+
+	bool FMultiplayPayloadTokenCache::IsTokenCached() const
+	{
+		return CachedResponse.IsSet() && GetUnixTime() < CachedExpiry - ExpiryMarginSeconds;
+	}
+
+	bool FMultiplayPayloadTokenCache::TryGetExpiry(const FString& Token, int64& OutExpiry)
+	{
+		// A JWT is made of the header, the claims and the signature, each encoded in Base64Url and separated by dots.
+		TArray<FString> Segments;
+		if (Token.ParseIntoArray(Segments, TEXT("."), false) != 3)
+		{
+			return false;
+		}
+
+		// The segments are encoded without padding, which the decoder requires.
+		FString Claims = Segments[1];
+		while (Claims.Len() % 4 != 0)
+		{
+			Claims.AppendChar(TEXT('='));
+		}
+
+		TArray<uint8> ClaimsBytes;
+		if (!Base64UrlDecode(Claims, ClaimsBytes))
+		{
+			return false;
+		}
+
+		const FUTF8ToTCHAR ClaimsString(reinterpret_cast<const ANSICHAR*>(ClaimsBytes.GetData()), ClaimsBytes.Num());
+
+		TSharedPtr<FJsonObject> ClaimsObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(ClaimsString.Length(), ClaimsString.Get()));
+		if (!FJsonSerializer::Deserialize(Reader, ClaimsObject) || !ClaimsObject.IsValid())
+		{
+			return false;
+		}
+
+		return TryGetJsonValue(ClaimsObject, TEXT("exp"), OutExpiry);
+	}
+
+	int64 FMultiplayPayloadTokenCache::GetUnixTime() const
+	{
+		return FDateTime::UtcNow().ToUnixTimestamp();
+	}
+
+	void FMultiplayPayloadTokenCache::Fetch()
+	{
+		if (bInFlight)
+		{
+			return;
+		}
+
+		bInFlight = true;
+
+		Transport->PayloadToken(PayloadTokenRequest(), FPayloadTokenDelegate::CreateSP(this, &FMultiplayPayloadTokenCache::OnPayloadToken));
+	}
+
+	void FMultiplayPayloadTokenCache::OnPayloadToken(const PayloadTokenResponse& Response)
+	{
+		bInFlight = false;
+
+		if (Response.IsSuccessful() && Response.Content.Error.IsEmpty())
+		{
+			int64 Expiry;
+			if (TryGetExpiry(Response.Content.Token, Expiry))
+			{
+				CachedResponse = Response;
+				CachedExpiry = Expiry;
+				NextRefreshAttempt = 0;
+			}
+			else
+			{
+				UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("The payload token has no readable expiry and will not be cached."));
+			}
+		}
+
+		// The waiters are moved out first because a waiter may request the token again.
+		TArray<FPayloadTokenDelegate> CompletedWaiters = MoveTemp(Waiters);
+		Waiters.Reset();
+
+		for (const FPayloadTokenDelegate& Waiter : CompletedWaiters)
+		{
+			Waiter.ExecuteIfBound(Response);
+		}
+	}
+} // namespace Multiplay
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Utils/MultiplayTicker.h"
+#include "OpenAPIPayloadApi.h"
+#include "OpenAPIPayloadApiOperations.h"
+
+namespace Multiplay
+{
+	class FMultiplayRpcTransport;
+
+	// Serves the payload token from memory for as long as it is valid, fetching a replacement before it expires.
+	//
+	// The expiry is read from the "exp" claim of the token. A cached token is served until ExpiryMarginSeconds before it
+	// expires, and a replacement is fetched in the background RefreshAheadSeconds before that, so that callers on the warm
+	// path never wait for the daemon. Requests made while a fetch is in flight wait for that fetch instead of issuing another.
+	// Tokens without an "exp" claim and unsuccessful responses are delivered to the waiting requests but are not cached.
+	class FMultiplayPayloadTokenCache : public FMultiplayTickerObjectBase, public TSharedFromThis<FMultiplayPayloadTokenCache>
+	{
+	public:
+		// The number of seconds to wait before retrying a background refresh that failed.
+		static constexpr int64 kRefreshRetrySeconds = 5;
+
+	public:
+		FMultiplayPayloadTokenCache(TSharedPtr<FMultiplayRpcTransport> Transport, float ExpiryMarginSeconds, float RefreshAheadSeconds);
+
+		virtual bool Tick(float DeltaTime) override;
+
+		void PayloadToken(const FPayloadTokenDelegate& Delegate);
+
+		// Starts fetching a token unless a usable one is cached or a fetch is already in flight.
+		void Prefetch();
+
+		// Returns true if a cached token would be served without contacting the daemon.
+		bool IsTokenCached() const;
+
+		// Reads the "exp" claim of a JWT, returns false if the token is malformed or has no expiry.
+		static bool TryGetExpiry(const FString& Token, int64& OutExpiry);
+
+	protected:
+		// Returns the current time as seconds since the Unix epoch, the unit of the "exp" claim.
+		virtual int64 GetUnixTime() const;
+
+	private:
+		void Fetch();
+
+		void OnPayloadToken(const PayloadTokenResponse& Response);
+
+	private:
+		TSharedPtr<FMultiplayRpcTransport> Transport;
+		double ExpiryMarginSeconds;
+		double RefreshAheadSeconds;
+		TOptional<PayloadTokenResponse> CachedResponse;
+		int64 CachedExpiry;
+		int64 NextRefreshAttempt;
+		TArray<FPayloadTokenDelegate> Waiters;
+		bool bInFlight;
+	};
+} // namespace Multiplay
@@ -0,0 +1,206 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayPayloadTokenCache.h"
+#include "MultiplayGameServerSDK/MultiplayRpcTransport.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace Multiplay
+{
+	// Stands in for the SDK daemon, holding every RPC until the test answers it.
+	class FDeferredRpcChannel : public IMultiplayRpcChannel
+	{
+	public:
+		virtual bool IsAvailable() const override { return true; }
+
+		virtual void Call(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcCompleteDelegate& OnComplete) override
+		{
+			PendingCalls.Add(OnComplete);
+		}
+
+		void AnswerToken(const FString& Token)
+		{
+			TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
+			Body->SetStringField(TEXT("token"), Token);
+			Body->SetStringField(TEXT("error"), TEXT(""));
+
+			FString BodyString;
+			const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&BodyString);
+			FJsonSerializer::Serialize(Body, Writer);
+
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetNumberField(TEXT("code"), 200);
+			Object->SetStringField(TEXT("body"), BodyString);
+
+			const FMultiplayRpcCompleteDelegate OnComplete = PendingCalls[0];
+			PendingCalls.RemoveAt(0);
+			OnComplete.ExecuteIfBound(EMultiplayRpcStatus::Succeeded, MakeShared<FJsonValueObject>(Object), FMultiplayRpcBodyPtr());
+		}
+
+	public:
+		TArray<FMultiplayRpcCompleteDelegate> PendingCalls;
+	};
+
+	// Reads the time from a field so that the tests can move it past the expiry margins.
+	class FTestPayloadTokenCache : public FMultiplayPayloadTokenCache
+	{
+	public:
+		using FMultiplayPayloadTokenCache::FMultiplayPayloadTokenCache;
+
+		virtual int64 GetUnixTime() const override { return Now; }
+
+	public:
+		int64 Now = 0;
+	};
+} // namespace Multiplay
+
+BEGIN_DEFINE_SPEC(FMultiplayPayloadTokenCacheSpec, "MultiplayGameServerSDK.PayloadTokenCache", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+// Claims {"exp":1700000000,"sub":"fleet"}.
+const FString TokenWithExpiry = TEXT("eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9.eyJleHAiOjE3MDAwMDAwMDAsInN1YiI6ImZsZWV0In0.c2ln");
+// Claims {"sub":"fleet?"}.
+const FString TokenWithoutExpiry = TEXT("eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9.eyJzdWIiOiJmbGVldD8ifQ.c2ln");
+const int64 Expiry = 1700000000;
+TSharedPtr<Multiplay::FDeferredRpcChannel> Channel;
+TUniquePtr<Multiplay::OpenAPIGameServerApi> GameServerApi;
+TUniquePtr<Multiplay::OpenAPIPayloadApi> PayloadApi;
+TSharedPtr<Multiplay::FMultiplayRpcTransport> Transport;
+TSharedPtr<Multiplay::FTestPayloadTokenCache> Cache;
+int32 Completions;
+FString LastToken;
+Multiplay::FPayloadTokenDelegate MakeDelegate();
+END_DEFINE_SPEC(FMultiplayPayloadTokenCacheSpec)
+
+Multiplay::FPayloadTokenDelegate FMultiplayPayloadTokenCacheSpec::MakeDelegate()
+{
+	return Multiplay::FPayloadTokenDelegate::CreateLambda([this](const Multiplay::PayloadTokenResponse& Response)
+		{
+			++Completions;
+			LastToken = Response.Content.Token;
+		});
+}
+
+void FMultiplayPayloadTokenCacheSpec::Define()
+{
+	BeforeEach([this]()
+		{
+			Channel = MakeShared<Multiplay::FDeferredRpcChannel>();
+			GameServerApi = MakeUnique<Multiplay::OpenAPIGameServerApi>();
+			PayloadApi = MakeUnique<Multiplay::OpenAPIPayloadApi>();
+			Transport = MakeShared<Multiplay::FMultiplayRpcTransport>(Channel, *GameServerApi, *PayloadApi, 2.0f);
+
+			Cache = MakeShared<Multiplay::FTestPayloadTokenCache>(Transport, 30.0f, 60.0f);
+			Cache->Now = Expiry - 600;
+
+			Completions = 0;
+			LastToken.Reset();
+		});
+
+	AfterEach([this]()
+		{
+			Cache.Reset();
+			Transport.Reset();
+			PayloadApi.Reset();
+			GameServerApi.Reset();
+			Channel.Reset();
+		});
+
+	Describe("TryGetExpiry", [this]()
+		{
+			It("should read the exp claim of a token.", [this]()
+				{
+					int64 TokenExpiry = 0;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayPayloadTokenCache::TryGetExpiry(TokenWithExpiry, TokenExpiry)))
+					{
+						TestEqual("Expiry", TokenExpiry, Expiry);
+					}
+				});
+
+			It("should reject tokens that are malformed or have no expiry.", [this]()
+				{
+					int64 TokenExpiry = 0;
+					TestFalseExpr(Multiplay::FMultiplayPayloadTokenCache::TryGetExpiry(TokenWithoutExpiry, TokenExpiry));
+					TestFalseExpr(Multiplay::FMultiplayPayloadTokenCache::TryGetExpiry(TEXT("foo"), TokenExpiry));
+					TestFalseExpr(Multiplay::FMultiplayPayloadTokenCache::TryGetExpiry(TEXT("a.!!!.c"), TokenExpiry));
+				});
+		});
+
+	Describe("PayloadToken", [this]()
+		{
+			It("should coalesce the requests made while a fetch is in flight.", [this]()
+				{
+					Cache->PayloadToken(MakeDelegate());
+					Cache->PayloadToken(MakeDelegate());
+
+					if (MP_TEST_TRUE_EXPR(Channel->PendingCalls.Num() == 1))
+					{
+						Channel->AnswerToken(TokenWithExpiry);
+
+						TestEqual("Completions", Completions, 2);
+						TestEqual("Token", LastToken, TokenWithExpiry);
+					}
+				});
+
+			It("should serve the cached token without contacting the daemon.", [this]()
+				{
+					Cache->PayloadToken(MakeDelegate());
+					Channel->AnswerToken(TokenWithExpiry);
+
+					Cache->PayloadToken(MakeDelegate());
+
+					TestEqual("Completions", Completions, 2);
+					TestEqual("PendingCalls.Num()", Channel->PendingCalls.Num(), 0);
+					TestTrueExpr(Cache->IsTokenCached());
+				});
+
+			It("should fetch a new token once the cached token is within the expiry margin.", [this]()
+				{
+					Cache->PayloadToken(MakeDelegate());
+					Channel->AnswerToken(TokenWithExpiry);
+
+					Cache->Now = Expiry - 20;
+					TestFalseExpr(Cache->IsTokenCached());
+
+					Cache->PayloadToken(MakeDelegate());
+
+					TestEqual("Completions", Completions, 1);
+					TestEqual("PendingCalls.Num()", Channel->PendingCalls.Num(), 1);
+				});
+
+			It("should not cache a token without an expiry.", [this]()
+				{
+					AddExpectedError(TEXT("no readable expiry"), EAutomationExpectedErrorFlags::Contains, 1);
+
+					Cache->PayloadToken(MakeDelegate());
+					Channel->AnswerToken(TokenWithoutExpiry);
+
+					TestEqual("Completions", Completions, 1);
+					TestFalseExpr(Cache->IsTokenCached());
+				});
+		});
+
+	Describe("Tick", [this]()
+		{
+			It("should refresh the token ahead of the expiry margin while still serving the cached token.", [this]()
+				{
+					Cache->PayloadToken(MakeDelegate());
+					Channel->AnswerToken(TokenWithExpiry);
+
+					Cache->Tick(0.0f);
+					TestEqual("PendingCalls.Num()", Channel->PendingCalls.Num(), 0);
+
+					Cache->Now = Expiry - 30 - 60;
+					Cache->Tick(0.0f);
+
+					if (MP_TEST_TRUE_EXPR(Channel->PendingCalls.Num() == 1))
+					{
+						Cache->PayloadToken(MakeDelegate());
+						TestEqual("Completions", Completions, 2);
+
+						Channel->AnswerToken(TokenWithExpiry);
+						TestEqual("Completions", Completions, 2);
+					}
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,314 @@
+#include "MultiplayQueryReceiver.h"
+#include "Common/UdpSocketBuilder.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "MultiplayGameServerSDKLog.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+#include "BSDSockets/SocketsBSD.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace Multiplay
+{
+	TSharedRef<FMultiplayQueryReceiver> FMultiplayQueryReceiver::GetShared()
+	{
+		check(IsInGameThread());
+
+		static TWeakPtr<FMultiplayQueryReceiver> Shared;
+
+		TSharedPtr<FMultiplayQueryReceiver> Receiver = Shared.Pin();
+		if (!Receiver.IsValid())
+		{
+			Receiver = MakeShared<FMultiplayQueryReceiver>();
+			Shared = Receiver;
+		}
+
+		return Receiver.ToSharedRef();
+	}
+
+	FMultiplayQueryReceiver::FMultiplayQueryReceiver()
+		: Thread(nullptr)
+		, bStopping(false)
+	{
+		WakeDescriptors[0] = -1;
+		WakeDescriptors[1] = -1;
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+		int Pipe[2];
+		if (pipe(Pipe) == 0)
+		{
+			for (int Descriptor : Pipe)
+			{
+				fcntl(Descriptor, F_SETFL, fcntl(Descriptor, F_GETFL) | O_NONBLOCK);
+				fcntl(Descriptor, F_SETFD, FD_CLOEXEC);
+			}
+
+			WakeDescriptors[0] = Pipe[0];
+			WakeDescriptors[1] = Pipe[1];
+		}
+		else
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to create the pipe that wakes the query receiver, polling the query ports every %.0f ms."), kIdleSleepSeconds * 1000.0f);
+		}
+#endif
+	}
+
+	FMultiplayQueryReceiver::~FMultiplayQueryReceiver()
+	{
+		if (Thread != nullptr)
+		{
+			Stop();
+			Thread->WaitForCompletion();
+			delete Thread;
+			Thread = nullptr;
+		}
+
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		for (const FBoundSocketPtr& Bound : Sockets)
+		{
+			Bound->Socket->Close();
+			if (SocketSubsystem != nullptr)
+			{
+				SocketSubsystem->DestroySocket(Bound->Socket);
+			}
+		}
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+		for (int32 Descriptor : WakeDescriptors)
+		{
+			if (Descriptor >= 0)
+			{
+				close(Descriptor);
+			}
+		}
+#endif
+	}
+
+	FSocket* FMultiplayQueryReceiver::Bind(int32 Port, FDataFunction OnData)
+	{
+		FScopeLock Lock(&SocketsLock);
+
+		// The sockets are reusable, a second bind to the same port would succeed and take the packets of the first.
+		if (Port != 0 && Sockets.ContainsByPredicate([Port](const FBoundSocketPtr& Bound) { return Bound->Port == Port; }))
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Query port '%d' is already bound by another server in this process."), Port);
+			return nullptr;
+		}
+
+		int32 BufferSize = 2 * 1024 * 1024;
+
+		FSocket* Socket = FUdpSocketBuilder(TEXT("GameServerQueryReceiver"))
+			.AsNonBlocking()
+			.AsReusable()
+			.BoundToAddress(FIPv4Address::Any)
+			.BoundToPort(Port)
+			.WithSendBufferSize(BufferSize)
+			.WithReceiveBufferSize(BufferSize);
+
+		if (Socket == nullptr)
+		{
+			return nullptr;
+		}
+
+		FBoundSocketPtr Bound = MakeShared<FBoundSocket, ESPMode::ThreadSafe>();
+		Bound->Socket = Socket;
+		Bound->Port = Socket->GetPortNo();
+		Bound->OnData = MoveTemp(OnData);
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+		// The platform socket subsystem creates BSD sockets on these platforms.
+		if (WakeDescriptors[0] >= 0)
+		{
+			Bound->Descriptor = static_cast<int32>(static_cast<FSocketBSD*>(Socket)->GetNativeSocket());
+		}
+#endif
+
+		Sockets.Add(Bound);
+
+		if (Thread == nullptr)
+		{
+			Thread = FRunnableThread::Create(this, TEXT("MultiplayQueryReceiver"), 128 * 1024, TPri_AboveNormal);
+		}
+		else
+		{
+			Wake();
+		}
+
+		return Socket;
+	}
+
+	void FMultiplayQueryReceiver::Unbind(FSocket* Socket)
+	{
+		FBoundSocketPtr Bound;
+		{
+			FScopeLock Lock(&SocketsLock);
+
+			const int32 Index = Sockets.IndexOfByPredicate([Socket](const FBoundSocketPtr& Candidate) { return Candidate->Socket == Socket; });
+			if (Index == INDEX_NONE)
+			{
+				return;
+			}
+
+			Bound = Sockets[Index];
+			Bound->bUnbound = true;
+			Sockets.RemoveAt(Index);
+		}
+
+		// The thread may be blocked on the socket, it lets go of it once woken.
+		Wake();
+
+		// Waits for the function of the socket to return, if it is running.
+		FScopeLock DispatchScope(&DispatchLock);
+
+		Socket->Close();
+
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		if (SocketSubsystem != nullptr)
+		{
+			SocketSubsystem->DestroySocket(Socket);
+		}
+	}
+
+	int32 FMultiplayQueryReceiver::GetSocketCount() const
+	{
+		FScopeLock Lock(&SocketsLock);
+		return Sockets.Num();
+	}
+
+	uint32 FMultiplayQueryReceiver::Run()
+	{
+		TArray<FBoundSocketPtr> ReadSockets;
+		while (!bStopping)
+		{
+			{
+				FScopeLock Lock(&SocketsLock);
+				ReadSockets = Sockets;
+			}
+
+			const bool bPolled = WakeDescriptors[0] >= 0;
+			if (bPolled)
+			{
+				WaitForRead(ReadSockets);
+			}
+
+			int32 Count = 0;
+			if (ReadSockets.Num() > 0 && !bStopping)
+			{
+				FScopeLock Lock(&DispatchLock);
+				Count = ReceivePass(ReadSockets);
+			}
+
+			if (!bPolled && Count == 0)
+			{
+				FPlatformProcess::Sleep(kIdleSleepSeconds);
+			}
+		}
+
+		return 0;
+	}
+
+	void FMultiplayQueryReceiver::Stop()
+	{
+		bStopping = true;
+		Wake();
+	}
+
+	void FMultiplayQueryReceiver::WaitForRead(TArray<FBoundSocketPtr>& InOutSockets)
+	{
+#if PLATFORM_UNIX || PLATFORM_MAC
+		TArray<pollfd, TInlineAllocator<8>> Polls;
+
+		pollfd WakePoll;
+		WakePoll.fd = WakeDescriptors[0];
+		WakePoll.events = POLLIN;
+		WakePoll.revents = 0;
+		Polls.Add(WakePoll);
+
+		for (const FBoundSocketPtr& Bound : InOutSockets)
+		{
+			pollfd Poll;
+			Poll.fd = Bound->Descriptor;
+			Poll.events = POLLIN;
+			Poll.revents = 0;
+			Polls.Add(Poll);
+		}
+
+		const int Result = poll(Polls.GetData(), Polls.Num(), static_cast<int>(kPollSeconds * 1000.0f));
+		if (Result <= 0)
+		{
+			InOutSockets.Reset();
+			return;
+		}
+
+		if (Polls[0].revents != 0)
+		{
+			uint8 Buffer[64];
+			while (read(WakeDescriptors[0], Buffer, sizeof(Buffer)) > 0)
+			{
+			}
+		}
+
+		// The descriptor of a socket unbound during the poll may have been reused, ReceivePass skips unbound sockets.
+		for (int32 Index = InOutSockets.Num() - 1; Index >= 0; --Index)
+		{
+			if (Polls[Index + 1].revents == 0)
+			{
+				InOutSockets.RemoveAt(Index, 1, false);
+			}
+		}
+#endif
+	}
+
+	int32 FMultiplayQueryReceiver::ReceivePass(const TArray<FBoundSocketPtr>& ReadSockets)
+	{
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		if (SocketSubsystem == nullptr)
+		{
+			return 0;
+		}
+
+		TSharedRef<FInternetAddr> Sender = SocketSubsystem->CreateInternetAddr();
+
+		int32 Count = 0;
+		for (const FBoundSocketPtr& Bound : ReadSockets)
+		{
+			uint32 PendingSize = 0;
+			for (int32 Packet = 0; Packet < kMaxPacketsPerPass && !Bound->bUnbound && Bound->Socket->HasPendingData(PendingSize); ++Packet)
+			{
+				FArrayReaderPtr Reader = MakeShared<FArrayReader, ESPMode::ThreadSafe>(true);
+				Reader->SetNumUninitialized(FMath::Min(PendingSize, static_cast<uint32>(kMaxPacketSize)));
+
+				int32 BytesRead = 0;
+				if (!Bound->Socket->RecvFrom(Reader->GetData(), Reader->Num(), BytesRead, *Sender))
+				{
+					break;
+				}
+
+				Reader->RemoveAt(BytesRead, Reader->Num() - BytesRead, false);
+				Bound->OnData(Reader, FIPv4Endpoint(Sender));
+				++Count;
+			}
+		}
+
+		return Count;
+	}
+
+	void FMultiplayQueryReceiver::Wake()
+	{
+#if PLATFORM_UNIX || PLATFORM_MAC
+		if (WakeDescriptors[1] >= 0)
+		{
+			// A full pipe already wakes the thread.
+			const uint8 Byte = 0;
+			const ssize_t Written = write(WakeDescriptors[1], &Byte, 1);
+			(void)Written;
+		}
+#endif
+	}
+} // namespace Multiplay
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/ArrayReader.h"
+#include <atomic>
+
+class FRunnableThread;
+class FSocket;
+
+namespace Multiplay
+{
+	// Receives server queries on several query ports from one background thread, for processes hosting several servers.
+	//
+	// Each port is bound to its own socket and the packets received on it are passed to the function it was bound with,
+	// on the receiver thread. On Linux and Mac the thread blocks on all the sockets with a single poll, which a pipe
+	// interrupts when sockets are bound or unbound and on shutdown. On other platforms it reads every socket in turn and
+	// sleeps briefly when none had a packet waiting. The functions are called without the lock Bind takes, but Unbind does
+	// not return while the function of the socket is running, so the function may reference an object that unbinds it
+	// before it is destroyed.
+	class FMultiplayQueryReceiver : private FRunnable
+	{
+	public:
+		using FDataFunction = TFunction<void(const FArrayReaderPtr& /* Data */, const FIPv4Endpoint& /* Sender */)>;
+
+		// The longest the thread blocks in a poll without being woken, a safety net for a lost wake-up.
+		static constexpr float kPollSeconds = 1.0f;
+
+		// Where the sockets cannot be polled, the thread sleeps for this long when no socket had a packet waiting.
+		static constexpr float kIdleSleepSeconds = 0.005f;
+
+		// A socket is read at most this many times in a row, so that a flooded port cannot delay the others.
+		static constexpr int32 kMaxPacketsPerPass = 16;
+
+		// The largest payload of a UDP packet.
+		static constexpr int32 kMaxPacketSize = 65507;
+
+	public:
+		// The receiver shared by every game instance in the process, created on first use and destroyed with its last reference.
+		static TSharedRef<FMultiplayQueryReceiver> GetShared();
+
+		FMultiplayQueryReceiver();
+		virtual ~FMultiplayQueryReceiver();
+
+		// Binds a socket to the port and passes it the packets received on it. Port 0 binds an ephemeral port.
+		// Returns the socket, which replies may be sent from until it is unbound, or null if the port could not be bound.
+		FSocket* Bind(int32 Port, FDataFunction OnData);
+
+		// Stops receiving on the socket and destroys it.
+		void Unbind(FSocket* Socket);
+
+		int32 GetSocketCount() const;
+
+	private:
+		// FRunnable
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+
+	private:
+		struct FBoundSocket
+		{
+			FSocket* Socket = nullptr;
+			int32 Port = 0;
+			// The native descriptor polled by the thread, -1 where the sockets are not polled.
+			int32 Descriptor = -1;
+			FDataFunction OnData;
+			// Set by Unbind before the socket is destroyed, the thread skips the socket from then on.
+			std::atomic<bool> bUnbound{ false };
+		};
+
+		using FBoundSocketPtr = TSharedPtr<FBoundSocket, ESPMode::ThreadSafe>;
+
+		// Blocks until one of the sockets has a packet waiting or the thread is woken, and keeps only the readable sockets.
+		void WaitForRead(TArray<FBoundSocketPtr>& InOutSockets);
+
+		// Reads the sockets and passes their packets on, returns the number of packets received. Called with DispatchLock held.
+		int32 ReceivePass(const TArray<FBoundSocketPtr>& ReadSockets);
+
+		// Interrupts the poll of the thread, so that it picks up bound and unbound sockets.
+		void Wake();
+
+	private:
+		// Guards the list of sockets, it is not held while the sockets are read.
+		mutable FCriticalSection SocketsLock;
+		TArray<FBoundSocketPtr> Sockets;
+
+		// Held while the sockets are read and their functions run, Unbind takes it to wait for the function of its socket.
+		FCriticalSection DispatchLock;
+
+		// The read and write ends of the pipe that wakes the thread, -1 where the sockets are not polled.
+		int32 WakeDescriptors[2];
+
+		FRunnableThread* Thread;
+		std::atomic<bool> bStopping;
+	};
+} // namespace Multiplay
@@ -0,0 +1,167 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayQueryReceiver.h"
+#include "Common/UdpSocketBuilder.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayQueryReceiverSpec, "MultiplayGameServerSDK.QueryReceiver", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TSharedPtr<Multiplay::FMultiplayQueryReceiver> Receiver;
+FSocket* Sender;
+void SendTo(FSocket* Socket, uint8 Value);
+bool WaitFor(TFunction<bool()> Condition);
+END_DEFINE_SPEC(FMultiplayQueryReceiverSpec)
+
+// Sends a one byte packet to the port the socket is bound to on the loopback address.
+void FMultiplayQueryReceiverSpec::SendTo(FSocket* Socket, uint8 Value)
+{
+	TSharedRef<FInternetAddr> Address = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+	Address->SetIp(FIPv4Address(127, 0, 0, 1).Value);
+	Address->SetPort(Socket->GetPortNo());
+
+	int32 BytesSent = 0;
+	Sender->SendTo(&Value, 1, BytesSent, *Address);
+}
+
+// Waits up to a second for the receiver thread to satisfy the condition.
+bool FMultiplayQueryReceiverSpec::WaitFor(TFunction<bool()> Condition)
+{
+	for (int32 Attempt = 0; Attempt < 100; ++Attempt)
+	{
+		if (Condition())
+		{
+			return true;
+		}
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	return Condition();
+}
+
+void FMultiplayQueryReceiverSpec::Define()
+{
+	BeforeEach([this]()
+		{
+			Receiver = MakeShared<Multiplay::FMultiplayQueryReceiver>();
+			Sender = FUdpSocketBuilder(TEXT("QueryReceiverSpecSender")).BoundToPort(0);
+		});
+
+	AfterEach([this]()
+		{
+			Receiver.Reset();
+
+			if (Sender != nullptr)
+			{
+				ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Sender);
+				Sender = nullptr;
+			}
+		});
+
+	It("should pass each packet to the function of the port it was received on.", [this]()
+		{
+			std::atomic<int32> FirstValue(0);
+			std::atomic<int32> SecondValue(0);
+
+			FSocket* First = Receiver->Bind(0, [&FirstValue](const FArrayReaderPtr& Data, const FIPv4Endpoint&) { FirstValue = (*Data)[0]; });
+			FSocket* Second = Receiver->Bind(0, [&SecondValue](const FArrayReaderPtr& Data, const FIPv4Endpoint&) { SecondValue = (*Data)[0]; });
+			if (!MP_TEST_TRUE_EXPR(First != nullptr && Second != nullptr))
+			{
+				return;
+			}
+			TestEqual(TEXT("Sockets"), Receiver->GetSocketCount(), 2);
+
+			SendTo(First, 1);
+			SendTo(Second, 2);
+
+			TestTrueExpr(WaitFor([&FirstValue, &SecondValue]() { return FirstValue == 1 && SecondValue == 2; }));
+
+			Receiver->Unbind(First);
+			Receiver->Unbind(Second);
+		});
+
+	It("should not bind a port that is already bound.", [this]()
+		{
+			FSocket* First = Receiver->Bind(0, [](const FArrayReaderPtr&, const FIPv4Endpoint&) {});
+			if (!MP_TEST_TRUE_EXPR(First != nullptr))
+			{
+				return;
+			}
+
+			TestTrueExpr(Receiver->Bind(First->GetPortNo(), [](const FArrayReaderPtr&, const FIPv4Endpoint&) {}) == nullptr);
+			TestEqual(TEXT("Sockets"), Receiver->GetSocketCount(), 1);
+
+			Receiver->Unbind(First);
+		});
+
+	It("should bind another port while a function is running.", [this]()
+		{
+			FEvent* Release = FPlatformProcess::GetSynchEventFromPool(true);
+			std::atomic<bool> bEntered(false);
+			std::atomic<bool> bReturned(false);
+
+			FSocket* Blocked = Receiver->Bind(0, [Release, &bEntered, &bReturned](const FArrayReaderPtr&, const FIPv4Endpoint&)
+				{
+					bEntered = true;
+					Release->Wait(FTimespan::FromSeconds(5.0));
+					bReturned = true;
+				});
+			if (MP_TEST_TRUE_EXPR(Blocked != nullptr))
+			{
+				SendTo(Blocked, 1);
+				if (MP_TEST_TRUE_EXPR(WaitFor([&bEntered]() { return bEntered.load(); })))
+				{
+					FSocket* Other = Receiver->Bind(0, [](const FArrayReaderPtr&, const FIPv4Endpoint&) {});
+					TestTrueExpr(Other != nullptr);
+					TestFalseExpr(bReturned.load());
+
+					Release->Trigger();
+					if (Other != nullptr)
+					{
+						Receiver->Unbind(Other);
+					}
+				}
+
+				// Unbind waits for the function to return.
+				Release->Trigger();
+				Receiver->Unbind(Blocked);
+				TestTrueExpr(!bEntered || bReturned);
+			}
+
+			FPlatformProcess::ReturnSynchEventToPool(Release);
+		});
+
+	It("should stop passing on packets once the socket has been unbound.", [this]()
+		{
+			std::atomic<int32> Packets(0);
+			FSocket* Kept = Receiver->Bind(0, [&Packets](const FArrayReaderPtr&, const FIPv4Endpoint&) { ++Packets; });
+			FSocket* Unbound = Receiver->Bind(0, [this](const FArrayReaderPtr&, const FIPv4Endpoint&) { AddError(TEXT("A packet was passed to an unbound socket.")); });
+			if (!MP_TEST_TRUE_EXPR(Kept != nullptr && Unbound != nullptr))
+			{
+				return;
+			}
+
+			const int32 UnboundPort = Unbound->GetPortNo();
+			Receiver->Unbind(Unbound);
+			TestEqual(TEXT("Sockets"), Receiver->GetSocketCount(), 1);
+
+			TSharedRef<FInternetAddr> Address = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+			Address->SetIp(FIPv4Address(127, 0, 0, 1).Value);
+			Address->SetPort(UnboundPort);
+			uint8 Value = 1;
+			int32 BytesSent = 0;
+			Sender->SendTo(&Value, 1, BytesSent, *Address);
+
+			// The packet sent to the kept socket afterwards shows that the receiver has had a chance to read both ports.
+			SendTo(Kept, 2);
+			TestTrueExpr(WaitFor([&Packets]() { return Packets == 1; }));
+
+			Receiver->Unbind(Kept);
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,151 @@
+#include "MultiplayReadinessReconciler.h"
+#include "MultiplayRetryPolicy.h"
+#include "MultiplayGameServerSDKLog.h"
+#include "HAL/PlatformTime.h"
+
+namespace Multiplay
+{
+	namespace
+	{
+		const TCHAR* ReadinessToString(FMultiplayReadinessReconciler::EReadiness State)
+		{
+			return State == FMultiplayReadinessReconciler::EReadiness::Ready ? TEXT("ready") : TEXT("unready");
+		}
+	} // namespace
+
+	FMultiplayReadinessReconciler::FMultiplayReadinessReconciler(FSendFunction InSend)
+		: Send(MoveTemp(InSend))
+		, Desired(EReadiness::Unknown)
+		, Confirmed(EReadiness::Unknown)
+		, InFlight(EReadiness::Unknown)
+		, CallCount(0)
+		, ResendBaseDelay(-1.0)
+		, ResendMaxDelay(0.0)
+		, ResendDelay(0.0)
+		, ResendAt(0.0)
+	{
+	}
+
+	bool FMultiplayReadinessReconciler::Tick(float DeltaTime)
+	{
+		Update(FPlatformTime::Seconds());
+		return true;
+	}
+
+	void FMultiplayReadinessReconciler::EnableResend(float BaseDelaySeconds, float MaxDelaySeconds)
+	{
+		ResendBaseDelay = FMath::Max(0.0f, BaseDelaySeconds);
+		ResendMaxDelay = FMath::Max(BaseDelaySeconds, MaxDelaySeconds);
+	}
+
+	void FMultiplayReadinessReconciler::Update(double Now)
+	{
+		if (ResendAt > 0.0 && Now >= ResendAt)
+		{
+			ResendAt = 0.0;
+			Pump();
+		}
+	}
+
+	void FMultiplayReadinessReconciler::SetDesired(bool bReady, FCompleteFunction OnComplete)
+	{
+		const EReadiness State = bReady ? EReadiness::Ready : EReadiness::Unready;
+		const EReadiness Previous = Desired;
+
+		Desired = State;
+		GetWaiters(State).Add(MoveTemp(OnComplete));
+
+		// A declaration is sent without waiting for the re-send of an earlier one.
+		ResendAt = 0.0;
+		ResendDelay = 0.0;
+
+		// A declaration whose call is in flight still receives the result of that call.
+		if (Previous != EReadiness::Unknown && Previous != State && Previous != InFlight)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("The server was declared %s before it was made %s, dropping the earlier declaration."), ReadinessToString(State), ReadinessToString(Previous));
+
+			FMultiplayErrorResponse Superseded;
+			Superseded.Status = kSupersededStatus;
+			Superseded.Title = TEXT("Superseded");
+			Superseded.Detail = FString::Printf(TEXT("The server was declared %s before it was made %s."), ReadinessToString(State), ReadinessToString(Previous));
+			CompleteWaiters(Previous, false, Superseded);
+		}
+
+		Pump();
+	}
+
+	void FMultiplayReadinessReconciler::Invalidate()
+	{
+		Confirmed = EReadiness::Unknown;
+	}
+
+	void FMultiplayReadinessReconciler::Pump()
+	{
+		if (InFlight != EReadiness::Unknown || Desired == EReadiness::Unknown || ResendAt > 0.0)
+		{
+			return;
+		}
+
+		if (Desired == Confirmed)
+		{
+			CompleteWaiters(Desired, true, FMultiplayErrorResponse());
+			return;
+		}
+
+		InFlight = Desired;
+		++CallCount;
+
+		const EReadiness State = InFlight;
+		TWeakPtr<FMultiplayReadinessReconciler> WeakThis = AsShared();
+
+		Send(State == EReadiness::Ready, [WeakThis, State](bool bSucceeded, const FMultiplayErrorResponse& ErrorResponse)
+			{
+				if (TSharedPtr<FMultiplayReadinessReconciler> This = WeakThis.Pin())
+				{
+					This->OnCallComplete(State, bSucceeded, ErrorResponse);
+				}
+			});
+	}
+
+	void FMultiplayReadinessReconciler::OnCallComplete(EReadiness State, bool bSucceeded, const FMultiplayErrorResponse& ErrorResponse)
+	{
+		InFlight = EReadiness::Unknown;
+		Confirmed = bSucceeded ? State : EReadiness::Unknown;
+
+		if (bSucceeded)
+		{
+			ResendDelay = 0.0;
+		}
+		else if (Desired == State)
+		{
+			const bool bTransient = FMultiplayRetryPolicy::IsTransientFailure(static_cast<EHttpResponseCodes::Type>(ErrorResponse.Status));
+			if (ResendBaseDelay >= 0.0 && bTransient)
+			{
+				ResendDelay = ResendDelay > 0.0 ? FMath::Min(ResendMaxDelay, ResendDelay * 2.0) : ResendBaseDelay;
+				ResendAt = FPlatformTime::Seconds() + ResendDelay;
+
+				UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("Failed to make the server %s, sending it again in %.2f seconds."), ReadinessToString(State), ResendDelay);
+			}
+			else
+			{
+				// Without re-sending, the transport is expected to have retried the call already.
+				Desired = EReadiness::Unknown;
+			}
+		}
+
+		CompleteWaiters(State, bSucceeded, ErrorResponse);
+		Pump();
+	}
+
+	void FMultiplayReadinessReconciler::CompleteWaiters(EReadiness State, bool bSucceeded, const FMultiplayErrorResponse& ErrorResponse)
+	{
+		// Moved out first, as a waiter may declare the readiness again.
+		TArray<FCompleteFunction> Waiters = MoveTemp(GetWaiters(State));
+		GetWaiters(State).Reset();
+
+		for (const FCompleteFunction& Waiter : Waiters)
+		{
+			Waiter(bSucceeded, ErrorResponse);
+		}
+	}
+} // namespace Multiplay
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayErrorResponse.h"
+#include "Utils/MultiplayTicker.h"
+
+namespace Multiplay
+{
+	// Moves the server towards the readiness most recently declared by the game, with at most one call to the daemon in flight.
+	//
+	// Declaring the readiness the daemon has already confirmed completes without a call. A declaration made while a call
+	// is in flight waits for it, and only the latest declaration is sent once it completes. Declarations superseded before
+	// their call was sent fail with a 409 status, and those attached to a call receive its result.
+	//
+	// A failed call fails the declarations attached to it either way. By default the declaration is then dropped, for use
+	// with a transport that has already retried the call. Once re-sending is enabled, a call that failed transiently is sent
+	// again while its readiness is still desired, after a delay that doubles with every failure up to a maximum, so that
+	// the readiness the daemon holds does not stay apart from the declared one. A new declaration is sent without waiting.
+	class FMultiplayReadinessReconciler : public FMultiplayTickerObjectBase, public TSharedFromThis<FMultiplayReadinessReconciler>
+	{
+	public:
+		enum class EReadiness : uint8
+		{
+			Unknown,
+			Ready,
+			Unready,
+		};
+
+		using FCompleteFunction = TFunction<void(bool /* bSucceeded */, const FMultiplayErrorResponse& /* ErrorResponse */)>;
+
+		// Sends the call that moves the server to the given readiness. OnComplete must be invoked exactly once.
+		using FSendFunction = TFunction<void(bool /* bReady */, FCompleteFunction /* OnComplete */)>;
+
+		// The status a superseded declaration fails with.
+		static constexpr int32 kSupersededStatus = 409;
+
+	public:
+		explicit FMultiplayReadinessReconciler(FSendFunction Send);
+
+		virtual bool Tick(float DeltaTime) override;
+
+		// Re-sends failed calls after BaseDelaySeconds, doubled after every consecutive failure up to MaxDelaySeconds.
+		void EnableResend(float BaseDelaySeconds, float MaxDelaySeconds);
+
+		// Sends the desired readiness again if a re-send is due at Now.
+		void Update(double Now);
+
+		// Declares the readiness the server should have. OnComplete is invoked once the daemon has confirmed it, or the declaration has failed or been superseded.
+		void SetDesired(bool bReady, FCompleteFunction OnComplete);
+
+		// Forgets the confirmed readiness, so that the next declaration is sent even if it matches. Used when the daemon changes the readiness itself.
+		void Invalidate();
+
+		EReadiness GetDesired() const { return Desired; }
+		EReadiness GetConfirmed() const { return Confirmed; }
+		bool IsCallInFlight() const { return InFlight != EReadiness::Unknown; }
+
+		// The number of calls sent to the daemon.
+		int64 GetCallCount() const { return CallCount; }
+
+		// The delay before the pending re-send, 0 if none is pending.
+		double GetResendDelay() const { return ResendAt > 0.0 ? ResendDelay : 0.0; }
+
+	private:
+		void Pump();
+		void OnCallComplete(EReadiness State, bool bSucceeded, const FMultiplayErrorResponse& ErrorResponse);
+		void CompleteWaiters(EReadiness State, bool bSucceeded, const FMultiplayErrorResponse& ErrorResponse);
+
+		TArray<FCompleteFunction>& GetWaiters(EReadiness State) { return State == EReadiness::Ready ? ReadyWaiters : UnreadyWaiters; }
+
+	private:
+		FSendFunction Send;
+		EReadiness Desired;
+		EReadiness Confirmed;
+		EReadiness InFlight;
+		TArray<FCompleteFunction> ReadyWaiters;
+		TArray<FCompleteFunction> UnreadyWaiters;
+		int64 CallCount;
+
+		// Re-sending is disabled while the base delay is negative.
+		double ResendBaseDelay;
+		double ResendMaxDelay;
+		double ResendDelay;
+		// The time at which the desired readiness is sent again, 0 if no re-send is pending.
+		double ResendAt;
+	};
+} // namespace Multiplay
@@ -0,0 +1,234 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayReadinessReconciler.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayReadinessReconcilerSpec, "MultiplayGameServerSDK.ReadinessReconciler", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+using EReadiness = Multiplay::FMultiplayReadinessReconciler::EReadiness;
+TSharedPtr<Multiplay::FMultiplayReadinessReconciler> Reconciler;
+TArray<bool> SentCalls;
+TArray<Multiplay::FMultiplayReadinessReconciler::FCompleteFunction> PendingCalls;
+TArray<int32> Results;
+Multiplay::FMultiplayReadinessReconciler::FCompleteFunction RecordResult();
+void CompleteCall(bool bSucceeded, int32 Status = 200);
+END_DEFINE_SPEC(FMultiplayReadinessReconcilerSpec)
+
+// Records the status each declaration completes with, 200 for success.
+Multiplay::FMultiplayReadinessReconciler::FCompleteFunction FMultiplayReadinessReconcilerSpec::RecordResult()
+{
+	return [this](bool bSucceeded, const FMultiplayErrorResponse& ErrorResponse)
+	{
+		Results.Add(bSucceeded ? 200 : ErrorResponse.Status);
+	};
+}
+
+// Completes the oldest call sent to the stand-in daemon.
+void FMultiplayReadinessReconcilerSpec::CompleteCall(bool bSucceeded, int32 Status)
+{
+	Multiplay::FMultiplayReadinessReconciler::FCompleteFunction OnComplete = MoveTemp(PendingCalls[0]);
+	PendingCalls.RemoveAt(0);
+
+	FMultiplayErrorResponse ErrorResponse;
+	ErrorResponse.Status = Status;
+	OnComplete(bSucceeded, ErrorResponse);
+}
+
+void FMultiplayReadinessReconcilerSpec::Define()
+{
+	BeforeEach([this]()
+		{
+			SentCalls.Reset();
+			PendingCalls.Reset();
+			Results.Reset();
+
+			Reconciler = MakeShared<Multiplay::FMultiplayReadinessReconciler>([this](bool bReady, Multiplay::FMultiplayReadinessReconciler::FCompleteFunction OnComplete)
+				{
+					SentCalls.Add(bReady);
+					PendingCalls.Add(MoveTemp(OnComplete));
+				});
+		});
+
+	AfterEach([this]()
+		{
+			PendingCalls.Reset();
+			Reconciler.Reset();
+		});
+
+	It("should send a declaration and complete it with the result of the call.", [this]()
+		{
+			Reconciler->SetDesired(true, RecordResult());
+			MP_TEST_TRUE_EXPR(SentCalls.Num() == 1);
+			TestTrueExpr(SentCalls[0]);
+			TestTrueExpr(Results.Num() == 0);
+
+			CompleteCall(true);
+			TestTrueExpr(Results.Num() == 1 && Results[0] == 200);
+			TestTrueExpr(Reconciler->GetConfirmed() == EReadiness::Ready);
+			TestFalseExpr(Reconciler->IsCallInFlight());
+		});
+
+	It("should complete a declaration of the confirmed readiness without a call.", [this]()
+		{
+			Reconciler->SetDesired(true, RecordResult());
+			CompleteCall(true);
+
+			Reconciler->SetDesired(true, RecordResult());
+			TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(1));
+			TestTrueExpr(Results.Num() == 2 && Results[1] == 200);
+		});
+
+	It("should attach repeated declarations to the call in flight.", [this]()
+		{
+			Reconciler->SetDesired(true, RecordResult());
+			Reconciler->SetDesired(true, RecordResult());
+			Reconciler->SetDesired(true, RecordResult());
+			TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(1));
+
+			CompleteCall(true);
+			TestTrueExpr(Results.Num() == 3);
+			TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(1));
+		});
+
+	It("should send only the latest declaration once the call in flight completes.", [this]()
+		{
+			Reconciler->SetDesired(true, RecordResult());
+			Reconciler->SetDesired(false, RecordResult());
+			Reconciler->SetDesired(true, RecordResult());
+			Reconciler->SetDesired(false, RecordResult());
+
+			// The second unready superseded the ready declared after the first.
+			MP_TEST_TRUE_EXPR(Results.Num() == 1);
+			TestEqual(TEXT("Superseded"), Results[0], Multiplay::FMultiplayReadinessReconciler::kSupersededStatus);
+
+			CompleteCall(true);
+			MP_TEST_TRUE_EXPR(SentCalls.Num() == 2);
+			TestFalseExpr(SentCalls[1]);
+
+			CompleteCall(true);
+			TestTrueExpr(Results.Num() == 4);
+			TestTrueExpr(Reconciler->GetConfirmed() == EReadiness::Unready);
+			TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(2));
+		});
+
+	It("should not send anything when the readiness returns to the call in flight.", [this]()
+		{
+			Reconciler->SetDesired(true, RecordResult());
+			Reconciler->SetDesired(false, RecordResult());
+			Reconciler->SetDesired(true, RecordResult());
+
+			CompleteCall(true);
+			TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(1));
+			TestTrueExpr(Results.Num() == 3);
+			TestTrueExpr(Results.Contains(Multiplay::FMultiplayReadinessReconciler::kSupersededStatus));
+		});
+
+	It("should fail the declaration and forget the readiness when the call fails.", [this]()
+		{
+			Reconciler->SetDesired(true, RecordResult());
+			CompleteCall(false, 503);
+
+			TestTrueExpr(Results.Num() == 1 && Results[0] == 503);
+			TestTrueExpr(Reconciler->GetConfirmed() == EReadiness::Unknown);
+			TestTrueExpr(Reconciler->GetDesired() == EReadiness::Unknown);
+			TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(1));
+
+			Reconciler->SetDesired(true, RecordResult());
+			TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(2));
+		});
+
+	Describe("with re-sending enabled", [this]()
+		{
+			BeforeEach([this]()
+				{
+					Reconciler->EnableResend(1.0f, 3.0f);
+				});
+
+			It("should send a declaration whose call failed again, doubling the delay up to the maximum.", [this]()
+				{
+					Reconciler->SetDesired(true, RecordResult());
+					CompleteCall(false, 503);
+
+					TestTrueExpr(Results.Num() == 1 && Results[0] == 503);
+					TestTrueExpr(Reconciler->GetDesired() == EReadiness::Ready);
+					TestEqual(TEXT("Delay"), Reconciler->GetResendDelay(), 1.0);
+
+					// The re-send is not due yet.
+					Reconciler->Update(FPlatformTime::Seconds());
+					TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(1));
+
+					const double Later = FPlatformTime::Seconds() + 60.0;
+					const double ExpectedDelays[] = { 2.0, 3.0 };
+					for (const double ExpectedDelay : ExpectedDelays)
+					{
+						Reconciler->Update(Later);
+						MP_TEST_TRUE_EXPR(PendingCalls.Num() == 1);
+						TestTrueExpr(SentCalls.Last());
+
+						CompleteCall(false, 0);
+						TestEqual(TEXT("Delay"), Reconciler->GetResendDelay(), ExpectedDelay);
+					}
+
+					Reconciler->Update(Later);
+					MP_TEST_TRUE_EXPR(PendingCalls.Num() == 1);
+					CompleteCall(true);
+
+					TestTrueExpr(Reconciler->GetConfirmed() == EReadiness::Ready);
+					TestEqual(TEXT("Delay"), Reconciler->GetResendDelay(), 0.0);
+					TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(4));
+					TestTrueExpr(Results.Num() == 1);
+				});
+
+			It("should drop a declaration the daemon rejected.", [this]()
+				{
+					Reconciler->SetDesired(true, RecordResult());
+					CompleteCall(false, 404);
+
+					TestTrueExpr(Reconciler->GetDesired() == EReadiness::Unknown);
+					TestEqual(TEXT("Delay"), Reconciler->GetResendDelay(), 0.0);
+				});
+
+			It("should send a new declaration without waiting for the re-send of the failed one.", [this]()
+				{
+					Reconciler->SetDesired(true, RecordResult());
+					CompleteCall(false, 503);
+
+					Reconciler->SetDesired(false, RecordResult());
+					MP_TEST_TRUE_EXPR(SentCalls.Num() == 2);
+					TestFalseExpr(SentCalls[1]);
+
+					CompleteCall(true);
+					Reconciler->Update(FPlatformTime::Seconds() + 60.0);
+					TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(2));
+					TestTrueExpr(Reconciler->GetConfirmed() == EReadiness::Unready);
+				});
+		});
+
+	It("should send a matching declaration again once invalidated.", [this]()
+		{
+			Reconciler->SetDesired(true, RecordResult());
+			CompleteCall(true);
+
+			Reconciler->Invalidate();
+			Reconciler->SetDesired(true, RecordResult());
+			TestEqual(TEXT("Calls"), Reconciler->GetCallCount(), static_cast<int64>(2));
+		});
+
+	It("should allow a declaration to be made from a completion.", [this]()
+		{
+			Reconciler->SetDesired(true, [this](bool bSucceeded, const FMultiplayErrorResponse&)
+				{
+					Reconciler->SetDesired(false, RecordResult());
+				});
+
+			CompleteCall(true);
+			MP_TEST_TRUE_EXPR(SentCalls.Num() == 2);
+			TestFalseExpr(SentCalls[1]);
+
+			CompleteCall(true);
+			TestTrueExpr(Results.Num() == 1 && Results[0] == 200);
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
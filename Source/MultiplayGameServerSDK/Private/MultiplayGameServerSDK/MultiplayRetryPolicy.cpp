@@ -0,0 +1,108 @@
+#include "MultiplayRetryPolicy.h"
+#include "MultiplayGameServerSDKLog.h"
+
+namespace Multiplay
+{
+	FMultiplayRetryPolicy::FMultiplayRetryPolicy(int32 InMaxAttempts, float InBaseDelaySeconds, float InMaxDelaySeconds, int32 InBreakerFailureThreshold, float InBreakerOpenSeconds, int32 Seed)
+		: MaxAttempts(FMath::Max(1, InMaxAttempts))
+		, BaseDelaySeconds(FMath::Max(0.0f, InBaseDelaySeconds))
+		, MaxDelaySeconds(FMath::Max(InBaseDelaySeconds, InMaxDelaySeconds))
+		, BreakerFailureThreshold(FMath::Max(0, InBreakerFailureThreshold))
+		, BreakerOpenSeconds(FMath::Max(0.0f, InBreakerOpenSeconds))
+		, Random(Seed)
+		, CircuitState(ECircuitState::Closed)
+		, ConsecutiveFailures(0)
+		, OpenUntil(0.0)
+	{
+	}
+
+	void FMultiplayRetryPolicy::SetOperation(const FString& Method, const FOperation& Operation)
+	{
+		Operations.Add(Method, Operation);
+	}
+
+	const FMultiplayRetryPolicy::FOperation& FMultiplayRetryPolicy::GetOperation(const FString& Method) const
+	{
+		const FOperation* Operation = Operations.Find(Method);
+		return Operation ? *Operation : DefaultOperation;
+	}
+
+	bool FMultiplayRetryPolicy::IsTransientFailure(EHttpResponseCodes::Type Code)
+	{
+		switch (Code)
+		{
+		case EHttpResponseCodes::Unknown:
+		case EHttpResponseCodes::RequestTimeout:
+		case EHttpResponseCodes::ServerError:
+		case EHttpResponseCodes::BadGateway:
+		case EHttpResponseCodes::ServiceUnavail:
+		case EHttpResponseCodes::GatewayTimeout:
+			return true;
+		default:
+			// Too Many Requests is not part of EHttpResponseCodes on every supported engine version.
+			return static_cast<int32>(Code) == 429;
+		}
+	}
+
+	double FMultiplayRetryPolicy::NextDelay(double PreviousDelay)
+	{
+		const double Upper = FMath::Max(BaseDelaySeconds, PreviousDelay * 3.0);
+		return FMath::Min(MaxDelaySeconds, BaseDelaySeconds + Random.GetFraction() * (Upper - BaseDelaySeconds));
+	}
+
+	bool FMultiplayRetryPolicy::ShouldRetry(const FString& Method, int32 AttemptsMade, double Now, double Delay, double Deadline) const
+	{
+		return GetOperation(Method).bRetrySafe && AttemptsMade < MaxAttempts && Now + Delay < Deadline;
+	}
+
+	bool FMultiplayRetryPolicy::AllowRequest(double Now)
+	{
+		switch (CircuitState)
+		{
+		case ECircuitState::Open:
+		{
+			if (Now < OpenUntil)
+			{
+				return false;
+			}
+
+			// The call that finds the circuit open for long enough is the probe, later calls fail fast until it completes.
+			CircuitState = ECircuitState::HalfOpen;
+			return true;
+		}
+		case ECircuitState::HalfOpen:
+			return false;
+		default:
+			return true;
+		}
+	}
+
+	void FMultiplayRetryPolicy::RecordSuccess()
+	{
+		if (CircuitState != ECircuitState::Closed)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("The SDK daemon is reachable again, closing the circuit."));
+		}
+
+		CircuitState = ECircuitState::Closed;
+		ConsecutiveFailures = 0;
+	}
+
+	void FMultiplayRetryPolicy::RecordFailure(double Now)
+	{
+		++ConsecutiveFailures;
+
+		if (BreakerFailureThreshold == 0)
+		{
+			return;
+		}
+
+		if (CircuitState == ECircuitState::HalfOpen || (CircuitState == ECircuitState::Closed && ConsecutiveFailures >= BreakerFailureThreshold))
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("The SDK daemon failed %d consecutive calls, failing calls fast for %.2f seconds."), ConsecutiveFailures, BreakerOpenSeconds);
+
+			CircuitState = ECircuitState::Open;
+			OpenUntil = Now + BreakerOpenSeconds;
+		}
+	}
+} // namespace Multiplay
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Math/RandomStream.h"
+
+namespace Multiplay
+{
+	// Decides whether and when an HTTP call to the SDK daemon is retried, and fails calls fast while the daemon is down.
+	//
+	// Every operation has a deadline that bounds its total latency, retries included. Only operations registered as
+	// retry-safe are retried, and only after a response that indicates a transient failure. The delay before each retry
+	// uses decorrelated jitter: a random value between the base delay and three times the previous delay, capped at the
+	// maximum delay, so that servers sharing a host do not retry in lockstep.
+	//
+	// After BreakerFailureThreshold consecutive transient failures the circuit opens and calls fail without being sent
+	// for BreakerOpenSeconds. A single probe call is then let through, which closes the circuit if it succeeds and opens
+	// it again otherwise.
+	class FMultiplayRetryPolicy
+	{
+	public:
+		struct FOperation
+		{
+			// The number of seconds after which the operation fails, retries included.
+			double DeadlineSeconds = 10.0;
+			// Whether the operation is idempotent or otherwise safe to send more than once.
+			bool bRetrySafe = false;
+		};
+
+		enum class ECircuitState
+		{
+			Closed,
+			Open,
+			HalfOpen,
+		};
+
+	public:
+		FMultiplayRetryPolicy(int32 MaxAttempts, float BaseDelaySeconds, float MaxDelaySeconds, int32 BreakerFailureThreshold, float BreakerOpenSeconds, int32 Seed = 0);
+
+		void SetOperation(const FString& Method, const FOperation& Operation);
+		const FOperation& GetOperation(const FString& Method) const;
+
+		// Returns true if a response with this code indicates a failure that may not recur, such as a timeout or an overloaded daemon.
+		static bool IsTransientFailure(EHttpResponseCodes::Type Code);
+
+		// Returns the delay before the next retry given the delay before the previous one, which is 0 before the first retry.
+		double NextDelay(double PreviousDelay);
+
+		// Returns true if another attempt of the operation should be made Delay seconds from Now.
+		bool ShouldRetry(const FString& Method, int32 AttemptsMade, double Now, double Delay, double Deadline) const;
+
+		// Returns true if a call may be sent now, false if it should fail fast because the circuit is open.
+		bool AllowRequest(double Now);
+
+		// Records the outcome of a call that was sent.
+		void RecordSuccess();
+		void RecordFailure(double Now);
+
+		ECircuitState GetCircuitState() const { return CircuitState; }
+
+	private:
+		int32 MaxAttempts;
+		double BaseDelaySeconds;
+		double MaxDelaySeconds;
+		int32 BreakerFailureThreshold;
+		double BreakerOpenSeconds;
+		FRandomStream Random;
+		TMap<FString, FOperation> Operations;
+		FOperation DefaultOperation;
+		ECircuitState CircuitState;
+		int32 ConsecutiveFailures;
+		double OpenUntil;
+	};
+} // namespace Multiplay
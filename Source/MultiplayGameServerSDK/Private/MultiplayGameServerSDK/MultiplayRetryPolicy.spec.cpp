@@ -0,0 +1,113 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayRetryPolicy.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayRetryPolicySpec, "MultiplayGameServerSDK.RetryPolicy", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+const FString SafeMethod = TEXT("safe");
+const FString UnsafeMethod = TEXT("unsafe");
+TUniquePtr<Multiplay::FMultiplayRetryPolicy> Policy;
+END_DEFINE_SPEC(FMultiplayRetryPolicySpec)
+
+void FMultiplayRetryPolicySpec::Define()
+{
+	BeforeEach([this]()
+		{
+			Policy = MakeUnique<Multiplay::FMultiplayRetryPolicy>(3, 0.1f, 1.0f, 2, 5.0f, 42);
+
+			Multiplay::FMultiplayRetryPolicy::FOperation Safe;
+			Safe.DeadlineSeconds = 10.0;
+			Safe.bRetrySafe = true;
+			Policy->SetOperation(SafeMethod, Safe);
+		});
+
+	AfterEach([this]()
+		{
+			Policy.Reset();
+		});
+
+	Describe("IsTransientFailure", [this]()
+		{
+			It("should only retry timeouts, connection failures and server errors.", [this]()
+				{
+					TestTrueExpr(Multiplay::FMultiplayRetryPolicy::IsTransientFailure(EHttpResponseCodes::Unknown));
+					TestTrueExpr(Multiplay::FMultiplayRetryPolicy::IsTransientFailure(EHttpResponseCodes::RequestTimeout));
+					TestTrueExpr(Multiplay::FMultiplayRetryPolicy::IsTransientFailure(EHttpResponseCodes::ServiceUnavail));
+					TestTrueExpr(Multiplay::FMultiplayRetryPolicy::IsTransientFailure(static_cast<EHttpResponseCodes::Type>(429)));
+					TestFalseExpr(Multiplay::FMultiplayRetryPolicy::IsTransientFailure(EHttpResponseCodes::Ok));
+					TestFalseExpr(Multiplay::FMultiplayRetryPolicy::IsTransientFailure(EHttpResponseCodes::BadRequest));
+					TestFalseExpr(Multiplay::FMultiplayRetryPolicy::IsTransientFailure(EHttpResponseCodes::NotFound));
+				});
+		});
+
+	Describe("NextDelay", [this]()
+		{
+			It("should stay between the base delay, three times the previous delay and the maximum delay.", [this]()
+				{
+					double Delay = 0.0;
+					for (int32 Attempt = 0; Attempt < 20; ++Attempt)
+					{
+						const double Next = Policy->NextDelay(Delay);
+						TestTrueExpr(Next >= 0.1);
+						TestTrueExpr(Next <= FMath::Max(0.1, Delay * 3.0));
+						TestTrueExpr(Next <= 1.0);
+						Delay = Next;
+					}
+				});
+		});
+
+	Describe("ShouldRetry", [this]()
+		{
+			It("should only retry safe operations within their attempts and deadline.", [this]()
+				{
+					TestTrueExpr(Policy->ShouldRetry(SafeMethod, 1, 0.0, 0.5, 10.0));
+					TestFalseExpr(Policy->ShouldRetry(SafeMethod, 3, 0.0, 0.5, 10.0));
+					TestFalseExpr(Policy->ShouldRetry(SafeMethod, 1, 9.8, 0.5, 10.0));
+					TestFalseExpr(Policy->ShouldRetry(UnsafeMethod, 1, 0.0, 0.5, 10.0));
+				});
+		});
+
+	Describe("AllowRequest", [this]()
+		{
+			It("should open the circuit after consecutive failures and let a single probe through once it has been open long enough.", [this]()
+				{
+					Policy->RecordFailure(0.0);
+					TestTrueExpr(Policy->AllowRequest(0.0));
+
+					Policy->RecordFailure(0.0);
+					TestTrueExpr(Policy->GetCircuitState() == Multiplay::FMultiplayRetryPolicy::ECircuitState::Open);
+					TestFalseExpr(Policy->AllowRequest(4.0));
+
+					TestTrueExpr(Policy->AllowRequest(5.0));
+					TestFalseExpr(Policy->AllowRequest(5.0));
+
+					Policy->RecordSuccess();
+					TestTrueExpr(Policy->GetCircuitState() == Multiplay::FMultiplayRetryPolicy::ECircuitState::Closed);
+					TestTrueExpr(Policy->AllowRequest(5.0));
+				});
+
+			It("should open the circuit again when the probe fails.", [this]()
+				{
+					Policy->RecordFailure(0.0);
+					Policy->RecordFailure(0.0);
+					TestTrueExpr(Policy->AllowRequest(5.0));
+
+					Policy->RecordFailure(5.0);
+					TestTrueExpr(Policy->GetCircuitState() == Multiplay::FMultiplayRetryPolicy::ECircuitState::Open);
+					TestFalseExpr(Policy->AllowRequest(9.0));
+					TestTrueExpr(Policy->AllowRequest(10.0));
+				});
+
+			It("should reset the failure count after a success.", [this]()
+				{
+					Policy->RecordFailure(0.0);
+					Policy->RecordSuccess();
+					Policy->RecordFailure(0.0);
+
+					TestTrueExpr(Policy->GetCircuitState() == Multiplay::FMultiplayRetryPolicy::ECircuitState::Closed);
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,570 @@
+#include "MultiplayRpcTransport.h"
+#include "MultiplayRetryPolicy.h"
+#include "MultiplayConnectionWarmer.h"
+#include "Centrifuge/MultiplayCentrifugeClient.h"
+#include "Centrifuge/MultiplayCentrifugeMessages.h"
+#include "OpenAPIGameServerApiOperations.h"
+#include "OpenAPIPayloadApiOperations.h"
+#include "HAL/PlatformTime.h"
+#include "MultiplayGameServerSDKLog.h"
+
+namespace Multiplay
+{
+	FCentrifugeRpcChannel::FCentrifugeRpcChannel(FCentrifugeClient& InClient) : Client(InClient)
+	{
+	}
+
+	bool FCentrifugeRpcChannel::IsAvailable() const
+	{
+		return Client.IsConnected();
+	}
+
+	void FCentrifugeRpcChannel::Call(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcCompleteDelegate& OnComplete)
+	{
+		FRpcRequest Request;
+		Request.Method = Method;
+		Request.Data = Data;
+
+		FRpcCompleteDelegate Delegate = FRpcCompleteDelegate::CreateLambda([OnComplete](bool bSucceeded, const FRpcResult& Result, const FError& Error)
+			{
+				if (bSucceeded)
+				{
+					OnComplete.ExecuteIfBound(EMultiplayRpcStatus::Succeeded, Result.Data.IsSet() ? Result.Data.GetValue() : TSharedPtr<FJsonValue>(), FMultiplayRpcBodyPtr());
+				}
+				else if (Error.Code == kErrorMethodNotFound || Error.Code == kErrorNotAvailable)
+				{
+					OnComplete.ExecuteIfBound(EMultiplayRpcStatus::Unsupported, TSharedPtr<FJsonValue>(), FMultiplayRpcBodyPtr());
+				}
+				else
+				{
+					OnComplete.ExecuteIfBound(EMultiplayRpcStatus::Failed, TSharedPtr<FJsonValue>(), FMultiplayRpcBodyPtr());
+				}
+			});
+
+		Client.Rpc(Request, Delegate);
+	}
+
+	FMultiplayRpcTransport::FMultiplayRpcTransport(TSharedPtr<IMultiplayRpcChannel> InChannel, OpenAPIGameServerApi& InGameServerApi, OpenAPIPayloadApi& InPayloadApi, float InTimeoutSeconds)
+		: Channel(MoveTemp(InChannel))
+		, GameServerApi(InGameServerApi)
+		, PayloadApi(InPayloadApi)
+		, TimeoutSeconds(FMath::Max(0.0f, InTimeoutSeconds))
+		, bRpcUnsupported(false)
+		, NextCallId(1)
+		, NextStateChangeSequence(1)
+		, bHedgeReadyServer(false)
+		, HedgePercentile(0.0)
+		, HedgeInitialDelaySeconds(0.0)
+		, NextRequestId(1)
+	{
+	}
+
+	bool FMultiplayRpcTransport::Tick(float DeltaTime)
+	{
+		if (PendingCalls.Num() == 0 && InFlightRequests.Num() == 0 && ScheduledRetries.Num() == 0)
+		{
+			return true;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+
+		// Fallbacks are collected first because they may issue new calls.
+		TArray<TFunction<void()>> Fallbacks;
+		for (auto It = PendingCalls.CreateIterator(); It; ++It)
+		{
+			if (It.Value().Deadline <= Now)
+			{
+				Fallbacks.Add(MoveTemp(It.Value().Fallback));
+				It.RemoveCurrent();
+			}
+		}
+
+		for (TFunction<void()>& Fallback : Fallbacks)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("An RPC to the SDK daemon timed out after %.2f seconds, retrying over HTTP."), TimeoutSeconds);
+
+			Fallback();
+		}
+
+		// Cancelling a request completes it as timed out, and it is not retried since its deadline has passed.
+		TArray<FHttpRequestPtr> Expired;
+		for (auto It = InFlightRequests.CreateIterator(); It; ++It)
+		{
+			if (It.Value().Deadline > 0.0 && It.Value().Deadline <= Now)
+			{
+				Expired.Add(It.Value().Request);
+				It.RemoveCurrent();
+			}
+		}
+
+		for (const FHttpRequestPtr& Request : Expired)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("An HTTP call to the SDK daemon did not complete before its deadline, cancelling it."));
+
+			Request->CancelRequest();
+		}
+
+		TArray<TFunction<void()>> Retries;
+		for (int32 Index = ScheduledRetries.Num() - 1; Index >= 0; --Index)
+		{
+			if (ScheduledRetries[Index].Due <= Now)
+			{
+				Retries.Insert(MoveTemp(ScheduledRetries[Index].Attempt), 0);
+				ScheduledRetries.RemoveAt(Index);
+			}
+		}
+
+		for (TFunction<void()>& Retry : Retries)
+		{
+			Retry();
+		}
+
+		return true;
+	}
+
+	void FMultiplayRpcTransport::ReadyServer(const ReadyServerRequest& Request, const FReadyServerDelegate& InDelegate)
+	{
+		const FStateChangeKey Key = MakeStateChangeKey(kReadyServerMethod, Request.ServerId, Request.AllocationId);
+
+		FReadyServerDelegate Delegate = InDelegate;
+		if (Coalesce<ReadyServerResponse>(&FMultiplayRpcTransport::ReadyServerWaiters, Key, Delegate))
+		{
+			return;
+		}
+
+		TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+		Params->SetStringField(TEXT("serverId"), LexToString(Request.ServerId));
+		Params->SetStringField(TEXT("allocationId"), ToString(Request.AllocationId));
+
+		TSharedRef<THttpOperation<FReadyServerDelegate>> Operation = MakeHttpOperation<FReadyServerDelegate>(kReadyServerMethod, Delegate,
+			[this, Request](const FReadyServerDelegate& OnResponse) { return GameServerApi.ReadyServer(Request, OnResponse); });
+		Operation->StateChangeSequence = Key.Sequence;
+		Operation->ServerId = Request.ServerId;
+		Operation->HedgeDelay = GetReadyServerHedgeDelay();
+		Operation->bRecordLatency = true;
+
+		Call<ReadyServerResponse>(kReadyServerMethod, MakeShared<FJsonValueObject>(Params),
+			[Delegate](const ReadyServerResponse& Response) { Delegate.ExecuteIfBound(Response); },
+			[this, Operation]() { SendHttp<ReadyServerResponse>(Operation); });
+	}
+
+	void FMultiplayRpcTransport::UnreadyServer(const UnreadyServerRequest& Request, const FUnreadyServerDelegate& InDelegate)
+	{
+		const FStateChangeKey Key = MakeStateChangeKey(kUnreadyServerMethod, Request.ServerId, FGuid());
+
+		FUnreadyServerDelegate Delegate = InDelegate;
+		if (Coalesce<UnreadyServerResponse>(&FMultiplayRpcTransport::UnreadyServerWaiters, Key, Delegate))
+		{
+			return;
+		}
+
+		TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+		Params->SetStringField(TEXT("serverId"), LexToString(Request.ServerId));
+
+		TSharedRef<THttpOperation<FUnreadyServerDelegate>> Operation = MakeHttpOperation<FUnreadyServerDelegate>(kUnreadyServerMethod, Delegate,
+			[this, Request](const FUnreadyServerDelegate& OnResponse) { return GameServerApi.UnreadyServer(Request, OnResponse); });
+		Operation->StateChangeSequence = Key.Sequence;
+		Operation->ServerId = Request.ServerId;
+
+		Call<UnreadyServerResponse>(kUnreadyServerMethod, MakeShared<FJsonValueObject>(Params),
+			[Delegate](const UnreadyServerResponse& Response) { Delegate.ExecuteIfBound(Response); },
+			[this, Operation]() { SendHttp<UnreadyServerResponse>(Operation); });
+	}
+
+	void FMultiplayRpcTransport::PayloadAllocation(const PayloadAllocationRequest& Request, const FPayloadAllocationDelegate& InDelegate)
+	{
+		FPayloadAllocationDelegate Delegate = InDelegate;
+		if (Coalesce<PayloadAllocationResponse>(&FMultiplayRpcTransport::PayloadAllocationWaiters, Request.AllocationId, Delegate))
+		{
+			return;
+		}
+
+		TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+		Params->SetStringField(TEXT("allocationId"), ToString(Request.AllocationId));
+
+		TSharedRef<THttpOperation<FPayloadAllocationDelegate>> Operation = MakeHttpOperation<FPayloadAllocationDelegate>(kPayloadAllocationMethod, Delegate,
+			[this, Request](const FPayloadAllocationDelegate& OnResponse) { return PayloadApi.PayloadAllocation(Request, OnResponse); });
+
+		Call<PayloadAllocationResponse>(kPayloadAllocationMethod, MakeShared<FJsonValueObject>(Params),
+			[Delegate](const PayloadAllocationResponse& Response) { Delegate.ExecuteIfBound(Response); },
+			[this, Operation]() { SendHttp<PayloadAllocationResponse>(Operation); });
+	}
+
+	void FMultiplayRpcTransport::PayloadToken(const PayloadTokenRequest& Request, const FPayloadTokenDelegate& InDelegate)
+	{
+		FPayloadTokenDelegate Delegate = InDelegate;
+		if (Coalesce<PayloadTokenResponse>(&FMultiplayRpcTransport::PayloadTokenWaiters, FString(), Delegate))
+		{
+			return;
+		}
+
+		TSharedRef<THttpOperation<FPayloadTokenDelegate>> Operation = MakeHttpOperation<FPayloadTokenDelegate>(kPayloadTokenMethod, Delegate,
+			[this, Request](const FPayloadTokenDelegate& OnResponse) { return PayloadApi.PayloadToken(Request, OnResponse); });
+
+		Call<PayloadTokenResponse>(kPayloadTokenMethod, MakeShared<FJsonValueObject>(MakeShared<FJsonObject>()),
+			[Delegate](const PayloadTokenResponse& Response) { Delegate.ExecuteIfBound(Response); },
+			[this, Operation]() { SendHttp<PayloadTokenResponse>(Operation); });
+	}
+
+	bool FMultiplayRpcTransport::ApplyRpcResult(const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcBodyPtr& Body, Response& OutResponse)
+	{
+		const TSharedPtr<FJsonObject>* Object;
+		if (!Data.IsValid() || !Data->TryGetObject(Object))
+		{
+			return false;
+		}
+
+		int32 Code;
+		if (!TryGetJsonValue(*Object, TEXT("code"), Code))
+		{
+			return false;
+		}
+
+		OutResponse.SetHttpResponseCode((EHttpResponseCodes::Type)Code);
+
+		// As with HTTP, a body that cannot be decoded does not make the operation unsuccessful.
+		if (Body.IsValid())
+		{
+			// The daemon answers RPCs with JSON, a body without a content type is read as such like the string bodies below.
+			const FString ContentType = Body->ContentType.IsEmpty() ? FString(TEXT("application/json")) : Body->ContentType;
+			OutResponse.ReceiveContent(MoveTemp(Body->Bytes), ContentType, Body->ContentEncoding);
+			return true;
+		}
+
+		FString BodyString;
+		TryGetJsonValue(*Object, TEXT("body"), BodyString);
+
+		OutResponse.ReceiveContent(BodyString, TEXT("application/json"));
+
+		return true;
+	}
+
+	void FMultiplayRpcTransport::PrepareResponse(PayloadAllocationResponse& InOutResponse) const
+	{
+		PayloadApi.PreparePayloadAllocationResponse(InOutResponse);
+	}
+
+	template <typename TResponse, typename TKey, typename TDelegate>
+	bool FMultiplayRpcTransport::Coalesce(TWaiters<TKey, TDelegate> FMultiplayRpcTransport::* Waiters, const TKey& Key, TDelegate& InOutDelegate)
+	{
+		if (TArray<TDelegate>* InFlight = (this->*Waiters).Find(Key))
+		{
+			InFlight->Add(InOutDelegate);
+			return true;
+		}
+
+		(this->*Waiters).Add(Key).Add(InOutDelegate);
+		InOutDelegate = TDelegate::CreateSP(this, &FMultiplayRpcTransport::FanOut<TResponse, TKey, TDelegate>, Waiters, Key);
+		return false;
+	}
+
+	template <typename TResponse, typename TKey, typename TDelegate>
+	void FMultiplayRpcTransport::FanOut(const TResponse& Response, TWaiters<TKey, TDelegate> FMultiplayRpcTransport::* Waiters, TKey Key)
+	{
+		// The waiters are removed first so that a waiter issuing the same operation again starts a new one.
+		TArray<TDelegate> Completed;
+		(this->*Waiters).RemoveAndCopyValue(Key, Completed);
+
+		for (const TDelegate& Waiter : Completed)
+		{
+			Waiter.ExecuteIfBound(Response);
+		}
+	}
+
+	FMultiplayRpcTransport::FStateChangeKey FMultiplayRpcTransport::MakeStateChangeKey(const TCHAR* Method, int64 ServerId, const FGuid& AllocationId)
+	{
+		FStateChangeKey& Last = StateChanges.FindOrAdd(ServerId);
+		if (Last.Sequence == 0 || Method != Last.Method || AllocationId != Last.AllocationId)
+		{
+			Last.Method = Method;
+			Last.ServerId = ServerId;
+			Last.AllocationId = AllocationId;
+			Last.Sequence = NextStateChangeSequence++;
+		}
+
+		return Last;
+	}
+
+	template <typename TResponse, typename TDelegate>
+	void FMultiplayRpcTransport::CompleteUnsent(const TDelegate& Delegate, EHttpResponseCodes::Type Code)
+	{
+		TResponse Response;
+		Response.SetHttpResponseCode(Code);
+		Delegate.ExecuteIfBound(Response);
+	}
+
+	template <typename TDelegate>
+	TSharedRef<FMultiplayRpcTransport::THttpOperation<TDelegate>> FMultiplayRpcTransport::MakeHttpOperation(const TCHAR* Method, const TDelegate& Delegate, TFunction<FHttpRequestPtr(const TDelegate&)> Send) const
+	{
+		TSharedRef<THttpOperation<TDelegate>> Operation = MakeShared<THttpOperation<TDelegate>>();
+		Operation->Method = Method;
+		Operation->Send = MoveTemp(Send);
+		Operation->Delegate = Delegate;
+
+		// The deadline runs from when the operation is issued, so that it also bounds an RPC attempt that falls back to HTTP.
+		if (RetryPolicy.IsValid())
+		{
+			Operation->Deadline = FPlatformTime::Seconds() + RetryPolicy->GetOperation(Method).DeadlineSeconds;
+		}
+
+		return Operation;
+	}
+
+	template <typename TResponse, typename TDelegate>
+	void FMultiplayRpcTransport::SendHttp(TSharedRef<THttpOperation<TDelegate>> Operation, bool bHedge)
+	{
+		if (RetryPolicy.IsValid() && !RetryPolicy->AllowRequest(FPlatformTime::Seconds()))
+		{
+			// A hedge is only an optimization, the attempt in flight completes the operation.
+			if (bHedge)
+			{
+				return;
+			}
+
+			UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("The SDK daemon is failing calls, %s fails without being sent."), Operation->Method);
+
+			CompleteUnsent<TResponse>(Operation->Delegate, EHttpResponseCodes::ServiceUnavail);
+			return;
+		}
+
+		++Operation->Attempts;
+
+		// The request is registered before it is sent because the HTTP module may complete it immediately.
+		const uint32 RequestId = NextRequestId++;
+		Operation->Outstanding.Add(RequestId);
+
+		const FHttpRequestPtr HttpRequest = Operation->Send(TDelegate::CreateSP(this, &FMultiplayRpcTransport::OnHttpResponse<TResponse, TDelegate>, Operation, RequestId));
+		if (!HttpRequest.IsValid())
+		{
+			Operation->Outstanding.Remove(RequestId);
+
+			// A probe that cannot be sent must not leave the circuit half open.
+			if (RetryPolicy.IsValid())
+			{
+				RetryPolicy->RecordFailure(FPlatformTime::Seconds());
+			}
+
+			if (!bHedge)
+			{
+				CompleteUnsent<TResponse>(Operation->Delegate);
+			}
+			return;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+
+		if (Operation->Outstanding.Contains(RequestId))
+		{
+			InFlightRequests.Add(RequestId, { HttpRequest, Operation->Deadline, Now, ConnectionWarmer.IsValid() && ConnectionWarmer->IsWarm(Now) });
+		}
+
+		if (!bHedge && Operation->HedgeDelay > 0.0 && (Operation->Deadline == 0.0 || Now + Operation->HedgeDelay < Operation->Deadline))
+		{
+			const int32 Attempt = Operation->Attempts;
+			ScheduledRetries.Add({ Now + Operation->HedgeDelay, [this, Operation, Attempt]()
+				{
+					// The attempt may have completed, been retried or been superseded in the meantime.
+					if (!Operation->bCompleted && Operation->Attempts == Attempt && Operation->Outstanding.Num() > 0 && !IsSuperseded(*Operation))
+					{
+						UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("%s has not completed after %.3f seconds, sending it again."), Operation->Method, Operation->HedgeDelay);
+
+						SendHttp<TResponse>(Operation, true);
+					}
+				} });
+		}
+	}
+
+	template <typename TResponse, typename TDelegate>
+	void FMultiplayRpcTransport::OnHttpResponse(const TResponse& Response, TSharedRef<THttpOperation<TDelegate>> Operation, uint32 RequestId)
+	{
+		Operation->Outstanding.Remove(RequestId);
+
+		FInFlightRequest Request;
+		const bool bTracked = InFlightRequests.RemoveAndCopyValue(RequestId, Request);
+
+		// A request that lost to a hedge is cancelled, which still completes it.
+		if (Operation->bCompleted)
+		{
+			return;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		const bool bTransientFailure = FMultiplayRetryPolicy::IsTransientFailure(Response.GetHttpResponseCode());
+
+		if (ConnectionWarmer.IsValid() && bTracked)
+		{
+			// The OpenAPI clients report a request that the daemon did not answer as timed out.
+			const bool bAnswered = Response.GetHttpResponseCode() != EHttpResponseCodes::RequestTimeout && Response.GetHttpResponseCode() != EHttpResponseCodes::Unknown;
+			ConnectionWarmer->RecordCall(Request.bWarm, Now - Request.SentAt, bAnswered, Now);
+		}
+
+		// Any response other than a transient failure shows that the daemon is up, even if it rejected the operation.
+		if (RetryPolicy.IsValid())
+		{
+			if (bTransientFailure)
+			{
+				RetryPolicy->RecordFailure(Now);
+			}
+			else
+			{
+				RetryPolicy->RecordSuccess();
+			}
+		}
+
+		if (!bTransientFailure)
+		{
+			if (Operation->bRecordLatency && bTracked)
+			{
+				RecordReadyServerLatency(Now - Request.SentAt);
+			}
+
+			CompleteHttp(Response, *Operation);
+			return;
+		}
+
+		// Another request of the operation is in flight and may still succeed.
+		if (Operation->Outstanding.Num() > 0)
+		{
+			return;
+		}
+
+		if (!RetryPolicy.IsValid())
+		{
+			CompleteHttp(Response, *Operation);
+			return;
+		}
+
+		const double Delay = RetryPolicy->NextDelay(Operation->Delay);
+		if (IsSuperseded(*Operation) || !RetryPolicy->ShouldRetry(Operation->Method, Operation->Attempts, Now, Delay, Operation->Deadline))
+		{
+			CompleteHttp(Response, *Operation);
+			return;
+		}
+
+		UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("%s failed with status %d after %d attempts, retrying in %.2f seconds."), Operation->Method, static_cast<int32>(Response.GetHttpResponseCode()), Operation->Attempts, Delay);
+
+		Operation->Delay = Delay;
+		ScheduledRetries.Add({ Now + Delay, [this, Operation]() { SendHttp<TResponse>(Operation); } });
+	}
+
+	template <typename TResponse, typename TDelegate>
+	void FMultiplayRpcTransport::CompleteHttp(const TResponse& Response, THttpOperation<TDelegate>& Operation)
+	{
+		Operation.bCompleted = true;
+
+		// The outstanding requests are moved out first because cancelling a request may complete it immediately.
+		const TArray<uint32> Losers = MoveTemp(Operation.Outstanding);
+		Operation.Outstanding.Reset();
+
+		for (uint32 Loser : Losers)
+		{
+			FInFlightRequest Request;
+			if (InFlightRequests.RemoveAndCopyValue(Loser, Request))
+			{
+				Request.Request->CancelRequest();
+			}
+		}
+
+		Operation.Delegate.ExecuteIfBound(Response);
+	}
+
+	void FMultiplayRpcTransport::SetReadyServerHedging(float Percentile, float InitialDelaySeconds)
+	{
+		bHedgeReadyServer = true;
+		HedgePercentile = FMath::Clamp(Percentile, 0.0f, 100.0f);
+		HedgeInitialDelaySeconds = FMath::Max(0.0f, InitialDelaySeconds);
+	}
+
+	double FMultiplayRpcTransport::GetReadyServerHedgeDelay() const
+	{
+		if (!bHedgeReadyServer)
+		{
+			return 0.0;
+		}
+
+		if (ReadyServerLatency.GetCount() < kHedgeMinSamples)
+		{
+			return HedgeInitialDelaySeconds;
+		}
+
+		return ReadyServerLatency.GetPercentileMs(HedgePercentile) / 1000.0;
+	}
+
+	template <typename TResponse>
+	void FMultiplayRpcTransport::Call(const TCHAR* Method, const TSharedPtr<FJsonValue>& Data, TFunction<void(const TResponse&)> OnResponse, TFunction<void()> Fallback)
+	{
+		if (!IsRpcEnabled() || !Channel->IsAvailable())
+		{
+			Fallback();
+			return;
+		}
+
+		const uint32 CallId = NextCallId++;
+
+		FPendingCall& PendingCall = PendingCalls.Add(CallId);
+		PendingCall.Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		PendingCall.Fallback = MoveTemp(Fallback);
+
+		// Only invoked through OnCallComplete, while the transport is alive.
+		TFunction<bool(const TSharedPtr<FJsonValue>&, const FMultiplayRpcBodyPtr&)> OnResult = [this, OnResponse](const TSharedPtr<FJsonValue>& Result, const FMultiplayRpcBodyPtr& Body)
+		{
+			TResponse Response;
+			PrepareResponse(Response);
+
+			if (!ApplyRpcResult(Result, Body, Response))
+			{
+				return false;
+			}
+
+			OnResponse(Response);
+			return true;
+		};
+
+		TWeakPtr<FMultiplayRpcTransport> WeakThis = AsShared();
+
+		Channel->Call(Method, Data, FMultiplayRpcCompleteDelegate::CreateLambda([WeakThis, CallId, OnResult](EMultiplayRpcStatus Status, const TSharedPtr<FJsonValue>& Result, const FMultiplayRpcBodyPtr& Body)
+			{
+				if (TSharedPtr<FMultiplayRpcTransport> This = WeakThis.Pin())
+				{
+					This->OnCallComplete(CallId, Status, Result, Body, OnResult);
+				}
+			}));
+	}
+
+	void FMultiplayRpcTransport::OnCallComplete(uint32 CallId, EMultiplayRpcStatus Status, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcBodyPtr& Body, TFunction<bool(const TSharedPtr<FJsonValue>&, const FMultiplayRpcBodyPtr&)> OnResult)
+	{
+		FPendingCall PendingCall;
+		if (!PendingCalls.RemoveAndCopyValue(CallId, PendingCall))
+		{
+			// The call timed out and has already been re-issued over HTTP.
+			return;
+		}
+
+		switch (Status)
+		{
+		case EMultiplayRpcStatus::Succeeded:
+		{
+			if (OnResult(Data, Body))
+			{
+				return;
+			}
+
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Received a malformed RPC result from the SDK daemon, retrying over HTTP."));
+			break;
+		}
+		case EMultiplayRpcStatus::Unsupported:
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("The SDK daemon does not support RPCs, using HTTP for the rest of the session."));
+			bRpcUnsupported = true;
+			break;
+		}
+		default:
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("An RPC to the SDK daemon failed, retrying over HTTP."));
+			break;
+		}
+		}
+
+		PendingCall.Fallback();
+	}
+} // namespace Multiplay
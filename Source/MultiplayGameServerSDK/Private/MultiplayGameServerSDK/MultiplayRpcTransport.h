@@ -0,0 +1,276 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "Utils/MultiplayTicker.h"
+#include "Centrifuge/MultiplayCentrifugeKeepalive.h"
+#include "OpenAPIGameServerApi.h"
+#include "OpenAPIPayloadApi.h"
+
+namespace Multiplay
+{
+	class FCentrifugeClient;
+	class FMultiplayConnectionWarmer;
+	class FMultiplayRetryPolicy;
+	class Response;
+
+	enum class EMultiplayRpcStatus
+	{
+		// The RPC was answered, the data carries the operation result.
+		Succeeded,
+		// The daemon does not implement the RPC, further calls should not be attempted.
+		Unsupported,
+		// The RPC was not answered, the operation may be retried over another transport.
+		Failed,
+	};
+
+	// The body of a response carried as HTTP rather than as a JSON string, by channels that exchange HTTP with the daemon.
+	// The bytes are handed to the response as received, so that payloads are inflated and kept as they are over TCP.
+	struct FMultiplayRpcBody
+	{
+		TArray<uint8> Bytes;
+		FString ContentType;
+		FString ContentEncoding;
+	};
+
+	using FMultiplayRpcBodyPtr = TSharedPtr<FMultiplayRpcBody, ESPMode::ThreadSafe>;
+
+	// Body is only set by channels that exchange HTTP, the result data then only carries the code.
+	DECLARE_DELEGATE_ThreeParams(FMultiplayRpcCompleteDelegate, EMultiplayRpcStatus /* Status */, const TSharedPtr<FJsonValue>& /* Data */, const FMultiplayRpcBodyPtr& /* Body */);
+
+	// A channel capable of carrying RPCs to the SDK daemon.
+	class IMultiplayRpcChannel
+	{
+	public:
+		virtual ~IMultiplayRpcChannel() {}
+
+		// Returns true if an RPC issued now could reach the daemon.
+		virtual bool IsAvailable() const = 0;
+
+		// Issues an RPC. OnComplete must be invoked exactly once.
+		virtual void Call(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcCompleteDelegate& OnComplete) = 0;
+	};
+
+	// Carries RPCs over the Centrifuge connection that is already used for server events.
+	class FCentrifugeRpcChannel : public IMultiplayRpcChannel
+	{
+	public:
+		// Centrifuge error codes returned when the server has no handler for an RPC.
+		static constexpr uint32 kErrorMethodNotFound = 104;
+		static constexpr uint32 kErrorNotAvailable = 108;
+
+	public:
+		FCentrifugeRpcChannel(FCentrifugeClient& Client);
+
+		virtual bool IsAvailable() const override;
+		virtual void Call(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcCompleteDelegate& OnComplete) override;
+
+	private:
+		FCentrifugeClient& Client;
+	};
+
+	// Routes the game server and payload operations over an RPC channel when one is available, falling back to HTTP otherwise.
+	//
+	// Each operation is sent as an RPC whose data carries the operation parameters. The daemon answers with
+	// {"code": <http status>, "body": "<http body>"} so that the response is handled exactly as its HTTP equivalent.
+	// An RPC that fails or times out is re-issued over HTTP. If the daemon reports that it does not implement the
+	// RPCs, the transport stops attempting them for the rest of the session.
+	//
+	// An operation issued while an identical one is in flight joins it, and the response is delivered to every caller.
+	// Ready and unready only join the most recently issued state change, so that the daemon always receives the latest state last.
+	//
+	// With a retry policy, operations sent over HTTP are retried, bounded by their deadline, and cancelled once it passes.
+	// A state change that has been superseded by another one is not retried.
+	//
+	// With hedging, a ready sent over HTTP that has not completed by a percentile of the latencies observed so far is sent
+	// a second time. The first response that is not a transient failure completes the operation and the other request is cancelled.
+	class FMultiplayRpcTransport : public FMultiplayTickerObjectBase, public TSharedFromThis<FMultiplayRpcTransport>
+	{
+	public:
+		static constexpr const TCHAR* const kReadyServerMethod = TEXT("server.ready");
+		static constexpr const TCHAR* const kUnreadyServerMethod = TEXT("server.unready");
+		static constexpr const TCHAR* const kPayloadAllocationMethod = TEXT("payload.allocation");
+		static constexpr const TCHAR* const kPayloadTokenMethod = TEXT("payload.token");
+
+		// The number of ready latencies to observe before hedging at a percentile of them.
+		static constexpr uint64 kHedgeMinSamples = 10;
+
+	public:
+		FMultiplayRpcTransport(TSharedPtr<IMultiplayRpcChannel> Channel, OpenAPIGameServerApi& GameServerApi, OpenAPIPayloadApi& PayloadApi, float TimeoutSeconds);
+
+		virtual bool Tick(float DeltaTime) override;
+
+		void ReadyServer(const ReadyServerRequest& Request, const FReadyServerDelegate& Delegate);
+		void UnreadyServer(const UnreadyServerRequest& Request, const FUnreadyServerDelegate& Delegate);
+		void PayloadAllocation(const PayloadAllocationRequest& Request, const FPayloadAllocationDelegate& Delegate);
+		void PayloadToken(const PayloadTokenRequest& Request, const FPayloadTokenDelegate& Delegate);
+
+		// Applies a retry policy to the operations sent over HTTP. Without one, each operation is sent over HTTP once and has no deadline.
+		void SetRetryPolicy(TSharedPtr<FMultiplayRetryPolicy> InRetryPolicy) { RetryPolicy = MoveTemp(InRetryPolicy); }
+
+		// Hedges ready requests sent over HTTP at the given percentile (0-100) of their observed latency, or after InitialDelaySeconds
+		// until kHedgeMinSamples latencies have been observed.
+		void SetReadyServerHedging(float Percentile, float InitialDelaySeconds);
+
+		// Returns the number of seconds after which a ready request is hedged, 0 if ready requests are not hedged.
+		double GetReadyServerHedgeDelay() const;
+
+		// Records whether each HTTP request found the connection to the daemon warm, and keeps it warm while requests are made.
+		void SetConnectionWarmer(TSharedPtr<FMultiplayConnectionWarmer> InConnectionWarmer) { ConnectionWarmer = MoveTemp(InConnectionWarmer); }
+
+		// Records the latency of a ready request that completed over HTTP.
+		void RecordReadyServerLatency(double Seconds) { ReadyServerLatency.Record(Seconds * 1000.0); }
+
+		// Returns true while operations are attempted over the RPC channel.
+		bool IsRpcEnabled() const { return Channel.IsValid() && !bRpcUnsupported; }
+
+		// Applies an RPC result of the form {"code": <http status>, "body": "<http body>"} to a response, returns false if the result is malformed.
+		// A Body received as bytes takes the place of the body field, and its bytes are moved into the response.
+		static bool ApplyRpcResult(const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcBodyPtr& Body, Response& OutResponse);
+
+	private:
+		struct FPendingCall
+		{
+			double Deadline;
+			TFunction<void()> Fallback;
+		};
+
+		template <typename TKey, typename TDelegate>
+		using TWaiters = TMap<TKey, TArray<TDelegate>>;
+
+		// An operation sent over HTTP, which may take several attempts.
+		template <typename TDelegate>
+		struct THttpOperation
+		{
+			const TCHAR* Method;
+			TFunction<FHttpRequestPtr(const TDelegate&)> Send;
+			TDelegate Delegate;
+			// The time at which the operation fails, 0 if it has no deadline.
+			double Deadline = 0.0;
+			int32 Attempts = 0;
+			double Delay = 0.0;
+			// The state change sequence the operation belongs to, 0 if it is not a state change.
+			uint32 StateChangeSequence = 0;
+			// The server whose state the operation changes.
+			int64 ServerId = 0;
+			// The number of seconds after which an attempt is sent a second time, 0 if attempts are not hedged.
+			double HedgeDelay = 0.0;
+			// Whether latencies are recorded to compute the hedge delay from.
+			bool bRecordLatency = false;
+			// The requests of the operation that have not completed.
+			TArray<uint32> Outstanding;
+			bool bCompleted = false;
+		};
+
+		struct FInFlightRequest
+		{
+			FHttpRequestPtr Request;
+			double Deadline;
+			double SentAt;
+			bool bWarm;
+		};
+
+		// Identifies a ready or unready operation without allocating, the unready of a server has no allocation.
+		struct FStateChangeKey
+		{
+			// One of the method constants, compared by address.
+			const TCHAR* Method = nullptr;
+			int64 ServerId = 0;
+			FGuid AllocationId;
+			uint32 Sequence = 0;
+
+			bool operator==(const FStateChangeKey& Other) const
+			{
+				return Method == Other.Method && ServerId == Other.ServerId && AllocationId == Other.AllocationId && Sequence == Other.Sequence;
+			}
+
+			friend uint32 GetTypeHash(const FStateChangeKey& Key)
+			{
+				return HashCombine(HashCombine(PointerHash(Key.Method), GetTypeHash(Key.ServerId)), HashCombine(GetTypeHash(Key.AllocationId), Key.Sequence));
+			}
+		};
+
+		struct FScheduledRetry
+		{
+			double Due;
+			TFunction<void()> Attempt;
+		};
+
+		// Joins an identical operation in flight and returns true, or registers Delegate as the first waiter and replaces it with the one to issue the operation with.
+		template <typename TResponse, typename TKey, typename TDelegate>
+		bool Coalesce(TWaiters<TKey, TDelegate> FMultiplayRpcTransport::* Waiters, const TKey& Key, TDelegate& InOutDelegate);
+
+		template <typename TResponse, typename TKey, typename TDelegate>
+		void FanOut(const TResponse& Response, TWaiters<TKey, TDelegate> FMultiplayRpcTransport::* Waiters, TKey Key);
+
+		// Returns the coalescing key of a ready or unready operation, whose sequence changes whenever a different state change is
+		// issued for the same server.
+		FStateChangeKey MakeStateChangeKey(const TCHAR* Method, int64 ServerId, const FGuid& AllocationId);
+
+		// Completes an operation that was not sent over HTTP, because the OpenAPI client could not issue the request, in which case it
+		// does not invoke the delegate, or because the circuit is open.
+		template <typename TResponse, typename TDelegate>
+		static void CompleteUnsent(const TDelegate& Delegate, EHttpResponseCodes::Type Code = EHttpResponseCodes::Unknown);
+
+		template <typename TDelegate>
+		TSharedRef<THttpOperation<TDelegate>> MakeHttpOperation(const TCHAR* Method, const TDelegate& Delegate, TFunction<FHttpRequestPtr(const TDelegate&)> Send) const;
+
+		// Sends an attempt of the operation. A hedge is sent alongside the attempt in flight rather than after it failed.
+		template <typename TResponse, typename TDelegate>
+		void SendHttp(TSharedRef<THttpOperation<TDelegate>> Operation, bool bHedge = false);
+
+		template <typename TResponse, typename TDelegate>
+		void OnHttpResponse(const TResponse& Response, TSharedRef<THttpOperation<TDelegate>> Operation, uint32 RequestId);
+
+		// Completes the operation and cancels its requests that are still in flight.
+		template <typename TResponse, typename TDelegate>
+		void CompleteHttp(const TResponse& Response, THttpOperation<TDelegate>& Operation);
+
+		// Returns true if a different state change has been issued for the server of the operation since it was.
+		template <typename TDelegate>
+		bool IsSuperseded(const THttpOperation<TDelegate>& Operation) const
+		{
+			if (Operation.StateChangeSequence == 0)
+			{
+				return false;
+			}
+
+			const FStateChangeKey* Last = StateChanges.Find(Operation.ServerId);
+			return Last == nullptr || Last->Sequence != Operation.StateChangeSequence;
+		}
+
+		template <typename TResponse>
+		void Call(const TCHAR* Method, const TSharedPtr<FJsonValue>& Data, TFunction<void(const TResponse&)> OnResponse, TFunction<void()> Fallback);
+
+		void OnCallComplete(uint32 CallId, EMultiplayRpcStatus Status, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcBodyPtr& Body, TFunction<bool(const TSharedPtr<FJsonValue>&, const FMultiplayRpcBodyPtr&)> OnResult);
+
+		// Applies the settings the HTTP API applies to its responses to a response received over the RPC channel.
+		void PrepareResponse(Response& InOutResponse) const {}
+		void PrepareResponse(PayloadAllocationResponse& InOutResponse) const;
+
+	private:
+		TSharedPtr<IMultiplayRpcChannel> Channel;
+		OpenAPIGameServerApi& GameServerApi;
+		OpenAPIPayloadApi& PayloadApi;
+		double TimeoutSeconds;
+		bool bRpcUnsupported;
+		uint32 NextCallId;
+		TMap<uint32, FPendingCall> PendingCalls;
+		TWaiters<FStateChangeKey, FReadyServerDelegate> ReadyServerWaiters;
+		TWaiters<FStateChangeKey, FUnreadyServerDelegate> UnreadyServerWaiters;
+		TWaiters<FGuid, FPayloadAllocationDelegate> PayloadAllocationWaiters;
+		TWaiters<FString, FPayloadTokenDelegate> PayloadTokenWaiters;
+		// The last state change issued for each server, the servers of a shared SDK core do not supersede each other's.
+		TMap<int64, FStateChangeKey> StateChanges;
+		uint32 NextStateChangeSequence;
+		TSharedPtr<FMultiplayRetryPolicy> RetryPolicy;
+		TSharedPtr<FMultiplayConnectionWarmer> ConnectionWarmer;
+		bool bHedgeReadyServer;
+		double HedgePercentile;
+		double HedgeInitialDelaySeconds;
+		FCentrifugeRttHistogram ReadyServerLatency;
+		uint32 NextRequestId;
+		TMap<uint32, FInFlightRequest> InFlightRequests;
+		TArray<FScheduledRetry> ScheduledRetries;
+	};
+} // namespace Multiplay
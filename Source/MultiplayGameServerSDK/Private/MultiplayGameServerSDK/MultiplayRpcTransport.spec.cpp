@@ -0,0 +1,443 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayRpcTransport.h"
+#include "MultiplayGameServerSDK/MultiplayRetryPolicy.h"
+#include "OpenAPIGameServerApiOperations.h"
+#include "OpenAPIPayloadApiOperations.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace Multiplay
+{
+	// Stands in for the SDK daemon, answering every RPC with a canned status and result, or holding it until released.
+	class FStandInRpcChannel : public IMultiplayRpcChannel
+	{
+	public:
+		virtual bool IsAvailable() const override { return bAvailable; }
+
+		virtual void Call(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcCompleteDelegate& OnComplete) override
+		{
+			Methods.Add(Method);
+			Params.Add(Data);
+
+			if (bHold)
+			{
+				Held.Add(OnComplete);
+				return;
+			}
+
+			OnComplete.ExecuteIfBound(Status, Result, FMultiplayRpcBodyPtr());
+		}
+
+		void ReleaseAll()
+		{
+			TArray<FMultiplayRpcCompleteDelegate> Released = MoveTemp(Held);
+			for (const FMultiplayRpcCompleteDelegate& OnComplete : Released)
+			{
+				OnComplete.ExecuteIfBound(Status, Result, FMultiplayRpcBodyPtr());
+			}
+		}
+
+		void Answer(int32 Code, const FString& Body)
+		{
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetNumberField(TEXT("code"), Code);
+			Object->SetStringField(TEXT("body"), Body);
+
+			Status = EMultiplayRpcStatus::Succeeded;
+			Result = MakeShared<FJsonValueObject>(Object);
+		}
+
+	public:
+		bool bAvailable = true;
+		bool bHold = false;
+		TArray<FMultiplayRpcCompleteDelegate> Held;
+		EMultiplayRpcStatus Status = EMultiplayRpcStatus::Failed;
+		TSharedPtr<FJsonValue> Result;
+		TArray<FString> Methods;
+		TArray<TSharedPtr<FJsonValue>> Params;
+	};
+} // namespace Multiplay
+
+BEGIN_DEFINE_SPEC(FMultiplayRpcTransportSpec, "MultiplayGameServerSDK.RpcTransport", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TSharedPtr<Multiplay::FStandInRpcChannel> Channel;
+TUniquePtr<Multiplay::OpenAPIGameServerApi> GameServerApi;
+TUniquePtr<Multiplay::OpenAPIPayloadApi> PayloadApi;
+TSharedPtr<Multiplay::FMultiplayRpcTransport> Transport;
+END_DEFINE_SPEC(FMultiplayRpcTransportSpec)
+
+void FMultiplayRpcTransportSpec::Define()
+{
+	BeforeEach([this]()
+		{
+			Channel = MakeShared<Multiplay::FStandInRpcChannel>();
+
+			// Without an endpoint, operations that fall back to HTTP are rejected before a request is sent.
+			GameServerApi = MakeUnique<Multiplay::OpenAPIGameServerApi>();
+			GameServerApi->SetURL(TEXT(""));
+			PayloadApi = MakeUnique<Multiplay::OpenAPIPayloadApi>();
+			PayloadApi->SetURL(TEXT(""));
+
+			Transport = MakeShared<Multiplay::FMultiplayRpcTransport>(Channel, *GameServerApi, *PayloadApi, 2.0f);
+		});
+
+	AfterEach([this]()
+		{
+			Transport.Reset();
+			PayloadApi.Reset();
+			GameServerApi.Reset();
+			Channel.Reset();
+		});
+
+	Describe("ReadyServer", [this]()
+		{
+			It("should complete with the response returned by the daemon.", [this]()
+				{
+					Channel->Answer(200, TEXT(""));
+
+					Multiplay::ReadyServerRequest Request;
+					Request.ServerId = 12345;
+					Request.AllocationId = FGuid(1, 2, 3, 4);
+
+					bool bCompleted = false;
+					bool bSuccessful = false;
+					Transport->ReadyServer(Request, Multiplay::FReadyServerDelegate::CreateLambda([&bCompleted, &bSuccessful](const Multiplay::ReadyServerResponse& Response)
+						{
+							bCompleted = true;
+							bSuccessful = Response.IsSuccessful();
+						}));
+
+					TestTrueExpr(bCompleted);
+					TestTrueExpr(bSuccessful);
+
+					if (MP_TEST_TRUE_EXPR(Channel->Methods.Num() == 1))
+					{
+						TestEqual("Method", Channel->Methods[0], FString(Multiplay::FMultiplayRpcTransport::kReadyServerMethod));
+
+						const TSharedPtr<FJsonObject>* Params;
+						if (MP_TEST_TRUE_EXPR(Channel->Params[0]->TryGetObject(Params)))
+						{
+							TestEqual("serverId", (*Params)->GetStringField(TEXT("serverId")), FString(TEXT("12345")));
+						}
+					}
+				});
+
+			It("should report the error body returned by the daemon.", [this]()
+				{
+					FString Body = TEXT(R"({"title": "foo", "detail": "bar", "status": 400})");
+					Channel->Answer(400, Body);
+
+					bool bSuccessful = true;
+					FString Content;
+					Multiplay::EContentDecodeStatus DecodeStatus = Multiplay::EContentDecodeStatus::None;
+					FString Title;
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), Multiplay::FReadyServerDelegate::CreateLambda([&bSuccessful, &Content, &DecodeStatus, &Title](const Multiplay::ReadyServerResponse& Response)
+						{
+							bSuccessful = Response.IsSuccessful();
+							Content = Response.GetResponseContent();
+							DecodeStatus = Response.GetContentDecodeStatus();
+							Title = Response.ErrorContent.Title;
+						}));
+
+					TestFalseExpr(bSuccessful);
+					TestEqual("GetResponseContent()", Content, Body);
+					TestTrueExpr(DecodeStatus == Multiplay::EContentDecodeStatus::Decoded);
+					TestEqual("ErrorContent.Title", Title, FString(TEXT("foo")));
+				});
+
+			It("should fall back to HTTP without calling the daemon when the channel is unavailable.", [this]()
+				{
+					Channel->bAvailable = false;
+
+					AddExpectedError(TEXT("Endpoint Url is not set"), EAutomationExpectedErrorFlags::Contains, 1);
+
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), Multiplay::FReadyServerDelegate());
+
+					TestEqual("Methods.Num()", Channel->Methods.Num(), 0);
+					TestTrueExpr(Transport->IsRpcEnabled());
+				});
+
+			It("should stop using RPCs once the daemon reports that they are unsupported.", [this]()
+				{
+					Channel->Status = Multiplay::EMultiplayRpcStatus::Unsupported;
+
+					AddExpectedError(TEXT("Endpoint Url is not set"), EAutomationExpectedErrorFlags::Contains, 2);
+
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), Multiplay::FReadyServerDelegate());
+					TestFalseExpr(Transport->IsRpcEnabled());
+
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), Multiplay::FReadyServerDelegate());
+					TestEqual("Methods.Num()", Channel->Methods.Num(), 1);
+				});
+
+			It("should complete the caller when the HTTP request cannot be issued.", [this]()
+				{
+					Channel->bAvailable = false;
+
+					AddExpectedError(TEXT("Endpoint Url is not set"), EAutomationExpectedErrorFlags::Contains, 1);
+
+					bool bCompleted = false;
+					bool bSuccessful = true;
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), Multiplay::FReadyServerDelegate::CreateLambda([&bCompleted, &bSuccessful](const Multiplay::ReadyServerResponse& Response)
+						{
+							bCompleted = true;
+							bSuccessful = Response.IsSuccessful();
+						}));
+
+					TestTrueExpr(bCompleted);
+					TestFalseExpr(bSuccessful);
+				});
+
+			It("should only join a ready issued in flight if no unready was issued after it.", [this]()
+				{
+					Channel->bHold = true;
+					Channel->Answer(200, TEXT(""));
+
+					int32 Completions = 0;
+					Multiplay::FReadyServerDelegate OnReady = Multiplay::FReadyServerDelegate::CreateLambda([&Completions](const Multiplay::ReadyServerResponse& Response)
+						{
+							++Completions;
+						});
+
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), OnReady);
+					Transport->UnreadyServer(Multiplay::UnreadyServerRequest(), Multiplay::FUnreadyServerDelegate());
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), OnReady);
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), OnReady);
+
+					TestEqual("Methods.Num()", Channel->Methods.Num(), 3);
+
+					Channel->ReleaseAll();
+					TestEqual("Completions", Completions, 3);
+				});
+
+			It("should not let the state change of another server supersede a ready in flight.", [this]()
+				{
+					Channel->bHold = true;
+					Channel->Answer(200, TEXT(""));
+
+					int32 Completions = 0;
+					Multiplay::FReadyServerDelegate OnReady = Multiplay::FReadyServerDelegate::CreateLambda([&Completions](const Multiplay::ReadyServerResponse& Response)
+						{
+							++Completions;
+						});
+
+					Multiplay::ReadyServerRequest First;
+					First.ServerId = 1;
+					Multiplay::UnreadyServerRequest Second;
+					Second.ServerId = 2;
+
+					// The second ready of the first server still joins its first, the unready was issued for the second server.
+					Transport->ReadyServer(First, OnReady);
+					Transport->UnreadyServer(Second, Multiplay::FUnreadyServerDelegate());
+					Transport->ReadyServer(First, OnReady);
+
+					TestEqual("Methods.Num()", Channel->Methods.Num(), 2);
+
+					Channel->ReleaseAll();
+					TestEqual("Completions", Completions, 2);
+				});
+
+			It("should fail fast without sending a request while the circuit is open.", [this]()
+				{
+					Channel->bAvailable = false;
+					Transport->SetRetryPolicy(MakeShared<Multiplay::FMultiplayRetryPolicy>(4, 0.1f, 2.0f, 1, 60.0f));
+
+					// Only the first call reaches the HTTP client, the failure to send it opens the circuit.
+					AddExpectedError(TEXT("Endpoint Url is not set"), EAutomationExpectedErrorFlags::Contains, 1);
+
+					TArray<int32> Codes;
+					Multiplay::FReadyServerDelegate OnReady = Multiplay::FReadyServerDelegate::CreateLambda([&Codes](const Multiplay::ReadyServerResponse& Response)
+						{
+							Codes.Add(Response.GetHttpResponseCode());
+						});
+
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), OnReady);
+					Transport->ReadyServer(Multiplay::ReadyServerRequest(), OnReady);
+
+					if (MP_TEST_TRUE_EXPR(Codes.Num() == 2))
+					{
+						TestEqual("Codes[1]", Codes[1], static_cast<int32>(EHttpResponseCodes::ServiceUnavail));
+					}
+				});
+		});
+
+	Describe("GetReadyServerHedgeDelay", [this]()
+		{
+			It("should not hedge unless hedging is enabled.", [this]()
+				{
+					TestEqual("GetReadyServerHedgeDelay()", Transport->GetReadyServerHedgeDelay(), 0.0);
+				});
+
+			It("should hedge after the initial delay until enough latencies have been observed, then at their percentile.", [this]()
+				{
+					Transport->SetReadyServerHedging(95.0f, 0.25f);
+					TestEqual("GetReadyServerHedgeDelay()", Transport->GetReadyServerHedgeDelay(), 0.25);
+
+					for (uint64 Sample = 0; Sample < Multiplay::FMultiplayRpcTransport::kHedgeMinSamples; ++Sample)
+					{
+						Transport->RecordReadyServerLatency(0.02);
+					}
+
+					TestEqual("GetReadyServerHedgeDelay()", Transport->GetReadyServerHedgeDelay(), 0.02, 1e-6);
+				});
+		});
+
+	Describe("PayloadToken", [this]()
+		{
+			It("should parse the token returned by the daemon.", [this]()
+				{
+					Channel->Answer(200, TEXT(R"({"token": "foo", "error": ""})"));
+
+					FString Token;
+					Transport->PayloadToken(Multiplay::PayloadTokenRequest(), Multiplay::FPayloadTokenDelegate::CreateLambda([&Token](const Multiplay::PayloadTokenResponse& Response)
+						{
+							Token = Response.Content.Token;
+						}));
+
+					TestEqual("Token", Token, FString(TEXT("foo")));
+				});
+
+			It("should coalesce identical requests in flight into one call.", [this]()
+				{
+					Channel->bHold = true;
+					Channel->Answer(200, TEXT(R"({"token": "foo", "error": ""})"));
+
+					TArray<FString> Tokens;
+					Multiplay::FPayloadTokenDelegate OnToken = Multiplay::FPayloadTokenDelegate::CreateLambda([&Tokens](const Multiplay::PayloadTokenResponse& Response)
+						{
+							Tokens.Add(Response.Content.Token);
+						});
+
+					Transport->PayloadToken(Multiplay::PayloadTokenRequest(), OnToken);
+					Transport->PayloadToken(Multiplay::PayloadTokenRequest(), OnToken);
+
+					TestEqual("Methods.Num()", Channel->Methods.Num(), 1);
+
+					Channel->ReleaseAll();
+					if (MP_TEST_TRUE_EXPR(Tokens.Num() == 2))
+					{
+						TestEqual("Tokens[0]", Tokens[0], FString(TEXT("foo")));
+						TestEqual("Tokens[1]", Tokens[1], FString(TEXT("foo")));
+					}
+
+					// A request made after the response starts a new call.
+					Transport->PayloadToken(Multiplay::PayloadTokenRequest(), OnToken);
+					TestEqual("Methods.Num()", Channel->Methods.Num(), 2);
+				});
+		});
+
+	Describe("ApplyRpcResult", [this]()
+		{
+			It("should deliver a successful payload without decoding it.", [this]()
+				{
+					TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+					Object->SetNumberField(TEXT("code"), 200);
+					Object->SetStringField(TEXT("body"), TEXT("not json"));
+
+					Multiplay::PayloadAllocationResponse Response;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayRpcTransport::ApplyRpcResult(MakeShared<FJsonValueObject>(Object), nullptr, Response)))
+					{
+						TestEqual("GetResponseContent()", Response.GetResponseContent(), FString(TEXT("not json")));
+						TestTrueExpr(Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::None);
+					}
+				});
+
+			It("should decode an error body into the typed error model.", [this]()
+				{
+					TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+					Object->SetNumberField(TEXT("code"), 404);
+					Object->SetStringField(TEXT("body"), TEXT(R"({"error": true, "error_code": 404, "error_message": "foo", "success": false})"));
+
+					Multiplay::PayloadAllocationResponse Response;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayRpcTransport::ApplyRpcResult(MakeShared<FJsonValueObject>(Object), nullptr, Response)))
+					{
+						TestTrueExpr(Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::Decoded);
+						TestEqual("ErrorContent.ErrorMessage", Response.ErrorContent.ErrorMessage, FString(TEXT("foo")));
+					}
+				});
+
+			It("should keep an error body that is not served as JSON without decoding it.", [this]()
+				{
+					TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+					Object->SetNumberField(TEXT("code"), 502);
+
+					Multiplay::FMultiplayRpcBodyPtr Body = MakeShared<Multiplay::FMultiplayRpcBody, ESPMode::ThreadSafe>();
+					Body->Bytes = { '<', 'h', 't', 'm', 'l', '>' };
+					Body->ContentType = TEXT("text/html; charset=utf-8");
+
+					Multiplay::PayloadAllocationResponse Response;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayRpcTransport::ApplyRpcResult(MakeShared<FJsonValueObject>(Object), Body, Response)))
+					{
+						TestEqual("GetResponseContent()", Response.GetResponseContent(), FString(TEXT("<html>")));
+						TestTrueExpr(Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::None);
+					}
+				});
+
+			It("should decode an error body served as problem+json.", [this]()
+				{
+					TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+					Object->SetNumberField(TEXT("code"), 404);
+
+					const FTCHARToUTF8 Json(TEXT(R"({"error": true, "error_code": 404, "error_message": "foo", "success": false})"));
+					Multiplay::FMultiplayRpcBodyPtr Body = MakeShared<Multiplay::FMultiplayRpcBody, ESPMode::ThreadSafe>();
+					Body->Bytes.Append(reinterpret_cast<const uint8*>(Json.Get()), Json.Length());
+					Body->ContentType = TEXT("application/problem+json");
+
+					Multiplay::PayloadAllocationResponse Response;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayRpcTransport::ApplyRpcResult(MakeShared<FJsonValueObject>(Object), Body, Response)))
+					{
+						TestTrueExpr(Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::Decoded);
+						TestEqual("ErrorContent.ErrorMessage", Response.ErrorContent.ErrorMessage, FString(TEXT("foo")));
+					}
+				});
+
+			It("should decode a UTF-8 body without keeping it as a string.", [this]()
+				{
+					TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+					Object->SetNumberField(TEXT("code"), 404);
+
+					const FString Json = FString::Printf(TEXT(R"({"error": true, "error_code": 404, "error_message": "Allocation %s introuvable", "success": false})"), TEXT("\u00e9t\u00e9"));
+					const FTCHARToUTF8 Utf8(*Json);
+					Multiplay::FMultiplayRpcBodyPtr Body = MakeShared<Multiplay::FMultiplayRpcBody, ESPMode::ThreadSafe>();
+					Body->Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+					Body->ContentType = TEXT("application/json");
+
+					Multiplay::PayloadAllocationResponse Response;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayRpcTransport::ApplyRpcResult(MakeShared<FJsonValueObject>(Object), Body, Response)))
+					{
+						TestTrueExpr(Response.GetContentDecodeStatus() == Multiplay::EContentDecodeStatus::Decoded);
+						TestEqual("ErrorContent.ErrorMessage", Response.ErrorContent.ErrorMessage, FString(TEXT("Allocation \u00e9t\u00e9 introuvable")));
+						TestEqual("GetResponseContent()", Response.GetResponseContent(), Json);
+					}
+				});
+
+			It("should reject a result without a status code.", [this]()
+				{
+					TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+					Object->SetStringField(TEXT("body"), TEXT("foo"));
+
+					Multiplay::PayloadAllocationResponse Response;
+					TestFalseExpr(Multiplay::FMultiplayRpcTransport::ApplyRpcResult(MakeShared<FJsonValueObject>(Object), nullptr, Response));
+				});
+
+			It("should keep a body received as bytes as the payload without copying it.", [this]()
+				{
+					TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+					Object->SetNumberField(TEXT("code"), 200);
+
+					Multiplay::FMultiplayRpcBodyPtr Body = MakeShared<Multiplay::FMultiplayRpcBody, ESPMode::ThreadSafe>();
+					Body->Bytes = { 0x00, 0xFF, 0x10 };
+					Body->ContentType = TEXT("application/octet-stream");
+					const uint8* Received = Body->Bytes.GetData();
+
+					Multiplay::PayloadAllocationResponse Response;
+					if (MP_TEST_TRUE_EXPR(Multiplay::FMultiplayRpcTransport::ApplyRpcResult(MakeShared<FJsonValueObject>(Object), Body, Response)) && MP_TEST_TRUE_EXPR(Response.Payload.IsValid()))
+					{
+						TestEqual("Payload->Num()", Response.Payload->Num(), 3);
+						TestTrueExpr(Response.Payload->GetBytes().GetData() == Received);
+					}
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,341 @@
+#include "MultiplaySdkCore.h"
+#include "Async/Async.h"
+#include "Centrifuge/MultiplayCentrifugeClient.h"
+#include "Centrifuge/MultiplayCentrifugeKeepalive.h"
+#include "Centrifuge/MultiplayCentrifugeMessages.h"
+#include "MultiplayRpcTransport.h"
+#include "MultiplayUnixSocketChannel.h"
+#include "MultiplayRetryPolicy.h"
+#include "MultiplayConnectionWarmer.h"
+#include "MultiplayGameServerSettings.h"
+#include "OpenAPIGameServerApi.h"
+#include "OpenAPIPayloadApi.h"
+#include "MultiplayGameServerSDKLog.h"
+
+namespace Multiplay
+{
+	TSharedRef<FMultiplaySdkCore> FMultiplaySdkCore::GetShared()
+	{
+		check(IsInGameThread());
+
+		static TWeakPtr<FMultiplaySdkCore> Shared;
+
+		TSharedPtr<FMultiplaySdkCore> Core = Shared.Pin();
+		if (!Core.IsValid())
+		{
+			Core = MakeShared<FMultiplaySdkCore>();
+			Core->bShared = true;
+			Shared = Core;
+		}
+
+		return Core.ToSharedRef();
+	}
+
+	FMultiplaySdkCore::FMultiplaySdkCore()
+		: bConnectReplied(false)
+		, bConnectWhenClosed(false)
+		, bShared(false)
+	{
+		FString SdkDaemonIp = TEXT("localhost");
+		uint16 SdkDaemonPort = 8086;
+		FString SdkDaemonUrl = FString::Printf(TEXT("http://%s:%u"), *SdkDaemonIp, SdkDaemonPort);
+		FString SdkDaemonCentrifugeEndpoint = FString::Printf(TEXT("ws://%s:%u/v1/connection/websocket"), *SdkDaemonIp, SdkDaemonPort);
+
+		GameServerApi = MakeUnique<OpenAPIGameServerApi>();
+		GameServerApi->SetURL(SdkDaemonUrl);
+
+		PayloadApi = MakeUnique<OpenAPIPayloadApi>();
+		PayloadApi->SetURL(SdkDaemonUrl);
+
+		const UMultiplayGameServerSettings* Settings = GetDefault<UMultiplayGameServerSettings>();
+
+		PayloadApi->SetPayloadSpillThreshold(Settings->PayloadSpillThresholdBytes);
+		PayloadApi->SetPayloadCompression(Settings->bAcceptCompressedPayload, Settings->PayloadMaxDecompressedBytes);
+
+		// The TCP URLs are kept with a socket path, the HTTP fallback still uses them and the socket requests take their host from them.
+		FString SdkDaemonSocketPath = Settings->DaemonSocketPath;
+		if (!SdkDaemonSocketPath.IsEmpty() && !IsUnixSocketSupported())
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Unix domain sockets are not supported on this platform, connecting to the SDK daemon over TCP."));
+			SdkDaemonSocketPath.Empty();
+		}
+
+		const ECentrifugeConnectionType ConnectionType = Settings->bUseBuiltInWebSocket ? ECentrifugeConnectionType::BuiltIn : ECentrifugeConnectionType::Engine;
+		CentrifugeClient = MakeUnique<FCentrifugeClient>(SdkDaemonCentrifugeEndpoint, ConnectionType, SdkDaemonSocketPath);
+		CentrifugeClient->OnConnectionStatusChanged().AddRaw(this, &FMultiplaySdkCore::OnConnectionStatusChanged);
+		CentrifugeClient->OnConnectReply().AddRaw(this, &FMultiplaySdkCore::OnConnectReply);
+		CentrifugeClient->OnSubscribeReply().AddRaw(this, &FMultiplaySdkCore::OnSubscribeReply);
+		CentrifugeClient->OnHistoryReply().AddRaw(this, &FMultiplaySdkCore::OnHistoryReply);
+		CentrifugeClient->OnErrorReply().AddRaw(this, &FMultiplaySdkCore::OnErrorReply);
+		CentrifugeClient->OnPublicationPush().AddRaw(this, &FMultiplaySdkCore::OnPublicationPush);
+
+		if (Settings->bEnableKeepalive)
+		{
+			CentrifugeKeepalive = MakeUnique<FCentrifugeKeepalive>(*CentrifugeClient, Settings->KeepaliveIntervalSeconds, Settings->KeepaliveMaxMissedPongs, Settings->KeepaliveMaxReconnectDelaySeconds);
+		}
+
+		TSharedPtr<IMultiplayRpcChannel> RpcChannel;
+		if (!SdkDaemonSocketPath.IsEmpty())
+		{
+			RpcChannel = MakeShared<FMultiplayUnixSocketChannel>(SdkDaemonSocketPath, FString::Printf(TEXT("%s:%u"), *SdkDaemonIp, SdkDaemonPort), Settings->bAcceptCompressedPayload);
+		}
+		else if (Settings->bUseRpcTransport)
+		{
+			RpcChannel = MakeShared<FCentrifugeRpcChannel>(*CentrifugeClient);
+		}
+
+		RpcTransport = MakeShared<FMultiplayRpcTransport>(RpcChannel, *GameServerApi, *PayloadApi, Settings->RpcTimeoutSeconds);
+
+		if (Settings->bEnableRetries)
+		{
+			// Ready and unready set the server state rather than toggle it, so repeating them is as safe as repeating the payload reads.
+			TSharedRef<FMultiplayRetryPolicy> RetryPolicy = MakeShared<FMultiplayRetryPolicy>(
+				Settings->RetryMaxAttempts, Settings->RetryBaseDelaySeconds, Settings->RetryMaxDelaySeconds, Settings->CircuitBreakerFailureThreshold, Settings->CircuitBreakerOpenSeconds, static_cast<int32>(FPlatformTime::Cycles()));
+			RetryPolicy->SetOperation(FMultiplayRpcTransport::kReadyServerMethod, { Settings->ReadyServerDeadlineSeconds, true });
+			RetryPolicy->SetOperation(FMultiplayRpcTransport::kUnreadyServerMethod, { Settings->UnreadyServerDeadlineSeconds, true });
+			RetryPolicy->SetOperation(FMultiplayRpcTransport::kPayloadAllocationMethod, { Settings->PayloadAllocationDeadlineSeconds, true });
+			RetryPolicy->SetOperation(FMultiplayRpcTransport::kPayloadTokenMethod, { Settings->PayloadTokenDeadlineSeconds, true });
+			RpcTransport->SetRetryPolicy(RetryPolicy);
+		}
+
+		if (Settings->bHedgeReadyServer)
+		{
+			RpcTransport->SetReadyServerHedging(Settings->ReadyServerHedgePercentile, Settings->ReadyServerHedgeInitialDelaySeconds);
+		}
+
+		if (Settings->bKeepDaemonConnectionWarm)
+		{
+			GameServerApi->AddHeaderParam(TEXT("Connection"), TEXT("keep-alive"));
+			PayloadApi->AddHeaderParam(TEXT("Connection"), TEXT("keep-alive"));
+
+			ConnectionWarmer = MakeShared<FMultiplayConnectionWarmer>(SdkDaemonUrl, Settings->DaemonConnectionWarmupIntervalSeconds);
+			ConnectionWarmer->Warm();
+			RpcTransport->SetConnectionWarmer(ConnectionWarmer);
+		}
+	}
+
+	FMultiplaySdkCore::~FMultiplaySdkCore()
+	{
+		CentrifugeKeepalive.Reset();
+		RpcTransport.Reset();
+		ConnectionWarmer.Reset();
+
+		CentrifugeClient->OnConnectionStatusChanged().RemoveAll(this);
+		CentrifugeClient->OnConnectReply().RemoveAll(this);
+		CentrifugeClient->OnSubscribeReply().RemoveAll(this);
+		CentrifugeClient->OnHistoryReply().RemoveAll(this);
+		CentrifugeClient->OnErrorReply().RemoveAll(this);
+		CentrifugeClient->OnPublicationPush().RemoveAll(this);
+
+		if (CentrifugeClient->IsConnected())
+		{
+			CentrifugeClient->Disconnect();
+		}
+	}
+
+	void FMultiplaySdkCore::Subscribe(const FString& Channel, FChannelHandlers Handlers)
+	{
+		const bool bAdded = !Channels.Contains(Channel);
+		Channels.FindOrAdd(Channel).Handlers = MoveTemp(Handlers);
+
+		switch (CentrifugeClient->GetConnectionStatus())
+		{
+		case EConnectionStatus::Disconnected:
+			Connect();
+			break;
+		case EConnectionStatus::Connected:
+			if (bAdded && bConnectReplied)
+			{
+				SendSubscribe(Channel);
+			}
+			break;
+		case EConnectionStatus::Disconnecting:
+			bConnectWhenClosed = true;
+			break;
+		default:
+			// The connect reply subscribes every channel it did not include.
+			break;
+		}
+	}
+
+	void FMultiplaySdkCore::Unsubscribe(const FString& Channel)
+	{
+		if (Channels.Remove(Channel) == 0)
+		{
+			return;
+		}
+
+		if (Channels.Num() == 0)
+		{
+			bConnectWhenClosed = false;
+			CentrifugeClient->Disconnect();
+		}
+		else if (bConnectReplied)
+		{
+			FUnsubscribeRequest Request;
+			Request.Channel = Channel;
+			CentrifugeClient->Unsubscribe(Request);
+		}
+	}
+
+	bool FMultiplaySdkCore::IsSubscribed(const FString& Channel) const
+	{
+		const FChannel* Entry = Channels.Find(Channel);
+		return Entry != nullptr && Entry->bSubscribed;
+	}
+
+	void FMultiplaySdkCore::Connect()
+	{
+		// Subscribing as part of the connect command saves a round trip before the first server event can be received.
+		FConnectRequest Request;
+		for (const TPair<FString, FChannel>& It : Channels)
+		{
+			Request.Subs.Add(It.Key, FSubscribeRequest());
+		}
+
+		CentrifugeClient->Connect(Request);
+	}
+
+	void FMultiplaySdkCore::SendSubscribe(const FString& Channel)
+	{
+		FSubscribeRequest Request;
+		Request.Channel = Channel;
+		CentrifugeClient->Subscribe(Request);
+	}
+
+	void FMultiplaySdkCore::OnConnectionStatusChanged(const EConnectionStatus& Status)
+	{
+		if (Status == EConnectionStatus::Connected)
+		{
+			return;
+		}
+
+		bConnectReplied = false;
+		for (TPair<FString, FChannel>& It : Channels)
+		{
+			It.Value.bSubscribed = false;
+		}
+
+		if (Status == EConnectionStatus::Disconnected && bConnectWhenClosed)
+		{
+			bConnectWhenClosed = false;
+
+			// Connected from the game thread rather than from within the client reporting the closed connection.
+			TWeakPtr<FMultiplaySdkCore> WeakThis = AsShared();
+			AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+				{
+					TSharedPtr<FMultiplaySdkCore> This = WeakThis.Pin();
+					if (This.IsValid() && This->Channels.Num() > 0 && This->CentrifugeClient->GetConnectionStatus() == EConnectionStatus::Disconnected)
+					{
+						This->Connect();
+					}
+				});
+		}
+	}
+
+	void FMultiplaySdkCore::OnConnectReply(const FConnectResult& Result)
+	{
+		bConnectReplied = true;
+
+		// The client reconnects with the channels it first connected with, which may since have changed.
+		TArray<FString> ChannelNames;
+		Channels.GetKeys(ChannelNames);
+
+		for (const FString& Channel : ChannelNames)
+		{
+			const FSubscribeResult* SubscribeResult = Result.Subs.IsSet() ? Result.Subs.GetValue().Find(Channel) : nullptr;
+			if (SubscribeResult == nullptr)
+			{
+				// Daemons that do not support connect-time subscriptions omit the channel from the reply.
+				UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("The connect reply did not include %s, subscribing separately."), *Channel);
+
+				SendSubscribe(Channel);
+				continue;
+			}
+
+			// A handler may have unsubscribed the channel.
+			FChannel* Entry = Channels.Find(Channel);
+			if (Entry != nullptr)
+			{
+				Entry->bSubscribed = true;
+
+				// Invoked from a copy, the handler may unsubscribe its channel.
+				TFunction<void(const FSubscribeResult&)> OnSubscribed = Entry->Handlers.OnSubscribed;
+				OnSubscribed(*SubscribeResult);
+			}
+		}
+
+		if (Result.Subs.IsSet())
+		{
+			for (const auto& It : Result.Subs.GetValue())
+			{
+				if (!Channels.Contains(It.Key))
+				{
+					FUnsubscribeRequest Request;
+					Request.Channel = It.Key;
+					CentrifugeClient->Unsubscribe(Request);
+				}
+			}
+		}
+	}
+
+	void FMultiplaySdkCore::OnSubscribeReply(const FSubscribeResult& Result)
+	{
+		if (FChannel* Entry = FindMessageChannel())
+		{
+			Entry->bSubscribed = true;
+
+			TFunction<void(const FSubscribeResult&)> OnSubscribed = Entry->Handlers.OnSubscribed;
+			OnSubscribed(Result);
+		}
+	}
+
+	void FMultiplaySdkCore::OnHistoryReply(const FHistoryResult& Result)
+	{
+		if (FChannel* Entry = FindMessageChannel())
+		{
+			TFunction<void(const FHistoryResult&)> OnHistory = Entry->Handlers.OnHistory;
+			OnHistory(Result);
+		}
+	}
+
+	void FMultiplaySdkCore::OnErrorReply(EMethodType Method, const FError& Error)
+	{
+		if (FChannel* Entry = FindMessageChannel())
+		{
+			TFunction<void(EMethodType, const FError&)> OnError = Entry->Handlers.OnError;
+			OnError(Method, Error);
+		}
+	}
+
+	void FMultiplaySdkCore::OnPublicationPush(const FPublication& Push)
+	{
+		if (FChannel* Entry = FindMessageChannel())
+		{
+			TFunction<void(const FPublication&)> OnPublication = Entry->Handlers.OnPublication;
+			OnPublication(Push);
+		}
+		else
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Ignoring a publication on '%s', no server is subscribed to it."), *CentrifugeClient->GetMessageChannel());
+		}
+	}
+
+	FMultiplaySdkCore::FChannel* FMultiplaySdkCore::FindMessageChannel()
+	{
+		const FString& Channel = CentrifugeClient->GetMessageChannel();
+
+		// Messages that do not name their channel can only be meant for the one channel of an unshared core.
+		if (Channel.IsEmpty())
+		{
+			for (TPair<FString, FChannel>& It : Channels)
+			{
+				return Channels.Num() == 1 ? &It.Value : nullptr;
+			}
+
+			return nullptr;
+		}
+
+		return Channels.Find(Channel);
+	}
+} // namespace Multiplay
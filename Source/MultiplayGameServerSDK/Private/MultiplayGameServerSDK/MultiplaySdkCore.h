@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Centrifuge/MultiplayCentrifugeForwardDeclarations.h"
+
+namespace Multiplay
+{
+	class FCentrifugeKeepalive;
+	class OpenAPIGameServerApi;
+	class OpenAPIPayloadApi;
+	class FMultiplayRpcTransport;
+	class FMultiplayConnectionWarmer;
+
+	// Owns the connection to the SDK daemon and the clients of its APIs, and passes each server channel the replies and
+	// publications that concern it.
+	//
+	// A server owns its core unless the SDK core is shared, in which case every game instance in the process holds the
+	// same core and subscribes its own server#<id> channel on the one connection. The connection is opened when the first
+	// channel is subscribed and closed when the last one is unsubscribed, a channel subscribed while it is being opened is
+	// subscribed once the connect reply has arrived. Must only be used from the game thread.
+	class FMultiplaySdkCore : public TSharedFromThis<FMultiplaySdkCore>
+	{
+	public:
+		struct FChannelHandlers
+		{
+			// Invoked each time the daemon acknowledges the subscription, including after the connection was re-established.
+			TFunction<void(const FSubscribeResult&)> OnSubscribed;
+			TFunction<void(const FHistoryResult&)> OnHistory;
+			TFunction<void(EMethodType, const FError&)> OnError;
+			TFunction<void(const FPublication&)> OnPublication;
+		};
+
+	public:
+		// The core shared by every game instance in the process, created on first use and destroyed with its last reference.
+		static TSharedRef<FMultiplaySdkCore> GetShared();
+
+		// Connects to the daemon with the transport configured in the project settings.
+		FMultiplaySdkCore();
+		~FMultiplaySdkCore();
+
+		// Passes the channel its replies and publications and subscribes to it, connecting if it is the first channel.
+		// Subscribing a channel again only replaces its handlers.
+		void Subscribe(const FString& Channel, FChannelHandlers Handlers);
+
+		// Unsubscribes from the channel, disconnecting if it was the last one.
+		void Unsubscribe(const FString& Channel);
+
+		// Whether the daemon has acknowledged the subscription to the channel on the current connection.
+		bool IsSubscribed(const FString& Channel) const;
+
+		int32 GetChannelCount() const { return Channels.Num(); }
+
+		bool IsShared() const { return bShared; }
+
+		FCentrifugeClient& GetClient() const { return *CentrifugeClient; }
+
+		// Null when keepalive pings are disabled.
+		const FCentrifugeKeepalive* GetKeepalive() const { return CentrifugeKeepalive.Get(); }
+
+		TSharedRef<FMultiplayRpcTransport> GetRpcTransport() const { return RpcTransport.ToSharedRef(); }
+
+		// Null when the connection is not kept warm.
+		const TSharedPtr<FMultiplayConnectionWarmer>& GetConnectionWarmer() const { return ConnectionWarmer; }
+
+	private:
+		struct FChannel
+		{
+			FChannelHandlers Handlers;
+			bool bSubscribed = false;
+		};
+
+		void Connect();
+		void SendSubscribe(const FString& Channel);
+
+		void OnConnectionStatusChanged(const EConnectionStatus& Status);
+		void OnConnectReply(const FConnectResult& Result);
+		void OnSubscribeReply(const FSubscribeResult& Result);
+		void OnHistoryReply(const FHistoryResult& Result);
+		void OnErrorReply(EMethodType Method, const FError& Error);
+		void OnPublicationPush(const FPublication& Push);
+
+		// Returns the channel the message being dispatched concerns, or null if it concerns no subscribed channel.
+		FChannel* FindMessageChannel();
+
+	private:
+		TUniquePtr<OpenAPIGameServerApi> GameServerApi;
+		TUniquePtr<OpenAPIPayloadApi> PayloadApi;
+		TUniquePtr<FCentrifugeClient> CentrifugeClient;
+		TUniquePtr<FCentrifugeKeepalive> CentrifugeKeepalive;
+		TSharedPtr<FMultiplayRpcTransport> RpcTransport;
+		TSharedPtr<FMultiplayConnectionWarmer> ConnectionWarmer;
+
+		TMap<FString, FChannel> Channels;
+
+		// Whether the connect reply has arrived on the current connection, channels are only subscribed separately after it.
+		bool bConnectReplied;
+
+		// Whether a channel was subscribed while the connection was closing, it is opened again once it has closed.
+		bool bConnectWhenClosed;
+
+		bool bShared;
+	};
+} // namespace Multiplay
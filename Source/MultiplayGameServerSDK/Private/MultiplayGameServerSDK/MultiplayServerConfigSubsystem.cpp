@@ -4,54 +4,31 @@
 #include "Engine/GameInstance.h"
 #include "Subsystems/SubsystemCollection.h"
 #include "MultiplayServerJson.h"
+#include "MultiplayFileWatcher.h"
+#include "MultiplayGameServerSettings.h"
 #include "MultiplayGameServerSDKLog.h"
 
+namespace
+{
+    bool IsSameServerConfig(const FMultiplayServerConfig& A, const FMultiplayServerConfig& B)
+    {
+        return A.ServerId == B.ServerId
+            && A.AllocationId == B.AllocationId
+            && A.QueryPort == B.QueryPort
+            && A.Port == B.Port
+            && A.ServerLogDirectory == B.ServerLogDirectory;
+    }
+} // namespace
+
+FResolveServerJsonPathDelegate UMultiplayServerConfigSubsystem::ResolveServerJsonPath;
+
 void UMultiplayServerConfigSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
 
-#if PLATFORM_WINDOWS
-    FString HomeDrive = FPlatformMisc::GetEnvironmentVariable(TEXT("HOMEDRIVE"));
-    FString HomePath = FPlatformMisc::GetEnvironmentVariable(TEXT("HOMEPATH"));
-    FString PathToHomeDirectory = FPaths::Combine(HomeDrive, HomePath);
-#elif PLATFORM_LINUX
-    FString PathToHomeDirectory = FPlatformMisc::GetEnvironmentVariable(TEXT("HOME"));
-#else
-    FString PathToHomeDirectory = TEXT("");
-#endif
-
-    FString PathToServerJson = FPaths::Combine(PathToHomeDirectory, TEXT("server.json"));
+    ServerJsonPath = GetServerJsonPath();
 
-    bool bDidReadServerJson = false;
-    FString ServerJsonFileContents;
-    if (FFileHelper::LoadFileToString(ServerJsonFileContents, *PathToServerJson))
-    {
-        auto JsonReader = TJsonReaderFactory<>::Create(ServerJsonFileContents);
-
-        TSharedPtr<FJsonValue> ServerJsonValue;
-        if (FJsonSerializer::Deserialize(JsonReader, ServerJsonValue) && ServerJsonValue.IsValid())
-        {
-            Multiplay::FMultiplayServerJson ServerJson;
-            if (ServerJson.FromJson(ServerJsonValue))
-            {
-                UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Server Id: %lld"), ServerJson.ServerId);
-                UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Allocation Id: %s"), *ServerJson.AllocationId);
-                UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Query Port: %d"), ServerJson.QueryPort);
-                UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Port: %d"), ServerJson.Port);
-                UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Server Log Directory: %s"), *ServerJson.ServerLogDirectory);
-
-                bDidReadServerJson = true;
-
-                ServerConfig.ServerId = ServerJson.ServerId;
-                ServerConfig.AllocationId = ServerJson.AllocationId;
-                ServerConfig.QueryPort = ServerJson.QueryPort;
-                ServerConfig.Port = ServerJson.Port;
-                ServerConfig.ServerLogDirectory = ServerJson.ServerLogDirectory;
-            }
-        }
-    }
-
-    if (!bDidReadServerJson)
+    if (!ReadServerJson(ServerConfig))
     {
         ServerConfig.ServerId = 0;
         ServerConfig.AllocationId = TEXT("");
@@ -60,20 +37,122 @@ void UMultiplayServerConfigSubsystem::Initialize(FSubsystemCollectionBase& Colle
         ServerConfig.ServerLogDirectory = TEXT("");
 
 #if WITH_EDITOR
-        UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to read server ID from %s, defaulting to invalid server ID %d."), *PathToServerJson, ServerConfig.ServerId);
+        UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to read server ID from %s, defaulting to invalid server ID %d."), *ServerJsonPath, ServerConfig.ServerId);
 #else
-        UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to read server ID from %s."), *PathToServerJson);
+        UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to read server ID from %s."), *ServerJsonPath);
 #endif
 
 #if WITH_EDITOR
-        UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to read query port from %s, defaulting to an ephemeral port."), *PathToServerJson);
+        UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to read query port from %s, defaulting to an ephemeral port."), *ServerJsonPath);
 #else
-        UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to read query port from %s."), *PathToServerJson);
+        UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to read query port from %s."), *ServerJsonPath);
 #endif
     }
+
+    const UMultiplayGameServerSettings* Settings = GetDefault<UMultiplayGameServerSettings>();
+    if (Settings->bWatchServerJson)
+    {
+        ServerJsonWatcher = MakeShared<Multiplay::FMultiplayFileWatcher>(ServerJsonPath, Settings->ServerJsonWatchIntervalSeconds, [this]()
+            {
+                ReloadServerConfig();
+            });
+    }
+}
+
+void UMultiplayServerConfigSubsystem::Deinitialize()
+{
+    ServerJsonWatcher.Reset();
+
+    Super::Deinitialize();
 }
 
 const FMultiplayServerConfig& UMultiplayServerConfigSubsystem::GetServerConfig() const
 {
     return ServerConfig;
 }
+
+bool UMultiplayServerConfigSubsystem::ReloadServerConfig()
+{
+    // Read into a copy, so that the configuration is never seen half replaced by a file that is still being written.
+    FMultiplayServerConfig ReloadedConfig = ServerConfig;
+    if (!ReadServerJson(ReloadedConfig))
+    {
+        UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to reload %s, keeping the configuration of server ID %lld."), *ServerJsonPath, ServerConfig.ServerId);
+        return false;
+    }
+
+    if (IsSameServerConfig(ReloadedConfig, ServerConfig))
+    {
+        return false;
+    }
+
+    const FMultiplayServerConfig PreviousConfig = ServerConfig;
+    ServerConfig = ReloadedConfig;
+
+    UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Reloaded %s, server ID %lld is now server ID %lld."), *ServerJsonPath, PreviousConfig.ServerId, ServerConfig.ServerId);
+
+    ServerConfigChangedEvent.Broadcast(PreviousConfig, ServerConfig);
+
+    return true;
+}
+
+FString UMultiplayServerConfigSubsystem::GetServerJsonPath() const
+{
+    if (ResolveServerJsonPath.IsBound())
+    {
+        FString ResolvedPath = ResolveServerJsonPath.Execute(GetGameInstance());
+        if (!ResolvedPath.IsEmpty())
+        {
+            return ResolvedPath;
+        }
+    }
+
+#if PLATFORM_WINDOWS
+    FString HomeDrive = FPlatformMisc::GetEnvironmentVariable(TEXT("HOMEDRIVE"));
+    FString HomePath = FPlatformMisc::GetEnvironmentVariable(TEXT("HOMEPATH"));
+    FString PathToHomeDirectory = FPaths::Combine(HomeDrive, HomePath);
+#elif PLATFORM_LINUX
+    FString PathToHomeDirectory = FPlatformMisc::GetEnvironmentVariable(TEXT("HOME"));
+#else
+    FString PathToHomeDirectory = TEXT("");
+#endif
+
+    return FPaths::Combine(PathToHomeDirectory, TEXT("server.json"));
+}
+
+bool UMultiplayServerConfigSubsystem::ReadServerJson(FMultiplayServerConfig& OutConfig) const
+{
+    FString ServerJsonFileContents;
+    if (!FFileHelper::LoadFileToString(ServerJsonFileContents, *ServerJsonPath))
+    {
+        return false;
+    }
+
+    auto JsonReader = TJsonReaderFactory<>::Create(ServerJsonFileContents);
+
+    TSharedPtr<FJsonValue> ServerJsonValue;
+    if (!FJsonSerializer::Deserialize(JsonReader, ServerJsonValue) || !ServerJsonValue.IsValid())
+    {
+        return false;
+    }
+
+    Multiplay::FMultiplayServerJson ServerJson;
+    if (!ServerJson.FromJson(ServerJsonValue))
+    {
+        return false;
+    }
+
+    UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Server Id: %lld"), ServerJson.ServerId);
+    UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Allocation Id: %s"), *ServerJson.AllocationId);
+    UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Query Port: %d"), ServerJson.QueryPort);
+    UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Port: %d"), ServerJson.Port);
+    UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Retrieved Server Log Directory: %s"), *ServerJson.ServerLogDirectory);
+
+    OutConfig.ServerId = ServerJson.ServerId;
+    OutConfig.AllocationId = ServerJson.AllocationId;
+    OutConfig.QueryPort = ServerJson.QueryPort;
+    OutConfig.Port = ServerJson.Port;
+    OutConfig.ServerLogDirectory = ServerJson.ServerLogDirectory;
+
+    return true;
+}
@@ -0,0 +1,33 @@
+#include "MultiplayServerEventRouter.h"
+
+namespace Multiplay
+{
+	void FMultiplayServerEventRouter::Register(const FString& EventType, FHandlerFunction Handler)
+	{
+		Handlers.Add(EventType, MoveTemp(Handler));
+	}
+
+	void FMultiplayServerEventRouter::Unregister(const FString& EventType)
+	{
+		Handlers.Remove(EventType);
+	}
+
+	FMultiplayServerEventRouter::ERouteResult FMultiplayServerEventRouter::Route(const TSharedPtr<FJsonValue>& Data, FString& OutEventType) const
+	{
+		const TSharedPtr<FJsonObject>* Object;
+		if (!Data.IsValid() || !Data->TryGetObject(Object) || !(*Object)->TryGetStringField(kEventTypeField, OutEventType))
+		{
+			return ERouteResult::NotAnEvent;
+		}
+
+		const FHandlerFunction* Found = Handlers.Find(OutEventType);
+		if (Found == nullptr)
+		{
+			return ERouteResult::Unhandled;
+		}
+
+		// Invoked from a copy, the handler may unregister itself.
+		const FHandlerFunction Handler = *Found;
+		return Handler(Data) ? ERouteResult::Handled : ERouteResult::Invalid;
+	}
+} // namespace Multiplay
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+namespace Multiplay
+{
+	// Dispatches server events to the handler registered for their EventType.
+	//
+	// The EventType field is read once and looked up, so each event is decoded only by the handler for its type rather
+	// than by every decoder in turn. A handler may register or unregister handlers while it runs.
+	class FMultiplayServerEventRouter
+	{
+	public:
+		static constexpr const TCHAR* const kEventTypeField = TEXT("EventType");
+
+		// Returns false if the event could not be decoded.
+		using FHandlerFunction = TFunction<bool(const TSharedPtr<FJsonValue>& /* Data */)>;
+
+		enum class ERouteResult : uint8
+		{
+			Handled,
+			// The publication is not an object with an EventType.
+			NotAnEvent,
+			// No handler is registered for the EventType.
+			Unhandled,
+			// The handler could not decode the event.
+			Invalid,
+		};
+
+	public:
+		// Registers the handler for the event type, replacing any handler it had.
+		void Register(const FString& EventType, FHandlerFunction Handler);
+
+		// Registers a handler that receives events of the type decoded by EventClass::FromJson, the type is EventClass::kEventType.
+		template <typename EventClass>
+		void Register(TFunction<void(const EventClass&)> Handler)
+		{
+			Register(EventClass::kEventType, [Handler = MoveTemp(Handler)](const TSharedPtr<FJsonValue>& Data)
+				{
+					EventClass Event;
+					if (!Event.FromJson(Data))
+					{
+						return false;
+					}
+
+					Handler(Event);
+					return true;
+				});
+		}
+
+		void Unregister(const FString& EventType);
+
+		bool IsRegistered(const FString& EventType) const { return Handlers.Contains(EventType); }
+
+		// Passes the event to the handler registered for its type. OutEventType is set when the event has one.
+		ERouteResult Route(const TSharedPtr<FJsonValue>& Data, FString& OutEventType) const;
+
+	private:
+		TMap<FString, FHandlerFunction> Handlers;
+	};
+} // namespace Multiplay
@@ -0,0 +1,107 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayServerEventRouter.h"
+#include "MultiplayGameServerSDK/MultiplayServerEvents.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayServerEventRouterSpec, "MultiplayGameServerSDK.ServerEventRouter", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+using ERouteResult = Multiplay::FMultiplayServerEventRouter::ERouteResult;
+TSharedPtr<FJsonValue> Parse(const FString& JsonString) const;
+END_DEFINE_SPEC(FMultiplayServerEventRouterSpec)
+
+TSharedPtr<FJsonValue> FMultiplayServerEventRouterSpec::Parse(const FString& JsonString) const
+{
+	TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<>::Create(JsonString);
+
+	TSharedPtr<FJsonValue> JsonValue;
+	FJsonSerializer::Deserialize(JsonReader, JsonValue);
+	return JsonValue;
+}
+
+void FMultiplayServerEventRouterSpec::Define()
+{
+	It("should decode an event only with the decoder registered for its type.", [this]()
+		{
+			Multiplay::FMultiplayServerEventRouter Router;
+
+			int32 Allocations = 0;
+			int32 Deallocations = 0;
+			FGuid AllocationId;
+			Router.Register<Multiplay::FMultiplayServerAllocateEvent>([&](const Multiplay::FMultiplayServerAllocateEvent& Event)
+				{
+					++Allocations;
+					AllocationId = Event.AllocationId;
+				});
+			Router.Register<Multiplay::FMultiplayServerDeallocateEvent>([&](const Multiplay::FMultiplayServerDeallocateEvent&) { ++Deallocations; });
+
+			FString EventType;
+			const ERouteResult Result = Router.Route(Parse(TEXT("{\"EventID\":\"e3e455f8-f977-11e9-bccf-1a111111f111\",\"EventType\":\"AllocateEventType\",\"ServerID\":12345,\"AllocationID\":\"e3e455f8-f977-11e9-bccf-2a222222f222\"}")), EventType);
+
+			TestTrueExpr(Result == ERouteResult::Handled);
+			TestEqual(TEXT("EventType"), EventType, FString(Multiplay::FMultiplayServerAllocateEvent::kEventType));
+			TestEqual(TEXT("Allocations"), Allocations, 1);
+			TestEqual(TEXT("Deallocations"), Deallocations, 0);
+
+			FGuid Expected;
+			FGuid::Parse(TEXT("e3e455f8-f977-11e9-bccf-2a222222f222"), Expected);
+			TestEqual(TEXT("AllocationId"), AllocationId, Expected);
+		});
+
+	It("should report an event its decoder rejects as invalid.", [this]()
+		{
+			Multiplay::FMultiplayServerEventRouter Router;
+			Router.Register<Multiplay::FMultiplayServerDeallocateEvent>([](const Multiplay::FMultiplayServerDeallocateEvent&) {});
+
+			FString EventType;
+			TestTrueExpr(Router.Route(Parse(TEXT("{\"EventType\":\"DeallocateEventType\",\"ServerID\":12345}")), EventType) == ERouteResult::Invalid);
+		});
+
+	It("should pass events of a type registered by the game to its handler.", [this]()
+		{
+			Multiplay::FMultiplayServerEventRouter Router;
+
+			FString Reason;
+			Router.Register(TEXT("RecycleEventType"), [&Reason](const TSharedPtr<FJsonValue>& Data)
+				{
+					return Data->AsObject()->TryGetStringField(TEXT("Reason"), Reason);
+				});
+
+			FString EventType;
+			TestTrueExpr(Router.Route(Parse(TEXT("{\"EventType\":\"RecycleEventType\",\"Reason\":\"update\"}")), EventType) == ERouteResult::Handled);
+			TestEqual(TEXT("Reason"), Reason, FString(TEXT("update")));
+
+			Router.Unregister(TEXT("RecycleEventType"));
+			TestTrueExpr(Router.Route(Parse(TEXT("{\"EventType\":\"RecycleEventType\",\"Reason\":\"update\"}")), EventType) == ERouteResult::Unhandled);
+		});
+
+	It("should not route a publication without an event type.", [this]()
+		{
+			Multiplay::FMultiplayServerEventRouter Router;
+			Router.Register<Multiplay::FMultiplayServerAllocateEvent>([](const Multiplay::FMultiplayServerAllocateEvent&) {});
+
+			FString EventType;
+			TestTrueExpr(Router.Route(Parse(TEXT("{\"ServerID\":12345}")), EventType) == ERouteResult::NotAnEvent);
+			TestTrueExpr(Router.Route(Parse(TEXT("[1,2,3]")), EventType) == ERouteResult::NotAnEvent);
+		});
+
+	It("should let a handler unregister itself while it runs.", [this]()
+		{
+			Multiplay::FMultiplayServerEventRouter Router;
+
+			int32 Calls = 0;
+			Router.Register(TEXT("OnceEventType"), [&Router, &Calls](const TSharedPtr<FJsonValue>&)
+				{
+					++Calls;
+					Router.Unregister(TEXT("OnceEventType"));
+					return true;
+				});
+
+			FString EventType;
+			TestTrueExpr(Router.Route(Parse(TEXT("{\"EventType\":\"OnceEventType\"}")), EventType) == ERouteResult::Handled);
+			TestTrueExpr(Router.Route(Parse(TEXT("{\"EventType\":\"OnceEventType\"}")), EventType) == ERouteResult::Unhandled);
+			TestEqual(TEXT("Calls"), Calls, 1);
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -3,7 +3,10 @@
 #include "Subsystems/SubsystemCollection.h"
 #include "Serialization/ArrayWriter.h"
 #include "MultiplayServerQueryProtocol.h"
+#include "MultiplayQueryReceiver.h"
 #include "MultiplayServerConfigSubsystem.h"
+#include "MultiplayGameServerSettings.h"
+#include "MultiplayLogSink.h"
 #include "MultiplayGameServerSDKLog.h"
 
 void UMultiplayServerQueryHandlerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -12,10 +15,17 @@ void UMultiplayServerQueryHandlerSubsystem::Initialize(FSubsystemCollectionBase&
 
 	// This subsystem is dependent on the server.json file having been parsed so that the queryPort value can be retrieved.
 	Collection.InitializeDependency(UMultiplayServerConfigSubsystem::StaticClass());
+
+	GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>()->OnServerConfigChanged().AddUObject(this, &UMultiplayServerQueryHandlerSubsystem::OnServerConfigChanged);
 }
 
 void UMultiplayServerQueryHandlerSubsystem::Deinitialize()
 {
+	if (UMultiplayServerConfigSubsystem* Subsystem = GetGameInstance()->GetSubsystem<UMultiplayServerConfigSubsystem>())
+	{
+		Subsystem->OnServerConfigChanged().RemoveAll(this);
+	}
+
 	Disconnect();
 
 	Super::Deinitialize();
@@ -39,6 +49,27 @@ bool UMultiplayServerQueryHandlerSubsystem::Connect()
     const FMultiplayServerConfig& ServerConfig = Subsystem->GetServerConfig();
 	int32 QueryPort = ServerConfig.QueryPort;
 
+	if (GetDefault<UMultiplayGameServerSettings>()->bShareSdkCore)
+	{
+		TSharedRef<Multiplay::FMultiplayQueryReceiver> Receiver = Multiplay::FMultiplayQueryReceiver::GetShared();
+		QuerySocket = Receiver->Bind(QueryPort, [this](const FArrayReaderPtr& ArrayReaderPtr, const FIPv4Endpoint& EndPt)
+			{
+				ReceiveSQPData(ArrayReaderPtr, EndPt);
+			});
+
+		if (nullptr == QuerySocket)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to bind socket to port '%u'"), QueryPort);
+			return false;
+		}
+
+		SharedReceiver = Receiver;
+
+		UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Listening on port '%u' with the shared query receiver"), QueryPort);
+
+		return true;
+	}
+
 	int32 BufferSize = 2 * 1024 * 1024;
 
 	QuerySocket = FUdpSocketBuilder(TEXT("GameServerQueryReceiver"))
@@ -67,6 +98,14 @@ bool UMultiplayServerQueryHandlerSubsystem::Connect()
 
 void UMultiplayServerQueryHandlerSubsystem::Disconnect()
 {
+	// The shared receiver owns the socket, and does not pass on packets once it has been unbound.
+	if (SharedReceiver.IsValid())
+	{
+		SharedReceiver->Unbind(QuerySocket);
+		SharedReceiver.Reset();
+		QuerySocket = nullptr;
+	}
+
 	if (nullptr != UDPReceiver)
 	{
 		UDPReceiver = nullptr;
@@ -88,7 +127,20 @@ void UMultiplayServerQueryHandlerSubsystem::Disconnect()
 
 bool UMultiplayServerQueryHandlerSubsystem::IsConnected() const
 {
-	return (nullptr != UDPReceiver);
+	return (nullptr != UDPReceiver) || SharedReceiver.IsValid();
+}
+
+void UMultiplayServerQueryHandlerSubsystem::OnServerConfigChanged(const FMultiplayServerConfig& PreviousConfig, const FMultiplayServerConfig& ServerConfig)
+{
+	if (PreviousConfig.QueryPort == ServerConfig.QueryPort || !IsConnected())
+	{
+		return;
+	}
+
+	UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Query port changed from '%d' to '%d', rebinding."), PreviousConfig.QueryPort, ServerConfig.QueryPort);
+
+	Disconnect();
+	Connect();
 }
 
 const int32& UMultiplayServerQueryHandlerSubsystem::GetCurrentPlayers() const
@@ -260,7 +312,7 @@ void UMultiplayServerQueryHandlerSubsystem::ReceiveSQPData(const FArrayReaderPtr
 	{
 	case static_cast<uint8>(Multiplay::ESQPMessageType::ChallengeRequest):
 	{
-		UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("Received ChallengeRequest packet."))
+		MULTIPLAY_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("Received ChallengeRequest packet."));
 
 		SendSQPChallengePacket(FromAddress);
 
@@ -268,7 +320,7 @@ void UMultiplayServerQueryHandlerSubsystem::ReceiveSQPData(const FArrayReaderPtr
 	}
 	case static_cast<uint8>(Multiplay::ESQPMessageType::QueryRequest):
 	{
-		UE_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("Received QueryRequest packet."))
+		MULTIPLAY_LOG(LogMultiplayGameServerSDK, Verbose, TEXT("Received QueryRequest packet."));
 
 		SendSQPQueryPacket(ArrayReaderPtr, FromAddress);
 		break;
@@ -0,0 +1,240 @@
+#include "MultiplayStreamRecovery.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "MultiplayGameServerSDKLog.h"
+
+namespace Multiplay
+{
+	bool FMultiplayStreamCheckpoint::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
+	{
+		const TSharedPtr<FJsonObject>* Object;
+		if (!JsonValue->TryGetObject(Object))
+			return false;
+
+		bool bParseSuccess = true;
+
+		bParseSuccess &= TryGetJsonValue(*Object, TEXT("channel"), Channel);
+		bParseSuccess &= TryGetJsonValue(*Object, TEXT("epoch"), Epoch);
+		bParseSuccess &= TryGetJsonValue(*Object, TEXT("offset"), Offset);
+
+		return bParseSuccess;
+	}
+
+	void FMultiplayStreamCheckpoint::WriteJson(JsonWriter& Writer) const
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteIdentifierPrefix(TEXT("channel")); WriteJsonValue(Writer, Channel);
+		Writer->WriteIdentifierPrefix(TEXT("epoch")); WriteJsonValue(Writer, Epoch);
+		Writer->WriteIdentifierPrefix(TEXT("offset")); WriteJsonValue(Writer, static_cast<int64>(Offset));
+		Writer->WriteObjectEnd();
+	}
+
+	bool FMultiplayStreamCheckpoint::LoadFromFile(const FString& Path)
+	{
+		FString FileContents;
+		if (!FFileHelper::LoadFileToString(FileContents, *Path))
+		{
+			return false;
+		}
+
+		auto JsonReader = TJsonReaderFactory<>::Create(FileContents);
+
+		TSharedPtr<FJsonValue> JsonValue;
+		if (FJsonSerializer::Deserialize(JsonReader, JsonValue) && JsonValue.IsValid())
+		{
+			return FromJson(JsonValue);
+		}
+
+		return false;
+	}
+
+	bool FMultiplayStreamCheckpoint::SaveToFile(const FString& Path) const
+	{
+		// Write to a temporary file first so that a crash mid-write never leaves a truncated checkpoint behind.
+		const FString TemporaryPath = Path + TEXT(".tmp");
+
+		if (!FFileHelper::SaveStringToFile(ToString(*this), *TemporaryPath))
+		{
+			return false;
+		}
+
+		return IFileManager::Get().Move(*Path, *TemporaryPath, true, true);
+	}
+
+	FMultiplayStreamRecovery::FMultiplayStreamRecovery(FString InChannel, FString InCheckpointPath)
+		: Channel(MoveTemp(InChannel))
+		, CheckpointPath(MoveTemp(InCheckpointPath))
+		, bHasCheckpoint(false)
+		, bIsCatchingUp(false)
+		, CatchUpOffset(0)
+	{
+		if (!CheckpointPath.IsEmpty() && Checkpoint.LoadFromFile(CheckpointPath))
+		{
+			if (Checkpoint.Channel.Equals(Channel))
+			{
+				UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Loaded stream checkpoint for %s at offset %llu (epoch '%s')."), *Channel, Checkpoint.Offset, *Checkpoint.Epoch);
+
+				bHasCheckpoint = true;
+				Epoch = Checkpoint.Epoch;
+			}
+			else
+			{
+				UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Ignoring stream checkpoint for %s, the server is subscribed to %s."), *Checkpoint.Channel, *Channel);
+			}
+		}
+
+		Checkpoint.Channel = Channel;
+	}
+
+	bool FMultiplayStreamRecovery::BeginCatchUp(const FSubscribeResult& Result, FHistoryRequest& OutRequest, TArray<FPublication>& OutPublications)
+	{
+		const FString SubscribedEpoch = Result.Epoch.Get(Epoch);
+
+		if (bIsCatchingUp)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Resubscribed to %s during a catch-up, starting over from offset %llu."), *Channel, Checkpoint.Offset);
+		}
+
+		if (!bHasCheckpoint)
+		{
+			Epoch = SubscribedEpoch;
+			EndCatchUp(OutPublications);
+			return false;
+		}
+
+		if (!SubscribedEpoch.Equals(Checkpoint.Epoch))
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("The %s stream was reset (epoch '%s' is now '%s'), missed publications cannot be recovered."), *Channel, *Checkpoint.Epoch, *SubscribedEpoch);
+
+			Epoch = SubscribedEpoch;
+			Checkpoint.Epoch = SubscribedEpoch;
+			Checkpoint.Offset = 0;
+			bHasCheckpoint = false;
+			EndCatchUp(OutPublications);
+			return false;
+		}
+
+		if (Result.Offset.IsSet() && Result.Offset.GetValue() <= Checkpoint.Offset)
+		{
+			// The stream has not advanced since the checkpoint was written.
+			EndCatchUp(OutPublications);
+			return false;
+		}
+
+		MakeHistoryRequest(Checkpoint.Offset, OutRequest);
+
+		// Publications buffered by an unfinished catch-up are kept, the new one returns them after the history.
+		bIsCatchingUp = true;
+		CatchUpOffset = Checkpoint.Offset;
+
+		return true;
+	}
+
+	bool FMultiplayStreamRecovery::CompleteCatchUp(const FHistoryResult& Result, TArray<FPublication>& OutPublications, FHistoryRequest& OutRequest)
+	{
+		if (Result.Epoch.Equals(Checkpoint.Epoch))
+		{
+			const int32 NumRecovered = OutPublications.Num();
+			for (const FPublication& Publication : Result.Publications)
+			{
+				if (Publication.Offset > CatchUpOffset)
+				{
+					CatchUpOffset = Publication.Offset;
+					OutPublications.Add(Publication);
+				}
+			}
+
+			UE_LOG(LogMultiplayGameServerSDK, Log, TEXT("Recovered %d missed publications from %s."), OutPublications.Num() - NumRecovered, *Channel);
+
+			// A page that advanced but stopped short of the top of the stream is followed by the next one.
+			if (OutPublications.Num() > NumRecovered && CatchUpOffset < Result.Offset)
+			{
+				MakeHistoryRequest(CatchUpOffset, OutRequest);
+				return true;
+			}
+		}
+		else
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("The %s history epoch '%s' does not match the checkpoint epoch '%s', missed publications cannot be recovered."), *Channel, *Result.Epoch, *Checkpoint.Epoch);
+		}
+
+		bIsCatchingUp = false;
+
+		// Live publications may overlap with the tail of the history.
+		for (FPublication& Publication : BufferedPublications)
+		{
+			if (Publication.Offset == 0 || Publication.Offset > CatchUpOffset)
+			{
+				CatchUpOffset = FMath::Max(CatchUpOffset, Publication.Offset);
+				OutPublications.Add(MoveTemp(Publication));
+			}
+		}
+
+		BufferedPublications.Reset();
+
+		return false;
+	}
+
+	void FMultiplayStreamRecovery::AbortCatchUp(TArray<FPublication>& OutPublications)
+	{
+		EndCatchUp(OutPublications);
+	}
+
+	bool FMultiplayStreamRecovery::ShouldConsume(const FPublication& Publication)
+	{
+		if (bIsCatchingUp)
+		{
+			BufferedPublications.Add(Publication);
+			return false;
+		}
+
+		return !IsConsumed(Publication);
+	}
+
+	void FMultiplayStreamRecovery::Commit(const FPublication& Publication)
+	{
+		// Publications only carry an offset when the channel keeps a history.
+		if (Publication.Offset == 0)
+		{
+			return;
+		}
+
+		Checkpoint.Epoch = Epoch;
+		Checkpoint.Offset = Publication.Offset;
+		bHasCheckpoint = true;
+
+		if (!CheckpointPath.IsEmpty() && !Checkpoint.SaveToFile(CheckpointPath))
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to write stream checkpoint to %s."), *CheckpointPath);
+		}
+	}
+
+	bool FMultiplayStreamRecovery::IsConsumed(const FPublication& Publication) const
+	{
+		return bHasCheckpoint && (Publication.Offset != 0) && (Publication.Offset <= Checkpoint.Offset);
+	}
+
+	void FMultiplayStreamRecovery::MakeHistoryRequest(uint64 SinceOffset, FHistoryRequest& OutRequest) const
+	{
+		OutRequest.Channel = Channel;
+		OutRequest.Limit = kHistoryLimit;
+		OutRequest.Since.Offset = SinceOffset;
+		OutRequest.Since.Epoch = Checkpoint.Epoch;
+		OutRequest.bReverse = false;
+	}
+
+	void FMultiplayStreamRecovery::EndCatchUp(TArray<FPublication>& OutPublications)
+	{
+		bIsCatchingUp = false;
+
+		for (FPublication& Publication : BufferedPublications)
+		{
+			if (!IsConsumed(Publication))
+			{
+				OutPublications.Add(MoveTemp(Publication));
+			}
+		}
+
+		BufferedPublications.Reset();
+	}
+} // namespace Multiplay
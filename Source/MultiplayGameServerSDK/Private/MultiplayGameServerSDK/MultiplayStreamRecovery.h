@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Centrifuge/MultiplayCentrifugeMessages.h"
+
+namespace Multiplay
+{
+	// {
+	//   "channel": "server#12345",
+	//   "epoch": "xyz",
+	//   "offset": 42
+	// }
+	class FMultiplayStreamCheckpoint : public IJsonReadable, public IJsonWritable
+	{
+	public:
+		static constexpr const TCHAR* const kFileName = TEXT("multiplay-sdk-stream-position.json");
+
+		virtual ~FMultiplayStreamCheckpoint() = default;
+
+		virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) override;
+		virtual void WriteJson(JsonWriter& Writer) const override;
+
+		bool LoadFromFile(const FString& Path);
+		bool SaveToFile(const FString& Path) const;
+
+	public:
+		FString Channel;
+		FString Epoch;
+		uint64 Offset = 0;
+	};
+
+	// Tracks the last publication consumed from the server channel and replays missed publications after a restart.
+	//
+	// The checkpoint is persisted after every consumed publication. When the channel subscription is acknowledged,
+	// BeginCatchUp() produces a HISTORY request starting from the persisted position, followed by one request per page
+	// until the history has been read up to the top of the stream. Live publications received while the catch-up is in
+	// progress are buffered so that they are consumed after the missed ones. A catch-up that is left unfinished, for
+	// example because the connection closed, is ended by the next BeginCatchUp() and its buffer is returned then.
+	class FMultiplayStreamRecovery
+	{
+	public:
+		// Maximum number of publications requested per page when catching up.
+		static constexpr int32 kHistoryLimit = 100;
+
+	public:
+		// An empty CheckpointPath disables persistence, the recovery then only de-duplicates publications.
+		FMultiplayStreamRecovery(FString Channel, FString CheckpointPath);
+
+		// Returns true and populates OutRequest if publications may have been missed since the persisted position. Otherwise
+		// ends the catch-up in progress, if any, and returns the publications it had buffered in OutPublications.
+		bool BeginCatchUp(const FSubscribeResult& Result, FHistoryRequest& OutRequest, TArray<FPublication>& OutPublications);
+
+		// Returns the missed publications of the page. Returns true and populates OutRequest if the stream continues past
+		// the page, otherwise the publications buffered during the catch-up follow the missed ones.
+		bool CompleteCatchUp(const FHistoryResult& Result, TArray<FPublication>& OutPublications, FHistoryRequest& OutRequest);
+
+		// Abandons the catch-up and returns the publications buffered during the catch-up.
+		void AbortCatchUp(TArray<FPublication>& OutPublications);
+
+		// Returns true if the publication should be consumed now, false if it was buffered or already consumed.
+		bool ShouldConsume(const FPublication& Publication);
+
+		// Advances and persists the checkpoint past the consumed publication.
+		void Commit(const FPublication& Publication);
+
+		bool IsCatchingUp() const { return bIsCatchingUp; }
+		const FString& GetChannel() const { return Channel; }
+
+	private:
+		bool IsConsumed(const FPublication& Publication) const;
+
+		void MakeHistoryRequest(uint64 SinceOffset, FHistoryRequest& OutRequest) const;
+
+		// Ends the catch-up and returns the buffered publications that have not been consumed yet.
+		void EndCatchUp(TArray<FPublication>& OutPublications);
+
+	private:
+		FString Channel;
+		FString CheckpointPath;
+		FString Epoch;
+		FMultiplayStreamCheckpoint Checkpoint;
+		bool bHasCheckpoint;
+		bool bIsCatchingUp;
+
+		// The highest offset returned by the pages of the catch-up so far.
+		uint64 CatchUpOffset;
+		TArray<FPublication> BufferedPublications;
+	};
+} // namespace Multiplay
@@ -0,0 +1,223 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "MultiplayGameServerSDK/MultiplayStreamRecovery.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayStreamRecoverySpec, "MultiplayGameServerSDK.StreamRecovery", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+FString CheckpointPath;
+
+Multiplay::FPublication MakePublication(uint64 Offset)
+{
+	Multiplay::FPublication Publication;
+	Publication.Offset = Offset;
+	return Publication;
+}
+
+void SaveCheckpoint(uint64 Offset)
+{
+	Multiplay::FMultiplayStreamCheckpoint Saved;
+	Saved.Channel = TEXT("server#12345");
+	Saved.Epoch = TEXT("foo");
+	Saved.Offset = Offset;
+	Saved.SaveToFile(CheckpointPath);
+}
+END_DEFINE_SPEC(FMultiplayStreamRecoverySpec)
+
+void FMultiplayStreamRecoverySpec::Define()
+{
+	BeforeEach([this]()
+		{
+			CheckpointPath = FPaths::Combine(FPaths::AutomationTransientDir(), Multiplay::FMultiplayStreamCheckpoint::kFileName);
+			IFileManager::Get().Delete(*CheckpointPath);
+		});
+
+	AfterEach([this]()
+		{
+			IFileManager::Get().Delete(*CheckpointPath);
+		});
+
+	Describe("FMultiplayStreamCheckpoint", [this]()
+		{
+			It("should read back the position it has saved.", [this]()
+				{
+					Multiplay::FMultiplayStreamCheckpoint Saved;
+					Saved.Channel = TEXT("server#12345");
+					Saved.Epoch = TEXT("foo");
+					Saved.Offset = 42;
+
+					TestTrueExpr(Saved.SaveToFile(CheckpointPath));
+
+					Multiplay::FMultiplayStreamCheckpoint Loaded;
+					if (MP_TEST_TRUE_EXPR(Loaded.LoadFromFile(CheckpointPath)))
+					{
+						TestEqual("FMultiplayStreamCheckpoint::Channel", Loaded.Channel, Saved.Channel);
+						TestEqual("FMultiplayStreamCheckpoint::Epoch", Loaded.Epoch, Saved.Epoch);
+						TestEqual("FMultiplayStreamCheckpoint::Offset", Loaded.Offset, Saved.Offset);
+					}
+				});
+		});
+
+	Describe("FMultiplayStreamRecovery", [this]()
+		{
+			It("should not catch up without a checkpoint.", [this]()
+				{
+					Multiplay::FMultiplayStreamRecovery Recovery(TEXT("server#12345"), CheckpointPath);
+
+					Multiplay::FSubscribeResult Result;
+					Result.Epoch = FString(TEXT("foo"));
+
+					Multiplay::FHistoryRequest Request;
+					TArray<Multiplay::FPublication> Buffered;
+					TestFalseExpr(Recovery.BeginCatchUp(Result, Request, Buffered));
+					TestTrueExpr(Recovery.ShouldConsume(MakePublication(1)));
+				});
+
+			It("should request and replay only the publications missed since the checkpoint.", [this]()
+				{
+					{
+						Multiplay::FMultiplayStreamRecovery Recovery(TEXT("server#12345"), CheckpointPath);
+
+						Multiplay::FSubscribeResult Result;
+						Result.Epoch = FString(TEXT("foo"));
+
+						Multiplay::FHistoryRequest Request;
+						TArray<Multiplay::FPublication> Buffered;
+						Recovery.BeginCatchUp(Result, Request, Buffered);
+						Recovery.Commit(MakePublication(5));
+					}
+
+					// Simulate a process restart.
+					Multiplay::FMultiplayStreamRecovery Recovery(TEXT("server#12345"), CheckpointPath);
+
+					Multiplay::FSubscribeResult Result;
+					Result.Epoch = FString(TEXT("foo"));
+					Result.Offset = static_cast<uint64>(8);
+
+					Multiplay::FHistoryRequest Request;
+					TArray<Multiplay::FPublication> Buffered;
+					if (MP_TEST_TRUE_EXPR(Recovery.BeginCatchUp(Result, Request, Buffered)))
+					{
+						TestEqual("FHistoryRequest::Channel", Request.Channel, FString(TEXT("server#12345")));
+						TestEqual("FHistoryRequest::Since::Offset", Request.Since.Offset, static_cast<uint64>(5));
+						TestEqual("FHistoryRequest::Since::Epoch", Request.Since.Epoch, FString(TEXT("foo")));
+					}
+
+					// Live publications are held back until the history has been replayed.
+					TestFalseExpr(Recovery.ShouldConsume(MakePublication(8)));
+					TestFalseExpr(Recovery.ShouldConsume(MakePublication(9)));
+
+					Multiplay::FHistoryResult History;
+					History.Epoch = TEXT("foo");
+					History.Offset = 8;
+					History.Publications = { MakePublication(5), MakePublication(6), MakePublication(7), MakePublication(8) };
+
+					TArray<Multiplay::FPublication> Publications;
+					TestFalseExpr(Recovery.CompleteCatchUp(History, Publications, Request));
+
+					if (MP_TEST_TRUE_EXPR(Publications.Num() == 4))
+					{
+						TestEqual("FPublication::Offset", Publications[0].Offset, static_cast<uint64>(6));
+						TestEqual("FPublication::Offset", Publications[1].Offset, static_cast<uint64>(7));
+						TestEqual("FPublication::Offset", Publications[2].Offset, static_cast<uint64>(8));
+						TestEqual("FPublication::Offset", Publications[3].Offset, static_cast<uint64>(9));
+					}
+
+					TestFalseExpr(Recovery.IsCatchingUp());
+				});
+
+			It("should not catch up when the stream epoch has changed.", [this]()
+				{
+					Multiplay::FMultiplayStreamCheckpoint Saved;
+					Saved.Channel = TEXT("server#12345");
+					Saved.Epoch = TEXT("foo");
+					Saved.Offset = 5;
+					Saved.SaveToFile(CheckpointPath);
+
+					Multiplay::FMultiplayStreamRecovery Recovery(TEXT("server#12345"), CheckpointPath);
+
+					Multiplay::FSubscribeResult Result;
+					Result.Epoch = FString(TEXT("bar"));
+
+					Multiplay::FHistoryRequest Request;
+					TArray<Multiplay::FPublication> Buffered;
+					TestFalseExpr(Recovery.BeginCatchUp(Result, Request, Buffered));
+					TestTrueExpr(Recovery.ShouldConsume(MakePublication(1)));
+				});
+
+			It("should page the history until it reaches the top of the stream.", [this]()
+				{
+					SaveCheckpoint(5);
+
+					Multiplay::FMultiplayStreamRecovery Recovery(TEXT("server#12345"), CheckpointPath);
+
+					Multiplay::FSubscribeResult Result;
+					Result.Epoch = FString(TEXT("foo"));
+					Result.Offset = static_cast<uint64>(9);
+
+					Multiplay::FHistoryRequest Request;
+					TArray<Multiplay::FPublication> Buffered;
+					TestTrueExpr(Recovery.BeginCatchUp(Result, Request, Buffered));
+					TestFalseExpr(Recovery.ShouldConsume(MakePublication(10)));
+
+					Multiplay::FHistoryResult FirstPage;
+					FirstPage.Epoch = TEXT("foo");
+					FirstPage.Offset = 10;
+					FirstPage.Publications = { MakePublication(6), MakePublication(7) };
+
+					TArray<Multiplay::FPublication> Publications;
+					if (!MP_TEST_TRUE_EXPR(Recovery.CompleteCatchUp(FirstPage, Publications, Request)))
+					{
+						return;
+					}
+					TestEqual("FHistoryRequest::Since::Offset", Request.Since.Offset, static_cast<uint64>(7));
+					TestEqual("Publications", Publications.Num(), 2);
+					TestTrueExpr(Recovery.IsCatchingUp());
+
+					Multiplay::FHistoryResult LastPage;
+					LastPage.Epoch = TEXT("foo");
+					LastPage.Offset = 10;
+					LastPage.Publications = { MakePublication(8), MakePublication(9), MakePublication(10) };
+
+					Publications.Reset();
+					TestFalseExpr(Recovery.CompleteCatchUp(LastPage, Publications, Request));
+					if (MP_TEST_TRUE_EXPR(Publications.Num() == 3))
+					{
+						TestEqual("FPublication::Offset", Publications[2].Offset, static_cast<uint64>(10));
+					}
+					TestFalseExpr(Recovery.IsCatchingUp());
+				});
+
+			It("should consume the publications buffered by a catch-up the connection closed on once resubscribed at an unchanged offset.", [this]()
+				{
+					SaveCheckpoint(5);
+
+					Multiplay::FMultiplayStreamRecovery Recovery(TEXT("server#12345"), CheckpointPath);
+
+					Multiplay::FSubscribeResult Result;
+					Result.Epoch = FString(TEXT("foo"));
+					Result.Offset = static_cast<uint64>(8);
+
+					Multiplay::FHistoryRequest Request;
+					TArray<Multiplay::FPublication> Buffered;
+					TestTrueExpr(Recovery.BeginCatchUp(Result, Request, Buffered));
+					TestFalseExpr(Recovery.ShouldConsume(MakePublication(6)));
+
+					// The connection closes before the history reply arrives, and the stream has not advanced past the checkpoint since.
+					Result.Offset = static_cast<uint64>(5);
+
+					TestFalseExpr(Recovery.BeginCatchUp(Result, Request, Buffered));
+					TestFalseExpr(Recovery.IsCatchingUp());
+					if (MP_TEST_TRUE_EXPR(Buffered.Num() == 1))
+					{
+						TestEqual("FPublication::Offset", Buffered[0].Offset, static_cast<uint64>(6));
+					}
+
+					TestTrueExpr(Recovery.ShouldConsume(MakePublication(7)));
+				});
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,550 @@
+#include "MultiplayUnixSocketChannel.h"
+#include "Utils/MultiplayStreamSocket.h"
+#include "OpenAPIGameServerApiOperations.h"
+#include "OpenAPIPayloadApiOperations.h"
+#include "MultiplayPayloadCompression.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "MultiplayGameServerSDKLog.h"
+
+namespace Multiplay
+{
+	namespace
+	{
+		// Bounds how long the I/O thread waits for the sockets in flight, which is also how long a request queued
+		// meanwhile may wait to be started and how often the timeouts are checked.
+		const FTimespan kWaitTime = FTimespan::FromMilliseconds(5);
+
+		// Bounds how long the idle I/O thread waits to be woken, which is also how long it takes to notice a stop request.
+		constexpr uint32 kIdleWaitMilliseconds = 100;
+
+		// The transport re-issues a call over TCP once its RPC timeout passes, this only bounds how long a connection is kept.
+		constexpr double kExchangeTimeoutSeconds = 30.0;
+
+		// Responses are read straight into their buffer, growing it by at least this much at a time.
+		constexpr int32 kReadSize = 16 * 1024;
+
+		int32 FindSequence(const uint8* Data, int32 Length, int32 Offset, const char* Sequence, int32 SequenceLength)
+		{
+			for (int32 Index = Offset; Index + SequenceLength <= Length; ++Index)
+			{
+				if (FMemory::Memcmp(Data + Index, Sequence, SequenceLength) == 0)
+				{
+					return Index;
+				}
+			}
+
+			return INDEX_NONE;
+		}
+
+		FString Utf8ToString(const uint8* Data, int32 Length)
+		{
+			FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Length);
+			return FString(Converted.Length(), Converted.Get());
+		}
+
+		// Parses the size line of a chunk, ignoring chunk extensions. Returns false if the line does not start with a hexadecimal size.
+		bool ParseChunkSize(const uint8* Data, int32 Length, int64& OutSize)
+		{
+			OutSize = 0;
+
+			int32 Index = 0;
+			for (; Index < Length && FChar::IsHexDigit(static_cast<TCHAR>(Data[Index])); ++Index)
+			{
+				OutSize = (OutSize << 4) | FParse::HexDigit(static_cast<TCHAR>(Data[Index]));
+				if (OutSize > FMultiplayUnixSocketChannel::kMaxResponseSize)
+				{
+					return false;
+				}
+			}
+
+			return Index > 0;
+		}
+
+		bool SendRequest(IMultiplayStreamSocket& Socket, const FString& Request, FString& OutError)
+		{
+			FTCHARToUTF8 Converted(*Request);
+			const uint8* RequestData = reinterpret_cast<const uint8*>(Converted.Get());
+
+			int32 TotalSent = 0;
+			while (TotalSent < Converted.Length())
+			{
+				int32 BytesSent = 0;
+				if (!Socket.Send(RequestData + TotalSent, Converted.Length() - TotalSent, BytesSent))
+				{
+					OutError = TEXT("Failed to send the request.");
+					return false;
+				}
+
+				TotalSent += BytesSent;
+			}
+
+			return true;
+		}
+
+		enum class EReceiveStatus
+		{
+			Pending,
+			Answered,
+			Failed,
+		};
+
+		// Reads what the socket has available and parses the response received so far.
+		EReceiveStatus ReceiveResponse(IMultiplayStreamSocket& Socket, TArray<uint8>& Response, int32& OutCode, FMultiplayRpcBody& OutBody, FString& OutError)
+		{
+			const int32 Offset = Response.Num();
+			Response.AddUninitialized(kReadSize);
+
+			int32 BytesRead = 0;
+			const bool bConnectionClosed = !Socket.Recv(Response.GetData() + Offset, kReadSize, BytesRead);
+			Response.SetNum(Offset + BytesRead, false);
+
+			if (FMultiplayUnixSocketChannel::ParseHttpResponse(Response, bConnectionClosed, OutCode, OutBody))
+			{
+				return EReceiveStatus::Answered;
+			}
+
+			if (bConnectionClosed)
+			{
+				OutError = TEXT("The connection was closed before a complete response was received.");
+				return EReceiveStatus::Failed;
+			}
+
+			if (Response.Num() > FMultiplayUnixSocketChannel::kMaxResponseSize)
+			{
+				OutError = TEXT("The response is too large.");
+				return EReceiveStatus::Failed;
+			}
+
+			return EReceiveStatus::Pending;
+		}
+	} // namespace
+
+	FMultiplayUnixSocketChannel::FMultiplayUnixSocketChannel(const FString& InSocketPath, const FString& InHost, bool bInAcceptCompressedPayload)
+		: SocketPath(InSocketPath)
+		, Host(InHost)
+		, bAcceptCompressedPayload(bInAcceptCompressedPayload)
+		, NextCallId(1)
+		, Lifetime(MakeShared<bool, ESPMode::ThreadSafe>(true))
+		, WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+		, Thread(nullptr)
+		, bStopping(false)
+	{
+	}
+
+	FMultiplayUnixSocketChannel::~FMultiplayUnixSocketChannel()
+	{
+		if (Thread != nullptr)
+		{
+			// Stops the I/O thread and waits for it to exit, the exchanges still in flight are abandoned.
+			Thread->Kill(true);
+			delete Thread;
+			Thread = nullptr;
+		}
+
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+
+	bool FMultiplayUnixSocketChannel::IsAvailable() const
+	{
+		return IsUnixSocketSupported();
+	}
+
+	void FMultiplayUnixSocketChannel::Call(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcCompleteDelegate& OnComplete)
+	{
+		FString Request;
+		if (!MakeHttpRequest(Method, Data, Host, Request, bAcceptCompressedPayload))
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Cannot send '%s' over the SDK daemon socket."), *Method);
+			OnComplete.ExecuteIfBound(EMultiplayRpcStatus::Failed, TSharedPtr<FJsonValue>(), FMultiplayRpcBodyPtr());
+			return;
+		}
+
+		// The delegate stays on the game thread, the I/O thread only carries the call id back.
+		const uint32 CallId = NextCallId++;
+		PendingCalls.Add(CallId, OnComplete);
+
+		FQueuedRequest Queued;
+		Queued.CallId = CallId;
+		Queued.Request = MoveTemp(Request);
+		QueuedRequests.Enqueue(MoveTemp(Queued));
+
+		if (Thread == nullptr)
+		{
+			Thread = FRunnableThread::Create(this, TEXT("MultiplayUnixSocketChannel"), 0, TPri_AboveNormal);
+		}
+
+		WakeEvent->Trigger();
+	}
+
+	uint32 FMultiplayUnixSocketChannel::Run()
+	{
+		TArray<FActiveExchange> Exchanges;
+		TArray<IMultiplayStreamSocket*, TInlineAllocator<8>> Sockets;
+
+		while (!bStopping)
+		{
+			FQueuedRequest Queued;
+			while (QueuedRequests.Dequeue(Queued))
+			{
+				StartExchange(Queued, Exchanges);
+			}
+
+			if (Exchanges.Num() == 0)
+			{
+				WakeEvent->Wait(kIdleWaitMilliseconds);
+				continue;
+			}
+
+			Sockets.Reset();
+			for (const FActiveExchange& Exchange : Exchanges)
+			{
+				Sockets.Add(Exchange.Socket.Get());
+			}
+
+			const bool bAnyReadable = WaitForReadAny(Sockets, kWaitTime);
+			const double Now = FPlatformTime::Seconds();
+
+			for (int32 Index = Exchanges.Num() - 1; Index >= 0; --Index)
+			{
+				FActiveExchange& Exchange = Exchanges[Index];
+
+				int32 Code = 0;
+				FMultiplayRpcBody Body;
+				FString Error;
+
+				EReceiveStatus Status = EReceiveStatus::Pending;
+				if (bAnyReadable && Exchange.Socket->WaitForRead(FTimespan::Zero()))
+				{
+					Status = ReceiveResponse(*Exchange.Socket, Exchange.Response, Code, Body, Error);
+				}
+				else if (Now > Exchange.Deadline)
+				{
+					Error = TEXT("Timed out waiting for the response.");
+					Status = EReceiveStatus::Failed;
+				}
+
+				if (Status == EReceiveStatus::Pending)
+				{
+					continue;
+				}
+
+				if (Status == EReceiveStatus::Answered)
+				{
+					CompleteExchange(Exchange.CallId, true, Code, MakeShared<FMultiplayRpcBody, ESPMode::ThreadSafe>(MoveTemp(Body)));
+				}
+				else
+				{
+					UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to exchange a request with the SDK daemon over '%s': %s"), *SocketPath, *Error);
+					CompleteExchange(Exchange.CallId, false, 0, nullptr);
+				}
+
+				Exchanges.RemoveAtSwap(Index);
+			}
+		}
+
+		return 0;
+	}
+
+	void FMultiplayUnixSocketChannel::Stop()
+	{
+		bStopping = true;
+		WakeEvent->Trigger();
+	}
+
+	void FMultiplayUnixSocketChannel::StartExchange(const FQueuedRequest& Queued, TArray<FActiveExchange>& OutExchanges)
+	{
+		// Connecting to a local socket and writing a request that fits its buffer do not block in practice.
+		FString Error;
+		TUniquePtr<IMultiplayStreamSocket> Socket = ConnectUnixSocket(SocketPath, Error);
+		if (!Socket.IsValid() || !SendRequest(*Socket, Queued.Request, Error))
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Warning, TEXT("Failed to exchange a request with the SDK daemon over '%s': %s"), *SocketPath, *Error);
+			CompleteExchange(Queued.CallId, false, 0, nullptr);
+			return;
+		}
+
+		FActiveExchange Exchange;
+		Exchange.CallId = Queued.CallId;
+		Exchange.Socket = MoveTemp(Socket);
+		Exchange.Deadline = FPlatformTime::Seconds() + kExchangeTimeoutSeconds;
+		OutExchanges.Add(MoveTemp(Exchange));
+	}
+
+	void FMultiplayUnixSocketChannel::CompleteExchange(uint32 CallId, bool bAnswered, int32 Code, FMultiplayRpcBodyPtr Body)
+	{
+		TWeakPtr<bool, ESPMode::ThreadSafe> WeakLifetime = Lifetime;
+		AsyncTask(ENamedThreads::GameThread, [this, WeakLifetime, CallId, bAnswered, Code, Body = MoveTemp(Body)]()
+			{
+				if (WeakLifetime.IsValid())
+				{
+					OnExchangeComplete(CallId, bAnswered, Code, Body);
+				}
+			});
+	}
+
+	void FMultiplayUnixSocketChannel::OnExchangeComplete(uint32 CallId, bool bAnswered, int32 Code, const FMultiplayRpcBodyPtr& Body)
+	{
+		FMultiplayRpcCompleteDelegate OnComplete;
+		if (!PendingCalls.RemoveAndCopyValue(CallId, OnComplete))
+		{
+			return;
+		}
+
+		if (!bAnswered)
+		{
+			OnComplete.ExecuteIfBound(EMultiplayRpcStatus::Failed, TSharedPtr<FJsonValue>(), FMultiplayRpcBodyPtr());
+			return;
+		}
+
+		TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetNumberField(TEXT("code"), Code);
+
+		OnComplete.ExecuteIfBound(EMultiplayRpcStatus::Succeeded, MakeShared<FJsonValueObject>(Result), Body);
+	}
+
+	bool FMultiplayUnixSocketChannel::MakeHttpRequest(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FString& Host, FString& OutRequest, bool bAcceptCompressedPayload)
+	{
+		const TSharedPtr<FJsonObject>* Params = nullptr;
+		if (!Data.IsValid() || !Data->TryGetObject(Params))
+		{
+			return false;
+		}
+
+		FString ServerId;
+		FString AllocationId;
+		(*Params)->TryGetStringField(TEXT("serverId"), ServerId);
+		(*Params)->TryGetStringField(TEXT("allocationId"), AllocationId);
+
+		// The paths are computed by the OpenAPI requests so that they cannot drift from those sent over TCP.
+		FString Verb;
+		FString Path;
+		FString Headers;
+
+		if (Method == FMultiplayRpcTransport::kReadyServerMethod)
+		{
+			ReadyServerRequest Request;
+			if (!LexTryParseString(Request.ServerId, *ServerId) || !FGuid::Parse(AllocationId, Request.AllocationId))
+			{
+				return false;
+			}
+
+			Verb = TEXT("POST");
+			Path = Request.ComputePath();
+		}
+		else if (Method == FMultiplayRpcTransport::kUnreadyServerMethod)
+		{
+			UnreadyServerRequest Request;
+			if (!LexTryParseString(Request.ServerId, *ServerId))
+			{
+				return false;
+			}
+
+			Verb = TEXT("POST");
+			Path = Request.ComputePath();
+		}
+		else if (Method == FMultiplayRpcTransport::kPayloadAllocationMethod)
+		{
+			PayloadAllocationRequest Request;
+			if (!FGuid::Parse(AllocationId, Request.AllocationId))
+			{
+				return false;
+			}
+
+			Verb = TEXT("GET");
+			Path = Request.ComputePath();
+
+			if (bAcceptCompressedPayload)
+			{
+				Headers = FString::Printf(TEXT("Accept-Encoding: %s\r\n"), FMultiplayPayloadCompression::kAcceptEncoding);
+			}
+		}
+		else if (Method == FMultiplayRpcTransport::kPayloadTokenMethod)
+		{
+			Verb = TEXT("GET");
+			Path = PayloadTokenRequest().ComputePath();
+		}
+		else
+		{
+			return false;
+		}
+
+		// Each request has a connection of its own, so the daemon closing it marks the end of a response without a length.
+		if (Verb == TEXT("POST"))
+		{
+			Headers += TEXT("Content-Length: 0\r\n");
+		}
+
+		OutRequest = FString::Printf(TEXT("%s %s HTTP/1.1\r\nHost: %s\r\nAccept: application/json\r\nConnection: close\r\n%s\r\n"), *Verb, *Path, *Host, *Headers);
+
+		return true;
+	}
+
+	bool FMultiplayUnixSocketChannel::ParseHttpResponse(TArray<uint8>& Data, bool bConnectionClosed, int32& OutCode, FMultiplayRpcBody& OutBody)
+	{
+		const uint8* Bytes = Data.GetData();
+		const int32 Length = Data.Num();
+
+		const int32 HeaderEnd = FindSequence(Bytes, Length, 0, "\r\n\r\n", 4);
+		if (HeaderEnd == INDEX_NONE)
+		{
+			return false;
+		}
+
+		TArray<FString> Lines;
+		Utf8ToString(Bytes, HeaderEnd).ParseIntoArray(Lines, TEXT("\r\n"));
+
+		TArray<FString> StatusLine;
+		if (Lines.Num() == 0 || Lines[0].ParseIntoArrayWS(StatusLine) < 2 || !StatusLine[0].StartsWith(TEXT("HTTP/")) || !StatusLine[1].IsNumeric())
+		{
+			return false;
+		}
+
+		int64 ContentLength = INDEX_NONE;
+		bool bChunked = false;
+		FString ContentType;
+		FString ContentEncoding;
+		for (int32 Index = 1; Index < Lines.Num(); ++Index)
+		{
+			FString Name;
+			FString Value;
+			if (!Lines[Index].Split(TEXT(":"), &Name, &Value))
+			{
+				continue;
+			}
+
+			Name.TrimStartAndEndInline();
+			Value.TrimStartAndEndInline();
+
+			if (Name.Equals(TEXT("Content-Length"), ESearchCase::IgnoreCase))
+			{
+				if (!Value.IsNumeric() || !LexTryParseString(ContentLength, *Value) || ContentLength < 0 || ContentLength > kMaxResponseSize)
+				{
+					return false;
+				}
+			}
+			else if (Name.Equals(TEXT("Transfer-Encoding"), ESearchCase::IgnoreCase))
+			{
+				bChunked = Value.Contains(TEXT("chunked"));
+			}
+			else if (Name.Equals(TEXT("Content-Type"), ESearchCase::IgnoreCase))
+			{
+				ContentType = MoveTemp(Value);
+			}
+			else if (Name.Equals(TEXT("Content-Encoding"), ESearchCase::IgnoreCase))
+			{
+				ContentEncoding = MoveTemp(Value);
+			}
+		}
+
+		const int32 BodyStart = HeaderEnd + 4;
+
+		if (bChunked)
+		{
+			// The chunks are located before any is copied, as this is called again each time more of the response arrives.
+			TArray<TPair<int32, int32>, TInlineAllocator<16>> Chunks;
+			int64 BodyLength = 0;
+			int32 Offset = BodyStart;
+
+			while (true)
+			{
+				const int32 LineEnd = FindSequence(Bytes, Length, Offset, "\r\n", 2);
+				if (LineEnd == INDEX_NONE)
+				{
+					return false;
+				}
+
+				int64 ChunkSize;
+				if (!ParseChunkSize(Bytes + Offset, LineEnd - Offset, ChunkSize))
+				{
+					return false;
+				}
+
+				Offset = LineEnd + 2;
+
+				// Trailers after the last chunk are not needed, the response is complete once the last chunk has been seen.
+				if (ChunkSize == 0)
+				{
+					break;
+				}
+
+				BodyLength += ChunkSize;
+				if (Length - Offset < ChunkSize + 2 || BodyLength > kMaxResponseSize)
+				{
+					return false;
+				}
+
+				Chunks.Emplace(Offset, static_cast<int32>(ChunkSize));
+				Offset += static_cast<int32>(ChunkSize) + 2;
+			}
+
+			OutBody.Bytes.Reset(static_cast<int32>(BodyLength));
+			for (const TPair<int32, int32>& Chunk : Chunks)
+			{
+				OutBody.Bytes.Append(Bytes + Chunk.Key, Chunk.Value);
+			}
+		}
+		else
+		{
+			if (ContentLength == INDEX_NONE)
+			{
+				if (!bConnectionClosed)
+				{
+					return false;
+				}
+
+				ContentLength = Length - BodyStart;
+			}
+			else if (Length - BodyStart < ContentLength)
+			{
+				return false;
+			}
+
+			// The header is removed in place, so that the body keeps the allocation it was received into.
+			Data.RemoveAt(0, BodyStart, false);
+			Data.SetNum(static_cast<int32>(ContentLength), false);
+			OutBody.Bytes = MoveTemp(Data);
+		}
+
+		OutCode = FCString::Atoi(*StatusLine[1]);
+		OutBody.ContentType = MoveTemp(ContentType);
+		OutBody.ContentEncoding = MoveTemp(ContentEncoding);
+		return true;
+	}
+
+	bool FMultiplayUnixSocketChannel::Exchange(const FString& SocketPath, const FString& Request, double TimeoutSeconds, int32& OutCode, FMultiplayRpcBody& OutBody, FString& OutError)
+	{
+		TUniquePtr<IMultiplayStreamSocket> Socket = ConnectUnixSocket(SocketPath, OutError);
+		if (!Socket.IsValid() || !SendRequest(*Socket, Request, OutError))
+		{
+			return false;
+		}
+
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+
+		TArray<uint8> Response;
+		while (true)
+		{
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				OutError = TEXT("Timed out waiting for the response.");
+				return false;
+			}
+
+			if (!Socket->WaitForRead(kWaitTime))
+			{
+				continue;
+			}
+
+			const EReceiveStatus Status = ReceiveResponse(*Socket, Response, OutCode, OutBody, OutError);
+			if (Status != EReceiveStatus::Pending)
+			{
+				return Status == EReceiveStatus::Answered;
+			}
+		}
+	}
+} // namespace Multiplay
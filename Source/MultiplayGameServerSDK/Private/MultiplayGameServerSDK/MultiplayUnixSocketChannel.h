@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "MultiplayRpcTransport.h"
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+
+namespace Multiplay
+{
+	class IMultiplayStreamSocket;
+
+	// Carries the game server and payload operations to the SDK daemon as HTTP requests over a Unix domain socket.
+	//
+	// The engine HTTP module can only connect over TCP, so each operation is written as an HTTP/1.1 request on its own
+	// connection. The connections are serviced by a dedicated I/O thread, started with the first call, which polls every
+	// socket in flight at once rather than holding a task graph worker per request. The response is handed to the
+	// transport on the game thread as an RPC result of the form {"code": <http status>}, with the body as received, so
+	// that a payload is inflated and kept without being converted to a string. A request that cannot be exchanged fails
+	// the call so that the transport re-issues it over TCP.
+	class FMultiplayUnixSocketChannel : public IMultiplayRpcChannel, private FRunnable
+	{
+	public:
+		// Responses above this size are rejected.
+		static constexpr int32 kMaxResponseSize = 64 * 1024 * 1024;
+
+	public:
+		// With bAcceptCompressedPayload, payloads are requested with the encodings FMultiplayPayloadCompression can inflate.
+		FMultiplayUnixSocketChannel(const FString& SocketPath, const FString& Host, bool bAcceptCompressedPayload = false);
+		virtual ~FMultiplayUnixSocketChannel();
+
+		virtual bool IsAvailable() const override;
+		virtual void Call(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FMultiplayRpcCompleteDelegate& OnComplete) override;
+
+		// Builds the HTTP request of a transport operation from its RPC data, returns false for an unknown method or malformed data.
+		static bool MakeHttpRequest(const FString& Method, const TSharedPtr<FJsonValue>& Data, const FString& Host, FString& OutRequest, bool bAcceptCompressedPayload = false);
+
+		// Parses an HTTP/1.1 response whose body is delimited by Content-Length, chunked encoding or the end of the connection.
+		// Returns false until the response is complete, which for a response without a length is once bConnectionClosed is set.
+		// Once it is complete, the body is moved out of Data rather than copied when it was not chunked.
+		static bool ParseHttpResponse(TArray<uint8>& Data, bool bConnectionClosed, int32& OutCode, FMultiplayRpcBody& OutBody);
+
+		// Sends Request over a new connection to the socket and blocks until the response is complete or TimeoutSeconds pass.
+		static bool Exchange(const FString& SocketPath, const FString& Request, double TimeoutSeconds, int32& OutCode, FMultiplayRpcBody& OutBody, FString& OutError);
+
+	private:
+		struct FQueuedRequest
+		{
+			uint32 CallId;
+			FString Request;
+		};
+
+		// Owned by the I/O thread.
+		struct FActiveExchange
+		{
+			uint32 CallId;
+			TUniquePtr<IMultiplayStreamSocket> Socket;
+			TArray<uint8> Response;
+			double Deadline;
+		};
+
+		// FRunnable
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+
+		void StartExchange(const FQueuedRequest& Queued, TArray<FActiveExchange>& OutExchanges);
+		void CompleteExchange(uint32 CallId, bool bAnswered, int32 Code, FMultiplayRpcBodyPtr Body);
+		void OnExchangeComplete(uint32 CallId, bool bAnswered, int32 Code, const FMultiplayRpcBodyPtr& Body);
+
+	private:
+		FString SocketPath;
+		FString Host;
+		bool bAcceptCompressedPayload;
+		uint32 NextCallId;
+		TMap<uint32, FMultiplayRpcCompleteDelegate> PendingCalls;
+
+		// Lets exchanges completing on the game thread find out whether the channel still exists, without sharing ownership of it.
+		TSharedRef<bool, ESPMode::ThreadSafe> Lifetime;
+
+		// Requests are queued by the game thread and started by the I/O thread, which the event wakes while it is idle.
+		TQueue<FQueuedRequest, EQueueMode::Spsc> QueuedRequests;
+		FEvent* WakeEvent;
+		FRunnableThread* Thread;
+		std::atomic<bool> bStopping;
+	};
+} // namespace Multiplay
@@ -0,0 +1,279 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayUnixSocketChannel.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Multiplay
+{
+	// Stands in for the SDK daemon, answering a single connection on a Unix domain socket with a canned response.
+	class FUnixSocketChannelSpecDaemon
+	{
+	public:
+		FUnixSocketChannelSpecDaemon(const FString& InPath, const FString& InResponse) : Path(InPath), Response(InResponse), Descriptor(-1)
+		{
+			unlink(TCHAR_TO_UTF8(*Path));
+
+			sockaddr_un Address;
+			FMemory::Memzero(Address);
+			Address.sun_family = AF_UNIX;
+			FCStringAnsi::Strncpy(Address.sun_path, TCHAR_TO_UTF8(*Path), sizeof(Address.sun_path));
+
+			Descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (Descriptor >= 0 && (bind(Descriptor, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0 || listen(Descriptor, 1) != 0))
+			{
+				close(Descriptor);
+				Descriptor = -1;
+			}
+		}
+
+		~FUnixSocketChannelSpecDaemon()
+		{
+			if (Served.IsValid())
+			{
+				Served.Wait();
+			}
+
+			if (Descriptor >= 0)
+			{
+				close(Descriptor);
+			}
+
+			unlink(TCHAR_TO_UTF8(*Path));
+		}
+
+		bool IsListening() const { return Descriptor >= 0; }
+
+		// Accepts one connection on a background thread, records the request and answers it.
+		void Serve()
+		{
+			Served = ServedPromise.GetFuture();
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this]()
+				{
+					Answer();
+					ServedPromise.SetValue();
+				});
+		}
+
+		FString Request;
+
+	private:
+		void Answer()
+		{
+			pollfd Poll = { Descriptor, POLLIN, 0 };
+			if (poll(&Poll, 1, 5000) <= 0)
+			{
+				return;
+			}
+
+			const int Connection = accept(Descriptor, nullptr, nullptr);
+			if (Connection < 0)
+			{
+				return;
+			}
+
+			TArray<ANSICHAR> Buffer;
+			Buffer.SetNumZeroed(4096);
+			int32 Length = 0;
+			while (Length < Buffer.Num() - 1 && FCStringAnsi::Strstr(Buffer.GetData(), "\r\n\r\n") == nullptr)
+			{
+				const ssize_t Read = recv(Connection, Buffer.GetData() + Length, Buffer.Num() - 1 - Length, 0);
+				if (Read <= 0)
+				{
+					break;
+				}
+
+				Length += static_cast<int32>(Read);
+			}
+
+			Request = UTF8_TO_TCHAR(Buffer.GetData());
+
+			FTCHARToUTF8 Converted(*Response);
+			send(Connection, Converted.Get(), Converted.Length(), 0);
+			close(Connection);
+		}
+
+	private:
+		FString Path;
+		FString Response;
+		int Descriptor;
+		TPromise<void> ServedPromise;
+		TFuture<void> Served;
+	};
+} // namespace Multiplay
+#endif
+
+BEGIN_DEFINE_SPEC(FMultiplayUnixSocketChannelSpec, "MultiplayGameServerSDK.UnixSocketChannel", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+const FString AllocationId = TEXT("0c5e3b5e-8d39-4d8e-9b2a-3d0f1f5e6a7b");
+TArray<uint8> ToBytes(const FString& Text) const;
+TSharedPtr<FJsonValue> MakeParams(const FString& ServerId, const FString& InAllocationId) const;
+END_DEFINE_SPEC(FMultiplayUnixSocketChannelSpec)
+
+TArray<uint8> FMultiplayUnixSocketChannelSpec::ToBytes(const FString& Text) const
+{
+	FTCHARToUTF8 Converted(*Text);
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+}
+
+TSharedPtr<FJsonValue> FMultiplayUnixSocketChannelSpec::MakeParams(const FString& ServerId, const FString& InAllocationId) const
+{
+	TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+	Params->SetStringField(TEXT("serverId"), ServerId);
+	Params->SetStringField(TEXT("allocationId"), InAllocationId);
+	return MakeShared<FJsonValueObject>(Params);
+}
+
+void FMultiplayUnixSocketChannelSpec::Define()
+{
+	Describe("MakeHttpRequest", [this]()
+		{
+			It("should send ready as a POST to the path of the OpenAPI request.", [this]()
+				{
+					FString Request;
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::MakeHttpRequest(Multiplay::FMultiplayRpcTransport::kReadyServerMethod, MakeParams(TEXT("1234"), AllocationId), TEXT("localhost:8086"), Request));
+
+					TestTrueExpr(Request.StartsWith(FString::Printf(TEXT("POST /v1/server/1234/allocation/%s/ready-for-players HTTP/1.1\r\n"), *AllocationId), ESearchCase::IgnoreCase));
+					TestTrueExpr(Request.Contains(TEXT("\r\nHost: localhost:8086\r\n")));
+					TestTrueExpr(Request.Contains(TEXT("\r\nContent-Length: 0\r\n")));
+					TestTrueExpr(Request.EndsWith(TEXT("\r\n\r\n")));
+				});
+
+			It("should send the payload token as a GET.", [this]()
+				{
+					FString Request;
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::MakeHttpRequest(Multiplay::FMultiplayRpcTransport::kPayloadTokenMethod, MakeShared<FJsonValueObject>(MakeShared<FJsonObject>()), TEXT("localhost:8086"), Request));
+
+					TestTrueExpr(Request.StartsWith(TEXT("GET /token HTTP/1.1\r\n")));
+				});
+
+			It("should only request a compressed payload when asked to.", [this]()
+				{
+					FString Request;
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::MakeHttpRequest(Multiplay::FMultiplayRpcTransport::kPayloadAllocationMethod, MakeParams(TEXT("1234"), AllocationId), TEXT("localhost"), Request));
+					TestFalseExpr(Request.Contains(TEXT("Accept-Encoding")));
+
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::MakeHttpRequest(Multiplay::FMultiplayRpcTransport::kPayloadAllocationMethod, MakeParams(TEXT("1234"), AllocationId), TEXT("localhost"), Request, true));
+					TestTrueExpr(Request.Contains(TEXT("\r\nAccept-Encoding: gzip\r\n")));
+				});
+
+			It("should reject unknown methods and malformed parameters.", [this]()
+				{
+					FString Request;
+					TestFalseExpr(Multiplay::FMultiplayUnixSocketChannel::MakeHttpRequest(TEXT("server.unknown"), MakeParams(TEXT("1234"), AllocationId), TEXT("localhost"), Request));
+					TestFalseExpr(Multiplay::FMultiplayUnixSocketChannel::MakeHttpRequest(Multiplay::FMultiplayRpcTransport::kUnreadyServerMethod, MakeParams(TEXT("not a number"), AllocationId), TEXT("localhost"), Request));
+					TestFalseExpr(Multiplay::FMultiplayUnixSocketChannel::MakeHttpRequest(Multiplay::FMultiplayRpcTransport::kPayloadAllocationMethod, MakeParams(TEXT("1234"), TEXT("not a guid")), TEXT("localhost"), Request));
+				});
+		});
+
+	Describe("ParseHttpResponse", [this]()
+		{
+			It("should wait for the whole body of a response with a Content-Length.", [this]()
+				{
+					int32 Code = 0;
+					Multiplay::FMultiplayRpcBody Body;
+					TArray<uint8> Partial = ToBytes(TEXT("HTTP/1.1 200 OK\r\nContent-Length: 11\r\n\r\n{\"a\":"));
+					TestFalseExpr(Multiplay::FMultiplayUnixSocketChannel::ParseHttpResponse(Partial, false, Code, Body));
+
+					TArray<uint8> Complete = ToBytes(TEXT("HTTP/1.1 200 OK\r\ncontent-length: 11\r\nContent-Type: application/json\r\n\r\n{\"a\":\"b\"}\r\n"));
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::ParseHttpResponse(Complete, false, Code, Body));
+
+					TestEqual(TEXT("Code"), Code, 200);
+					TestTrueExpr(Body.Bytes == ToBytes(TEXT("{\"a\":\"b\"}\r\n")));
+					TestEqual(TEXT("ContentType"), Body.ContentType, FString(TEXT("application/json")));
+				});
+
+			It("should join the chunks of a chunked response.", [this]()
+				{
+					int32 Code = 0;
+					Multiplay::FMultiplayRpcBody Body;
+					TArray<uint8> Partial = ToBytes(TEXT("HTTP/1.1 404 Not Found\r\nTransfer-Encoding: chunked\r\n\r\n4\r\n{\"a\"\r\n"));
+					TestFalseExpr(Multiplay::FMultiplayUnixSocketChannel::ParseHttpResponse(Partial, false, Code, Body));
+
+					TArray<uint8> Complete = ToBytes(TEXT("HTTP/1.1 404 Not Found\r\nTransfer-Encoding: chunked\r\n\r\n4\r\n{\"a\"\r\n5;ext=1\r\n:\"b\"}\r\n0\r\n\r\n"));
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::ParseHttpResponse(Complete, false, Code, Body));
+
+					TestEqual(TEXT("Code"), Code, 404);
+					TestTrueExpr(Body.Bytes == ToBytes(TEXT("{\"a\":\"b\"}")));
+				});
+
+			It("should read a response without a length until the connection is closed.", [this]()
+				{
+					int32 Code = 0;
+					Multiplay::FMultiplayRpcBody Body;
+					TArray<uint8> Response = ToBytes(TEXT("HTTP/1.1 204 No Content\r\n\r\nrest"));
+					TestFalseExpr(Multiplay::FMultiplayUnixSocketChannel::ParseHttpResponse(Response, false, Code, Body));
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::ParseHttpResponse(Response, true, Code, Body));
+
+					TestEqual(TEXT("Code"), Code, 204);
+					TestTrueExpr(Body.Bytes == ToBytes(TEXT("rest")));
+				});
+
+			It("should keep a compressed body as received, along with its encoding.", [this]()
+				{
+					const uint8 Compressed[] = { 0x1F, 0x8B, 0x08, 0x00, 0xFF };
+
+					TArray<uint8> Response = ToBytes(TEXT("HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\nContent-Length: 5\r\n\r\n"));
+					Response.Append(Compressed, sizeof(Compressed));
+
+					int32 Code = 0;
+					Multiplay::FMultiplayRpcBody Body;
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::ParseHttpResponse(Response, false, Code, Body));
+
+					TestEqual(TEXT("ContentEncoding"), Body.ContentEncoding, FString(TEXT("gzip")));
+					TestTrueExpr(Body.Bytes == TArray<uint8>(Compressed, sizeof(Compressed)));
+				});
+
+			It("should reject a malformed status line.", [this]()
+				{
+					int32 Code = 0;
+					Multiplay::FMultiplayRpcBody Body;
+					TArray<uint8> Response = ToBytes(TEXT("SSH-2.0-OpenSSH\r\n\r\n"));
+					TestFalseExpr(Multiplay::FMultiplayUnixSocketChannel::ParseHttpResponse(Response, true, Code, Body));
+				});
+		});
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+	Describe("Exchange", [this]()
+		{
+			It("should exchange a request with a stand-in daemon.", [this]()
+				{
+					const FString Path = FString::Printf(TEXT("/tmp/multiplay-sdk-spec-%u.sock"), FPlatformProcess::GetCurrentProcessId());
+
+					Multiplay::FUnixSocketChannelSpecDaemon Daemon(Path, TEXT("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n{\"token\":\"t\"}"));
+					MP_TEST_TRUE_EXPR(Daemon.IsListening());
+					Daemon.Serve();
+
+					FString Request;
+					Multiplay::FMultiplayUnixSocketChannel::MakeHttpRequest(Multiplay::FMultiplayRpcTransport::kPayloadTokenMethod, MakeShared<FJsonValueObject>(MakeShared<FJsonObject>()), TEXT("localhost:8086"), Request);
+
+					int32 Code = 0;
+					Multiplay::FMultiplayRpcBody Body;
+					FString Error;
+					MP_TEST_TRUE_EXPR(Multiplay::FMultiplayUnixSocketChannel::Exchange(Path, Request, 5.0, Code, Body, Error));
+
+					TestEqual(TEXT("Code"), Code, 200);
+					TestTrueExpr(Body.Bytes == ToBytes(TEXT("{\"token\":\"t\"}")));
+					TestTrueExpr(Daemon.Request.StartsWith(TEXT("GET /token HTTP/1.1\r\n")));
+				});
+
+			It("should fail when nothing listens on the socket.", [this]()
+				{
+					int32 Code = 0;
+					Multiplay::FMultiplayRpcBody Body;
+					FString Error;
+					TestFalseExpr(Multiplay::FMultiplayUnixSocketChannel::Exchange(TEXT("/tmp/multiplay-sdk-spec-missing.sock"), TEXT("GET /token HTTP/1.1\r\n\r\n"), 1.0, Code, Body, Error));
+					TestFalseExpr(Error.IsEmpty());
+				});
+		});
+#endif
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,187 @@
+#include "MultiplayWarmStandby.h"
+#include "Async/Async.h"
+
+namespace Multiplay
+{
+	FMultiplayWarmStandby::FMultiplayWarmStandby(FHotFunction InOnHot)
+		: OnHot(MoveTemp(InOnHot))
+		, WarmStartSeconds(FPlatformTime::Seconds())
+		, bHot(true)
+		, bAllocated(false)
+	{
+	}
+
+	void FMultiplayWarmStandby::AddTask(FName Name, FTaskFunction Task)
+	{
+		int32 TaskIndex = Tasks.IndexOfByPredicate([&Name](const FTask& Existing) { return Existing.Name == Name; });
+		if (TaskIndex == INDEX_NONE)
+		{
+			TaskIndex = Tasks.AddDefaulted();
+			Tasks[TaskIndex].Name = Name;
+		}
+
+		Tasks[TaskIndex].Function = MoveTemp(Task);
+
+		if (bHot)
+		{
+			bHot = false;
+			WarmStartSeconds = FPlatformTime::Seconds();
+		}
+
+		Start(TaskIndex);
+	}
+
+	void FMultiplayWarmStandby::Warm()
+	{
+		if (Tasks.Num() == 0)
+		{
+			return;
+		}
+
+		bHot = false;
+		WarmStartSeconds = FPlatformTime::Seconds();
+
+		// Every task is marked first, a task completing while it is started must not find the others complete from the last run.
+		for (FTask& Task : Tasks)
+		{
+			Task.bComplete = false;
+		}
+
+		for (int32 TaskIndex = 0; TaskIndex < Tasks.Num(); ++TaskIndex)
+		{
+			Start(TaskIndex);
+		}
+	}
+
+	EMultiplayStandbyState FMultiplayWarmStandby::GetState() const
+	{
+		if (bAllocated)
+		{
+			return EMultiplayStandbyState::Allocated;
+		}
+
+		if (Tasks.Num() == 0)
+		{
+			return EMultiplayStandbyState::Cold;
+		}
+
+		return bHot ? EMultiplayStandbyState::Hot : EMultiplayStandbyState::Warming;
+	}
+
+	void FMultiplayWarmStandby::WhenHot(FDoneFunction InOnHot)
+	{
+		if (bHot)
+		{
+			InOnHot();
+		}
+		else
+		{
+			HotWaiters.Add(MoveTemp(InOnHot));
+		}
+	}
+
+	int32 FMultiplayWarmStandby::GetPendingTaskCount() const
+	{
+		int32 Count = 0;
+		for (const FTask& Task : Tasks)
+		{
+			Count += Task.bComplete ? 0 : 1;
+		}
+
+		return Count;
+	}
+
+	void FMultiplayWarmStandby::Start(int32 TaskIndex)
+	{
+		FTask& Task = Tasks[TaskIndex];
+		Task.bComplete = false;
+
+		if (Task.bRunning)
+		{
+			Task.bRunAgain = true;
+			return;
+		}
+
+		Task.bRunning = true;
+		Task.bRunAgain = false;
+
+		TWeakPtr<FMultiplayWarmStandby> WeakThis = AsShared();
+		const FName Name = Task.Name;
+		const uint32 RunId = ++Task.RunId;
+
+		FDoneFunction Done = [WeakThis, Name, RunId]()
+		{
+			if (IsInGameThread())
+			{
+				if (TSharedPtr<FMultiplayWarmStandby> This = WeakThis.Pin())
+				{
+					This->OnTaskDone(Name, RunId);
+				}
+				return;
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Name, RunId]()
+				{
+					if (TSharedPtr<FMultiplayWarmStandby> This = WeakThis.Pin())
+					{
+						This->OnTaskDone(Name, RunId);
+					}
+				});
+		};
+
+		// Invoked from a copy, the task may complete at once and the tasks may be added to while it runs.
+		FTaskFunction Function = Task.Function;
+		Function(MoveTemp(Done));
+	}
+
+	void FMultiplayWarmStandby::OnTaskDone(FName Name, uint32 RunId)
+	{
+		const int32 TaskIndex = Tasks.IndexOfByPredicate([&Name](const FTask& Task) { return Task.Name == Name; });
+		if (TaskIndex == INDEX_NONE)
+		{
+			return;
+		}
+
+		FTask& Task = Tasks[TaskIndex];
+		if (!Task.bRunning || Task.RunId != RunId)
+		{
+			return;
+		}
+
+		Task.bRunning = false;
+
+		if (Task.bRunAgain)
+		{
+			Start(TaskIndex);
+			return;
+		}
+
+		Task.bComplete = true;
+		UpdateHot();
+	}
+
+	void FMultiplayWarmStandby::UpdateHot()
+	{
+		if (bHot || GetPendingTaskCount() > 0)
+		{
+			return;
+		}
+
+		bHot = true;
+		const double WarmSeconds = FPlatformTime::Seconds() - WarmStartSeconds;
+
+		// Moved out first, a waiter may add a task and start warming again.
+		TArray<FDoneFunction> Waiters = MoveTemp(HotWaiters);
+		HotWaiters.Reset();
+
+		if (OnHot)
+		{
+			OnHot(WarmSeconds);
+		}
+
+		for (FDoneFunction& Waiter : Waiters)
+		{
+			Waiter();
+		}
+	}
+} // namespace Multiplay
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayStandbyState.h"
+
+namespace Multiplay
+{
+	// Runs the game's preload tasks while the server waits to be allocated, so that an allocation only has to wait for
+	// the work that had not finished.
+	//
+	// A task starts as soon as it is added and is run again each time the server is deallocated, so it should keep what
+	// it loaded and complete at once when there is nothing left to do. An allocation does not interrupt the tasks, the
+	// ones still running carry on and WhenHot tells the game when they are done. A task that is still running when it is
+	// due to run again is restarted once it completes.
+	class FMultiplayWarmStandby : public TSharedFromThis<FMultiplayWarmStandby>
+	{
+	public:
+		// Must be invoked once the task has completed. May be invoked from any thread, and more than once.
+		using FDoneFunction = TFunction<void()>;
+
+		using FTaskFunction = TFunction<void(FDoneFunction /* Done */)>;
+
+		// Invoked each time every task has completed, with the time since warming started.
+		using FHotFunction = TFunction<void(double /* WarmSeconds */)>;
+
+	public:
+		explicit FMultiplayWarmStandby(FHotFunction OnHot);
+
+		// Adds a task and starts it. A task with the same name replaces the previous one, which is started again.
+		void AddTask(FName Name, FTaskFunction Task);
+
+		// Runs every task again, used once the server has been deallocated.
+		void Warm();
+
+		void SetAllocated(bool bInAllocated) { bAllocated = bInAllocated; }
+
+		EMultiplayStandbyState GetState() const;
+
+		// Whether every task has completed.
+		bool IsHot() const { return bHot; }
+
+		// Invokes the function once every task has completed, immediately if they already have.
+		void WhenHot(FDoneFunction OnHot);
+
+		int32 GetPendingTaskCount() const;
+
+	private:
+		struct FTask
+		{
+			FName Name;
+			FTaskFunction Function;
+			// Identifies the current run, so that a late or repeated completion of an earlier one is ignored.
+			uint32 RunId = 0;
+			bool bRunning = false;
+			bool bComplete = false;
+			bool bRunAgain = false;
+		};
+
+		void Start(int32 TaskIndex);
+		void OnTaskDone(FName Name, uint32 RunId);
+		void UpdateHot();
+
+	private:
+		FHotFunction OnHot;
+		TArray<FTask> Tasks;
+		TArray<FDoneFunction> HotWaiters;
+		double WarmStartSeconds;
+		bool bHot;
+		bool bAllocated;
+	};
+} // namespace Multiplay
@@ -0,0 +1,137 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "MultiplayGameServerSDK/MultiplayWarmStandby.h"
+
+#if WITH_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FMultiplayWarmStandbySpec, "MultiplayGameServerSDK.WarmStandby", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TSharedPtr<Multiplay::FMultiplayWarmStandby> Standby;
+TMap<FName, TArray<Multiplay::FMultiplayWarmStandby::FDoneFunction>> PendingRuns;
+TMap<FName, int32> Runs;
+int32 HotCount;
+void AddTask(FName Name);
+void CompleteRun(FName Name);
+END_DEFINE_SPEC(FMultiplayWarmStandbySpec)
+
+// Adds a task whose runs complete when the spec completes them.
+void FMultiplayWarmStandbySpec::AddTask(FName Name)
+{
+	Standby->AddTask(Name, [this, Name](Multiplay::FMultiplayWarmStandby::FDoneFunction Done)
+		{
+			++Runs.FindOrAdd(Name);
+			PendingRuns.FindOrAdd(Name).Add(MoveTemp(Done));
+		});
+}
+
+// Completes the oldest run of the task.
+void FMultiplayWarmStandbySpec::CompleteRun(FName Name)
+{
+	TArray<Multiplay::FMultiplayWarmStandby::FDoneFunction>& Pending = PendingRuns.FindOrAdd(Name);
+	Multiplay::FMultiplayWarmStandby::FDoneFunction Done = MoveTemp(Pending[0]);
+	Pending.RemoveAt(0);
+	Done();
+}
+
+void FMultiplayWarmStandbySpec::Define()
+{
+	BeforeEach([this]()
+		{
+			PendingRuns.Reset();
+			Runs.Reset();
+			HotCount = 0;
+			Standby = MakeShared<Multiplay::FMultiplayWarmStandby>([this](double) { ++HotCount; });
+		});
+
+	It("should be hot once every task added at startup has completed.", [this]()
+		{
+			TestTrueExpr(Standby->GetState() == EMultiplayStandbyState::Cold);
+
+			AddTask(TEXT("Map"));
+			AddTask(TEXT("Shaders"));
+			TestTrueExpr(Standby->GetState() == EMultiplayStandbyState::Warming);
+			TestEqual(TEXT("Pending"), Standby->GetPendingTaskCount(), 2);
+
+			CompleteRun(TEXT("Map"));
+			TestFalseExpr(Standby->IsHot());
+
+			CompleteRun(TEXT("Shaders"));
+			TestTrueExpr(Standby->GetState() == EMultiplayStandbyState::Hot);
+			TestEqual(TEXT("HotCount"), HotCount, 1);
+		});
+
+	It("should let an allocation wait for the tasks that had not completed rather than start them again.", [this]()
+		{
+			AddTask(TEXT("Map"));
+			AddTask(TEXT("Shaders"));
+			CompleteRun(TEXT("Map"));
+
+			Standby->SetAllocated(true);
+			TestTrueExpr(Standby->GetState() == EMultiplayStandbyState::Allocated);
+
+			bool bHot = false;
+			Standby->WhenHot([&bHot]() { bHot = true; });
+			TestFalseExpr(bHot);
+
+			CompleteRun(TEXT("Shaders"));
+			TestTrueExpr(bHot);
+			TestEqual(TEXT("Map runs"), Runs.FindRef(TEXT("Map")), 1);
+			TestEqual(TEXT("Shaders runs"), Runs.FindRef(TEXT("Shaders")), 1);
+		});
+
+	It("should run every task again once warmed after a deallocation.", [this]()
+		{
+			AddTask(TEXT("Map"));
+			CompleteRun(TEXT("Map"));
+
+			Standby->SetAllocated(true);
+			Standby->SetAllocated(false);
+			Standby->Warm();
+
+			TestTrueExpr(Standby->GetState() == EMultiplayStandbyState::Warming);
+			TestEqual(TEXT("Map runs"), Runs.FindRef(TEXT("Map")), 2);
+
+			CompleteRun(TEXT("Map"));
+			TestEqual(TEXT("HotCount"), HotCount, 2);
+		});
+
+	It("should restart a task that is still running once it completes.", [this]()
+		{
+			AddTask(TEXT("Map"));
+			Standby->Warm();
+			TestEqual(TEXT("Map runs"), Runs.FindRef(TEXT("Map")), 1);
+
+			// The first run completing does not complete the warm that started while it ran.
+			CompleteRun(TEXT("Map"));
+			TestEqual(TEXT("Map runs"), Runs.FindRef(TEXT("Map")), 2);
+			TestFalseExpr(Standby->IsHot());
+
+			CompleteRun(TEXT("Map"));
+			TestTrueExpr(Standby->IsHot());
+			TestEqual(TEXT("HotCount"), HotCount, 1);
+		});
+
+	It("should ignore a run that completes more than once.", [this]()
+		{
+			AddTask(TEXT("Map"));
+			AddTask(TEXT("Shaders"));
+
+			Multiplay::FMultiplayWarmStandby::FDoneFunction Done = PendingRuns[TEXT("Map")][0];
+			Done();
+			Done();
+
+			TestEqual(TEXT("Pending"), Standby->GetPendingTaskCount(), 1);
+			TestFalseExpr(Standby->IsHot());
+		});
+
+	It("should be hot at once when tasks complete as they are started.", [this]()
+		{
+			Standby->AddTask(TEXT("Warmup"), [](Multiplay::FMultiplayWarmStandby::FDoneFunction Done) { Done(); });
+			TestTrueExpr(Standby->IsHot());
+
+			Standby->Warm();
+			TestTrueExpr(Standby->IsHot());
+			TestEqual(TEXT("HotCount"), HotCount, 2);
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -12,6 +12,10 @@
 
 #include "OpenAPIBaseModel.h"
 
+#include "MultiplayGameServerSDKModule.h"
+#include "Serialization/BufferReader.h"
+#include "Serialization/JsonSerializer.h"
+
 namespace Multiplay
 {
 
@@ -34,6 +38,13 @@ HttpRetryParams::HttpRetryParams(const FRetryLimitCountSetting& InRetryLimitCoun
 {
 }
 
+FString Request::ComputePath() const
+{
+	FMultiplayPathBuilder Path;
+	AppendPath(Path);
+	return Path.ToString();
+}
+
 void Response::SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode)
 {
     ResponseCode = InHttpResponseCode;
@@ -44,4 +55,130 @@ void Response::SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode)
     }
 }
 
+void Response::ReceiveContent(const FHttpResponsePtr& InHttpResponse)
+{
+	// The content is decoded from the bytes the response holds, and only converted to a string when it is asked for.
+	SetHttpResponse(InHttpResponse);
+	ContentBytes.Reset();
+	ResponseContent.Reset();
+	bResponseContentSet = false;
+
+	DecodeContent(InHttpResponse->GetContentType());
+}
+
+void Response::ReceiveContent(const FString& Content, const FString& ContentType)
+{
+	SetResponseContent(Content);
+	DecodeContent(ContentType);
+}
+
+void Response::ReceiveContent(TArray<uint8>&& Content, const FString& ContentType, const FString& ContentEncoding)
+{
+	ContentBytes = MoveTemp(Content);
+	ResponseContent.Reset();
+	bResponseContentSet = false;
+
+	DecodeContent(ContentType);
+}
+
+const FString& Response::GetResponseContent() const
+{
+	if (!bResponseContentSet && GetContentBytes().Num() > 0)
+	{
+		const TArrayView<const uint8> Bytes = GetContentBytes();
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		ResponseContent = FString(Converted.Length(), Converted.Get());
+		bResponseContentSet = true;
+	}
+
+	return ResponseContent;
+}
+
+TArrayView<const uint8> Response::GetContentBytes() const
+{
+	if (ContentBytes.Num() > 0 || !HttpResponse.IsValid())
+	{
+		return ContentBytes;
+	}
+
+	return HttpResponse->GetContent();
+}
+
+bool Response::DeserializeContentBytes(TArrayView<const uint8> Bytes, TSharedPtr<FJsonValue>& OutJsonValue)
+{
+	// The engine JSON reader reads TCHARs, the conversion is only held for the duration of the read.
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+	FBufferReader Archive(const_cast<TCHAR*>(Converted.Get()), Converted.Length() * sizeof(TCHAR), false);
+
+	TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(&Archive);
+	return FJsonSerializer::Deserialize(Reader, OutJsonValue) && OutJsonValue.IsValid();
+}
+
+bool Response::IsJsonContentType(const FString& ContentType)
+{
+	FString MediaType;
+	if (!ContentType.Split(TEXT(";"), &MediaType, nullptr))
+	{
+		MediaType = ContentType;
+	}
+	MediaType.TrimStartAndEndInline();
+
+	// Structured syntax suffixes cover error bodies served as application/problem+json.
+	return MediaType.Equals(TEXT("application/json"), ESearchCase::IgnoreCase)
+		|| MediaType.Equals(TEXT("text/json"), ESearchCase::IgnoreCase)
+		|| MediaType.EndsWith(TEXT("+json"), ESearchCase::IgnoreCase);
+}
+
+void Response::DecodeContent(const FString& ContentType)
+{
+	ContentDecodeStatus = EContentDecodeStatus::None;
+
+	const TArrayView<const uint8> Bytes = bResponseContentSet ? TArrayView<const uint8>() : GetContentBytes();
+	if (bResponseContentSet ? ResponseContent.IsEmpty() : Bytes.Num() == 0)
+	{
+		return; // Nothing to parse
+	}
+
+	if (ContentType.StartsWith(TEXT("text/plain")))
+	{
+		SetResponseString(GetResponseContent());
+		return; // Successfully parsed
+	}
+
+	// Other content, such as a payload served as application/octet-stream, is kept as received.
+	if (!IsJsonContentType(ContentType) || !ShouldDecodeContent())
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonValue> JsonValue;
+	bool bParsed;
+	if (bResponseContentSet)
+	{
+		auto Reader = TJsonReaderFactory<>::Create(ResponseContent);
+		bParsed = FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid();
+	}
+	else
+	{
+		bParsed = DeserializeContentBytes(Bytes, JsonValue);
+	}
+
+	if (!bParsed)
+	{
+		ContentDecodeStatus = EContentDecodeStatus::InvalidJson;
+	}
+	else if (!(IsSuccessful() ? FromJson(JsonValue) : FromErrorJson(JsonValue)))
+	{
+		ContentDecodeStatus = EContentDecodeStatus::InvalidModel;
+	}
+	else
+	{
+		ContentDecodeStatus = EContentDecodeStatus::Decoded;
+		return; // Successfully parsed
+	}
+
+	// Report the parse error but do not mark the request as unsuccessful. Data could be partial or malformed, but the request succeeded.
+	UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to deserialize response content (type:%s):\n%s"), *ContentType, *GetResponseContent());
+}
+
 }
@@ -20,6 +20,7 @@
 #include "Containers/Ticker.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Utils/MultiplayJsonHelpers.h"
+#include "Utils/MultiplayPathBuilder.h"
 
 namespace Multiplay
 {
@@ -78,7 +79,8 @@ class MULTIPLAYGAMESERVERSDK_API Request
 public:
 	virtual ~Request() {}
 	virtual void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const = 0;
-	virtual FString ComputePath() const = 0;
+	virtual void AppendPath(FMultiplayPathBuilder& Path) const = 0;
+	FString ComputePath() const;
 
 	/* Enables retry and optionally sets a retry policy for this request */
 	void SetShouldRetry(const HttpRetryParams& Params = HttpRetryParams()) { RetryParams = Params; }
@@ -88,12 +90,39 @@ private:
 	TOptional<HttpRetryParams> RetryParams;
 };
 
+enum class EContentDecodeStatus : uint8
+{
+	/* The content was empty, not served as JSON, or not decoded for the response code */
+	None,
+	/* The content was decoded into the typed model for the response code */
+	Decoded,
+	/* The content is not valid JSON */
+	InvalidJson,
+	/* The content is valid JSON but does not match the typed model for the response code */
+	InvalidModel,
+};
+
 class MULTIPLAYGAMESERVERSDK_API Response
 {
 public:
 	virtual ~Response() {}
 	virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) = 0;
 
+	/* Reads the content of an unsuccessful response, which defaults to the same model as a successful one */
+	virtual bool FromErrorJson(const TSharedPtr<FJsonValue>& JsonValue) { return FromJson(JsonValue); }
+
+	/* Stores and decodes the body of a response. Shared by every transport, responses that keep the raw body override these */
+	virtual void ReceiveContent(const FHttpResponsePtr& InHttpResponse);
+	virtual void ReceiveContent(const FString& Content, const FString& ContentType);
+
+	/* Stores and decodes a body received as bytes. Only payloads are requested with a content encoding, the others ignore it */
+	virtual void ReceiveContent(TArray<uint8>&& Content, const FString& ContentType, const FString& ContentEncoding);
+
+	/* Decodes the response content once, into the typed model selected by the response code. Only JSON content types are parsed */
+	void DecodeContent(const FString& ContentType);
+	static bool IsJsonContentType(const FString& ContentType);
+	EContentDecodeStatus GetContentDecodeStatus() const { return ContentDecodeStatus; }
+
 	void SetSuccessful(bool InSuccessful) { Successful = InSuccessful; }
 	bool IsSuccessful() const { return Successful; }
 
@@ -103,14 +132,34 @@ public:
 	void SetResponseString(const FString& InResponseString) { ResponseString = InResponseString; }
 	const FString& GetResponseString() const { return ResponseString; }
 
+	/* The raw response body, regardless of the transport that carried it. A body received as bytes is converted on first use,
+	   so that decoding it does not keep a UTF-16 copy */
+	void SetResponseContent(const FString& InResponseContent) { ResponseContent = InResponseContent; bResponseContentSet = true; }
+	const FString& GetResponseContent() const;
+
 	void SetHttpResponse(const FHttpResponsePtr& InHttpResponse) { HttpResponse = InHttpResponse; }
 	const FHttpResponsePtr& GetHttpResponse() const { return HttpResponse; }
 
+private:
+	/* The UTF-8 body received over RPC, or else the content of the HTTP response */
+	TArrayView<const uint8> GetContentBytes() const;
+
+	/* Deserializes the UTF-8 body through a converted view rather than a stored string */
+	static bool DeserializeContentBytes(TArrayView<const uint8> Bytes, TSharedPtr<FJsonValue>& OutJsonValue);
+
 private:
 	bool Successful;
 	EHttpResponseCodes::Type ResponseCode;
 	FString ResponseString;
+	mutable FString ResponseContent;
+	mutable bool bResponseContentSet = false;
+	TArray<uint8> ContentBytes;
 	FHttpResponsePtr HttpResponse;
+	EContentDecodeStatus ContentDecodeStatus = EContentDecodeStatus::None;
+
+protected:
+	/* Whether the content is a JSON document worth decoding, payloads for instance are free-form */
+	virtual bool ShouldDecodeContent() const { return true; }
 };
 
 }
@@ -35,7 +35,16 @@ void OpenAPIGameServerApi::SetURL(const FString& InUrl)
 
 void OpenAPIGameServerApi::AddHeaderParam(const FString& Key, const FString& Value)
 {
-	AdditionalHeaderParams.Add(Key, Value);
+	for (TPair<FString, FString>& Header : AdditionalHeaderParams)
+	{
+		if (Header.Key == Key)
+		{
+			Header.Value = Value;
+			return;
+		}
+	}
+
+	AdditionalHeaderParams.Emplace(Key, Value);
 }
 
 void OpenAPIGameServerApi::ClearHeaderParams()
@@ -97,35 +106,7 @@ void OpenAPIGameServerApi::HandleResponse(FHttpResponsePtr HttpResponse, bool bS
 	if (bSucceeded && HttpResponse.IsValid())
 	{
 		InOutResponse.SetHttpResponseCode((EHttpResponseCodes::Type)HttpResponse->GetResponseCode());
-		FString ContentType = HttpResponse->GetContentType();
-		FString Content;
-
-		if (ContentType.IsEmpty())
-		{
-			return; // Nothing to parse
-		}
-		else if (ContentType.StartsWith(TEXT("application/json")) || ContentType.StartsWith("text/json"))
-		{
-			Content = HttpResponse->GetContentAsString();
-
-			TSharedPtr<FJsonValue> JsonValue;
-			auto Reader = TJsonReaderFactory<>::Create(Content);
-
-			if (FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid())
-			{
-				if (InOutResponse.FromJson(JsonValue))
-					return; // Successfully parsed
-			}
-		}
-		else if(ContentType.StartsWith(TEXT("text/plain")))
-		{
-			Content = HttpResponse->GetContentAsString();
-			InOutResponse.SetResponseString(Content);
-			return; // Successfully parsed
-		}
-
-		// Report the parse error but do not mark the request as unsuccessful. Data could be partial or malformed, but the request succeeded.
-		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to deserialize Http response content (type:%s):\n%s"), *ContentType , *Content);
+		InOutResponse.ReceiveContent(HttpResponse);
 		return;
 	}
 
@@ -139,11 +120,14 @@ FHttpRequestPtr OpenAPIGameServerApi::ReadyServer(const ReadyServerRequest& Requ
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	FMultiplayPathBuilder RequestUrl;
+	RequestUrl.Append(Url);
+	Request.AppendPath(RequestUrl);
+	HttpRequest->SetURL(RequestUrl.ToString());
 
-	for(const auto& It : AdditionalHeaderParams)
+	for (const TPair<FString, FString>& Header : AdditionalHeaderParams)
 	{
-		HttpRequest->SetHeader(It.Key, It.Value);
+		HttpRequest->SetHeader(Header.Key, Header.Value);
 	}
 
 	Request.SetupHttpRequest(HttpRequest);
@@ -166,11 +150,14 @@ FHttpRequestPtr OpenAPIGameServerApi::SubscribeServer(const SubscribeServerReque
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	FMultiplayPathBuilder RequestUrl;
+	RequestUrl.Append(Url);
+	Request.AppendPath(RequestUrl);
+	HttpRequest->SetURL(RequestUrl.ToString());
 
-	for(const auto& It : AdditionalHeaderParams)
+	for (const TPair<FString, FString>& Header : AdditionalHeaderParams)
 	{
-		HttpRequest->SetHeader(It.Key, It.Value);
+		HttpRequest->SetHeader(Header.Key, Header.Value);
 	}
 
 	Request.SetupHttpRequest(HttpRequest);
@@ -193,11 +180,14 @@ FHttpRequestPtr OpenAPIGameServerApi::UnreadyServer(const UnreadyServerRequest&
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	FMultiplayPathBuilder RequestUrl;
+	RequestUrl.Append(Url);
+	Request.AppendPath(RequestUrl);
+	HttpRequest->SetURL(RequestUrl.ToString());
 
-	for(const auto& It : AdditionalHeaderParams)
+	for (const TPair<FString, FString>& Header : AdditionalHeaderParams)
 	{
-		HttpRequest->SetHeader(It.Key, It.Value);
+		HttpRequest->SetHeader(Header.Key, Header.Value);
 	}
 
 	Request.SetupHttpRequest(HttpRequest);
@@ -62,7 +62,8 @@ private:
 	void HandleResponse(FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const;
 
 	FString Url;
-	TMap<FString,FString> AdditionalHeaderParams;
+	// Kept as a flat array, which is all each request needs to copy the headers.
+	TArray<TPair<FString, FString>> AdditionalHeaderParams;
 	mutable FHttpRetrySystem::FManager* RetryManager = nullptr;
 	mutable TUniquePtr<HttpRetryManager> DefaultRetryManager;
 };
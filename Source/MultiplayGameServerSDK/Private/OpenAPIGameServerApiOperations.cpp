@@ -23,50 +23,19 @@
 namespace Multiplay
 {
 
-FString ReadyServerRequest::ComputePath() const
+void ReadyServerRequest::AppendPath(FMultiplayPathBuilder& Path) const
 {
-	TMap<FString, FStringFormatArg> PathParams = { 
-	{ TEXT("serverId"), ToStringFormatArg(ServerId) },
-	{ TEXT("allocationId"), ToStringFormatArg(AllocationId) } };
-
-	FString Path = FString::Format(TEXT("/v1/server/{serverId}/allocation/{allocationId}/ready-for-players"), PathParams);
-
-	return Path;
+	// /v1/server/{serverId}/allocation/{allocationId}/ready-for-players
+	Path.Append(TEXT("/v1/server/")).AppendInt(ServerId).Append(TEXT("/allocation/")).AppendGuid(AllocationId).Append(TEXT("/ready-for-players"));
 }
 
 void ReadyServerRequest::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
 {
-	static const TArray<FString> Consumes = {  };
 	//static const TArray<FString> Produces = { TEXT("application/json"), TEXT("application/problem+json") };
+	static const FString Verb(TEXT("POST"));
 
-	HttpRequest->SetVerb(TEXT("POST"));
-
-	// Default to Json Body request
-	if (Consumes.Contains(TEXT("application/json")))
-	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
-		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
-	}
-	else if (Consumes.Contains(TEXT("multipart/form-data")))
-	{
-	}
-	else if (Consumes.Contains(TEXT("application/x-www-form-urlencoded")))
-	{
-	}
-	else if (Consumes.Num() == 0)
-	{
-		// Do nothing.
-	}
-	else
-	{
-		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Request ContentType not supported (%s)"), *FString::Join(Consumes, TEXT(",")));
-	}
+	// The operation has no request body.
+	HttpRequest->SetVerb(Verb);
 }
 
 void ReadyServerResponse::SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode)
@@ -91,49 +60,27 @@ bool ReadyServerResponse::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 	return TryGetJsonValue(JsonValue, Content);
 }
 
-FString SubscribeServerRequest::ComputePath() const
+bool ReadyServerResponse::FromErrorJson(const TSharedPtr<FJsonValue>& JsonValue)
+{
+	return ErrorContent.FromJson(JsonValue);
+}
+
+void SubscribeServerRequest::AppendPath(FMultiplayPathBuilder& Path) const
 {
-	FString Path(TEXT("/v1/connection/websocket"));
-	return Path;
+	Path.Append(TEXT("/v1/connection/websocket"));
 }
 
 void SubscribeServerRequest::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
 {
-	static const TArray<FString> Consumes = {  };
 	//static const TArray<FString> Produces = { TEXT("application/problem+json") };
+	static const FString Verb(TEXT("GET"));
 
-	HttpRequest->SetVerb(TEXT("GET"));
+	// The operation has no request body.
+	HttpRequest->SetVerb(Verb);
 
 	// Header parameters
 	HttpRequest->SetHeader(TEXT("Connection"), Connection);
 	HttpRequest->SetHeader(TEXT("Upgrade"), Upgrade);
-
-	// Default to Json Body request
-	if (Consumes.Contains(TEXT("application/json")))
-	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
-		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
-	}
-	else if (Consumes.Contains(TEXT("multipart/form-data")))
-	{
-	}
-	else if (Consumes.Contains(TEXT("application/x-www-form-urlencoded")))
-	{
-	}
-	else if (Consumes.Num() == 0)
-	{
-		// Do nothing.
-	}
-	else
-	{
-		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Request ContentType not supported (%s)"), *FString::Join(Consumes, TEXT(",")));
-	}
 }
 
 void SubscribeServerResponse::SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode)
@@ -161,49 +108,19 @@ bool SubscribeServerResponse::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 	return true;
 }
 
-FString UnreadyServerRequest::ComputePath() const
+void UnreadyServerRequest::AppendPath(FMultiplayPathBuilder& Path) const
 {
-	TMap<FString, FStringFormatArg> PathParams = { 
-	{ TEXT("serverId"), ToStringFormatArg(ServerId) } };
-
-	FString Path = FString::Format(TEXT("/v1/server/{serverId}/unready"), PathParams);
-
-	return Path;
+	// /v1/server/{serverId}/unready
+	Path.Append(TEXT("/v1/server/")).AppendInt(ServerId).Append(TEXT("/unready"));
 }
 
 void UnreadyServerRequest::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
 {
-	static const TArray<FString> Consumes = {  };
 	//static const TArray<FString> Produces = { TEXT("application/json"), TEXT("application/problem+json") };
+	static const FString Verb(TEXT("POST"));
 
-	HttpRequest->SetVerb(TEXT("POST"));
-
-	// Default to Json Body request
-	if (Consumes.Contains(TEXT("application/json")))
-	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
-		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
-	}
-	else if (Consumes.Contains(TEXT("multipart/form-data")))
-	{
-	}
-	else if (Consumes.Contains(TEXT("application/x-www-form-urlencoded")))
-	{
-	}
-	else if (Consumes.Num() == 0)
-	{
-		// Do nothing.
-	}
-	else
-	{
-		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Request ContentType not supported (%s)"), *FString::Join(Consumes, TEXT(",")));
-	}
+	// The operation has no request body.
+	HttpRequest->SetVerb(Verb);
 }
 
 void UnreadyServerResponse::SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode)
@@ -228,4 +145,9 @@ bool UnreadyServerResponse::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 	return TryGetJsonValue(JsonValue, Content);
 }
 
+bool UnreadyServerResponse::FromErrorJson(const TSharedPtr<FJsonValue>& JsonValue)
+{
+	return ErrorContent.FromJson(JsonValue);
+}
+
 }
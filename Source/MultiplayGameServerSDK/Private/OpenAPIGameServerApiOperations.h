@@ -29,7 +29,7 @@ class MULTIPLAYGAMESERVERSDK_API ReadyServerRequest : public Request
 public:
     virtual ~ReadyServerRequest() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FMultiplayPathBuilder& Path) const final;
 
 	/* ID of the game server */
 	int64 ServerId = 0;
@@ -43,8 +43,10 @@ public:
     virtual ~ReadyServerResponse() {}
 	void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode) final;
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromErrorJson(const TSharedPtr<FJsonValue>& JsonValue) final;
 
     TSharedPtr<FJsonObject> Content;
+    OpenAPIErrorResponseBody ErrorContent;
 };
 
 /* Subscribe to game server lifecycle events
@@ -56,7 +58,7 @@ class MULTIPLAYGAMESERVERSDK_API SubscribeServerRequest : public Request
 public:
     virtual ~SubscribeServerRequest() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FMultiplayPathBuilder& Path) const final;
 
 	/* Controls whether the network connection stays open after the current transaction finishes. */
 	FString Connection;
@@ -83,7 +85,7 @@ class MULTIPLAYGAMESERVERSDK_API UnreadyServerRequest : public Request
 public:
     virtual ~UnreadyServerRequest() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FMultiplayPathBuilder& Path) const final;
 
 	/* ID of the game server */
 	int64 ServerId = 0;
@@ -95,8 +97,10 @@ public:
     virtual ~UnreadyServerResponse() {}
 	void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode) final;
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromErrorJson(const TSharedPtr<FJsonValue>& JsonValue) final;
 
     TSharedPtr<FJsonObject> Content;
+    OpenAPIErrorResponseBody ErrorContent;
 };
 
 }
@@ -17,6 +17,7 @@
 #include "Interfaces/IHttpRequest.h"
 #include "PlatformHttp.h"
 #include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
 #include "Misc/Paths.h"
 #include "Runtime/Launch/Resources/Version.h"
 
@@ -62,12 +63,150 @@ FString HttpFileInput::GetFilename() const
 const TCHAR* HttpMultipartFormData::Delimiter = TEXT("--");
 const TCHAR* HttpMultipartFormData::Newline = TEXT("\r\n");
 
+// Reads a multipart body segment by segment, keeping at most one file open.
+class HttpMultipartFormDataReader : public FArchive
+{
+public:
+	explicit HttpMultipartFormDataReader(TArray<HttpMultipartFormData::Segment>&& InSegments)
+		: Segments(MoveTemp(InSegments))
+		, TotalBytes(0)
+		, Position(0)
+		, SegmentIndex(0)
+		, SegmentOffset(0)
+	{
+		for (const HttpMultipartFormData::Segment& Current : Segments)
+		{
+			TotalBytes += Current.Num();
+		}
+	}
+
+	virtual void Serialize(void* Data, int64 Length) override
+	{
+		uint8* Dest = static_cast<uint8*>(Data);
+
+		// The reads following a failure are not attempted, so that the failure is reported once.
+		if (IsError())
+		{
+			FMemory::Memzero(Dest, Length);
+			return;
+		}
+
+		while (Length > 0)
+		{
+			if (SegmentIndex >= Segments.Num())
+			{
+				UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Attempted to read past the end of the multipart form data"));
+				Fail(Dest, Length);
+				return;
+			}
+
+			const HttpMultipartFormData::Segment& Current = Segments[SegmentIndex];
+			const int64 Count = FMath::Min(Length, Current.Num() - SegmentOffset);
+			if (Count > 0)
+			{
+				if (Current.FilePath.IsEmpty())
+				{
+					FMemory::Memcpy(Dest, Current.Bytes.GetData() + SegmentOffset, Count);
+				}
+				else if (!ReadFile(Current, Dest, Count))
+				{
+					Fail(Dest, Length);
+					return;
+				}
+			}
+
+			Dest += Count;
+			Length -= Count;
+			Position += Count;
+			SegmentOffset += Count;
+
+			if (SegmentOffset == Current.Num())
+			{
+				File.Reset();
+				++SegmentIndex;
+				SegmentOffset = 0;
+			}
+		}
+	}
+
+	// The HTTP module seeks back to the start when it has to send the body again.
+	virtual void Seek(int64 InPos) override
+	{
+		File.Reset();
+		Position = 0;
+		SegmentIndex = 0;
+		while (SegmentIndex < Segments.Num() && InPos - Position >= Segments[SegmentIndex].Num())
+		{
+			Position += Segments[SegmentIndex].Num();
+			++SegmentIndex;
+		}
+
+		SegmentOffset = InPos - Position;
+		Position = InPos;
+	}
+
+	virtual int64 Tell() override { return Position; }
+	virtual int64 TotalSize() override { return TotalBytes; }
+	virtual FString GetArchiveName() const override { return TEXT("HttpMultipartFormDataReader"); }
+
+private:
+	bool ReadFile(const HttpMultipartFormData::Segment& Current, uint8* Dest, int64 Count)
+	{
+		if (!File.IsValid())
+		{
+			File.Reset(IFileManager::Get().CreateFileReader(*Current.FilePath));
+
+			// The length of the body was sent from the size the file had when it was added.
+			if (!File.IsValid() || File->TotalSize() != Current.FileSize)
+			{
+				UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to stream file (%s), it was removed or changed size after it was added"), *Current.FilePath);
+				File.Reset();
+				return false;
+			}
+
+			File->Seek(SegmentOffset);
+		}
+
+		File->Serialize(Dest, Count);
+		if (File->IsError())
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to stream file (%s)"), *Current.FilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	void Fail(uint8* Dest, int64 Length)
+	{
+		FMemory::Memzero(Dest, Length);
+#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 25
+		ArIsError = true;
+#else
+		SetError();
+#endif
+	}
+
+	TArray<HttpMultipartFormData::Segment> Segments;
+	TUniquePtr<FArchive> File;
+	int64 TotalBytes;
+	int64 Position;
+	int32 SegmentIndex;
+	int64 SegmentOffset;
+};
+
 void HttpMultipartFormData::SetBoundary(const TCHAR* InBoundary)
 {
 	checkf(Boundary.IsEmpty(), TEXT("Boundary must be set before usage"));
 	Boundary = InBoundary;
 }
 
+void HttpMultipartFormData::SetStreamed(bool bInStreamed)
+{
+	checkf(Segments.Num() == 0, TEXT("Streaming must be set before any part is added"));
+	bStreamed = bInStreamed;
+}
+
 const FString& HttpMultipartFormData::GetBoundary() const
 {
 	if (Boundary.IsEmpty())
@@ -105,13 +244,43 @@ void HttpMultipartFormData::SetupHttpRequest(const FHttpRequestRef& HttpRequest)
 		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Expected POST verb when using multipart form data"));
 	}
 
-	// Append final boundary
-	AppendString(Delimiter);
-	AppendString(*GetBoundary());
-	AppendString(Delimiter);
+	AppendFinalBoundary();
 
 	HttpRequest->SetHeader("Content-Type", FString::Printf(TEXT("multipart/form-data; boundary=%s"), *GetBoundary()));
-	HttpRequest->SetContent(FormData);
+
+	if (!bStreamed)
+	{
+		HttpRequest->SetContent(GetBuffer());
+		return;
+	}
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+	HttpRequest->SetContentFromStream(CreateContentReader());
+#else
+	// Requests cannot read their content from an archive before UE 5.1, the streamed body is read into memory once it is complete.
+	TSharedRef<FArchive, ESPMode::ThreadSafe> Reader = CreateContentReader();
+	TArray<uint8> Content;
+	Content.SetNumUninitialized(Reader->TotalSize());
+	Reader->Serialize(Content.GetData(), Content.Num());
+	HttpRequest->SetContent(Content);
+#endif
+}
+
+TSharedRef<FArchive, ESPMode::ThreadSafe> HttpMultipartFormData::CreateContentReader()
+{
+	AppendFinalBoundary();
+	return MakeShared<HttpMultipartFormDataReader, ESPMode::ThreadSafe>(MoveTemp(Segments));
+}
+
+int64 HttpMultipartFormData::GetBufferedSize() const
+{
+	int64 Size = 0;
+	for (const Segment& Current : Segments)
+	{
+		Size += Current.Bytes.Num();
+	}
+
+	return Size;
 }
 
 void HttpMultipartFormData::AddStringPart(const TCHAR* Name, const TCHAR* Data)
@@ -173,14 +342,24 @@ void HttpMultipartFormData::AddBinaryPart(const TCHAR* Name, const TArray<uint8>
 	AppendString(Newline);
 
 	// Add Data
-	FormData.Append(ByteArray);
+	GetBuffer().Append(ByteArray);
 	AppendString(Newline);
 }
 
 void HttpMultipartFormData::AddFilePart(const TCHAR* Name, const HttpFileInput& File)
 {
 	TArray<uint8> FileContents;
-	if (!FFileHelper::LoadFileToArray(FileContents, *File.GetFilePath()))
+	int64 FileSize = 0;
+	if (bStreamed)
+	{
+		FileSize = IFileManager::Get().FileSize(*File.GetFilePath());
+		if (FileSize < 0)
+		{
+			UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to find file (%s)"), *File.GetFilePath());
+			return;
+		}
+	}
+	else if (!FFileHelper::LoadFileToArray(FileContents, *File.GetFilePath()))
 	{
 		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to load file (%s)"), *File.GetFilePath());
 		return;
@@ -201,14 +380,45 @@ void HttpMultipartFormData::AddFilePart(const TCHAR* Name, const HttpFileInput&
 	AppendString(Newline);
 
 	// Add Data
-	FormData.Append(FileContents);
+	if (bStreamed)
+	{
+		Segment& FileSegment = Segments[Segments.AddDefaulted()];
+		FileSegment.FilePath = File.GetFilePath();
+		FileSegment.FileSize = FileSize;
+	}
+	else
+	{
+		GetBuffer().Append(FileContents);
+	}
 	AppendString(Newline);
 }
 
 void HttpMultipartFormData::AppendString(const TCHAR* Str)
 {
 	FTCHARToUTF8 utf8Str(Str);
-	FormData.Append((uint8*)utf8Str.Get(), utf8Str.Length());
+	GetBuffer().Append((uint8*)utf8Str.Get(), utf8Str.Length());
+}
+
+void HttpMultipartFormData::AppendFinalBoundary()
+{
+	if (!bFinalBoundaryAppended)
+	{
+		AppendString(Delimiter);
+		AppendString(*GetBoundary());
+		AppendString(Delimiter);
+		bFinalBoundaryAppended = true;
+	}
+}
+
+TArray<uint8>& HttpMultipartFormData::GetBuffer()
+{
+	// Bytes following a streamed file part start a new segment.
+	if (Segments.Num() == 0 || !Segments.Last().FilePath.IsEmpty())
+	{
+		Segments.AddDefaulted();
+	}
+
+	return Segments.Last().Bytes;
 }
 
 //////////////////////////////////////////////////////////////////////////
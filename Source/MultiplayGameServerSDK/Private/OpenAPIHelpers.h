@@ -61,6 +61,11 @@ class HttpMultipartFormData
 {
 public:
 	void SetBoundary(const TCHAR* InBoundary);
+
+	// File parts of a streamed body are read from disk in chunks while the request is sent rather than loaded when they are added.
+	// Must be set before any part is added.
+	void SetStreamed(bool bInStreamed);
+
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest);
 
 	void AddStringPart(const TCHAR* Name, const TCHAR* Data);
@@ -68,12 +73,34 @@ public:
 	void AddBinaryPart(const TCHAR* Name, const TArray<uint8>& ByteArray);
 	void AddFilePart(const TCHAR* Name, const HttpFileInput& File);
 
+	// Completes the body and hands it to a reader, which opens the files of a streamed body as it reaches them.
+	TSharedRef<FArchive, ESPMode::ThreadSafe> CreateContentReader();
+
+	// The number of bytes of the body held in memory, which excludes the file parts of a streamed body.
+	int64 GetBufferedSize() const;
+
+	struct Segment
+	{
+		// The bytes of the segment, empty for a file part of a streamed body.
+		TArray<uint8> Bytes;
+
+		// The file a file part of a streamed body is read from.
+		FString FilePath;
+		int64 FileSize = 0;
+
+		int64 Num() const { return FilePath.IsEmpty() ? Bytes.Num() : FileSize; }
+	};
+
 private:
 	void AppendString(const TCHAR* Str);
+	void AppendFinalBoundary();
+	TArray<uint8>& GetBuffer();
 	const FString& GetBoundary() const;
 
 	mutable FString Boundary;
-	TArray<uint8> FormData;
+	TArray<Segment> Segments;
+	bool bStreamed = false;
+	bool bFinalBoundaryAppended = false;
 
 	static const TCHAR* Delimiter;
 	static const TCHAR* Newline;
@@ -0,0 +1,310 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "OpenAPIHelpers.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace Multiplay
+{
+	// Stands in for an HTTP server, answering a single request on a loopback port and recording its body.
+	class FMultipartFormDataSpecServer
+	{
+	public:
+		FMultipartFormDataSpecServer() : Listener(nullptr), Port(0)
+		{
+			ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+			bool bIsValid = false;
+			TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+			Address->SetIp(TEXT("127.0.0.1"), bIsValid);
+			Address->SetPort(0);
+
+			Listener = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("MultipartFormDataSpecServer"), false);
+			if (Listener != nullptr && Listener->Bind(*Address) && Listener->Listen(1))
+			{
+				Port = Listener->GetPortNo();
+			}
+		}
+
+		~FMultipartFormDataSpecServer()
+		{
+			if (Served.IsValid())
+			{
+				Served.Wait();
+			}
+
+			if (Listener != nullptr)
+			{
+				ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Listener);
+			}
+		}
+
+		int32 GetPort() const { return Port; }
+
+		// Accepts one connection on a background thread, records the request body and answers it.
+		void Serve()
+		{
+			Served = ServedPromise.GetFuture();
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this]()
+				{
+					Answer();
+					ServedPromise.SetValue();
+				});
+		}
+
+		TArray<uint8> Body;
+
+	private:
+		void Answer()
+		{
+			bool bHasPendingConnection = false;
+			if (!Listener->WaitForPendingConnection(bHasPendingConnection, FTimespan::FromSeconds(5.0)) || !bHasPendingConnection)
+			{
+				return;
+			}
+
+			FSocket* Connection = Listener->Accept(TEXT("MultipartFormDataSpecConnection"));
+			if (Connection == nullptr)
+			{
+				return;
+			}
+
+			TArray<uint8> Request;
+			int32 BodyStart = INDEX_NONE;
+			int64 ContentLength = 0;
+			uint8 Buffer[16384];
+
+			while (Connection->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(5.0)))
+			{
+				int32 Read = 0;
+				if (!Connection->Recv(Buffer, sizeof(Buffer), Read) || Read <= 0)
+				{
+					break;
+				}
+
+				Request.Append(Buffer, Read);
+
+				if (BodyStart == INDEX_NONE)
+				{
+					BodyStart = FindBodyStart(Request);
+					if (BodyStart != INDEX_NONE)
+					{
+						const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Request.GetData()), BodyStart);
+						const FString Headers(Converted.Length(), Converted.Get());
+						ContentLength = ParseContentLength(Headers);
+
+						if (Headers.Contains(TEXT("100-continue")))
+						{
+							Send(Connection, "HTTP/1.1 100 Continue\r\n\r\n");
+						}
+					}
+				}
+
+				if (BodyStart != INDEX_NONE && Request.Num() - BodyStart >= ContentLength)
+				{
+					break;
+				}
+			}
+
+			if (BodyStart != INDEX_NONE)
+			{
+				Body.Append(Request.GetData() + BodyStart, Request.Num() - BodyStart);
+			}
+
+			Send(Connection, "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+			Connection->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Connection);
+		}
+
+		static int32 FindBodyStart(const TArray<uint8>& Request)
+		{
+			for (int32 Index = 3; Index < Request.Num(); ++Index)
+			{
+				if (FMemory::Memcmp(Request.GetData() + Index - 3, "\r\n\r\n", 4) == 0)
+				{
+					return Index + 1;
+				}
+			}
+
+			return INDEX_NONE;
+		}
+
+		static int64 ParseContentLength(const FString& Headers)
+		{
+			static const FString Name = TEXT("content-length:");
+
+			const int32 Index = Headers.Find(Name, ESearchCase::IgnoreCase);
+			return Index != INDEX_NONE ? FCString::Atoi64(*Headers.Mid(Index + Name.Len()).TrimStart()) : 0;
+		}
+
+		static void Send(FSocket* Connection, const ANSICHAR* Text)
+		{
+			int32 Sent = 0;
+			Connection->Send(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text), Sent);
+		}
+
+	private:
+		FSocket* Listener;
+		int32 Port;
+		TPromise<void> ServedPromise;
+		TFuture<void> Served;
+	};
+} // namespace Multiplay
+
+BEGIN_DEFINE_SPEC(FMultiplayMultipartFormDataSpec, "MultiplayGameServerSDK.MultipartFormData", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+static constexpr int32 kFileSize = 1024 * 1024;
+FString FilePath;
+TArray<uint8> FileContents;
+TSharedPtr<Multiplay::FMultipartFormDataSpecServer> Server;
+void AddParts(Multiplay::HttpMultipartFormData& FormData) const;
+TArray<uint8> ReadAll(FArchive& Reader, int32 ChunkSize) const;
+END_DEFINE_SPEC(FMultiplayMultipartFormDataSpec)
+
+void FMultiplayMultipartFormDataSpec::AddParts(Multiplay::HttpMultipartFormData& FormData) const
+{
+	FormData.SetBoundary(TEXT("MultipartFormDataSpecBoundary"));
+	FormData.AddStringPart(TEXT("server"), TEXT("1234"));
+	FormData.AddFilePart(TEXT("replay"), Multiplay::HttpFileInput(FilePath));
+	FormData.AddJsonPart(TEXT("metadata"), TEXT("{\"reason\":\"deallocated\"}"));
+	FormData.AddFilePart(TEXT("dump"), Multiplay::HttpFileInput(FilePath));
+}
+
+TArray<uint8> FMultiplayMultipartFormDataSpec::ReadAll(FArchive& Reader, int32 ChunkSize) const
+{
+	TArray<uint8> Content;
+	Content.SetNumUninitialized(Reader.TotalSize());
+	for (int64 Offset = 0; Offset < Content.Num(); Offset += ChunkSize)
+	{
+		Reader.Serialize(Content.GetData() + Offset, FMath::Min<int64>(ChunkSize, Content.Num() - Offset));
+	}
+
+	return Content;
+}
+
+void FMultiplayMultipartFormDataSpec::Define()
+{
+	BeforeEach([this]()
+		{
+			FileContents.SetNumUninitialized(kFileSize);
+			for (int32 Index = 0; Index < kFileSize; ++Index)
+			{
+				FileContents[Index] = static_cast<uint8>(Index * 31 + (Index >> 8));
+			}
+
+			FilePath = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("MultipartFormDataSpec"), TEXT(".bin"));
+			FFileHelper::SaveArrayToFile(FileContents, *FilePath);
+		});
+
+	AfterEach([this]()
+		{
+			Server.Reset();
+			IFileManager::Get().Delete(*FilePath);
+		});
+
+	It("should stream the same body as the buffered form data while holding only the part headers.", [this]()
+		{
+			Multiplay::HttpMultipartFormData Buffered;
+			AddParts(Buffered);
+
+			Multiplay::HttpMultipartFormData Streamed;
+			Streamed.SetStreamed(true);
+			AddParts(Streamed);
+
+			TestTrueExpr(Buffered.GetBufferedSize() > 2 * kFileSize);
+			TestTrueExpr(Streamed.GetBufferedSize() < 1024);
+
+			const TArray<uint8> Expected = ReadAll(*Buffered.CreateContentReader(), MAX_int32);
+			TSharedRef<FArchive, ESPMode::ThreadSafe> Reader = Streamed.CreateContentReader();
+			MP_TEST_TRUE_EXPR(Reader->TotalSize() == Expected.Num());
+
+			TestTrueExpr(ReadAll(*Reader, 4000) == Expected);
+			TestFalseExpr(Reader->IsError());
+		});
+
+	It("should read the body again after seeking back into a file part.", [this]()
+		{
+			Multiplay::HttpMultipartFormData Buffered;
+			AddParts(Buffered);
+
+			Multiplay::HttpMultipartFormData Streamed;
+			Streamed.SetStreamed(true);
+			AddParts(Streamed);
+
+			const TArray<uint8> Expected = ReadAll(*Buffered.CreateContentReader(), MAX_int32);
+			TSharedRef<FArchive, ESPMode::ThreadSafe> Reader = Streamed.CreateContentReader();
+			ReadAll(*Reader, 65536);
+
+			const int64 Offset = kFileSize / 2;
+			Reader->Seek(Offset);
+
+			TArray<uint8> Rest;
+			Rest.SetNumUninitialized(Expected.Num() - Offset);
+			Reader->Serialize(Rest.GetData(), Rest.Num());
+
+			TestTrueExpr(FMemory::Memcmp(Rest.GetData(), Expected.GetData() + Offset, Rest.Num()) == 0);
+		});
+
+	It("should fail the read when a file changes size after it was added.", [this]()
+		{
+			Multiplay::HttpMultipartFormData Streamed;
+			Streamed.SetStreamed(true);
+			AddParts(Streamed);
+
+			FFileHelper::SaveArrayToFile(TArray<uint8>(FileContents.GetData(), 16), *FilePath);
+
+			AddExpectedError(TEXT("changed size"), EAutomationExpectedErrorFlags::Contains, 1);
+
+			TSharedRef<FArchive, ESPMode::ThreadSafe> Reader = Streamed.CreateContentReader();
+			ReadAll(*Reader, 65536);
+			TestTrueExpr(Reader->IsError());
+		});
+
+	LatentIt("should send a streamed body to a local HTTP stand-in.", FTimespan::FromSeconds(10.0), [this](const FDoneDelegate& Done)
+		{
+			Multiplay::HttpMultipartFormData Buffered;
+			AddParts(Buffered);
+			const TArray<uint8> Expected = ReadAll(*Buffered.CreateContentReader(), MAX_int32);
+
+			Server = MakeShared<Multiplay::FMultipartFormDataSpecServer>();
+			if (!MP_TEST_TRUE_EXPR(Server->GetPort() != 0))
+			{
+				Done.Execute();
+				return;
+			}
+			Server->Serve();
+
+			Multiplay::HttpMultipartFormData Streamed;
+			Streamed.SetStreamed(true);
+			AddParts(Streamed);
+
+			auto HttpRequest = FHttpModule::Get().CreateRequest();
+			HttpRequest->SetURL(FString::Printf(TEXT("http://127.0.0.1:%d/upload"), Server->GetPort()));
+			HttpRequest->SetVerb(TEXT("POST"));
+			Streamed.SetupHttpRequest(HttpRequest);
+
+			TSharedPtr<Multiplay::FMultipartFormDataSpecServer> CapturedServer = Server;
+			HttpRequest->OnProcessRequestComplete().BindLambda([this, CapturedServer, Expected, Done](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+				{
+					if (MP_TEST_TRUE_EXPR(bSucceeded && Response.IsValid()))
+					{
+						TestEqual(TEXT("ResponseCode"), Response->GetResponseCode(), 200);
+					}
+
+					TestEqual(TEXT("BodySize"), CapturedServer->Body.Num(), Expected.Num());
+					TestTrueExpr(CapturedServer->Body == Expected);
+					Done.Execute();
+				});
+
+			HttpRequest->ProcessRequest();
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -14,6 +14,7 @@
 
 #include "OpenAPIPayloadApiOperations.h"
 #include "MultiplayGameServerSDKModule.h"
+#include "MultiplayGameServerSDK/MultiplayPayloadCompression.h"
 
 #include "HttpModule.h"
 #include "Serialization/JsonSerializer.h"
@@ -35,7 +36,16 @@ void OpenAPIPayloadApi::SetURL(const FString& InUrl)
 
 void OpenAPIPayloadApi::AddHeaderParam(const FString& Key, const FString& Value)
 {
-	AdditionalHeaderParams.Add(Key, Value);
+	for (TPair<FString, FString>& Header : AdditionalHeaderParams)
+	{
+		if (Header.Key == Key)
+		{
+			Header.Value = Value;
+			return;
+		}
+	}
+
+	AdditionalHeaderParams.Emplace(Key, Value);
 }
 
 void OpenAPIPayloadApi::ClearHeaderParams()
@@ -97,35 +107,7 @@ void OpenAPIPayloadApi::HandleResponse(FHttpResponsePtr HttpResponse, bool bSucc
 	if (bSucceeded && HttpResponse.IsValid())
 	{
 		InOutResponse.SetHttpResponseCode((EHttpResponseCodes::Type)HttpResponse->GetResponseCode());
-		FString ContentType = HttpResponse->GetContentType();
-		FString Content;
-
-		if (ContentType.IsEmpty())
-		{
-			return; // Nothing to parse
-		}
-		else if (ContentType.StartsWith(TEXT("application/json")) || ContentType.StartsWith("text/json"))
-		{
-			Content = HttpResponse->GetContentAsString();
-
-			TSharedPtr<FJsonValue> JsonValue;
-			auto Reader = TJsonReaderFactory<>::Create(Content);
-
-			if (FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid())
-			{
-				if (InOutResponse.FromJson(JsonValue))
-					return; // Successfully parsed
-			}
-		}
-		else if(ContentType.StartsWith(TEXT("text/plain")))
-		{
-			Content = HttpResponse->GetContentAsString();
-			InOutResponse.SetResponseString(Content);
-			return; // Successfully parsed
-		}
-
-		// Report the parse error but do not mark the request as unsuccessful. Data could be partial or malformed, but the request succeeded.
-		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to deserialize Http response content (type:%s):\n%s"), *ContentType , *Content);
+		InOutResponse.ReceiveContent(HttpResponse);
 		return;
 	}
 
@@ -139,15 +121,23 @@ FHttpRequestPtr OpenAPIPayloadApi::PayloadAllocation(const PayloadAllocationRequ
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	FMultiplayPathBuilder RequestUrl;
+	RequestUrl.Append(Url);
+	Request.AppendPath(RequestUrl);
+	HttpRequest->SetURL(RequestUrl.ToString());
 
-	for(const auto& It : AdditionalHeaderParams)
+	for (const TPair<FString, FString>& Header : AdditionalHeaderParams)
 	{
-		HttpRequest->SetHeader(It.Key, It.Value);
+		HttpRequest->SetHeader(Header.Key, Header.Value);
 	}
 
 	Request.SetupHttpRequest(HttpRequest);
 
+	if (bAcceptCompressedPayload)
+	{
+		HttpRequest->SetHeader(TEXT("Accept-Encoding"), FMultiplayPayloadCompression::kAcceptEncoding);
+	}
+
 	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPIPayloadApi::OnPayloadAllocationResponse, Delegate);
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
@@ -156,21 +146,31 @@ FHttpRequestPtr OpenAPIPayloadApi::PayloadAllocation(const PayloadAllocationRequ
 void OpenAPIPayloadApi::OnPayloadAllocationResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FPayloadAllocationDelegate Delegate) const
 {
 	PayloadAllocationResponse Response;
+	PreparePayloadAllocationResponse(Response);
 	HandleResponse(HttpResponse, bSucceeded, Response);
 	Delegate.ExecuteIfBound(Response);
 }
 
+void OpenAPIPayloadApi::PreparePayloadAllocationResponse(PayloadAllocationResponse& Response) const
+{
+	Response.SpillThresholdBytes = PayloadSpillThresholdBytes;
+	Response.MaxDecompressedBytes = PayloadMaxDecompressedBytes;
+}
+
 FHttpRequestPtr OpenAPIPayloadApi::PayloadToken(const PayloadTokenRequest& Request, const FPayloadTokenDelegate& Delegate /*= FPayloadTokenDelegate()*/) const
 {
 	if (!IsValid())
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	FMultiplayPathBuilder RequestUrl;
+	RequestUrl.Append(Url);
+	Request.AppendPath(RequestUrl);
+	HttpRequest->SetURL(RequestUrl.ToString());
 
-	for(const auto& It : AdditionalHeaderParams)
+	for (const TPair<FString, FString>& Header : AdditionalHeaderParams)
 	{
-		HttpRequest->SetHeader(It.Key, It.Value);
+		HttpRequest->SetHeader(Header.Key, Header.Value);
 	}
 
 	Request.SetupHttpRequest(HttpRequest);
@@ -45,6 +45,15 @@ public:
 	void SetHttpRetryManager(FHttpRetrySystem::FManager& RetryManager);
 	FHttpRetrySystem::FManager& GetHttpRetryManager();
 
+	/* Sets the size above which allocation payloads are moved to a memory-mapped temporary file, 0 keeps every payload in memory */
+	void SetPayloadSpillThreshold(int64 Bytes) { PayloadSpillThresholdBytes = Bytes; }
+
+	/* Sets whether allocation payloads may be transferred compressed, and the size above which a compressed payload is rejected */
+	void SetPayloadCompression(bool bAccept, int64 MaxDecompressedBytes) { bAcceptCompressedPayload = bAccept; PayloadMaxDecompressedBytes = MaxDecompressedBytes; }
+
+	/* Applies the payload settings to a response, whichever transport it is received over */
+	void PreparePayloadAllocationResponse(PayloadAllocationResponse& Response) const;
+
     FHttpRequestPtr PayloadAllocation(const PayloadAllocationRequest& Request, const FPayloadAllocationDelegate& Delegate = FPayloadAllocationDelegate()) const;
     FHttpRequestPtr PayloadToken(const PayloadTokenRequest& Request, const FPayloadTokenDelegate& Delegate = FPayloadTokenDelegate()) const;
     
@@ -57,9 +66,13 @@ private:
 	void HandleResponse(FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const;
 
 	FString Url;
-	TMap<FString,FString> AdditionalHeaderParams;
+	// Kept as a flat array, which is all each request needs to copy the headers.
+	TArray<TPair<FString, FString>> AdditionalHeaderParams;
 	mutable FHttpRetrySystem::FManager* RetryManager = nullptr;
 	mutable TUniquePtr<HttpRetryManager> DefaultRetryManager;
+	int64 PayloadSpillThresholdBytes = 0;
+	bool bAcceptCompressedPayload = false;
+	int64 PayloadMaxDecompressedBytes = 64 * 1024 * 1024;
 };
 
 }
@@ -14,6 +14,8 @@
 
 #include "MultiplayGameServerSDKModule.h"
 #include "OpenAPIHelpers.h"
+#include "MultiplayGameServerSDK/MultiplayPayloadBufferFactory.h"
+#include "MultiplayGameServerSDK/MultiplayPayloadCompression.h"
 
 #include "Dom/JsonObject.h"
 #include "Templates/SharedPointer.h"
@@ -23,49 +25,19 @@
 namespace Multiplay
 {
 
-FString PayloadAllocationRequest::ComputePath() const
+void PayloadAllocationRequest::AppendPath(FMultiplayPathBuilder& Path) const
 {
-	TMap<FString, FStringFormatArg> PathParams = { 
-	{ TEXT("allocationId"), ToStringFormatArg(AllocationId) } };
-
-	FString Path = FString::Format(TEXT("/payload/{allocationId}"), PathParams);
-
-	return Path;
+	// /payload/{allocationId}
+	Path.Append(TEXT("/payload/")).AppendGuid(AllocationId);
 }
 
 void PayloadAllocationRequest::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
 {
-	static const TArray<FString> Consumes = {  };
 	//static const TArray<FString> Produces = { TEXT("application/json") };
+	static const FString Verb(TEXT("GET"));
 
-	HttpRequest->SetVerb(TEXT("GET"));
-
-	// Default to Json Body request
-	if (Consumes.Contains(TEXT("application/json")))
-	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
-		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
-	}
-	else if (Consumes.Contains(TEXT("multipart/form-data")))
-	{
-	}
-	else if (Consumes.Contains(TEXT("application/x-www-form-urlencoded")))
-	{
-	}
-	else if (Consumes.Num() == 0)
-	{
-		// Do nothing.
-	}
-	else
-	{
-		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Request ContentType not supported (%s)"), *FString::Join(Consumes, TEXT(",")));
-	}
+	// The operation has no request body.
+	HttpRequest->SetVerb(Verb);
 }
 
 void PayloadAllocationResponse::SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode)
@@ -90,45 +62,120 @@ bool PayloadAllocationResponse::FromJson(const TSharedPtr<FJsonValue>& JsonValue
 	return true;
 }
 
-FString PayloadTokenRequest::ComputePath() const
+bool PayloadAllocationResponse::FromErrorJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	FString Path(TEXT("/token"));
-	return Path;
+	return ErrorContent.FromJson(JsonValue);
 }
 
-void PayloadTokenRequest::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
+void PayloadAllocationResponse::ReceiveContent(const FHttpResponsePtr& InHttpResponse)
 {
-	static const TArray<FString> Consumes = {  };
-	//static const TArray<FString> Produces = { TEXT("application/json") };
+	if (!IsSuccessful())
+	{
+		Response::ReceiveContent(InHttpResponse);
+		return;
+	}
 
-	HttpRequest->SetVerb(TEXT("GET"));
+	const TArray<uint8>& Content = InHttpResponse->GetContent();
 
-	// Default to Json Body request
-	if (Consumes.Contains(TEXT("application/json")))
+	// The payload is kept as the received bytes, it is only converted to a string for callers that ask for one.
+	if (FMultiplayPayloadCompression::IsGzip(InHttpResponse->GetHeader(TEXT("Content-Encoding")), Content))
 	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
-		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
+		TArray<uint8> Inflated;
+		if (!InflatePayload(Content, Inflated))
+		{
+			return;
+		}
+
+		// The compressed bytes are released along with the HTTP response.
+		SetHttpResponse(nullptr);
+
+		KeepPayload(MoveTemp(Inflated));
+		return;
 	}
-	else if (Consumes.Contains(TEXT("multipart/form-data")))
+
+	if (SpillThresholdBytes > 0 && Content.Num() > SpillThresholdBytes)
 	{
+		Payload = MakeMappedPayloadBuffer(Content);
+		if (Payload.IsValid())
+		{
+			// The received bytes are released along with the HTTP response.
+			SetHttpResponse(nullptr);
+			return;
+		}
 	}
-	else if (Consumes.Contains(TEXT("application/x-www-form-urlencoded")))
+
+	Payload = MakeHttpPayloadBuffer(InHttpResponse);
+}
+
+void PayloadAllocationResponse::ReceiveContent(const FString& Content, const FString& ContentType)
+{
+	Response::ReceiveContent(Content, ContentType);
+
+	if (IsSuccessful())
 	{
+		Payload = MakeStringPayloadBuffer(Content);
 	}
-	else if (Consumes.Num() == 0)
+}
+
+void PayloadAllocationResponse::ReceiveContent(TArray<uint8>&& Content, const FString& ContentType, const FString& ContentEncoding)
+{
+	if (!IsSuccessful())
 	{
-		// Do nothing.
+		Response::ReceiveContent(MoveTemp(Content), ContentType, ContentEncoding);
+		return;
 	}
-	else
+
+	if (FMultiplayPayloadCompression::IsGzip(ContentEncoding, Content))
+	{
+		TArray<uint8> Inflated;
+		if (!InflatePayload(Content, Inflated))
+		{
+			return;
+		}
+
+		Content = MoveTemp(Inflated);
+	}
+
+	KeepPayload(MoveTemp(Content));
+}
+
+bool PayloadAllocationResponse::InflatePayload(TArrayView<const uint8> Compressed, TArray<uint8>& OutBytes)
+{
+	if (!FMultiplayPayloadCompression::InflateGzip(Compressed, MaxDecompressedBytes, OutBytes))
 	{
-		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Request ContentType not supported (%s)"), *FString::Join(Consumes, TEXT(",")));
+		UE_LOG(LogMultiplayGameServerSDK, Error, TEXT("Failed to decompress the allocation payload (%d compressed bytes)."), Compressed.Num());
+		SetSuccessful(false);
+		return false;
 	}
+
+	return true;
+}
+
+void PayloadAllocationResponse::KeepPayload(TArray<uint8>&& Bytes)
+{
+	if (SpillThresholdBytes > 0 && Bytes.Num() > SpillThresholdBytes)
+	{
+		Payload = MakeMappedPayloadBuffer(Bytes);
+	}
+
+	if (!Payload.IsValid())
+	{
+		Payload = MakeOwnedPayloadBuffer(MoveTemp(Bytes));
+	}
+}
+
+void PayloadTokenRequest::AppendPath(FMultiplayPathBuilder& Path) const
+{
+	Path.Append(TEXT("/token"));
+}
+
+void PayloadTokenRequest::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
+{
+	//static const TArray<FString> Produces = { TEXT("application/json") };
+	static const FString Verb(TEXT("GET"));
+
+	// The operation has no request body.
+	HttpRequest->SetVerb(Verb);
 }
 
 void PayloadTokenResponse::SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode)
@@ -17,6 +17,7 @@
 
 #include "OpenAPIPayloadAllocationErrorResponseBody.h"
 #include "OpenAPIPayloadTokenResponseBody.h"
+#include "MultiplayPayloadBuffer.h"
 
 namespace Multiplay
 {
@@ -30,7 +31,7 @@ class MULTIPLAYGAMESERVERSDK_API PayloadAllocationRequest : public Request
 public:
     virtual ~PayloadAllocationRequest() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FMultiplayPathBuilder& Path) const final;
 
 	/* ID of the game server allocation */
 	FGuid AllocationId;
@@ -42,8 +43,32 @@ public:
     virtual ~PayloadAllocationResponse() {}
 	void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode) final;
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromErrorJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	void ReceiveContent(const FHttpResponsePtr& InHttpResponse) final;
+	void ReceiveContent(const FString& Content, const FString& ContentType) final;
+	void ReceiveContent(TArray<uint8>&& Content, const FString& ContentType, const FString& ContentEncoding) final;
 
-    
+    OpenAPIPayloadAllocationErrorResponseBody ErrorContent;
+
+	/* The payload of a successful response, shared without copying the received bytes */
+	FMultiplayPayloadBufferPtr Payload;
+
+	/* Payloads larger than this are moved to a memory-mapped temporary file, 0 keeps every payload in memory. The file is written synchronously, on the thread receiving the content */
+	int64 SpillThresholdBytes = 0;
+
+	/* Compressed payloads that inflate to more than this are rejected */
+	int64 MaxDecompressedBytes = 64 * 1024 * 1024;
+
+protected:
+	/* The payload of a successful response is free-form and is delivered as is */
+	bool ShouldDecodeContent() const final { return !IsSuccessful(); }
+
+private:
+	/* Inflates a gzip payload, marking the response unsuccessful if it cannot be */
+	bool InflatePayload(TArrayView<const uint8> Compressed, TArray<uint8>& OutBytes);
+
+	/* Keeps received or inflated bytes as the payload, moving them to a memory-mapped temporary file above the spill threshold. Blocks until the file is written */
+	void KeepPayload(TArray<uint8>&& Bytes);
 };
 
 /* Retrieve a JWT token for payloads
@@ -55,7 +80,7 @@ class MULTIPLAYGAMESERVERSDK_API PayloadTokenRequest : public Request
 public:
     virtual ~PayloadTokenRequest() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FMultiplayPathBuilder& Path) const final;
 
 };
 
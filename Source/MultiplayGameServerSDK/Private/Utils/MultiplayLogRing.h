@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+namespace Multiplay
+{
+	// A log message as it is queued for the log writer. The text is copied as it was formatted and converted when written.
+	struct FMultiplayLogRecord
+	{
+		// Longer messages are truncated.
+		static constexpr int32 kMaxLength = 480;
+
+		uint64 Cycles;
+		const TCHAR* Category;
+		uint8 Verbosity;
+		bool bTruncated;
+		uint16 Length;
+		TCHAR Text[kMaxLength];
+	};
+
+	// A bounded queue of log records with any number of producers and a single consumer.
+	//
+	// Each cell carries a sequence number telling whether it is free for the producer that claims its position or holds
+	// a record for the consumer. A producer claims a position with a single compare and swap and publishes the record by
+	// advancing the sequence of its cell, so producers never wait on each other or on the consumer. When the ring is full
+	// the record is dropped and counted instead.
+	class FMultiplayLogRing
+	{
+	public:
+		// The capacity is rounded up to a power of two.
+		explicit FMultiplayLogRing(int32 Capacity)
+			: Mask(FMath::RoundUpToPowerOfTwo(FMath::Max(Capacity, 2)) - 1)
+			, Cells(new FCell[Mask + 1])
+			, Head(0)
+			, Tail(0)
+			, Dropped(0)
+		{
+			for (uint64 Index = 0; Index <= Mask; ++Index)
+			{
+				Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+			}
+		}
+
+		FMultiplayLogRing(const FMultiplayLogRing&) = delete;
+		FMultiplayLogRing& operator=(const FMultiplayLogRing&) = delete;
+
+		// Copies the message into the ring, returns false if it was dropped because the ring is full. Safe to call from any thread.
+		bool TryPush(const TCHAR* Category, uint8 Verbosity, const TCHAR* Text, int32 Length, bool bTruncated)
+		{
+			uint64 Position = Head.load(std::memory_order_relaxed);
+			FCell* Cell;
+			for (;;)
+			{
+				Cell = &Cells[Position & Mask];
+				const int64 Difference = static_cast<int64>(Cell->Sequence.load(std::memory_order_acquire) - Position);
+				if (Difference == 0)
+				{
+					if (Head.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (Difference < 0)
+				{
+					Dropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				else
+				{
+					Position = Head.load(std::memory_order_relaxed);
+				}
+			}
+
+			FMultiplayLogRecord& Record = Cell->Record;
+			Record.Cycles = FPlatformTime::Cycles64();
+			Record.Category = Category;
+			Record.Verbosity = Verbosity;
+			Record.bTruncated = bTruncated || Length > FMultiplayLogRecord::kMaxLength;
+			Record.Length = static_cast<uint16>(FMath::Min(Length, FMultiplayLogRecord::kMaxLength));
+			FMemory::Memcpy(Record.Text, Text, Record.Length * sizeof(TCHAR));
+
+			Cell->Sequence.store(Position + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Hands the oldest record to the visitor and frees its cell, returns false if the ring is empty. Must only be called from the consumer thread.
+		template <typename FunctorType>
+		bool TryPop(FunctorType&& Visitor)
+		{
+			FCell& Cell = Cells[Tail & Mask];
+			if (Cell.Sequence.load(std::memory_order_acquire) != Tail + 1)
+			{
+				return false;
+			}
+
+			Visitor(static_cast<const FMultiplayLogRecord&>(Cell.Record));
+
+			Cell.Sequence.store(Tail + Mask + 1, std::memory_order_release);
+			++Tail;
+			return true;
+		}
+
+		int32 GetCapacity() const { return static_cast<int32>(Mask + 1); }
+
+		// The number of records dropped because the ring was full.
+		int64 GetDroppedCount() const { return Dropped.load(std::memory_order_relaxed); }
+
+	private:
+		struct FCell
+		{
+			std::atomic<uint64> Sequence;
+			FMultiplayLogRecord Record;
+		};
+
+	private:
+		const uint64 Mask;
+		TUniquePtr<FCell[]> Cells;
+
+		// Kept on separate cache lines so that producers and the consumer do not contend on them.
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Head;
+		alignas(PLATFORM_CACHE_LINE_SIZE) uint64 Tail;
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<int64> Dropped;
+	};
+} // namespace Multiplay
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Multiplay
+{
+	// Builds request paths and URLs in an inline buffer, so that the only allocation is the resulting string.
+	//
+	// Routes are written as a sequence of literal segments and parameters rather than parsed from a template, and
+	// integers and GUIDs are written digit by digit instead of going through FString::Format.
+	class FMultiplayPathBuilder
+	{
+	public:
+		// Enough for the daemon URL and any of its routes.
+		static constexpr int32 kInlineSize = 192;
+
+	public:
+		template <int32 N>
+		FMultiplayPathBuilder& Append(const TCHAR (&Literal)[N])
+		{
+			Buffer.Append(Literal, N - 1);
+			return *this;
+		}
+
+		FMultiplayPathBuilder& Append(const FString& String)
+		{
+			Buffer.Append(*String, String.Len());
+			return *this;
+		}
+
+		FMultiplayPathBuilder& AppendInt(int64 Value)
+		{
+			TCHAR Digits[20];
+			int32 Count = 0;
+
+			// Negated as unsigned so that the minimum value does not overflow.
+			uint64 Magnitude = Value < 0 ? 0 - static_cast<uint64>(Value) : static_cast<uint64>(Value);
+			do
+			{
+				Digits[Count++] = TEXT('0') + static_cast<TCHAR>(Magnitude % 10);
+				Magnitude /= 10;
+			} while (Magnitude != 0);
+
+			if (Value < 0)
+			{
+				Buffer.Add(TEXT('-'));
+			}
+
+			while (Count > 0)
+			{
+				Buffer.Add(Digits[--Count]);
+			}
+
+			return *this;
+		}
+
+		// Writes the GUID as lower case digits with hyphens, the form the daemon expects in paths.
+		FMultiplayPathBuilder& AppendGuid(const FGuid& Value)
+		{
+			AppendHex(Value.A, 8).Add(TEXT('-'));
+			AppendHex(Value.B >> 16, 4).Add(TEXT('-'));
+			AppendHex(Value.B & 0xFFFF, 4).Add(TEXT('-'));
+			AppendHex(Value.C >> 16, 4).Add(TEXT('-'));
+			AppendHex(Value.C & 0xFFFF, 4);
+			AppendHex(Value.D, 8);
+			return *this;
+		}
+
+		int32 Len() const { return Buffer.Num(); }
+
+		FString ToString() const { return FString(Buffer.Num(), Buffer.GetData()); }
+
+	private:
+		TArray<TCHAR, TInlineAllocator<kInlineSize>>& AppendHex(uint32 Value, int32 DigitCount)
+		{
+			static const TCHAR* const kHexDigits = TEXT("0123456789abcdef");
+
+			for (int32 Shift = (DigitCount - 1) * 4; Shift >= 0; Shift -= 4)
+			{
+				Buffer.Add(kHexDigits[(Value >> Shift) & 0xF]);
+			}
+
+			return Buffer;
+		}
+
+	private:
+		TArray<TCHAR, TInlineAllocator<kInlineSize>> Buffer;
+	};
+} // namespace Multiplay
@@ -0,0 +1,130 @@
+#include "Tests/AutomationCommon.h"
+#include "Utils/AutomationTestUtils.h"
+#include "Utils/MultiplayPathBuilder.h"
+#include "OpenAPIGameServerApiOperations.h"
+#include "OpenAPIPayloadApiOperations.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace Multiplay
+{
+	// The path of a ready request as the generated client formatted it, which the path builder must reproduce.
+	FString FormatReadyServerPathForSpec(const ReadyServerRequest& Request)
+	{
+		TMap<FString, FStringFormatArg> PathParams = {
+			{ TEXT("serverId"), ToStringFormatArg(Request.ServerId) },
+			{ TEXT("allocationId"), ToStringFormatArg(Request.AllocationId) } };
+
+		return FString::Format(TEXT("/v1/server/{serverId}/allocation/{allocationId}/ready-for-players"), PathParams);
+	}
+} // namespace Multiplay
+
+BEGIN_DEFINE_SPEC(FMultiplayPathBuilderSpec, "MultiplayGameServerSDK.PathBuilder", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FMultiplayPathBuilderSpec)
+
+void FMultiplayPathBuilderSpec::Define()
+{
+	Describe("AppendInt", [this]()
+		{
+			It("should write integers as LexToString does.", [this]()
+				{
+					const int64 Values[] = { 0, 7, -7, 1234567890123, MAX_int64, MIN_int64 };
+					for (const int64 Value : Values)
+					{
+						Multiplay::FMultiplayPathBuilder Path;
+						Path.AppendInt(Value);
+						TestEqual(TEXT("Integer"), Path.ToString(), LexToString(Value));
+					}
+				});
+		});
+
+	Describe("AppendGuid", [this]()
+		{
+			It("should write GUIDs as lower case digits with hyphens.", [this]()
+				{
+					for (int32 Index = 0; Index < 16; ++Index)
+					{
+						const FGuid Guid = FGuid::NewGuid();
+
+						Multiplay::FMultiplayPathBuilder Path;
+						Path.AppendGuid(Guid);
+						TestEqual(TEXT("Guid"), Path.ToString(), Guid.ToString(EGuidFormats::DigitsWithHyphens).ToLower());
+					}
+				});
+		});
+
+	Describe("AppendPath", [this]()
+		{
+			It("should build the same paths as the route templates.", [this]()
+				{
+					Multiplay::ReadyServerRequest Ready;
+					Ready.ServerId = 1234;
+					Ready.AllocationId = FGuid::NewGuid();
+					TestEqual(TEXT("Ready"), Ready.ComputePath(), Multiplay::FormatReadyServerPathForSpec(Ready));
+
+					Multiplay::UnreadyServerRequest Unready;
+					Unready.ServerId = 1234;
+					TestEqual(TEXT("Unready"), Unready.ComputePath(), FString(TEXT("/v1/server/1234/unready")));
+
+					Multiplay::PayloadAllocationRequest Payload;
+					Payload.AllocationId = Ready.AllocationId;
+					TestEqual(TEXT("Payload"), Payload.ComputePath(), TEXT("/payload/") + Ready.AllocationId.ToString(EGuidFormats::DigitsWithHyphens).ToLower());
+				});
+
+			It("should append the path to the URL it is given.", [this]()
+				{
+					Multiplay::FMultiplayPathBuilder Url;
+					Url.Append(FString(TEXT("http://localhost:8086")));
+					Multiplay::PayloadTokenRequest().AppendPath(Url);
+
+					TestEqual(TEXT("Url"), Url.ToString(), FString(TEXT("http://localhost:8086/token")));
+				});
+		});
+}
+
+// Compares building a ready URL with the path builder to building it with FString::Format and string concatenation.
+// Run it explicitly, it is excluded from the product tests as its timings depend on the machine.
+BEGIN_DEFINE_SPEC(FMultiplayPathBuilderPerfSpec, "MultiplayGameServerSDK.Perf.PathBuilder", EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ApplicationContextMask)
+static constexpr int32 kIterations = 100000;
+END_DEFINE_SPEC(FMultiplayPathBuilderPerfSpec)
+
+void FMultiplayPathBuilderPerfSpec::Define()
+{
+	It("should build request URLs faster than the route templates.", [this]()
+		{
+			const FString Url = TEXT("http://localhost:8086");
+
+			Multiplay::ReadyServerRequest Request;
+			Request.ServerId = 1234567;
+			Request.AllocationId = FGuid::NewGuid();
+
+			// Keeps the optimizer from discarding the results.
+			int64 TotalLength = 0;
+
+			const double FormatStart = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < kIterations; ++Iteration)
+			{
+				const FString RequestUrl = Url + Multiplay::FormatReadyServerPathForSpec(Request);
+				TotalLength += RequestUrl.Len();
+			}
+			const double FormatSeconds = FPlatformTime::Seconds() - FormatStart;
+
+			const double BuilderStart = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < kIterations; ++Iteration)
+			{
+				Multiplay::FMultiplayPathBuilder RequestUrl;
+				RequestUrl.Append(Url);
+				Request.AppendPath(RequestUrl);
+				TotalLength += RequestUrl.ToString().Len();
+			}
+			const double BuilderSeconds = FPlatformTime::Seconds() - BuilderStart;
+
+			AddInfo(FString::Printf(TEXT("Route template: %.1f ns per URL, path builder: %.1f ns per URL (%lld characters)."),
+				FormatSeconds * 1e9 / kIterations, BuilderSeconds * 1e9 / kIterations, TotalLength));
+
+			TestTrueExpr(BuilderSeconds < FormatSeconds);
+		});
+}
+
+#endif // #if WITH_AUTOMATION_TESTS
@@ -0,0 +1,255 @@
+#include "Utils/MultiplayStreamSocket.h"
+#include "IPAddress.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace Multiplay
+{
+	namespace
+	{
+		class FMultiplayTcpStreamSocket : public IMultiplayStreamSocket
+		{
+		public:
+			explicit FMultiplayTcpStreamSocket(FSocket* InSocket) : Socket(InSocket)
+			{
+			}
+
+			virtual ~FMultiplayTcpStreamSocket()
+			{
+				Socket->Close();
+				ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+			}
+
+			virtual bool WaitForRead(const FTimespan& WaitTime) override
+			{
+				return Socket->Wait(ESocketWaitConditions::WaitForRead, WaitTime);
+			}
+
+			virtual bool Recv(uint8* Data, int32 Length, int32& BytesRead) override
+			{
+				return Socket->Recv(Data, Length, BytesRead);
+			}
+
+			virtual bool Send(const uint8* Data, int32 Length, int32& BytesSent) override
+			{
+				return Socket->Send(Data, Length, BytesSent);
+			}
+
+		private:
+			FSocket* Socket;
+		};
+
+#if PLATFORM_UNIX || PLATFORM_MAC
+		class FMultiplayUnixStreamSocket : public IMultiplayStreamSocket
+		{
+		public:
+			explicit FMultiplayUnixStreamSocket(int InDescriptor) : Descriptor(InDescriptor)
+			{
+			}
+
+			virtual ~FMultiplayUnixStreamSocket()
+			{
+				close(Descriptor);
+			}
+
+			virtual bool WaitForRead(const FTimespan& WaitTime) override
+			{
+				pollfd Poll;
+				Poll.fd = Descriptor;
+				Poll.events = POLLIN;
+				Poll.revents = 0;
+
+				// A hang up or error also counts as readable, so that the following Recv reports the connection as over.
+				return poll(&Poll, 1, static_cast<int>(WaitTime.GetTotalMilliseconds())) > 0;
+			}
+
+			virtual bool Recv(uint8* Data, int32 Length, int32& BytesRead) override
+			{
+				ssize_t Result;
+				do
+				{
+					Result = recv(Descriptor, Data, Length, 0);
+				} while (Result < 0 && errno == EINTR);
+
+				BytesRead = Result > 0 ? static_cast<int32>(Result) : 0;
+				return Result > 0;
+			}
+
+			virtual bool Send(const uint8* Data, int32 Length, int32& BytesSent) override
+			{
+#ifdef MSG_NOSIGNAL
+				const int Flags = MSG_NOSIGNAL;
+#else
+				const int Flags = 0;
+#endif
+				ssize_t Result;
+				do
+				{
+					Result = send(Descriptor, Data, Length, Flags);
+				} while (Result < 0 && errno == EINTR);
+
+				BytesSent = Result > 0 ? static_cast<int32>(Result) : 0;
+				return Result >= 0;
+			}
+
+			virtual int32 GetPollDescriptor() const override
+			{
+				return Descriptor;
+			}
+
+		private:
+			int Descriptor;
+		};
+#endif
+	} // namespace
+
+	TUniquePtr<IMultiplayStreamSocket> ConnectTcpSocket(const FString& Host, int32 Port, FString& OutError)
+	{
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+		TSharedPtr<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+
+		bool bIsValid = false;
+		Address->SetIp(*Host, bIsValid);
+
+		if (!bIsValid)
+		{
+#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 23
+			bIsValid = SocketSubsystem->GetHostByName(TCHAR_TO_ANSI(*Host), *Address) == SE_NO_ERROR;
+#else // UE 4.23+ resolves hosts with ISocketSubsystem::GetAddressInfo()
+			FAddressInfoResult Result = SocketSubsystem->GetAddressInfo(*Host, nullptr);
+			bIsValid = Result.ReturnCode == SE_NO_ERROR && Result.Results.Num() > 0;
+			if (bIsValid)
+			{
+				Address = Result.Results[0].Address;
+			}
+#endif
+		}
+
+		if (!bIsValid)
+		{
+			OutError = FString::Printf(TEXT("Failed to resolve '%s'."), *Host);
+			return nullptr;
+		}
+
+		Address->SetPort(Port);
+
+		FSocket* NewSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("MultiplayStreamSocket"), false);
+		if (NewSocket == nullptr)
+		{
+			OutError = TEXT("Failed to create a socket.");
+			return nullptr;
+		}
+
+		TUniquePtr<IMultiplayStreamSocket> Socket = MakeUnique<FMultiplayTcpStreamSocket>(NewSocket);
+
+		// Messages to the daemon are small, they should not wait for more data to fill a segment.
+		NewSocket->SetNoDelay(true);
+
+		if (!NewSocket->Connect(*Address))
+		{
+			OutError = FString::Printf(TEXT("Failed to connect to '%s'."), *Address->ToString(true));
+			return nullptr;
+		}
+
+		return Socket;
+	}
+
+	bool WaitForReadAny(TArrayView<IMultiplayStreamSocket* const> Sockets, const FTimespan& WaitTime)
+	{
+#if PLATFORM_UNIX || PLATFORM_MAC
+		TArray<pollfd, TInlineAllocator<8>> Polls;
+		for (IMultiplayStreamSocket* Socket : Sockets)
+		{
+			if (Socket->GetPollDescriptor() < 0)
+			{
+				break;
+			}
+
+			pollfd Poll;
+			Poll.fd = Socket->GetPollDescriptor();
+			Poll.events = POLLIN;
+			Poll.revents = 0;
+			Polls.Add(Poll);
+		}
+
+		if (Polls.Num() == Sockets.Num())
+		{
+			return poll(Polls.GetData(), Polls.Num(), static_cast<int>(WaitTime.GetTotalMilliseconds())) > 0;
+		}
+#endif
+
+		const FTimespan EachWaitTime = FTimespan::FromMilliseconds(WaitTime.GetTotalMilliseconds() / FMath::Max(Sockets.Num(), 1));
+		for (IMultiplayStreamSocket* Socket : Sockets)
+		{
+			if (Socket->WaitForRead(EachWaitTime))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool IsUnixSocketSupported()
+	{
+#if PLATFORM_UNIX || PLATFORM_MAC
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	TUniquePtr<IMultiplayStreamSocket> ConnectUnixSocket(const FString& Path, FString& OutError)
+	{
+#if PLATFORM_UNIX || PLATFORM_MAC
+		sockaddr_un Address;
+		FMemory::Memzero(Address);
+		Address.sun_family = AF_UNIX;
+
+		FTCHARToUTF8 Converted(*Path);
+		if (Converted.Length() <= 0 || Converted.Length() >= static_cast<int32>(sizeof(Address.sun_path)))
+		{
+			OutError = FString::Printf(TEXT("'%s' is not a valid Unix domain socket path."), *Path);
+			return nullptr;
+		}
+
+		FMemory::Memcpy(Address.sun_path, Converted.Get(), Converted.Length());
+
+		const int Descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (Descriptor < 0)
+		{
+			OutError = FString::Printf(TEXT("Failed to create a Unix domain socket (errno %d)."), errno);
+			return nullptr;
+		}
+
+		TUniquePtr<IMultiplayStreamSocket> Socket = MakeUnique<FMultiplayUnixStreamSocket>(Descriptor);
+
+#if defined(SO_NOSIGPIPE)
+		// Platforms without MSG_NOSIGNAL suppress SIGPIPE per socket instead.
+		const int NoSigPipe = 1;
+		setsockopt(Descriptor, SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif
+
+		if (connect(Descriptor, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0)
+		{
+			OutError = FString::Printf(TEXT("Failed to connect to '%s' (errno %d)."), *Path, errno);
+			return nullptr;
+		}
+
+		return Socket;
+#else
+		OutError = TEXT("Unix domain sockets are not supported on this platform.");
+		return nullptr;
+#endif
+	}
+} // namespace Multiplay
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Multiplay
+{
+	// A connected, blocking stream socket to the SDK daemon, over TCP or a Unix domain socket. The socket is closed on destruction.
+	class IMultiplayStreamSocket
+	{
+	public:
+		virtual ~IMultiplayStreamSocket() {}
+
+		// Returns true if data can be read without blocking, waiting at most WaitTime.
+		virtual bool WaitForRead(const FTimespan& WaitTime) = 0;
+
+		// Returns false if the read failed or the peer closed the connection.
+		virtual bool Recv(uint8* Data, int32 Length, int32& BytesRead) = 0;
+
+		virtual bool Send(const uint8* Data, int32 Length, int32& BytesSent) = 0;
+
+		// The descriptor WaitForReadAny polls, -1 if the socket can only be waited on by itself.
+		virtual int32 GetPollDescriptor() const { return -1; }
+	};
+
+	// Returns true if any of the sockets can be read without blocking, waiting at most WaitTime. Sockets with a poll
+	// descriptor are waited on together, the others in turn.
+	bool WaitForReadAny(TArrayView<IMultiplayStreamSocket* const> Sockets, const FTimespan& WaitTime);
+
+	// Connects to Host:Port over TCP with Nagle's algorithm disabled, returns null and sets OutError on failure.
+	TUniquePtr<IMultiplayStreamSocket> ConnectTcpSocket(const FString& Host, int32 Port, FString& OutError);
+
+	// Returns true if this platform can connect to Unix domain sockets.
+	bool IsUnixSocketSupported();
+
+	// Connects to the Unix domain socket at Path, returns null and sets OutError on failure.
+	TUniquePtr<IMultiplayStreamSocket> ConnectUnixSocket(const FString& Path, FString& OutError);
+} // namespace Multiplay
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+namespace Multiplay
+{
+#if ENGINE_MAJOR_VERSION == 5
+	// FTickerObjectBase was replaced by the thread-safe FTSTickerObjectBase in UE 5.0.
+	using FMultiplayTickerObjectBase = FTSTickerObjectBase;
+#else
+	using FMultiplayTickerObjectBase = FTickerObjectBase;
+#endif
+} // namespace Multiplay
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayAllocationTimeline.generated.h"
+
+/**
+ * The time each stage between receiving an allocation and the server being ready for players was reached.
+ * Times are in milliseconds since the allocation message was received, a negative time means the stage was not reached.
+ */
+USTRUCT(BlueprintType)
+struct MULTIPLAYGAMESERVERSDK_API FMultiplayAllocationTimeline
+{
+    GENERATED_BODY()
+
+    /**
+     * The unique UUID of the allocation.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    FString AllocationId;
+
+    /**
+     * When the allocation message had been parsed into an event.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    float EventParsedMs = -1.0f;
+
+    /**
+     * When OnAllocate started being broadcast.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    float AllocateBroadcastMs = -1.0f;
+
+    /**
+     * When the game first requested the allocation payload.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    float PayloadRequestedMs = -1.0f;
+
+    /**
+     * When the allocation payload was first handed to the game.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    float PayloadReceivedMs = -1.0f;
+
+    /**
+     * When the game first called ReadyServerForPlayers.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    float ReadyRequestedMs = -1.0f;
+
+    /**
+     * When the Multiplay SDK daemon acknowledged the server as ready, which completes the timeline.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    float ReadyAcknowledgedMs = -1.0f;
+};
+
+/**
+ * Percentiles of the allocation timelines completed most recently.
+ */
+USTRUCT(BlueprintType)
+struct MULTIPLAYGAMESERVERSDK_API FMultiplayAllocationTimelineStats
+{
+    GENERATED_BODY()
+
+    /**
+     * The number of allocations that reached the ready acknowledgement.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    int64 CompletedAllocations = 0;
+
+    /**
+     * The number of allocations that were deallocated or replaced before the ready acknowledgement.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    int64 AbandonedAllocations = 0;
+
+    /**
+     * The number of completed timelines the percentiles are computed from.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    int32 SampleCount = 0;
+
+    /**
+     * The median time of each stage. Each stage is computed independently over the timelines that reached it.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    FMultiplayAllocationTimeline P50;
+
+    /**
+     * The 90th percentile time of each stage.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    FMultiplayAllocationTimeline P90;
+
+    /**
+     * The 99th percentile time of each stage.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Timeline")
+    FMultiplayAllocationTimeline P99;
+};
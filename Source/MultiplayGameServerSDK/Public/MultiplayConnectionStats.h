@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayConnectionStats.generated.h"
+
+/**
+ * Connection reuse statistics for the HTTP calls made to the Multiplay SDK daemon.
+ * A call is counted as warm if the daemon answered a request less than two warmup intervals before it was sent, so that its connection was still open.
+ */
+USTRUCT(BlueprintType)
+struct MULTIPLAYGAMESERVERSDK_API FMultiplayConnectionStats
+{
+    GENERATED_BODY()
+
+    /**
+     * The number of requests sent only to keep the connection to the daemon open.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Connection")
+    int64 WarmupRequests = 0;
+
+    /**
+     * The number of warmup requests that the daemon did not answer.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Connection")
+    int64 WarmupFailures = 0;
+
+    /**
+     * The number of calls sent while the connection was warm.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Connection")
+    int64 WarmCalls = 0;
+
+    /**
+     * The number of calls sent while the connection may have needed to be re-established.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Connection")
+    int64 ColdCalls = 0;
+
+    /**
+     * The mean duration of warm calls in milliseconds.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Connection")
+    float MeanWarmCallMs = 0.0f;
+
+    /**
+     * The mean duration of cold calls in milliseconds.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Connection")
+    float MeanColdCallMs = 0.0f;
+};
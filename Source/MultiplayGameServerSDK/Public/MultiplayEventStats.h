@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayEventStats.generated.h"
+
+/**
+ * Counts of the server events received from the Multiplay SDK daemon.
+ */
+USTRUCT(BlueprintType)
+struct MULTIPLAYGAMESERVERSDK_API FMultiplayEventStats
+{
+    GENERATED_BODY()
+
+    /**
+     * The number of allocation and deallocation events broadcast.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Events")
+    int64 UniqueEvents = 0;
+
+    /**
+     * The number of allocation and deallocation events dropped because an event with the same ID had already been broadcast.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Events")
+    int64 DuplicateEvents = 0;
+};
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "MultiplayGameServerSettings.generated.h"
+
+/**
+ * Project settings for the Multiplay Game Server SDK, stored in the [/Script/MultiplayGameServerSDK.MultiplayGameServerSettings] section of DefaultGame.ini.
+ * Shown in the Plugins category of the Project Settings.
+ */
+UCLASS(config=Game, defaultconfig, meta=(DisplayName="Multiplay Game Server SDK"))
+class MULTIPLAYGAMESERVERSDK_API UMultiplayGameServerSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	/**
+	 * Whether the connection to the Multiplay SDK daemon is periodically pinged to measure latency and detect a dead link.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Keepalive")
+	bool bEnableKeepalive = false;
+
+	/**
+	 * The number of seconds between keepalive pings.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Keepalive", meta=(ClampMin="0.1", EditCondition="bEnableKeepalive"))
+	float KeepaliveIntervalSeconds = 5.0f;
+
+	/**
+	 * The number of consecutive intervals without a pong after which the connection is considered dead and re-established.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Keepalive", meta=(ClampMin="1", EditCondition="bEnableKeepalive"))
+	int32 KeepaliveMaxMissedPongs = 3;
+
+	/**
+	 * The longest delay in seconds between attempts to re-establish a lost connection. The first attempt waits one keepalive interval and each further attempt waits twice as long.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Keepalive", meta=(ClampMin="0.1", EditCondition="bEnableKeepalive"))
+	float KeepaliveMaxReconnectDelaySeconds = 30.0f;
+
+	/**
+	 * Whether ReadyServerForPlayers, UnreadyServer, GetPayloadAllocation and GetPayloadToken are sent as RPCs over the existing connection to the Multiplay SDK daemon.
+	 * Operations fall back to HTTP when the connection is unavailable, the RPC fails, or the daemon does not support RPCs.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Transport")
+	bool bUseRpcTransport = false;
+
+	/**
+	 * The number of seconds to wait for an RPC reply before retrying the operation over HTTP.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Transport", meta=(ClampMin="0.1", EditCondition="bUseRpcTransport"))
+	float RpcTimeoutSeconds = 2.0f;
+
+	/**
+	 * Whether the connection to the Multiplay SDK daemon uses the built-in websocket client instead of the engine WebSockets module.
+	 * The built-in client answers pings and the close handshake on its own thread. Server events are still handled on the game thread.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Transport")
+	bool bUseBuiltInWebSocket = false;
+
+	/**
+	 * The path of a Unix domain socket the Multiplay SDK daemon listens on. When set, the connection to the daemon and the game server and payload operations use the socket instead of TCP.
+	 * An operation that cannot be exchanged over the socket falls back to TCP. Ignored on platforms without Unix domain sockets.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Transport")
+	FString DaemonSocketPath;
+
+	/**
+	 * Whether a connection to the Multiplay SDK daemon is opened at initialization and kept open while the server idles, so that HTTP calls do not wait for connection setup.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Transport")
+	bool bKeepDaemonConnectionWarm = false;
+
+	/**
+	 * The number of seconds without a call to the daemon after which a request is sent to keep the connection open.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Transport", meta=(ClampMin="0.1", EditCondition="bKeepDaemonConnectionWarm"))
+	float DaemonConnectionWarmupIntervalSeconds = 10.0f;
+
+	/**
+	 * Whether every game instance in the process shares one connection to the Multiplay SDK daemon and one thread answering server queries, for processes hosting several servers.
+	 * Each game instance must then read its own server.json, see UMultiplayServerConfigSubsystem::ResolveServerJsonPath.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Transport")
+	bool bShareSdkCore = false;
+
+	/**
+	 * Whether operations sent over HTTP are retried, fail after a deadline, and fail early while the daemon keeps failing.
+	 * Without it, each operation is sent over HTTP once and waits for the HTTP module to time out.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry")
+	bool bEnableRetries = false;
+
+	/**
+	 * The maximum number of times an operation is sent over HTTP, 1 disables retries.
+	 * Only operations that are safe to repeat are retried, and only after a timeout, a connection failure or a server error.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="1", EditCondition="bEnableRetries"))
+	int32 RetryMaxAttempts = 4;
+
+	/**
+	 * The minimum number of seconds to wait before retrying an operation.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0", EditCondition="bEnableRetries"))
+	float RetryBaseDelaySeconds = 0.1f;
+
+	/**
+	 * The maximum number of seconds to wait before retrying an operation. The delay is randomized between the minimum and three times the previous delay.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0", EditCondition="bEnableRetries"))
+	float RetryMaxDelaySeconds = 2.0f;
+
+	/**
+	 * The number of seconds after which ReadyServerForPlayers fails, retries included.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0.1", EditCondition="bEnableRetries"))
+	float ReadyServerDeadlineSeconds = 10.0f;
+
+	/**
+	 * The number of seconds after which UnreadyServer fails, retries included.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0.1", EditCondition="bEnableRetries"))
+	float UnreadyServerDeadlineSeconds = 10.0f;
+
+	/**
+	 * The number of seconds after which GetPayloadAllocation fails, retries included.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0.1", EditCondition="bEnableRetries"))
+	float PayloadAllocationDeadlineSeconds = 15.0f;
+
+	/**
+	 * The number of seconds after which GetPayloadToken fails, retries included.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0.1", EditCondition="bEnableRetries"))
+	float PayloadTokenDeadlineSeconds = 5.0f;
+
+	/**
+	 * The number of consecutive failed calls after which calls to the SDK daemon fail without being sent, 0 never fails calls early.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0", EditCondition="bEnableRetries"))
+	int32 CircuitBreakerFailureThreshold = 5;
+
+	/**
+	 * The number of seconds calls fail without being sent before a single call is let through to check whether the daemon has recovered.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0", EditCondition="bEnableRetries"))
+	float CircuitBreakerOpenSeconds = 5.0f;
+
+	/**
+	 * Whether ReadyServerForPlayers sends a second identical HTTP request when the first is slower than usual, completing with whichever succeeds first.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry")
+	bool bHedgeReadyServer = false;
+
+	/**
+	 * The percentile of the ready latencies observed so far after which a ready request is sent a second time.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0", ClampMax="100", EditCondition="bHedgeReadyServer"))
+	float ReadyServerHedgePercentile = 95.0f;
+
+	/**
+	 * The number of seconds after which a ready request is sent a second time, until enough ready latencies have been observed to use the percentile.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Retry", meta=(ClampMin="0", EditCondition="bHedgeReadyServer"))
+	float ReadyServerHedgeInitialDelaySeconds = 0.25f;
+
+	/**
+	 * Whether ReadyServerForPlayers and UnreadyServer declare the readiness the server should have rather than each sending a request.
+	 * Only the latest declaration is sent once the request in flight completes, and declaring the readiness the daemon has already confirmed sends nothing.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Readiness")
+	bool bReconcileReadiness = false;
+
+	/**
+	 * The number of seconds after which a declaration whose request failed is sent again while it is still the declared readiness.
+	 * The delay doubles after every consecutive failure. Only used when bEnableRetries is not set, as the requests are otherwise retried by the transport.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Readiness", meta=(ClampMin="0", EditCondition="bReconcileReadiness"))
+	float ReadinessResendBaseDelaySeconds = 1.0f;
+
+	/**
+	 * The maximum number of seconds between two sends of a declaration whose requests keep failing.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Readiness", meta=(ClampMin="0", EditCondition="bReconcileReadiness"))
+	float ReadinessResendMaxDelaySeconds = 30.0f;
+
+	/**
+	 * Whether the allocation payload and payload token are fetched as soon as the server is allocated.
+	 * The payload is kept until the server is deallocated and the token is kept in the token cache, so GetPayloadAllocation and GetPayloadToken complete from memory.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Payload")
+	bool bPrefetchPayloadOnAllocate = false;
+
+	/**
+	 * Whether the payload token is kept in memory until shortly before it expires, so GetPayloadToken completes without contacting the daemon.
+	 * The cached token is replaced in the background before it stops being served. Always enabled when bPrefetchPayloadOnAllocate is set.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Payload")
+	bool bCachePayloadToken = false;
+
+	/**
+	 * The number of seconds before its expiry at which a cached payload token stops being served.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Payload", meta=(ClampMin="0"))
+	float PayloadTokenExpiryMarginSeconds = 30.0f;
+
+	/**
+	 * The number of seconds before a cached payload token stops being served at which a replacement is fetched in the background.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Payload", meta=(ClampMin="0"))
+	float PayloadTokenRefreshAheadSeconds = 60.0f;
+
+	/**
+	 * The size in bytes above which an allocation payload is moved to a memory-mapped temporary file instead of being kept on the heap, 0 keeps every payload on the heap.
+	 * The file is written on the game thread as the payload is received, which stalls the frame for as long as the write takes.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Payload", meta=(ClampMin="0"))
+	int64 PayloadSpillThresholdBytes = 0;
+
+	/**
+	 * Whether to ask the SDK daemon for the allocation payload compressed with gzip, which is decompressed on arrival.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Payload")
+	bool bAcceptCompressedPayload = false;
+
+	/**
+	 * The size in bytes above which a compressed allocation payload is rejected rather than decompressed.
+	 * Values above 2147483647 are treated as that limit, as the payload is held in a single array.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Payload", meta=(ClampMin="1", ClampMax="2147483647", EditCondition="bAcceptCompressedPayload"))
+	int64 PayloadMaxDecompressedBytes = 64 * 1024 * 1024;
+
+	/**
+	 * Whether SDK logs are written to rotated files in the server log directory by a background thread instead of through UE_LOG.
+	 * Warnings and errors are still also logged through UE_LOG.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Logging")
+	bool bEnableLogSink = false;
+
+	/**
+	 * The least severe verbosity written to the SDK log files, such as Log, Verbose or VeryVerbose.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Logging", meta=(EditCondition="bEnableLogSink"))
+	FString LogSinkVerbosity = TEXT("Log");
+
+	/**
+	 * The size in bytes at which the SDK log file is rotated.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Logging", meta=(ClampMin="65536", EditCondition="bEnableLogSink"))
+	int64 LogSinkMaxFileBytes = 16 * 1024 * 1024;
+
+	/**
+	 * The number of SDK log files kept, including the one being written.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Logging", meta=(ClampMin="1", EditCondition="bEnableLogSink"))
+	int32 LogSinkMaxFiles = 4;
+
+	/**
+	 * The number of messages that can be queued for the log writer, messages logged while it is full are dropped.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Logging", meta=(ClampMin="2", EditCondition="bEnableLogSink"))
+	int32 LogSinkCapacity = 4096;
+
+	/**
+	 * Whether server.json is watched and reloaded when it changes, so that a server the Multiplay agent recycles takes on its new server ID, query port and log directory without restarting the process.
+	 * On Linux the file is watched with inotify, on other platforms its modification time and size are compared every interval.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="ServerConfig")
+	bool bWatchServerJson = false;
+
+	/**
+	 * The number of seconds between checks for changes to server.json.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="ServerConfig", meta=(ClampMin="0.1", EditCondition="bWatchServerJson"))
+	float ServerJsonWatchIntervalSeconds = 1.0f;
+};
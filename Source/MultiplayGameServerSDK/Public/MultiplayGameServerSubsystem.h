@@ -7,10 +7,21 @@
 #include "MultiplayErrorResponse.h"
 #include "MultiplayPayloadAllocationErrorResponse.h"
 #include "MultiplayPayloadTokenResponse.h"
+#include "MultiplayPayloadBuffer.h"
+#include "MultiplayPingStats.h"
+#include "MultiplayConnectionStats.h"
+#include "MultiplayAllocationTimeline.h"
+#include "MultiplayStandbyState.h"
+#include "MultiplayEventStats.h"
+#include "MultiplayServerInstanceState.h"
+#include "MultiplayServerConfig.h"
 #include "MultiplayGameServerSubsystem.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAllocateDelegate, FMultiplayAllocation, Allocation);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDeallocateDelegate, FMultiplayDeallocation, Deallocation);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAllocationReadyDelegate, FMultiplayAllocationTimeline, Timeline);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FStandbyHotDelegate, float, WarmSeconds);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FServerRecycledDelegate, FMultiplayServerConfig, ServerConfig);
 
 DECLARE_DYNAMIC_DELEGATE(FReadyServerSuccessDelegate);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FReadyServerFailureDelegate, FMultiplayErrorResponse, ErrorResponse);
@@ -24,17 +35,35 @@ DECLARE_DYNAMIC_DELEGATE_OneParam(FPayloadAllocationFailureDelegate, FMultiplayP
 DECLARE_DYNAMIC_DELEGATE_OneParam(FPayloadTokenSuccessDelegate, FMultiplayPayloadTokenResponse, TokenResponse);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FPayloadTokenFailureDelegate, FMultiplayPayloadTokenResponse, ErrorResponse);
 
+DECLARE_DELEGATE_TwoParams(FPayloadAllocationBufferDelegate, FMultiplayPayloadBufferPtr /* Payload */, const FMultiplayPayloadAllocationErrorResponse& /* ErrorResponse */);
+
+class FJsonObject;
+struct FStreamableManager;
+
 namespace Multiplay
 {
-	class FCentrifugeClient;
-	class FConnectResult;
+	class FError;
+	class FHistoryResult;
 	class FPublication;
+	class FSubscribeResult;
+	class FMultiplayStreamRecovery;
+
+	enum class EMethodType;
 
-	class OpenAPIGameServerApi;
 	class ReadyServerResponse;
 	class UnreadyServerResponse;
 
-	class OpenAPIPayloadApi;
+	class FMultiplaySdkCore;
+	class FMultiplayRpcTransport;
+	class FMultiplayPayloadCache;
+	class FMultiplayPayloadTokenCache;
+	class FMultiplayReadinessReconciler;
+	class FMultiplayAllocationTimelineRecorder;
+	class FMultiplayWarmStandby;
+	class FMultiplayEventIdFilter;
+	class FMultiplayServerEventRouter;
+	class FMultiplayServerAllocateEvent;
+	class FMultiplayServerDeallocateEvent;
 	class PayloadAllocationResponse;
 	class PayloadTokenResponse;
 }
@@ -89,6 +118,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Multiplay | GameServer")
 	void UnsubscribeToServerEvents();
 
+	/**
+	 * @brief Handles server events of a type the SDK does not handle itself, such as one added by a newer Multiplay SDK daemon.
+	 * @param EventType The EventType field of the events to handle. A handler registered for the same type is replaced.
+	 * @param Handler Invoked on the game thread with each event of the type.
+	 * @return False if the SDK handles events of the type itself, in which case the handler is not registered.
+	 */
+	bool RegisterServerEventHandler(const FString& EventType, TFunction<void(const TSharedRef<FJsonObject>&)> Handler);
+
+	/**
+	 * @brief Removes the handler registered by RegisterServerEventHandler for the event type.
+	 * @param EventType The EventType field of the events the handler handles.
+	 */
+	void UnregisterServerEventHandler(const FString& EventType);
+
 	/**
 	 * @brief Retrieves the allocation payload.
 	 * @param OnSuccess This delegate will be invoked if the operation completes successfully.
@@ -97,6 +140,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Multiplay | GameServer")
 	void GetPayloadAllocation(FPayloadAllocationSuccessDelegate OnSuccess, FPayloadAllocationFailureDelegate OnFailure);
 
+	/**
+	 * @brief Retrieves the allocation payload as the UTF-8 bytes received from the Multiplay SDK daemon, without converting or copying them.
+	 * @param OnComplete This delegate will be invoked with the payload if the operation completes successfully, or with a null payload and the error response otherwise.
+	 */
+	void GetPayloadAllocationBuffer(FPayloadAllocationBufferDelegate OnComplete);
+
 	/**
 	 * @brief Retrieves a JWT token for payloads.
 	 * @param OnSuccess This delegate will be invoked if the operation completes successfully.
@@ -105,6 +154,84 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Multiplay | GameServer")
 	void GetPayloadToken(FPayloadTokenSuccessDelegate OnSuccess, FPayloadTokenFailureDelegate OnFailure);
 
+	/**
+	 * @brief Retrieves the round-trip time statistics gathered by the keepalive pings to the Multiplay SDK daemon.
+	 * @return The ping statistics, or default statistics if keepalive pings are disabled.
+	 */
+	UFUNCTION(BlueprintPure, Category="Multiplay | GameServer")
+	FMultiplayPingStats GetPingStats() const;
+
+	/**
+	 * @brief Retrieves how many HTTP calls to the Multiplay SDK daemon found its connection warm, and how long warm and cold calls took.
+	 * @return The connection statistics, or default statistics if the connection is not kept warm.
+	 */
+	UFUNCTION(BlueprintPure, Category="Multiplay | GameServer")
+	FMultiplayConnectionStats GetConnectionStats() const;
+
+	/**
+	 * @brief Retrieves how many allocation and deallocation events were broadcast, and how many were dropped as duplicates.
+	 * @return The event statistics.
+	 */
+	UFUNCTION(BlueprintPure, Category="Multiplay | GameServer")
+	FMultiplayEventStats GetEventStats() const;
+
+	/**
+	 * @brief Retrieves when each stage between receiving the most recent allocation and it being acknowledged as ready was reached.
+	 * @return The timeline of the allocation most recently acknowledged as ready, or a default timeline if none has been.
+	 */
+	UFUNCTION(BlueprintPure, Category="Multiplay | GameServer")
+	FMultiplayAllocationTimeline GetLastAllocationTimeline() const;
+
+	/**
+	 * @brief Retrieves the percentiles of each allocation stage over the allocations most recently acknowledged as ready.
+	 * @return The allocation timeline statistics.
+	 */
+	UFUNCTION(BlueprintPure, Category="Multiplay | GameServer")
+	FMultiplayAllocationTimelineStats GetAllocationTimelineStats() const;
+
+	/**
+	 * @brief Adds a task that prepares for the next allocation while the server waits for it. The task is started at once, and again each time the server is deallocated.
+	 * An allocation does not interrupt the task, use WhenStandbyHot to wait for the tasks that had not completed.
+	 * @param Name Identifies the task. A task added with the same name replaces it.
+	 * @param Task Performs the preload and invokes the function it is given once it has completed. Running it again should only redo what is no longer loaded.
+	 */
+	void AddStandbyTask(FName Name, TFunction<void(TFunction<void()>)> Task);
+
+	/**
+	 * @brief Adds a standby task that loads the assets asynchronously and keeps them loaded between allocations.
+	 * @param Name Identifies the task. A task added with the same name replaces it.
+	 * @param Assets The assets to load, such as the map packages the next allocation may use.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Multiplay | GameServer")
+	void AddStandbyAssets(FName Name, const TArray<FSoftObjectPath>& Assets);
+
+	/**
+	 * @brief Invokes the function once every standby task has completed, immediately if they already have.
+	 * @param OnHot The function to invoke.
+	 */
+	void WhenStandbyHot(TFunction<void()> OnHot);
+
+	/**
+	 * @brief Retrieves how far the server has come in preparing for its next allocation.
+	 * @return The standby state.
+	 */
+	UFUNCTION(BlueprintPure, Category="Multiplay | GameServer")
+	EMultiplayStandbyState GetStandbyState() const;
+
+	/**
+	 * @brief Retrieves a snapshot of the state of the server hosted by this game instance.
+	 * @return The server state.
+	 */
+	UFUNCTION(BlueprintPure, Category="Multiplay | GameServer")
+	FMultiplayServerInstanceState GetInstanceState() const;
+
+	/**
+	 * @brief Reloads server.json and prepares the SDK for the next allocation without restarting the process. Server events are subscribed on the channel of the reloaded server ID,
+	 * and the current allocation is forgotten without broadcasting OnDeallocate. Invoked whenever the server ID or log directory in server.json changes when bWatchServerJson is enabled.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Multiplay | GameServer")
+	void RecycleServer();
+
     /**
      * Delegate that is invoked when this server has been allocated.
      */
@@ -117,13 +244,44 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Multiplay | GameServer")
 	FDeallocateDelegate OnDeallocate;
 
+    /**
+     * Delegate that is invoked with the timeline of an allocation once the Multiplay SDK daemon has acknowledged it as ready.
+     */
+	UPROPERTY(BlueprintAssignable, Category="Multiplay | GameServer")
+	FAllocationReadyDelegate OnAllocationReady;
+
+    /**
+     * Delegate that is invoked each time every standby task has completed, with the seconds since they were started.
+     */
+	UPROPERTY(BlueprintAssignable, Category="Multiplay | GameServer")
+	FStandbyHotDelegate OnStandbyHot;
+
+    /**
+     * Delegate that is invoked once the SDK has been recycled, with the server configuration it was recycled for.
+     */
+	UPROPERTY(BlueprintAssignable, Category="Multiplay | GameServer")
+	FServerRecycledDelegate OnServerRecycled;
+
 private:
 	
 	/**
-	 * @brief Calls when connection messages have been received. 
-	 * @param Reply The message body.
+	 * @brief Calls when subscription messages have been received. Starts recovering publications missed before a restart.
+	 * @param Result The message body.
+	 */
+	void OnSubscribeReply(const Multiplay::FSubscribeResult& Result);
+
+	/**
+	 * @brief Calls when history messages have been received. Replays the publications missed before a restart.
+	 * @param Result The message body.
 	 */
-	void OnConnectReply(const Multiplay::FConnectResult& Reply);
+	void OnHistoryReply(const Multiplay::FHistoryResult& Result);
+
+	/**
+	 * @brief Calls when a command has been rejected by the Multiplay SDK daemon.
+	 * @param Method The method of the rejected command.
+	 * @param Error The error body.
+	 */
+	void OnErrorReply(Multiplay::EMethodType Method, const Multiplay::FError& Error);
 
 	/**
 	 * @brief Calls when push messages have been received. Interprets the message as a server event. 
@@ -131,95 +289,185 @@ private:
 	 */
 	void OnPublicationPush(const Multiplay::FPublication& Push);
 
+	/**
+	 * @brief Passes a publication to the handler for its event type and records it as consumed.
+	 * @param Publication The publication to consume.
+	 */
+	void ConsumePublication(const Multiplay::FPublication& Publication);
+
+	/**
+	 * @brief Calls when an allocation event has been received. Broadcasts OnAllocate unless the event has already been broadcast.
+	 * @param AllocateEvent The event.
+	 */
+	void OnAllocateEvent(const Multiplay::FMultiplayServerAllocateEvent& AllocateEvent);
+
+	/**
+	 * @brief Calls when a deallocation event has been received. Broadcasts OnDeallocate unless the event has already been broadcast.
+	 * @param DeallocateEvent The event.
+	 */
+	void OnDeallocateEvent(const Multiplay::FMultiplayServerDeallocateEvent& DeallocateEvent);
+
+	/**
+	 * @brief Retrieves the name of the channel on which server events are published.
+	 * @return The channel name, formatted as server#<serverid>.
+	 */
+	FString GetServerChannel() const;
+
+	/**
+	 * @brief Retrieves the path at which the position of the last consumed publication is persisted.
+	 * @return The path in the server log directory, empty when there is no server log directory.
+	 */
+	FString GetCheckpointPath() const;
+
+	/**
+	 * @brief Opens the SDK log sink in the server log directory when it is enabled.
+	 */
+	void OpenLogSink();
+
+	/**
+	 * @brief Calls when the server configuration has been reloaded. Recycles the SDK if the server ID or log directory changed.
+	 * @param PreviousConfig The configuration before it was reloaded.
+	 * @param ServerConfig The reloaded configuration.
+	 */
+	void OnServerConfigChanged(const FMultiplayServerConfig& PreviousConfig, const FMultiplayServerConfig& ServerConfig);
+
+	/**
+	 * @brief Forgets the current allocation, and moves the subscription, stream position and caches over to the current server configuration.
+	 * @param PreviousConfig The configuration the SDK state was kept for.
+	 */
+	void Recycle(const FMultiplayServerConfig& PreviousConfig);
+
 private:
+	/**
+	 * @brief Moves the server to the given readiness, through the readiness reconciler when it is enabled.
+	 * @param bReady Whether the server should be ready for players.
+	 * @param OnComplete Invoked with whether the readiness was reached and the error response if it was not.
+	 */
+	void SetReadiness(bool bReady, TFunction<void(bool, const FMultiplayErrorResponse&)> OnComplete);
+
+	/**
+	 * @brief Sends the ReadyServer or UnreadyServer request.
+	 * @param bReady Whether to send the ReadyServer request.
+	 * @param OnComplete Invoked with whether the request was successful and the error response if it was not.
+	 */
+	void SendReadiness(bool bReady, TFunction<void(bool, const FMultiplayErrorResponse&)> OnComplete);
+
 	/**
 	 * @brief Callback invoked when we have received a response to the ReadyServer request.
 	 * @param Response The response body.
+	 * @param OnComplete The function passed to the call that issued the request.
 	 */
-	void OnReadyServer(const Multiplay::ReadyServerResponse& Response);
+	void OnReadyServer(const Multiplay::ReadyServerResponse& Response, TFunction<void(bool, const FMultiplayErrorResponse&)> OnComplete);
 
 	/**
 	 * @brief Callback invoked when we have received a response to the UnreadyServer request.
 	 * @param Response The response body.
+	 * @param OnComplete The function passed to the call that issued the request.
 	 */
-	void OnUnreadyServer(const Multiplay::UnreadyServerResponse& Response);
+	void OnUnreadyServer(const Multiplay::UnreadyServerResponse& Response, TFunction<void(bool, const FMultiplayErrorResponse&)> OnComplete);
+
+	/**
+	 * @brief Completes the timeline of an allocation acknowledged as ready and broadcasts it.
+	 * @param ReadyAllocationId The allocation ReadyServerForPlayers was called for.
+	 */
+	void OnReadyAcknowledged(const FGuid& ReadyAllocationId);
 
 private:
 	/**
 	 * @brief Callback invoked when we have received a response to the PayloadAllocation request.
 	 * @param Response The response body.
+	 * @param OnComplete The delegate passed to the call that issued the request.
+	 * @param RequestedAllocationId The allocation the payload was requested for.
+	 */
+	void OnPayloadAllocationBuffer(const Multiplay::PayloadAllocationResponse& Response, FPayloadAllocationBufferDelegate OnComplete, FGuid RequestedAllocationId);
+
+	/**
+	 * @brief Callback invoked when the payload requested by GetPayloadAllocation has been received, converts it for Blueprint.
+	 * @param Payload The payload, null if the request was unsuccessful.
+	 * @param ErrorResponse The error response if the request was unsuccessful.
+	 * @param OnSuccess The delegate passed to the call that issued the request.
+	 * @param OnFailure The delegate passed to the call that issued the request.
 	 */
-	void OnPayloadAllocation(const Multiplay::PayloadAllocationResponse& Response);
+	void OnPayloadAllocation(FMultiplayPayloadBufferPtr Payload, const FMultiplayPayloadAllocationErrorResponse& ErrorResponse, FPayloadAllocationSuccessDelegate OnSuccess, FPayloadAllocationFailureDelegate OnFailure);
 
 	/**
 	 * @brief Callback invoked when we have received a response to the PayloadToken request.
 	 * @param Response The response body.
+	 * @param OnSuccess The delegate passed to the call that issued the request.
+	 * @param OnFailure The delegate passed to the call that issued the request.
 	 */
-	void OnPayloadToken(const Multiplay::PayloadTokenResponse& Response);
+	void OnPayloadToken(const Multiplay::PayloadTokenResponse& Response, FPayloadTokenSuccessDelegate OnSuccess, FPayloadTokenFailureDelegate OnFailure);
 
 private:
     /**
-     * Holds a reference to the delegate that will be invoked when ReadyServer is successful.
+     * Owns the connection to the Multiplay SDK daemon and the clients of its APIs, shared with the other game instances in the process when enabled.
+     */
+	TSharedPtr<Multiplay::FMultiplaySdkCore> SdkCore;
+
+    /**
+     * The channel subscribed to through the SDK core, empty when not subscribed to server events.
+     */
+	FString SubscribedChannel;
+
+    /**
+     * Tracks the last consumed publication so that missed publications can be replayed after a restart.
+     */
+	TUniquePtr<Multiplay::FMultiplayStreamRecovery> StreamRecovery;
+
+    /**
+     * The transport of the SDK core. Carries the game server and payload operations over the Centrifuge connection when enabled, or over the OpenAPI clients otherwise.
      */
-	UPROPERTY()
-	FReadyServerSuccessDelegate OnReadyServerSuccess;
+	TSharedPtr<Multiplay::FMultiplayRpcTransport> RpcTransport;
 
     /**
-     * Holds a reference to the delegate that will be invoked when ReadyServer is unsuccessful.
+     * Holds the payload and token fetched for the current allocation when prefetching is enabled.
      */
-	UPROPERTY()
-	FReadyServerFailureDelegate OnReadyServerFailure;
+	TSharedPtr<Multiplay::FMultiplayPayloadCache> PayloadCache;
 
     /**
-     * Holds a reference to the delegate that will be invoked when UnreadyServer is successful.
+     * Holds the payload token until shortly before it expires when token caching or prefetching is enabled.
      */
-	UPROPERTY()
-	FUnreadyServerSuccessDelegate OnUnreadyServerSuccess;
+	TSharedPtr<Multiplay::FMultiplayPayloadTokenCache> PayloadTokenCache;
 
     /**
-     * Holds a reference to the delegate that will be invoked when UnreadyServer is unsuccessful.
+     * Collapses ReadyServerForPlayers and UnreadyServer calls into the minimal requests when enabled.
      */
-	UPROPERTY()
-	FUnreadyServerFailureDelegate OnUnreadyServerFailure;
+	TSharedPtr<Multiplay::FMultiplayReadinessReconciler> ReadinessReconciler;
 
     /**
-     * Holds a reference to the delegate that will be invoked when PayloadAllocation is successful.
+     * Records when each allocation reached each stage on its way to being ready for players.
      */
-	UPROPERTY()
-	FPayloadAllocationSuccessDelegate OnPayloadAllocationSuccess;
+	TUniquePtr<Multiplay::FMultiplayAllocationTimelineRecorder> AllocationTimeline;
 
     /**
-     * Holds a reference to the delegate that will be invoked when PayloadAllocation is unsuccessful.
+     * Passes each server event to the handler registered for its type.
      */
-	UPROPERTY()
-	FPayloadAllocationFailureDelegate OnPayloadAllocationFailure;
+	TUniquePtr<Multiplay::FMultiplayServerEventRouter> EventRouter;
 
     /**
-     * Holds a reference to the delegate that will be invoked when PayloadToken is successful.
+     * Drops allocation and deallocation events that have already been broadcast.
      */
-	UPROPERTY()
-	FPayloadTokenSuccessDelegate OnPayloadTokenSuccess;
+	TUniquePtr<Multiplay::FMultiplayEventIdFilter> EventIdFilter;
 
     /**
-     * Holds a reference to the delegate that will be invoked when PayloadToken is unsuccessful.
+     * Runs the standby tasks while the server is unallocated.
      */
-	UPROPERTY()
-	FPayloadTokenFailureDelegate OnPayloadTokenFailure;
+	TSharedPtr<Multiplay::FMultiplayWarmStandby> WarmStandby;
 
     /**
-     * A reference to the client's connection to Centrifuge.
+     * Loads the assets of the standby tasks added by AddStandbyAssets.
      */
-	TUniquePtr<Multiplay::FCentrifugeClient> CentrifugeClient;
+	TUniquePtr<FStreamableManager> StandbyStreamableManager;
 
     /**
-     * A reference to the OpenAPI Game Server API.
+     * Whether this subsystem opened the SDK log sink and closes it when deinitialized.
      */
-	TUniquePtr<Multiplay::OpenAPIGameServerApi> GameServerApi;
+	bool bLogSinkOpened = false;
 
     /**
-     * A reference to the OpenAPI Payload API.
+     * Whether RecycleServer is reloading the server configuration, the change is then recycled by RecycleServer itself.
      */
-	TUniquePtr<Multiplay::OpenAPIPayloadApi> PayloadApi;
+	bool bRecycling = false;
 
     /**
      * The unique UUID of the allocation.
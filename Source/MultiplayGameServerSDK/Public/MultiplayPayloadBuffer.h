@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Templates/Function.h"
+
+/**
+ * An immutable allocation payload as received from the Multiplay SDK daemon, in UTF-8.
+ * The bytes are owned by the HTTP response that carried them, by the buffer itself, or by a memory-mapped temporary file, and are never copied on delivery.
+ * Buffers may be shared across threads.
+ */
+class MULTIPLAYGAMESERVERSDK_API FMultiplayPayloadBuffer
+{
+public:
+	/**
+	 * The default number of bytes handed to a parser by ForEachChunk.
+	 */
+	static constexpr int32 kDefaultChunkSize = 64 * 1024;
+
+public:
+	virtual ~FMultiplayPayloadBuffer() {}
+
+	/**
+	 * @brief Retrieves the payload bytes, valid for the lifetime of the buffer.
+	 * @return A view of the payload bytes.
+	 */
+	virtual TArrayView<const uint8> GetBytes() const = 0;
+
+	/**
+	 * @brief Whether the payload is held in a memory-mapped temporary file rather than on the heap.
+	 */
+	virtual bool IsMapped() const { return false; }
+
+	/**
+	 * @brief Retrieves the size of the payload in bytes.
+	 */
+	int32 Num() const { return GetBytes().Num(); }
+
+	/**
+	 * @brief Converts the payload to a string, which copies it.
+	 * @return The payload as a string.
+	 */
+	FString ToString() const;
+
+	/**
+	 * @brief Hands the payload to an incremental parser in consecutive chunks, so that it can be consumed without materializing a copy.
+	 * @param ChunkSize The maximum number of bytes in a chunk.
+	 * @param Parser Invoked with each chunk in order, returns false to stop.
+	 * @return True if the parser consumed every chunk, false if it stopped early.
+	 */
+	bool ForEachChunk(int32 ChunkSize, TFunctionRef<bool(TArrayView<const uint8> Chunk)> Parser) const;
+};
+
+using FMultiplayPayloadBufferPtr = TSharedPtr<const FMultiplayPayloadBuffer, ESPMode::ThreadSafe>;
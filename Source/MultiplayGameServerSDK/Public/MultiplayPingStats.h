@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayPingStats.generated.h"
+
+/**
+ * Round-trip time statistics for the connection to the Multiplay SDK daemon.
+ */
+USTRUCT(BlueprintType)
+struct MULTIPLAYGAMESERVERSDK_API FMultiplayPingStats
+{
+    GENERATED_BODY()
+
+    /**
+     * The number of pings sent to the daemon.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    int64 PingsSent = 0;
+
+    /**
+     * The number of pongs received from the daemon.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    int64 PongsReceived = 0;
+
+    /**
+     * The number of consecutive keepalive intervals that have elapsed without a pong.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    int32 MissedPongs = 0;
+
+    /**
+     * The number of times the connection was re-established because the daemon stopped answering pings.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    int64 Reconnects = 0;
+
+    /**
+     * The most recent round-trip time in milliseconds.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    float LastRttMs = 0.0f;
+
+    /**
+     * The smallest round-trip time in milliseconds.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    float MinRttMs = 0.0f;
+
+    /**
+     * The mean round-trip time in milliseconds.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    float MeanRttMs = 0.0f;
+
+    /**
+     * The largest round-trip time in milliseconds.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    float MaxRttMs = 0.0f;
+
+    /**
+     * The upper bound of the histogram bucket containing the 99th percentile round-trip time in milliseconds.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    float P99RttMs = 0.0f;
+
+    /**
+     * The inclusive upper bound in milliseconds of each histogram bucket. The final bucket, which has no upper bound, is not listed.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    TArray<float> BucketUpperBoundsMs;
+
+    /**
+     * The number of round-trip times recorded in each histogram bucket. Contains one more entry than BucketUpperBoundsMs.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Ping")
+    TArray<int64> BucketCounts;
+};
@@ -5,6 +5,14 @@
 #include "MultiplayServerConfig.h"
 #include "MultiplayServerConfigSubsystem.generated.h"
 
+DECLARE_DELEGATE_RetVal_OneParam(FString, FResolveServerJsonPathDelegate, const UGameInstance* /* GameInstance */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FServerConfigChangedEvent, const FMultiplayServerConfig& /* PreviousConfig */, const FMultiplayServerConfig& /* ServerConfig */);
+
+namespace Multiplay
+{
+	class FMultiplayFileWatcher;
+}
+
 /**
  * Subsystem responsible for retrieving the Multiplay server configuration.
  */
@@ -15,6 +23,7 @@ class MULTIPLAYGAMESERVERSDK_API UMultiplayServerConfigSubsystem : public UGameI
 
 public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
 
     /**
      * @brief Accessor for the server configuration.
@@ -22,10 +31,55 @@ public:
      */
     const FMultiplayServerConfig& GetServerConfig() const;
 
+    /**
+     * @brief Reads server.json again and replaces the server configuration if it changed. The configuration is only replaced once the whole file has been read, a file that cannot be read keeps the previous configuration.
+     * Invoked whenever server.json changes when bWatchServerJson is enabled.
+     * @return True if the server configuration changed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Multiplay | ServerConfig")
+    bool ReloadServerConfig();
+
+    /**
+     * @brief Event broadcast with the previous and the reloaded configuration each time the server configuration changes.
+     */
+    FServerConfigChangedEvent& OnServerConfigChanged() { return ServerConfigChangedEvent; }
+
+    /**
+     * Resolves the path of the server.json read by a game instance, for processes hosting a server per game instance.
+     * Must be bound before the game instances are initialized. The server.json in the home directory is read when it is unbound or returns an empty path.
+     */
+    static FResolveServerJsonPathDelegate ResolveServerJsonPath;
+
+private:
+    /**
+     * @brief Retrieves the path of the server.json read by this game instance.
+     * @return The path resolved by ResolveServerJsonPath, or the server.json in the home directory.
+     */
+    FString GetServerJsonPath() const;
+
+    /**
+     * @brief Reads the server configuration from server.json.
+     * @param OutConfig Receives the configuration, left unchanged if the file could not be read.
+     * @return True if the file was read.
+     */
+    bool ReadServerJson(FMultiplayServerConfig& OutConfig) const;
+
 private:
     /**
      * The server configuration for the current session.
      */
     UPROPERTY(BlueprintReadOnly, Category="Multiplay | ServerConfig", meta = (AllowPrivateAccess = "true"))
     FMultiplayServerConfig ServerConfig;
+
+    /**
+     * The path of the server.json read by this game instance.
+     */
+    FString ServerJsonPath;
+
+    /**
+     * Reloads the server configuration whenever server.json changes, when enabled.
+     */
+    TSharedPtr<Multiplay::FMultiplayFileWatcher> ServerJsonWatcher;
+
+    FServerConfigChangedEvent ServerConfigChangedEvent;
 };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayStandbyState.h"
+#include "MultiplayServerInstanceState.generated.h"
+
+/**
+ * The state of the server hosted by one game instance, which is all a server keeps of its own when the SDK core is shared.
+ */
+USTRUCT(BlueprintType)
+struct MULTIPLAYGAMESERVERSDK_API FMultiplayServerInstanceState
+{
+    GENERATED_BODY()
+
+    /**
+     * The server ID read from the server.json of the game instance.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Instance")
+    int64 ServerId = 0;
+
+    /**
+     * The channel on which the server events of the server are published, empty when not subscribed to server events.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Instance")
+    FString ServerChannel;
+
+    /**
+     * Whether the Multiplay SDK daemon has acknowledged the subscription to the server channel.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Instance")
+    bool bSubscribed = false;
+
+    /**
+     * The allocation ID of the current allocation, empty when the server is not allocated.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Instance")
+    FString AllocationId;
+
+    /**
+     * How far the server has come in preparing for its next allocation.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Instance")
+    EMultiplayStandbyState StandbyState = EMultiplayStandbyState::Cold;
+
+    /**
+     * Whether the connection to the Multiplay SDK daemon is shared with the other game instances in the process.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Instance")
+    bool bSharedCore = false;
+
+    /**
+     * The number of servers subscribed to their server events over the connection to the Multiplay SDK daemon.
+     */
+    UPROPERTY(BlueprintReadOnly, Category="Multiplay | Instance")
+    int32 CoreServers = 0;
+};
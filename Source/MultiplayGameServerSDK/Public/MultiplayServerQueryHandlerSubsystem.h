@@ -6,6 +6,13 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "MultiplayServerQueryHandlerSubsystem.generated.h"
 
+struct FMultiplayServerConfig;
+
+namespace Multiplay
+{
+	class FMultiplayQueryReceiver;
+}
+
 /** 
   * @brief Subsystem responsible for handling Multiplay server queries. 
   */
@@ -209,6 +216,13 @@ private:
 	 */
 	void SendSQPQueryPacket(const FArrayReaderPtr& ArrayReaderPtr, TSharedRef<FInternetAddr> FromAddress);
 
+	/**
+	 * @brief Calls when the server configuration has been reloaded. Rebinds the query socket to the new query port if connected.
+	 * @param PreviousConfig The configuration before it was reloaded.
+	 * @param ServerConfig The reloaded configuration.
+	 */
+	void OnServerConfigChanged(const FMultiplayServerConfig& PreviousConfig, const FMultiplayServerConfig& ServerConfig);
+
 private:
 	static constexpr int32 kMaxStringLength = 255;
 
@@ -222,6 +236,11 @@ private:
      */
 	TUniquePtr<FUdpSocketReceiver> UDPReceiver;
 
+    /**
+     * The receiver shared by the game instances in the process when the SDK core is shared, it owns the query socket.
+     */
+	TSharedPtr<Multiplay::FMultiplayQueryReceiver> SharedReceiver;
+
     /**
      * A mapping of IPv4 addresses to challenge token IDs.
      */
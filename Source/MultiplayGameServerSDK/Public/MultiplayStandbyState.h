@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MultiplayStandbyState.generated.h"
+
+/**
+ * How far the server has come in preparing for its next allocation.
+ */
+UENUM(BlueprintType)
+enum class EMultiplayStandbyState : uint8
+{
+    /**
+     * No preload tasks have been added.
+     */
+    Cold,
+
+    /**
+     * The server is unallocated and preload tasks are running.
+     */
+    Warming,
+
+    /**
+     * The server is unallocated and every preload task has completed.
+     */
+    Hot,
+
+    /**
+     * The server is allocated. Preload tasks that had not completed keep running rather than being started again.
+     */
+    Allocated,
+};